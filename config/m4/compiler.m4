@@ -410,6 +410,14 @@ CHECK_SPECIFIC_ATTRIBUTE([optimize], [NOOPTIMIZE],
                          [int foo (int arg) __attribute__ ((optimize("O0")));])
 
 
+#
+# Check for compiler attribute which enables AVX code generation per-function,
+# so AVX copy routines can be built without -mavx and selected at runtime.
+#
+CHECK_SPECIFIC_ATTRIBUTE([target], [TARGET_AVX],
+                         [int foo (int arg) __attribute__ ((target("avx")));])
+
+
 #
 # Compile code with frame pointer. Optimizations usually omit the frame pointer,
 # but if we are profiling the code with callgraph we need it.
@@ -216,6 +216,15 @@ AC_CHECK_HEADERS([sys/capability.h],
 AC_CHECK_DECLS([PR_SET_PTRACER], [], [], [#include <sys/prctl.h>])
 
 
+#
+# Check for memfd and pidfd system calls
+#
+AC_CHECK_DECLS([SYS_memfd_create,
+                SYS_pidfd_open,
+                SYS_pidfd_getfd],
+               [], [], [#include <sys/syscall.h>])
+
+
 #
 # ipv6 s6_addr32/__u6_addr32 shortcuts for in6_addr
 # ip header structure layout name
@@ -212,6 +212,34 @@ run_client_server_app() {
 	wait ${server_pid} || true
 }
 
+run_client_server_group_app() {
+	test_exe=$1
+	test_args=$2
+	server_addr_arg=$3
+	group_size=$4
+
+	server_port_arg="-p $server_port"
+	step_server_port
+
+	${test_exe} ${test_args} -k ${group_size} ${server_port_arg} &
+	server_pid=$!
+
+	sleep 15
+
+	client_pids=""
+	for i in $(seq 2 ${group_size})
+	do
+		${test_exe} ${test_args} -k ${group_size} ${server_addr_arg} ${server_port_arg} &
+		client_pids="${client_pids} $!"
+	done
+
+	for pid in ${client_pids}
+	do
+		wait ${pid}
+	done
+	wait ${server_pid}
+}
+
 run_hello() {
 	api=$1
 	shift
@@ -489,6 +517,16 @@ run_ucx_perftest() {
 			# Run UCP loopback performance test
 			run_loopback_app "$ucx_perftest" "$ucp_test_args"
 
+			# Run UCP loopback message size sweep with JSON output
+			run_loopback_app "$ucx_perftest" \
+				"-t tag_lat -u 8-64k -V 10:5 -n 10000 -w 10 -J ucx_perftest_sweep.json"
+
+			# Run UCP incast and all-to-all tests in a group of 4 processes
+			run_client_server_group_app "$ucx_perftest" \
+				"-t tag_bw -j many_to_one -n 10000" "$(hostname)" 4
+			run_client_server_group_app "$ucx_perftest" \
+				"-t ucp_am_bw -j all_to_all -s 65536 -n 1000" "$(hostname)" 4
+
 			unset UCX_NET_DEVICES
 			unset UCX_TLS
 		fi
@@ -787,6 +825,7 @@ test_profiling() {
 	$UCX_READ_PROFILE -r ucx_jenkins.prof | grep "printf" -C 20
 	$UCX_READ_PROFILE -r ucx_jenkins.prof | grep -q "calc_pi"
 	$UCX_READ_PROFILE -r ucx_jenkins.prof | grep -q "print_pi"
+	$UCX_READ_PROFILE -f chrome ucx_jenkins.prof | grep -q "\"traceEvents\""
 }
 
 test_ucs_load() {
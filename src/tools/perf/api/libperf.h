@@ -84,6 +84,25 @@ typedef enum {
 } ucx_perf_channel_mode_t;
 
 
+typedef enum {
+    UCX_PERF_PATTERN_PAIR,           /* Pairs of processes (default) */
+    UCX_PERF_PATTERN_MANY_TO_ONE,    /* All processes send to process 0 */
+    UCX_PERF_PATTERN_ONE_TO_MANY,    /* Process 0 sends to all processes */
+    UCX_PERF_PATTERN_ALL_TO_ALL,     /* Every process sends to every other */
+    UCX_PERF_PATTERN_LAST
+} ucx_perf_pattern_t;
+
+
+typedef enum {
+    UCX_PERF_REPLAY_OP_TAG_SEND,
+    UCX_PERF_REPLAY_OP_TAG_SEND_SYNC,
+    UCX_PERF_REPLAY_OP_AM_SEND,
+    UCX_PERF_REPLAY_OP_PUT,
+    UCX_PERF_REPLAY_OP_GET,
+    UCX_PERF_REPLAY_OP_LAST
+} ucx_perf_replay_op_t;
+
+
 enum ucx_perf_test_flags {
     UCX_PERF_TEST_FLAG_VALIDATE         = UCS_BIT(1), /* Validate data. Affects performance. */
     UCX_PERF_TEST_FLAG_ONE_SIDED        = UCS_BIT(2), /* For tests which involves only one side,
@@ -98,7 +117,8 @@ enum ucx_perf_test_flags {
     UCX_PERF_TEST_FLAG_ERR_HANDLING     = UCS_BIT(11), /* Create UCP eps with error handling support */
     UCX_PERF_TEST_FLAG_LOOPBACK         = UCS_BIT(12), /* Use loopback connection */
     UCX_PERF_TEST_FLAG_PREREG           = UCS_BIT(13), /* Pass pre-registered memory handle */
-    UCX_PERF_TEST_FLAG_AM_RECV_COPY     = UCS_BIT(14)  /* Do additional memcopy during AM receive */
+    UCX_PERF_TEST_FLAG_AM_RECV_COPY     = UCS_BIT(14), /* Do additional memcopy during AM receive */
+    UCX_PERF_TEST_FLAG_DTLB_MISSES      = UCS_BIT(15)  /* Count dTLB load misses of the measured run */
 };
 
 
@@ -179,6 +199,19 @@ typedef enum {
 typedef uint64_t ucx_perf_counter_t;
 
 
+/*
+ * Result of a single receiving process in a group pattern test.
+ */
+typedef struct ucx_perf_receiver_result {
+    unsigned                rank;           /* Index of the receiver in the group */
+    unsigned                senders;        /* Number of processes sending to it */
+    double                  bandwidth;      /* Received bytes per second */
+    double                  msgrate;        /* Received messages per second */
+    double                  fairness;       /* Jain's fairness index of the
+                                               incoming flows, 1.0 is ideal */
+} ucx_perf_receiver_result_t;
+
+
 /*
  * Performance test result.
  *
@@ -195,9 +228,46 @@ typedef struct ucx_perf_result {
         double              total_average;  /* Average of the whole test */
     }
     latency, bandwidth, msgrate;
+    double                  dtlb_misses;    /* dTLB load misses per iteration,
+                                               negative if not measured */
+    double                  fairness;       /* Jain's fairness index of all
+                                               flows in a group pattern test */
+    unsigned                num_receivers;  /* Number of entries in receivers */
+    const ucx_perf_receiver_result_t *receivers; /* Per-receiver results of a
+                                               group pattern test, valid only
+                                               during the report callback */
 } ucx_perf_result_t;
 
 
+/*
+ * Latency distribution of replayed operations of one type.
+ */
+typedef struct ucx_perf_replay_op_result {
+    uint64_t                count;
+    uint64_t                bytes;
+    double                  latency_avg;    /* From issue to local completion */
+    double                  latency_p50;
+    double                  latency_p90;
+    double                  latency_p99;
+    double                  latency_max;
+} ucx_perf_replay_op_result_t;
+
+
+/*
+ * Result of replaying an operation trace recorded with UCX_OP_TRACE_FILE.
+ */
+typedef struct ucx_perf_replay_result {
+    uint64_t                    num_ops;
+    unsigned                    num_peers;  /* Distinct endpoints in the trace */
+    double                      trace_time; /* Between the first and the last
+                                               traced operation */
+    double                      total_time; /* Replay, until all operations
+                                               completed */
+    ucx_perf_replay_op_result_t ops[UCX_PERF_REPLAY_OP_LAST];
+    ucx_perf_replay_op_result_t total;
+} ucx_perf_replay_result_t;
+
+
 typedef struct {
     ucs_memory_type_t mem_type;
     int               device_id;
@@ -266,6 +336,7 @@ typedef struct ucx_perf_params {
     ucx_perf_api_t          api;             /* Which API to test */
     ucx_perf_cmd_t          command;         /* Command to perform */
     ucx_perf_test_type_t    test_type;       /* Test communication type */
+    ucx_perf_pattern_t      pattern;         /* Communication pattern of the group */
     ucs_thread_mode_t       thread_mode;     /* Thread mode for communication objects */
     unsigned                thread_count;    /* Number of threads in the test program */
     ucs_async_mode_t        async_mode;      /* how async progress and locking is done */
@@ -362,6 +433,19 @@ ucs_status_t ucx_perf_run(const ucx_perf_params_t *params,
                           ucx_perf_result_t *result);
 
 
+/**
+ * Replay an operation trace recorded with UCX_OP_TRACE_FILE against the peer
+ * process, one operation at a time. All traced peers are mapped to the single
+ * peer. The process which does not have the trace file (trace_file == NULL)
+ * receives the messages. If timed is nonzero, the original intervals between
+ * the operations are kept; otherwise the operations are issued back to back.
+ * Both processes return the same result.
+ */
+ucs_status_t ucx_perf_replay(const ucx_perf_params_t *params,
+                             const char *trace_file, int timed,
+                             ucx_perf_replay_result_t *result);
+
+
 END_C_DECLS
 
 #endif /* UCX_PERF_H_ */
@@ -25,6 +25,9 @@
 
 #include <string.h>
 #include <unistd.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
 
 #if _OPENMP
 #   include <omp.h>
@@ -288,6 +291,58 @@ void ucx_perf_calc_result(ucx_perf_context_t *perf, ucx_perf_result_t *result)
         perf->current.msgs /
         (perf->current.time_acc - perf->start_time_acc) * factor;
 
+    result->dtlb_misses = -1.0; /* Set by ucx_perf_dtlb_counter_stop() */
+    result->fairness      = 0.0;
+    result->num_receivers = 0;
+    result->receivers     = NULL;
+}
+
+void ucx_perf_dtlb_counter_start(ucx_perf_context_t *perf)
+{
+    struct perf_event_attr attr;
+
+    perf->dtlb.fd = -1;
+    if (!(perf->params.flags & UCX_PERF_TEST_FLAG_DTLB_MISSES)) {
+        return;
+    }
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type           = PERF_TYPE_HW_CACHE;
+    attr.size           = sizeof(attr);
+    attr.config         = PERF_COUNT_HW_CACHE_DTLB |
+                          (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+
+    /* Count for the calling thread on any CPU */
+    perf->dtlb.fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    if (perf->dtlb.fd < 0) {
+        ucs_warn("failed to open dTLB misses counter: %m");
+        return;
+    }
+
+    ioctl(perf->dtlb.fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(perf->dtlb.fd, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+void ucx_perf_dtlb_counter_stop(ucx_perf_context_t *perf,
+                                ucx_perf_result_t *result)
+{
+    if (perf->dtlb.fd < 0) {
+        return;
+    }
+
+    ioctl(perf->dtlb.fd, PERF_EVENT_IOC_DISABLE, 0);
+    if ((read(perf->dtlb.fd, &perf->dtlb.count, sizeof(perf->dtlb.count)) ==
+         sizeof(perf->dtlb.count)) &&
+        (perf->current.iters > 0)) {
+        result->dtlb_misses = (double)perf->dtlb.count / perf->current.iters;
+    }
+
+    close(perf->dtlb.fd);
+    perf->dtlb.fd = -1;
 }
 
 static ucs_status_t ucx_perf_test_check_params(ucx_perf_params_t *params)
@@ -2220,6 +2275,11 @@ ucs_status_t ucx_perf_run(const ucx_perf_params_t *params,
         goto out;
     }
 
+    if (params->pattern != UCX_PERF_PATTERN_PAIR) {
+        status = ucx_perf_pattern_run(params, result);
+        goto out;
+    }
+
     perf = malloc(sizeof(*perf));
     if (perf == NULL) {
         status = UCS_ERR_NO_MEMORY;
@@ -2257,10 +2317,12 @@ ucs_status_t ucx_perf_run(const ucx_perf_params_t *params,
         }
 
         /* Run test */
+        ucx_perf_dtlb_counter_start(perf);
         status = ucx_perf_funcs[params->api].run(perf);
         ucx_perf_funcs[params->api].barrier(perf);
         if (status == UCS_OK) {
             ucx_perf_calc_result(perf, result);
+            ucx_perf_dtlb_counter_stop(perf, result);
             perf->params.report_func(perf->params.rte_group, result,
                                      perf->params.report_arg, perf->extra_info,
                                      1, 0);
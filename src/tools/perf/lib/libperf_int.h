@@ -114,6 +114,12 @@ struct ucx_perf_context {
 
     char                         extra_info[EXTRA_INFO_SIZE];
 
+    /* dTLB load misses counter of the measured run */
+    struct {
+        int                      fd;
+        uint64_t                 count;
+    } dtlb;
+
     union {
         struct {
             ucs_async_context_t    async;
@@ -183,6 +189,9 @@ void uct_perf_iface_flush_b(ucx_perf_context_t *perf);
 ucs_status_t uct_perf_test_dispatch(ucx_perf_context_t *perf);
 ucs_status_t ucp_perf_test_dispatch(ucx_perf_context_t *perf);
 void ucx_perf_calc_result(ucx_perf_context_t *perf, ucx_perf_result_t *result);
+void ucx_perf_dtlb_counter_start(ucx_perf_context_t *perf);
+void ucx_perf_dtlb_counter_stop(ucx_perf_context_t *perf,
+                                ucx_perf_result_t *result);
 void uct_perf_barrier(ucx_perf_context_t *perf);
 void ucp_perf_thread_barrier(ucx_perf_context_t *perf);
 void ucp_perf_barrier(ucx_perf_context_t *perf);
@@ -191,6 +200,8 @@ ucs_status_t ucp_perf_test_alloc_mem(ucx_perf_context_t *perf);
 void ucp_perf_test_free_mem(ucx_perf_context_t *perf);
 ucs_status_t uct_perf_test_alloc_mem(ucx_perf_context_t *perf);
 void uct_perf_test_free_mem(ucx_perf_context_t *perf);
+ucs_status_t ucx_perf_pattern_run(const ucx_perf_params_t *params,
+                                  ucx_perf_result_t *result);
 ucs_status_t ucx_perf_thread_spawn(ucx_perf_context_t *perf,
                                    ucx_perf_result_t* result);
 void ucx_perf_test_prepare_new_run(ucx_perf_context_t *perf,
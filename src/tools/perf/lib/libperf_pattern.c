@@ -0,0 +1,1042 @@
+/**
+* Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+*
+* See file LICENSE for terms.
+*/
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <ucs/debug/log.h>
+#include <ucs/sys/string.h>
+
+#include <tools/perf/lib/libperf_int.h>
+
+#include <string.h>
+
+
+/* Group pattern tests run on their own UCP context and worker, so any AM id
+ * and tag space may be used */
+#define UCP_PERF_PATTERN_AM_ID      0
+#define UCP_PERF_PATTERN_TAG        0x5ca1ab1e00000000ul
+#define UCP_PERF_PATTERN_TAG_MASK   0xffffffff00000000ul
+#define UCP_PERF_PATTERN_SRC_MASK   0x00000000fffffffful
+
+/* Keep warmup short: each flow does it, and the group may be large */
+#define UCP_PERF_PATTERN_MAX_WARMUP 100
+
+
+/*
+ * Connection information posted by every process of the group.
+ */
+typedef struct {
+    uint32_t                group_index;
+    uint32_t                address_length;
+    uint32_t                rkey_length;
+    uint64_t                recv_buffer;
+    /* Followed by worker address and packed rkey */
+} UCS_S_PACKED ucp_perf_pattern_info_t;
+
+
+/*
+ * Measured counters of a single flow, exchanged after the run.
+ */
+typedef struct {
+    uint32_t                src;
+    uint32_t                dst;
+    uint64_t                msgs;
+    uint64_t                bytes;
+    double                  elapsed;
+} UCS_S_PACKED ucp_perf_pattern_flow_t;
+
+
+typedef struct {
+    uint32_t                group_index;
+    uint32_t                num_flows;
+    /* Followed by num_flows ucp_perf_pattern_flow_t */
+} UCS_S_PACKED ucp_perf_pattern_stats_hdr_t;
+
+
+typedef struct ucp_perf_pattern ucp_perf_pattern_t;
+
+
+/*
+ * State of the flows between this process and one remote process.
+ */
+typedef struct {
+    ucp_perf_pattern_t      *pattern;
+    unsigned                index;       /* Remote process index */
+    int                     is_dest;     /* We send to the remote process */
+    int                     is_src;      /* The remote process sends to us */
+    ucp_ep_h                ep;
+    ucp_rkey_h              rkey;
+    uint64_t                remote_addr;
+    ucx_perf_counter_t      posted;      /* Sends posted to the peer */
+    ucx_perf_counter_t      completed;   /* Sends completed to the peer */
+    ucx_perf_counter_t      received;    /* Messages received from the peer */
+    int                     flushing;    /* Flush of PUT flow was issued */
+    int                     done;        /* Measured side of the flow is done */
+    double                  start_time;  /* First message received */
+    double                  end_time;
+} ucp_perf_pattern_peer_t;
+
+
+struct ucp_perf_pattern {
+    const ucx_perf_params_t *params;
+    unsigned                group_size;
+    unsigned                group_index;
+    uint32_t                am_header;   /* Our index, sent in every AM */
+    size_t                  length;
+    ucp_context_h           context;
+    ucp_worker_h            worker;
+    ucp_mem_h               send_memh;
+    ucp_mem_h               recv_memh;
+    void                    *send_buffer;
+    void                    *recv_buffer;
+    ucp_perf_pattern_peer_t *peers;
+    ucx_perf_counter_t      iters;       /* Messages per flow in current pass */
+    unsigned                window;      /* Outstanding sends per flow */
+    ucx_perf_counter_t      recv_posted; /* Tag receives posted */
+    ucx_perf_counter_t      recv_total;  /* Tag receives expected in a pass */
+    ucx_perf_counter_t      recv_done;   /* Tag receives completed */
+    unsigned                flows_left;  /* Flows not completed in a pass */
+    double                  start_time;
+    ucs_status_t            status;      /* First error from a callback */
+};
+
+
+static int ucp_perf_pattern_is_flow(ucx_perf_pattern_t pattern, unsigned src,
+                                    unsigned dst)
+{
+    if (src == dst) {
+        return 0;
+    }
+
+    switch (pattern) {
+    case UCX_PERF_PATTERN_MANY_TO_ONE:
+        return dst == 0;
+    case UCX_PERF_PATTERN_ONE_TO_MANY:
+        return src == 0;
+    case UCX_PERF_PATTERN_ALL_TO_ALL:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+/* PUT flows are measured by the sender, since the target is passive */
+static UCS_F_ALWAYS_INLINE int
+ucp_perf_pattern_sender_measured(const ucp_perf_pattern_t *pattern)
+{
+    return pattern->params->command == UCX_PERF_CMD_PUT;
+}
+
+static void ucp_perf_pattern_error(ucp_perf_pattern_t *pattern,
+                                   ucs_status_t status)
+{
+    if (pattern->status == UCS_OK) {
+        pattern->status = status;
+    }
+}
+
+static void ucp_perf_pattern_flow_done(ucp_perf_pattern_peer_t *peer)
+{
+    ucs_assert(!peer->done);
+    peer->done     = 1;
+    peer->end_time = ucs_get_accurate_time();
+    --peer->pattern->flows_left;
+}
+
+static void ucp_perf_pattern_recv_done(ucp_perf_pattern_t *pattern,
+                                       unsigned src)
+{
+    ucp_perf_pattern_peer_t *peer;
+
+    if ((src >= pattern->group_size) || !pattern->peers[src].is_src) {
+        ucs_error("received a message from unexpected process %u", src);
+        ucp_perf_pattern_error(pattern, UCS_ERR_IO_ERROR);
+        return;
+    }
+
+    /* Faster processes leave the barrier first, so messages may arrive while
+     * this one is still in the barrier */
+    peer = &pattern->peers[src];
+    if (peer->received == 0) {
+        peer->start_time = ucs_get_accurate_time();
+    }
+
+    if (++peer->received == pattern->iters) {
+        ucp_perf_pattern_flow_done(peer);
+    }
+}
+
+static void ucp_perf_pattern_send_cb(void *request, ucs_status_t status,
+                                     void *user_data)
+{
+    ucp_perf_pattern_peer_t *peer = user_data;
+
+    if (status != UCS_OK) {
+        ucp_perf_pattern_error(peer->pattern, status);
+    }
+
+    ++peer->completed;
+    ucp_request_free(request);
+}
+
+static void ucp_perf_pattern_flush_cb(void *request, ucs_status_t status,
+                                      void *user_data)
+{
+    ucp_perf_pattern_peer_t *peer = user_data;
+
+    if (status != UCS_OK) {
+        ucp_perf_pattern_error(peer->pattern, status);
+    }
+
+    ucp_perf_pattern_flow_done(peer);
+    ucp_request_free(request);
+}
+
+static void ucp_perf_pattern_tag_recv_cb(void *request, ucs_status_t status,
+                                         const ucp_tag_recv_info_t *info,
+                                         void *user_data)
+{
+    ucp_perf_pattern_t *pattern = user_data;
+
+    ++pattern->recv_done;
+    if (status != UCS_OK) {
+        ucp_perf_pattern_error(pattern, status);
+    } else {
+        ucp_perf_pattern_recv_done(pattern,
+                                   info->sender_tag & UCP_PERF_PATTERN_SRC_MASK);
+    }
+
+    ucp_request_free(request);
+}
+
+static void ucp_perf_pattern_am_data_cb(void *request, ucs_status_t status,
+                                        size_t length, void *user_data)
+{
+    ucp_perf_pattern_peer_t *peer = user_data;
+
+    if (status != UCS_OK) {
+        ucp_perf_pattern_error(peer->pattern, status);
+    } else {
+        ucp_perf_pattern_recv_done(peer->pattern, peer->index);
+    }
+
+    ucp_request_free(request);
+}
+
+static ucs_status_t
+ucp_perf_pattern_am_cb(void *arg, const void *header, size_t header_length,
+                       void *data, size_t length,
+                       const ucp_am_recv_param_t *param)
+{
+    ucp_perf_pattern_t *pattern = arg;
+    ucp_request_param_t recv_param;
+    ucs_status_ptr_t sptr;
+    uint32_t src;
+
+    if (header_length != sizeof(src)) {
+        ucs_error("unexpected AM header length %zu", header_length);
+        ucp_perf_pattern_error(pattern, UCS_ERR_IO_ERROR);
+        return UCS_OK;
+    }
+
+    src = *(const uint32_t*)header;
+    if (!(param->recv_attr & UCP_AM_RECV_ATTR_FLAG_RNDV)) {
+        ucp_perf_pattern_recv_done(pattern, src);
+        return UCS_OK;
+    }
+
+    if (src >= pattern->group_size) {
+        ucs_error("received a message from unexpected process %u", src);
+        ucp_perf_pattern_error(pattern, UCS_ERR_IO_ERROR);
+        ucp_am_data_release(pattern->worker, data);
+        return UCS_OK;
+    }
+
+    recv_param.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK |
+                              UCP_OP_ATTR_FIELD_USER_DATA;
+    recv_param.cb.recv_am   = ucp_perf_pattern_am_data_cb;
+    recv_param.user_data   = &pattern->peers[src];
+
+    sptr = ucp_am_recv_data_nbx(pattern->worker, data, pattern->recv_buffer,
+                                length, &recv_param);
+    if (sptr == NULL) {
+        ucp_perf_pattern_recv_done(pattern, src);
+    } else if (UCS_PTR_IS_ERR(sptr)) {
+        ucp_perf_pattern_error(pattern, UCS_PTR_STATUS(sptr));
+    }
+
+    return UCS_INPROGRESS;
+}
+
+static void ucp_perf_pattern_progress(void *arg)
+{
+    ucp_perf_pattern_t *pattern = arg;
+
+    ucp_worker_progress(pattern->worker);
+}
+
+static void ucp_perf_pattern_barrier(ucp_perf_pattern_t *pattern)
+{
+    pattern->params->rte->barrier(pattern->params->rte_group,
+                                  ucp_perf_pattern_progress, pattern);
+}
+
+static ucs_status_t ucp_perf_pattern_check(const ucx_perf_params_t *params,
+                                           unsigned group_size)
+{
+    if (params->api != UCX_PERF_API_UCP) {
+        ucs_error("communication patterns are supported only for UCP tests");
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    if ((params->command != UCX_PERF_CMD_TAG) &&
+        (params->command != UCX_PERF_CMD_AM) &&
+        (params->command != UCX_PERF_CMD_PUT)) {
+        ucs_error("communication patterns are supported only for tag, am "
+                  "and put tests");
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    if (params->test_type != UCX_PERF_TEST_TYPE_STREAM_UNI) {
+        ucs_error("communication patterns require a unidirectional "
+                  "bandwidth test");
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    if ((params->thread_count != 1) ||
+        (params->send_mem_type != UCS_MEMORY_TYPE_HOST) ||
+        (params->recv_mem_type != UCS_MEMORY_TYPE_HOST) ||
+        (params->ucp.send_datatype != UCP_PERF_DATATYPE_CONTIG) ||
+        (params->ucp.is_daemon_mode)) {
+        ucs_error("communication patterns support only a single thread, "
+                  "contiguous host memory and no daemon offload");
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    if (params->max_iter == 0) {
+        ucs_error("communication patterns require an iteration count");
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    if (group_size < 2) {
+        ucs_error("communication patterns require at least 2 processes");
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    return UCS_OK;
+}
+
+static ucs_status_t ucp_perf_pattern_mem_alloc(ucp_perf_pattern_t *pattern,
+                                               void **address_p,
+                                               ucp_mem_h *memh_p)
+{
+    ucp_mem_map_params_t params;
+    ucp_mem_attr_t attr;
+    ucs_status_t status;
+
+    params.field_mask = UCP_MEM_MAP_PARAM_FIELD_ADDRESS |
+                        UCP_MEM_MAP_PARAM_FIELD_LENGTH |
+                        UCP_MEM_MAP_PARAM_FIELD_FLAGS;
+    params.address    = NULL;
+    params.length     = pattern->length;
+    params.flags      = UCP_MEM_MAP_ALLOCATE;
+
+    status = ucp_mem_map(pattern->context, &params, memh_p);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    attr.field_mask = UCP_MEM_ATTR_FIELD_ADDRESS;
+    status          = ucp_mem_query(*memh_p, &attr);
+    if (status != UCS_OK) {
+        ucp_mem_unmap(pattern->context, *memh_p);
+        return status;
+    }
+
+    *address_p = attr.address;
+    return UCS_OK;
+}
+
+static ucs_status_t ucp_perf_pattern_init(ucp_perf_pattern_t *pattern)
+{
+    const ucx_perf_params_t *params = pattern->params;
+    ucp_am_handler_param_t am_param;
+    ucp_worker_params_t worker_params;
+    ucp_params_t ucp_params;
+    ucs_status_t status;
+    ucp_config_t *config;
+
+    ucp_params.field_mask = UCP_PARAM_FIELD_FEATURES | UCP_PARAM_FIELD_NAME;
+    ucp_params.name       = "perftest";
+    switch (params->command) {
+    case UCX_PERF_CMD_TAG:
+        ucp_params.features = UCP_FEATURE_TAG;
+        break;
+    case UCX_PERF_CMD_AM:
+        ucp_params.features = UCP_FEATURE_AM;
+        break;
+    default:
+        ucp_params.features = UCP_FEATURE_RMA;
+        break;
+    }
+
+    status = ucp_config_read(NULL, NULL, &config);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    status = ucp_init(&ucp_params, config, &pattern->context);
+    ucp_config_release(config);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    worker_params.field_mask  = UCP_WORKER_PARAM_FIELD_THREAD_MODE;
+    worker_params.thread_mode = params->thread_mode;
+    status = ucp_worker_create(pattern->context, &worker_params,
+                               &pattern->worker);
+    if (status != UCS_OK) {
+        goto err_cleanup;
+    }
+
+    status = ucp_perf_pattern_mem_alloc(pattern, &pattern->send_buffer,
+                                        &pattern->send_memh);
+    if (status != UCS_OK) {
+        goto err_destroy_worker;
+    }
+
+    status = ucp_perf_pattern_mem_alloc(pattern, &pattern->recv_buffer,
+                                        &pattern->recv_memh);
+    if (status != UCS_OK) {
+        goto err_free_send;
+    }
+
+    memset(pattern->send_buffer, 0, pattern->length);
+
+    if (params->command == UCX_PERF_CMD_AM) {
+        am_param.field_mask = UCP_AM_HANDLER_PARAM_FIELD_ID |
+                              UCP_AM_HANDLER_PARAM_FIELD_FLAGS |
+                              UCP_AM_HANDLER_PARAM_FIELD_CB |
+                              UCP_AM_HANDLER_PARAM_FIELD_ARG;
+        am_param.id         = UCP_PERF_PATTERN_AM_ID;
+        am_param.flags      = UCP_AM_FLAG_WHOLE_MSG;
+        am_param.cb         = ucp_perf_pattern_am_cb;
+        am_param.arg        = pattern;
+        status = ucp_worker_set_am_recv_handler(pattern->worker, &am_param);
+        if (status != UCS_OK) {
+            goto err_free_recv;
+        }
+    }
+
+    return UCS_OK;
+
+err_free_recv:
+    ucp_mem_unmap(pattern->context, pattern->recv_memh);
+err_free_send:
+    ucp_mem_unmap(pattern->context, pattern->send_memh);
+err_destroy_worker:
+    ucp_worker_destroy(pattern->worker);
+err_cleanup:
+    ucp_cleanup(pattern->context);
+    return status;
+}
+
+static void ucp_perf_pattern_cleanup(ucp_perf_pattern_t *pattern)
+{
+    ucp_mem_unmap(pattern->context, pattern->recv_memh);
+    ucp_mem_unmap(pattern->context, pattern->send_memh);
+    ucp_worker_destroy(pattern->worker);
+    ucp_cleanup(pattern->context);
+}
+
+static void ucp_perf_pattern_close_eps(ucp_perf_pattern_t *pattern)
+{
+    ucp_request_param_t param;
+    ucs_status_ptr_t sptr;
+    unsigned i;
+
+    param.op_attr_mask = 0;
+    for (i = 0; i < pattern->group_size; ++i) {
+        if (pattern->peers[i].rkey != NULL) {
+            ucp_rkey_destroy(pattern->peers[i].rkey);
+        }
+
+        if (pattern->peers[i].ep == NULL) {
+            continue;
+        }
+
+        sptr = ucp_ep_close_nbx(pattern->peers[i].ep, &param);
+        if (UCS_PTR_IS_PTR(sptr)) {
+            while (ucp_request_check_status(sptr) == UCS_INPROGRESS) {
+                ucp_worker_progress(pattern->worker);
+            }
+            ucp_request_free(sptr);
+        }
+    }
+}
+
+static ucs_status_t ucp_perf_pattern_connect(ucp_perf_pattern_t *pattern)
+{
+    const size_t buffer_size         = ADDR_BUF_SIZE;
+    const ucx_perf_params_t *params  = pattern->params;
+    ucp_perf_pattern_info_t info, *remote_info;
+    ucp_perf_pattern_peer_t *peer;
+    ucp_address_t *address;
+    size_t address_length;
+    ucp_ep_params_t ep_params;
+    void *rkey_buffer;
+    size_t rkey_size;
+    ucs_status_t status;
+    struct iovec vec[3];
+    void *buffer;
+    void *req;
+    unsigned i;
+
+    buffer = malloc(buffer_size);
+    if (buffer == NULL) {
+        ucs_error("failed to allocate RTE buffer");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    status = ucp_worker_get_address(pattern->worker, &address,
+                                    &address_length);
+    if (status != UCS_OK) {
+        goto out_free_buffer;
+    }
+
+    rkey_buffer = NULL;
+    rkey_size   = 0;
+    if (params->command == UCX_PERF_CMD_PUT) {
+        status = ucp_rkey_pack(pattern->context, pattern->recv_memh,
+                               &rkey_buffer, &rkey_size);
+        if (status != UCS_OK) {
+            ucs_error("ucp_rkey_pack() failed: %s", ucs_status_string(status));
+            goto out_release_address;
+        }
+    }
+
+    info.group_index    = pattern->group_index;
+    info.address_length = address_length;
+    info.rkey_length    = rkey_size;
+    info.recv_buffer    = (uintptr_t)pattern->recv_buffer;
+
+    if ((sizeof(info) + address_length + rkey_size) > buffer_size) {
+        ucs_error("connection information is too large (%zu bytes)",
+                  sizeof(info) + address_length + rkey_size);
+        status = UCS_ERR_BUFFER_TOO_SMALL;
+        goto out_release_rkey;
+    }
+
+    vec[0].iov_base = &info;
+    vec[0].iov_len  = sizeof(info);
+    vec[1].iov_base = address;
+    vec[1].iov_len  = address_length;
+    vec[2].iov_base = rkey_buffer;
+    vec[2].iov_len  = rkey_size;
+
+    params->rte->post_vec(params->rte_group, vec, 3, &req);
+    params->rte->exchange_vec(params->rte_group, req);
+
+    ep_params.field_mask = UCP_EP_PARAM_FIELD_REMOTE_ADDRESS;
+    for (i = 0; i < pattern->group_size; ++i) {
+        if (i == pattern->group_index) {
+            continue;
+        }
+
+        /* The runtime must deliver the information of every process, not
+         * only of the paired one */
+        remote_info              = buffer;
+        remote_info->group_index = UINT32_MAX;
+        params->rte->recv(params->rte_group, i, buffer, buffer_size, req);
+        if (remote_info->group_index != i) {
+            ucs_error("runtime does not support group exchange, process %u "
+                      "information is missing", i);
+            status = UCS_ERR_UNSUPPORTED;
+            goto out_release_rkey;
+        }
+
+        peer = &pattern->peers[i];
+        if (!peer->is_dest) {
+            continue;
+        }
+
+        ep_params.address = (ucp_address_t*)(remote_info + 1);
+        status = ucp_ep_create(pattern->worker, &ep_params, &peer->ep);
+        if (status != UCS_OK) {
+            goto out_release_rkey;
+        }
+
+        if (params->command == UCX_PERF_CMD_PUT) {
+            status = ucp_ep_rkey_unpack(peer->ep,
+                                        UCS_PTR_BYTE_OFFSET(ep_params.address,
+                                                remote_info->address_length),
+                                        &peer->rkey);
+            if (status != UCS_OK) {
+                ucs_error("ucp_ep_rkey_unpack() failed: %s",
+                          ucs_status_string(status));
+                goto out_release_rkey;
+            }
+
+            peer->remote_addr = remote_info->recv_buffer;
+        }
+    }
+
+    status = UCS_OK;
+
+out_release_rkey:
+    if (rkey_buffer != NULL) {
+        ucp_rkey_buffer_release(rkey_buffer);
+    }
+out_release_address:
+    ucp_worker_release_address(pattern->worker, address);
+out_free_buffer:
+    free(buffer);
+    return status;
+}
+
+static ucs_status_t ucp_perf_pattern_send(ucp_perf_pattern_t *pattern,
+                                          ucp_perf_pattern_peer_t *peer)
+{
+    ucp_request_param_t param;
+    ucs_status_ptr_t sptr;
+    ucp_tag_t tag;
+
+    param.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK |
+                         UCP_OP_ATTR_FIELD_USER_DATA;
+    param.cb.send      = ucp_perf_pattern_send_cb;
+    param.user_data    = peer;
+
+    switch (pattern->params->command) {
+    case UCX_PERF_CMD_TAG:
+        tag  = UCP_PERF_PATTERN_TAG | pattern->group_index;
+        sptr = ucp_tag_send_nbx(peer->ep, pattern->send_buffer,
+                                pattern->length, tag, &param);
+        break;
+    case UCX_PERF_CMD_AM:
+        sptr = ucp_am_send_nbx(peer->ep, UCP_PERF_PATTERN_AM_ID,
+                               &pattern->am_header, sizeof(pattern->am_header),
+                               pattern->send_buffer, pattern->length, &param);
+        break;
+    default:
+        sptr = ucp_put_nbx(peer->ep, pattern->send_buffer, pattern->length,
+                           peer->remote_addr, peer->rkey, &param);
+        break;
+    }
+
+    ++peer->posted;
+    if (sptr == NULL) {
+        ++peer->completed;
+    } else if (UCS_PTR_IS_ERR(sptr)) {
+        return UCS_PTR_STATUS(sptr);
+    }
+
+    return UCS_OK;
+}
+
+static ucs_status_t ucp_perf_pattern_flush(ucp_perf_pattern_t *pattern,
+                                           ucp_perf_pattern_peer_t *peer)
+{
+    ucp_request_param_t param;
+    ucs_status_ptr_t sptr;
+
+    param.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK |
+                         UCP_OP_ATTR_FIELD_USER_DATA;
+    param.cb.send      = ucp_perf_pattern_flush_cb;
+    param.user_data    = peer;
+
+    peer->flushing = 1;
+    sptr           = ucp_ep_flush_nbx(peer->ep, &param);
+    if (sptr == NULL) {
+        ucp_perf_pattern_flow_done(peer);
+    } else if (UCS_PTR_IS_ERR(sptr)) {
+        return UCS_PTR_STATUS(sptr);
+    }
+
+    return UCS_OK;
+}
+
+static ucs_status_t ucp_perf_pattern_post_recvs(ucp_perf_pattern_t *pattern)
+{
+    ucp_request_param_t param;
+    ucp_tag_recv_info_t info;
+    ucs_status_ptr_t sptr;
+
+    param.op_attr_mask  = UCP_OP_ATTR_FIELD_CALLBACK |
+                          UCP_OP_ATTR_FIELD_USER_DATA |
+                          UCP_OP_ATTR_FIELD_RECV_INFO;
+    param.cb.recv       = ucp_perf_pattern_tag_recv_cb;
+    param.user_data     = pattern;
+    param.recv_info.tag_info = &info;
+
+    while ((pattern->recv_posted < pattern->recv_total) &&
+           ((pattern->recv_posted - pattern->recv_done) < pattern->window)) {
+        ++pattern->recv_posted;
+        sptr = ucp_tag_recv_nbx(pattern->worker, pattern->recv_buffer,
+                                pattern->length, UCP_PERF_PATTERN_TAG,
+                                UCP_PERF_PATTERN_TAG_MASK, &param);
+        if (sptr == NULL) {
+            ++pattern->recv_done;
+            ucp_perf_pattern_recv_done(pattern, info.sender_tag &
+                                                UCP_PERF_PATTERN_SRC_MASK);
+        } else if (UCS_PTR_IS_ERR(sptr)) {
+            return UCS_PTR_STATUS(sptr);
+        }
+    }
+
+    return UCS_OK;
+}
+
+/*
+ * Run one pass of the pattern: every flow transfers 'iters' messages. Returns
+ * when all the flows this process participates in are complete.
+ */
+static ucs_status_t ucp_perf_pattern_pass(ucp_perf_pattern_t *pattern,
+                                          ucx_perf_counter_t iters)
+{
+    int sender_measured = ucp_perf_pattern_sender_measured(pattern);
+    ucp_perf_pattern_peer_t *peer;
+    unsigned i, num_srcs, sends_left;
+    ucs_status_t status;
+
+    num_srcs            = 0;
+    pattern->flows_left = 0;
+    pattern->iters      = iters;
+    for (i = 0; i < pattern->group_size; ++i) {
+        peer            = &pattern->peers[i];
+        peer->posted     = 0;
+        peer->completed  = 0;
+        peer->received   = 0;
+        peer->flushing   = 0;
+        peer->done       = 0;
+        peer->start_time = 0;
+        peer->end_time   = 0;
+        num_srcs       += peer->is_src;
+        if (sender_measured ? peer->is_dest : peer->is_src) {
+            ++pattern->flows_left;
+        }
+    }
+
+    pattern->window      = ucs_max(pattern->params->max_outstanding, 1);
+    pattern->recv_posted = 0;
+    pattern->recv_done   = 0;
+    pattern->recv_total  = (pattern->params->command == UCX_PERF_CMD_TAG) ?
+                           (iters * num_srcs) : 0;
+
+    ucp_perf_pattern_barrier(pattern);
+    pattern->start_time = ucs_get_accurate_time();
+
+    do {
+        sends_left = 0;
+        for (i = 0; i < pattern->group_size; ++i) {
+            peer = &pattern->peers[i];
+            if (!peer->is_dest) {
+                continue;
+            }
+
+            while ((peer->posted < iters) &&
+                   ((peer->posted - peer->completed) < pattern->window)) {
+                status = ucp_perf_pattern_send(pattern, peer);
+                if (status != UCS_OK) {
+                    return status;
+                }
+            }
+
+            if (peer->completed < iters) {
+                ++sends_left;
+            } else if (sender_measured && !peer->flushing) {
+                status = ucp_perf_pattern_flush(pattern, peer);
+                if (status != UCS_OK) {
+                    return status;
+                }
+            }
+        }
+
+        status = ucp_perf_pattern_post_recvs(pattern);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        ucp_worker_progress(pattern->worker);
+        if (pattern->status != UCS_OK) {
+            return pattern->status;
+        }
+    } while ((pattern->flows_left > 0) || (sends_left > 0));
+
+    return UCS_OK;
+}
+
+/* Jain's fairness index: 1.0 when all flows get the same throughput */
+static double ucp_perf_pattern_fairness(const double *values, unsigned count)
+{
+    double sum = 0, sum_sq = 0;
+    unsigned i;
+
+    for (i = 0; i < count; ++i) {
+        sum    += values[i];
+        sum_sq += values[i] * values[i];
+    }
+
+    if (sum_sq == 0) {
+        return 0;
+    }
+
+    return (sum * sum) / (count * sum_sq);
+}
+
+/*
+ * Gather the counters of all flows to every process, so all of them compute
+ * identical results.
+ */
+static ucs_status_t
+ucp_perf_pattern_gather(ucp_perf_pattern_t *pattern,
+                        ucp_perf_pattern_flow_t **flows_p,
+                        unsigned *num_flows_p)
+{
+    const ucx_perf_params_t *params = pattern->params;
+    int sender_measured             = ucp_perf_pattern_sender_measured(pattern);
+    unsigned group_size             = pattern->group_size;
+    size_t buffer_size              = sizeof(ucp_perf_pattern_stats_hdr_t) +
+                                      (group_size *
+                                       sizeof(ucp_perf_pattern_flow_t));
+    ucp_perf_pattern_stats_hdr_t *hdr;
+    ucp_perf_pattern_flow_t *flows, *flow;
+    ucp_perf_pattern_peer_t *peer;
+    unsigned i, num_flows;
+    ucs_status_t status;
+    struct iovec vec;
+    double start;
+    void *req;
+
+    hdr   = malloc(buffer_size);
+    flows = calloc(group_size * group_size, sizeof(*flows));
+    if ((hdr == NULL) || (flows == NULL)) {
+        status = UCS_ERR_NO_MEMORY;
+        goto err_free;
+    }
+
+    hdr->group_index = pattern->group_index;
+    hdr->num_flows   = 0;
+    flow             = (ucp_perf_pattern_flow_t*)(hdr + 1);
+    for (i = 0; i < group_size; ++i) {
+        peer = &pattern->peers[i];
+        if (!(sender_measured ? peer->is_dest : peer->is_src)) {
+            continue;
+        }
+
+        flow->src     = sender_measured ? pattern->group_index : i;
+        flow->dst     = sender_measured ? i : pattern->group_index;
+        flow->msgs    = pattern->iters;
+        flow->bytes   = pattern->iters * pattern->length;
+        start         = sender_measured ? pattern->start_time :
+                        ucs_min(pattern->start_time, peer->start_time);
+        flow->elapsed = peer->end_time - start;
+        ++flow;
+        ++hdr->num_flows;
+    }
+
+    /* Own flows first, the runtime does not loop back our own data */
+    memcpy(flows, hdr + 1, hdr->num_flows * sizeof(*flows));
+    num_flows = hdr->num_flows;
+
+    vec.iov_base = hdr;
+    vec.iov_len  = UCS_PTR_BYTE_DIFF(hdr, flow);
+    params->rte->post_vec(params->rte_group, &vec, 1, &req);
+    params->rte->exchange_vec(params->rte_group, req);
+
+    for (i = 0; i < group_size; ++i) {
+        if (i == pattern->group_index) {
+            continue;
+        }
+
+        hdr->group_index = UINT32_MAX;
+        params->rte->recv(params->rte_group, i, hdr, buffer_size, req);
+        if ((hdr->group_index != i) || (hdr->num_flows > group_size)) {
+            ucs_error("failed to gather results of process %u", i);
+            status = UCS_ERR_IO_ERROR;
+            goto err_free;
+        }
+
+        memcpy(&flows[num_flows], hdr + 1, hdr->num_flows * sizeof(*flows));
+        num_flows += hdr->num_flows;
+    }
+
+    free(hdr);
+    *flows_p     = flows;
+    *num_flows_p = num_flows;
+    return UCS_OK;
+
+err_free:
+    free(flows);
+    free(hdr);
+    return status;
+}
+
+static ucs_status_t ucp_perf_pattern_report(ucp_perf_pattern_t *pattern,
+                                            ucx_perf_result_t *result)
+{
+    const ucx_perf_params_t *params = pattern->params;
+    ucx_perf_receiver_result_t *receivers, *receiver;
+    double *throughput, *rank_throughput;
+    double elapsed, rank_elapsed;
+    uint64_t bytes, msgs, rank_bytes, rank_msgs;
+    ucp_perf_pattern_flow_t *flows;
+    unsigned num_flows, i, rank, count;
+    ucs_status_t status;
+
+    status = ucp_perf_pattern_gather(pattern, &flows, &num_flows);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    throughput      = calloc(ucs_max(num_flows, 1) * 2, sizeof(*throughput));
+    receivers       = calloc(pattern->group_size, sizeof(*receivers));
+    if ((throughput == NULL) || (receivers == NULL)) {
+        status = UCS_ERR_NO_MEMORY;
+        goto out;
+    }
+
+    rank_throughput = throughput + ucs_max(num_flows, 1);
+
+    elapsed = 0;
+    bytes   = 0;
+    msgs    = 0;
+    for (i = 0; i < num_flows; ++i) {
+        elapsed       = ucs_max(elapsed, flows[i].elapsed);
+        bytes        += flows[i].bytes;
+        msgs         += flows[i].msgs;
+        throughput[i] = flows[i].bytes / ucs_max(flows[i].elapsed, 1e-9);
+    }
+
+    memset(result, 0, sizeof(*result));
+    elapsed             = ucs_max(elapsed, 1e-9);
+    result->dtlb_misses = -1.0;
+    result->fairness    = ucp_perf_pattern_fairness(throughput, num_flows);
+
+    for (rank = 0; rank < pattern->group_size; ++rank) {
+        count        = 0;
+        rank_elapsed = 0;
+        rank_bytes   = 0;
+        rank_msgs    = 0;
+        for (i = 0; i < num_flows; ++i) {
+            if (flows[i].dst == rank) {
+                rank_throughput[count++] = throughput[i];
+                rank_elapsed             = ucs_max(rank_elapsed,
+                                                   flows[i].elapsed);
+                rank_bytes              += flows[i].bytes;
+                rank_msgs               += flows[i].msgs;
+            }
+        }
+
+        if (count == 0) {
+            continue;
+        }
+
+        rank_elapsed        = ucs_max(rank_elapsed, 1e-9);
+        receiver            = &receivers[result->num_receivers++];
+        receiver->rank      = rank;
+        receiver->senders   = count;
+        receiver->bandwidth = rank_bytes / rank_elapsed;
+        receiver->msgrate   = rank_msgs / rank_elapsed;
+        receiver->fairness  = ucp_perf_pattern_fairness(rank_throughput,
+                                                        count);
+    }
+
+    result->iters                    = pattern->iters;
+    result->bytes                    = bytes;
+    result->elapsed_time             = elapsed;
+    result->bandwidth.total_average  = bytes / elapsed;
+    result->bandwidth.moment_average = result->bandwidth.total_average;
+    result->msgrate.total_average    = msgs / elapsed;
+    result->msgrate.moment_average   = result->msgrate.total_average;
+    result->latency.total_average    = elapsed / pattern->iters;
+    result->latency.moment_average   = result->latency.total_average;
+    result->latency.percentile       = result->latency.total_average;
+    result->receivers                = receivers;
+
+    params->report_func(params->rte_group, result, params->report_arg, "", 1,
+                        0);
+
+    result->receivers     = NULL;
+    result->num_receivers = 0;
+
+out:
+    free(receivers);
+    free(throughput);
+    free(flows);
+    return status;
+}
+
+ucs_status_t ucx_perf_pattern_run(const ucx_perf_params_t *params,
+                                  ucx_perf_result_t *result)
+{
+    ucp_perf_pattern_t pattern;
+    ucs_status_t status;
+    unsigned i;
+
+    memset(&pattern, 0, sizeof(pattern));
+    pattern.params      = params;
+    pattern.group_size  = params->rte->group_size(params->rte_group);
+    pattern.group_index = params->rte->group_index(params->rte_group);
+    pattern.am_header   = pattern.group_index;
+    pattern.length      = ucs_max(ucx_perf_get_message_size(params), 1);
+
+    status = ucp_perf_pattern_check(params, pattern.group_size);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    pattern.peers = calloc(pattern.group_size, sizeof(*pattern.peers));
+    if (pattern.peers == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    for (i = 0; i < pattern.group_size; ++i) {
+        pattern.peers[i].pattern = &pattern;
+        pattern.peers[i].index   = i;
+        pattern.peers[i].is_dest = ucp_perf_pattern_is_flow(
+                params->pattern, pattern.group_index, i);
+        pattern.peers[i].is_src  = ucp_perf_pattern_is_flow(
+                params->pattern, i, pattern.group_index);
+    }
+
+    status = ucp_perf_pattern_init(&pattern);
+    if (status != UCS_OK) {
+        goto out_free_peers;
+    }
+
+    status = ucp_perf_pattern_connect(&pattern);
+    if (status != UCS_OK) {
+        goto out_close_eps;
+    }
+
+    if (params->warmup_iter > 0) {
+        status = ucp_perf_pattern_pass(&pattern,
+                                       ucs_min(params->warmup_iter,
+                                               UCP_PERF_PATTERN_MAX_WARMUP));
+        if (status != UCS_OK) {
+            goto out_close_eps;
+        }
+    }
+
+    status = ucp_perf_pattern_pass(&pattern, params->max_iter);
+    if (status != UCS_OK) {
+        goto out_close_eps;
+    }
+
+    ucp_perf_pattern_barrier(&pattern);
+    status = ucp_perf_pattern_report(&pattern, result);
+
+out_close_eps:
+    ucp_perf_pattern_barrier(&pattern);
+    ucp_perf_pattern_close_eps(&pattern);
+    ucp_perf_pattern_barrier(&pattern);
+    ucp_perf_pattern_cleanup(&pattern);
+out_free_peers:
+    free(pattern.peers);
+    return status;
+}
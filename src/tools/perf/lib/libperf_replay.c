@@ -0,0 +1,825 @@
+/**
+* Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+*
+* See file LICENSE for terms.
+*/
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <ucp/core/ucp_op_trace.h>
+#include <ucs/debug/log.h>
+#include <ucs/sys/string.h>
+#include <ucs/time/time.h>
+
+#include <tools/perf/lib/libperf_int.h>
+
+#include <string.h>
+#include <sys/stat.h>
+
+
+/* Replay runs on its own UCP context and worker, so any AM id may be used */
+#define UCP_PERF_REPLAY_AM_ID       0
+
+/* Tag receives kept posted by the receiving process */
+#define UCP_PERF_REPLAY_RECV_WINDOW 64
+
+
+/*
+ * Summary of the trace, exchanged before the test so the receiving process
+ * knows which features to enable and how many messages to expect.
+ */
+typedef struct {
+    uint32_t                has_trace;
+    uint32_t                num_peers;
+    uint64_t                num_ops;
+    uint64_t                num_tag;     /* Tag messages to receive */
+    uint64_t                num_am;      /* Active messages to receive */
+    uint64_t                max_length;
+    uint64_t                features;
+} UCS_S_PACKED ucp_perf_replay_plan_t;
+
+
+/*
+ * Connection information exchanged by both processes.
+ */
+typedef struct {
+    uint32_t                address_length;
+    uint32_t                rkey_length;
+    uint64_t                buffer;
+    /* Followed by worker address and packed rkey */
+} UCS_S_PACKED ucp_perf_replay_info_t;
+
+
+typedef struct {
+    const ucx_perf_params_t *params;
+    unsigned                peer_index;
+    int                     timed;       /* Keep the traced intervals */
+    int                     is_sender;   /* Replays the trace */
+    int                     is_receiver; /* Receives the messages */
+    ucp_perf_replay_plan_t  plan;
+    ucp_op_trace_record_t   *records;
+    double                  *latency;    /* Per-operation latency */
+    ucp_context_h           context;
+    ucp_worker_h            worker;
+    ucp_mem_h               memh;
+    void                    *buffer;
+    size_t                  length;
+    ucp_ep_h                ep;
+    ucp_rkey_h              rkey;
+    uint64_t                remote_addr;
+    uint64_t                tag_posted;  /* Tag receives posted */
+    uint64_t                tag_done;    /* Tag receives completed */
+    uint64_t                am_done;     /* Active messages received */
+    ucs_status_t            status;      /* First error from a callback */
+} ucp_perf_replay_t;
+
+
+static const ucx_perf_replay_op_t ucp_perf_replay_ops[] = {
+    [UCP_OP_TRACE_TAG_SEND]      = UCX_PERF_REPLAY_OP_TAG_SEND,
+    [UCP_OP_TRACE_TAG_SEND_SYNC] = UCX_PERF_REPLAY_OP_TAG_SEND_SYNC,
+    [UCP_OP_TRACE_AM_SEND]       = UCX_PERF_REPLAY_OP_AM_SEND,
+    [UCP_OP_TRACE_PUT]           = UCX_PERF_REPLAY_OP_PUT,
+    [UCP_OP_TRACE_GET]           = UCX_PERF_REPLAY_OP_GET
+};
+
+
+static void ucp_perf_replay_error(ucp_perf_replay_t *replay,
+                                  ucs_status_t status)
+{
+    if (replay->status == UCS_OK) {
+        replay->status = status;
+    }
+}
+
+static ucs_status_t
+ucp_perf_replay_load(ucp_perf_replay_t *replay, const char *trace_file)
+{
+    ucp_perf_replay_plan_t *plan = &replay->plan;
+    ucp_op_trace_header_t header;
+    ucp_op_trace_record_t *record;
+    ucs_status_t status;
+    struct stat st;
+    uint64_t count;
+    FILE *stream;
+
+    stream = fopen(trace_file, "r");
+    if (stream == NULL) {
+        ucs_error("failed to open trace file '%s': %m", trace_file);
+        return UCS_ERR_IO_ERROR;
+    }
+
+    if ((fread(&header, sizeof(header), 1, stream) != 1) ||
+        (header.magic != UCP_OP_TRACE_MAGIC)) {
+        ucs_error("'%s' is not an operation trace file", trace_file);
+        status = UCS_ERR_INVALID_PARAM;
+        goto out_close;
+    }
+
+    if ((header.version != UCP_OP_TRACE_VERSION) ||
+        (header.record_size != sizeof(*record))) {
+        ucs_error("unsupported trace file '%s' version %u", trace_file,
+                  header.version);
+        status = UCS_ERR_UNSUPPORTED;
+        goto out_close;
+    }
+
+    /* The header of a trace which was not closed has no record count */
+    if (fstat(fileno(stream), &st) < 0) {
+        ucs_error("failed to stat trace file '%s': %m", trace_file);
+        status = UCS_ERR_IO_ERROR;
+        goto out_close;
+    }
+
+    count = (st.st_size - sizeof(header)) / sizeof(*record);
+    if (header.num_records != 0) {
+        count = ucs_min(count, header.num_records);
+    }
+
+    replay->records = calloc(ucs_max(count, 1), sizeof(*record));
+    replay->latency = calloc(ucs_max(count, 1), sizeof(*replay->latency));
+    if ((replay->records == NULL) || (replay->latency == NULL)) {
+        ucs_error("failed to allocate %" PRIu64 " trace records", count);
+        status = UCS_ERR_NO_MEMORY;
+        goto out_close;
+    }
+
+    if (fread(replay->records, sizeof(*record), count, stream) != count) {
+        ucs_error("failed to read trace file '%s'", trace_file);
+        status = UCS_ERR_IO_ERROR;
+        goto out_close;
+    }
+
+    plan->has_trace = 1;
+    plan->num_peers = header.num_peers;
+    plan->num_ops   = count;
+    for (record = replay->records; record < replay->records + count;
+         ++record) {
+        switch (record->op) {
+        case UCP_OP_TRACE_TAG_SEND:
+        case UCP_OP_TRACE_TAG_SEND_SYNC:
+            plan->features |= UCP_FEATURE_TAG;
+            ++plan->num_tag;
+            break;
+        case UCP_OP_TRACE_AM_SEND:
+            plan->features |= UCP_FEATURE_AM;
+            ++plan->num_am;
+            break;
+        case UCP_OP_TRACE_PUT:
+        case UCP_OP_TRACE_GET:
+            plan->features |= UCP_FEATURE_RMA;
+            break;
+        default:
+            ucs_error("trace file '%s' record %zu: invalid operation %u",
+                      trace_file, record - replay->records, record->op);
+            status = UCS_ERR_INVALID_PARAM;
+            goto out_close;
+        }
+
+        plan->max_length = ucs_max(plan->max_length, record->length);
+    }
+
+    status = UCS_OK;
+
+out_close:
+    fclose(stream);
+    return status;
+}
+
+/*
+ * Agree on the trace to replay: exactly one process of the pair, or the single
+ * process in loopback mode, must have it.
+ */
+static ucs_status_t ucp_perf_replay_exchange_plan(ucp_perf_replay_t *replay)
+{
+    const ucx_perf_params_t *params = replay->params;
+    ucp_perf_replay_plan_t remote_plan;
+    struct iovec vec;
+    void *req;
+
+    vec.iov_base = &replay->plan;
+    vec.iov_len  = sizeof(replay->plan);
+    params->rte->post_vec(params->rte_group, &vec, 1, &req);
+    params->rte->exchange_vec(params->rte_group, req);
+
+    memset(&remote_plan, 0, sizeof(remote_plan));
+    params->rte->recv(params->rte_group, replay->peer_index, &remote_plan,
+                      sizeof(remote_plan), req);
+
+    replay->is_sender   = replay->plan.has_trace;
+    replay->is_receiver = (replay->peer_index ==
+                           params->rte->group_index(params->rte_group)) ||
+                          !replay->plan.has_trace;
+
+    if (!replay->is_receiver && remote_plan.has_trace) {
+        ucs_error("the trace file must be given to one process only");
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    if (!replay->is_sender) {
+        if (!remote_plan.has_trace) {
+            ucs_error("no trace file to replay");
+            return UCS_ERR_INVALID_PARAM;
+        }
+
+        replay->plan = remote_plan;
+    }
+
+    if (replay->plan.num_ops == 0) {
+        /* A process which failed to load the trace already reported it */
+        if (replay->is_sender && (replay->records != NULL)) {
+            ucs_error("the trace file does not contain any operations");
+        }
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    replay->length = ucs_max(replay->plan.max_length, 1);
+    return UCS_OK;
+}
+
+static void ucp_perf_replay_tag_recv_cb(void *request, ucs_status_t status,
+                                        const ucp_tag_recv_info_t *info,
+                                        void *user_data)
+{
+    ucp_perf_replay_t *replay = user_data;
+
+    ++replay->tag_done;
+    if (status != UCS_OK) {
+        ucp_perf_replay_error(replay, status);
+    }
+
+    ucp_request_free(request);
+}
+
+static void ucp_perf_replay_am_data_cb(void *request, ucs_status_t status,
+                                       size_t length, void *user_data)
+{
+    ucp_perf_replay_t *replay = user_data;
+
+    ++replay->am_done;
+    if (status != UCS_OK) {
+        ucp_perf_replay_error(replay, status);
+    }
+
+    ucp_request_free(request);
+}
+
+static ucs_status_t
+ucp_perf_replay_am_cb(void *arg, const void *header, size_t header_length,
+                      void *data, size_t length,
+                      const ucp_am_recv_param_t *param)
+{
+    ucp_perf_replay_t *replay = arg;
+    ucp_request_param_t recv_param;
+    ucs_status_ptr_t sptr;
+
+    if (!(param->recv_attr & UCP_AM_RECV_ATTR_FLAG_RNDV)) {
+        ++replay->am_done;
+        return UCS_OK;
+    }
+
+    recv_param.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK |
+                              UCP_OP_ATTR_FIELD_USER_DATA;
+    recv_param.cb.recv_am   = ucp_perf_replay_am_data_cb;
+    recv_param.user_data    = replay;
+
+    sptr = ucp_am_recv_data_nbx(replay->worker, data, replay->buffer, length,
+                                &recv_param);
+    if (sptr == NULL) {
+        ++replay->am_done;
+    } else if (UCS_PTR_IS_ERR(sptr)) {
+        ucp_perf_replay_error(replay, UCS_PTR_STATUS(sptr));
+    }
+
+    return UCS_INPROGRESS;
+}
+
+/* Keep a window of tag receives posted, the messages carry any tag */
+static void ucp_perf_replay_post_recvs(ucp_perf_replay_t *replay)
+{
+    ucp_request_param_t param;
+    ucs_status_ptr_t sptr;
+
+    param.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK |
+                         UCP_OP_ATTR_FIELD_USER_DATA;
+    param.cb.recv      = ucp_perf_replay_tag_recv_cb;
+    param.user_data    = replay;
+
+    while ((replay->tag_posted < replay->plan.num_tag) &&
+           ((replay->tag_posted - replay->tag_done) <
+            UCP_PERF_REPLAY_RECV_WINDOW)) {
+        ++replay->tag_posted;
+        sptr = ucp_tag_recv_nbx(replay->worker, replay->buffer, replay->length,
+                                0, 0, &param);
+        if (sptr == NULL) {
+            ++replay->tag_done;
+        } else if (UCS_PTR_IS_ERR(sptr)) {
+            ucp_perf_replay_error(replay, UCS_PTR_STATUS(sptr));
+            return;
+        }
+    }
+}
+
+static void ucp_perf_replay_progress(void *arg)
+{
+    ucp_perf_replay_t *replay = arg;
+
+    if (replay->is_receiver) {
+        ucp_perf_replay_post_recvs(replay);
+    }
+
+    ucp_worker_progress(replay->worker);
+}
+
+static void ucp_perf_replay_barrier(ucp_perf_replay_t *replay)
+{
+    replay->params->rte->barrier(replay->params->rte_group,
+                                 ucp_perf_replay_progress, replay);
+}
+
+static ucs_status_t
+ucp_perf_replay_wait(ucp_perf_replay_t *replay, ucs_status_ptr_t sptr)
+{
+    ucs_status_t status;
+
+    if (!UCS_PTR_IS_PTR(sptr)) {
+        return UCS_PTR_STATUS(sptr);
+    }
+
+    do {
+        ucp_perf_replay_progress(replay);
+        status = ucp_request_check_status(sptr);
+    } while (status == UCS_INPROGRESS);
+
+    ucp_request_free(sptr);
+    return status;
+}
+
+static ucs_status_t ucp_perf_replay_init(ucp_perf_replay_t *replay)
+{
+    const ucx_perf_params_t *params = replay->params;
+    ucp_am_handler_param_t am_param;
+    ucp_worker_params_t worker_params;
+    ucp_mem_map_params_t mem_params;
+    ucp_params_t ucp_params;
+    ucp_mem_attr_t mem_attr;
+    ucp_config_t *config;
+    ucs_status_t status;
+
+    ucp_params.field_mask = UCP_PARAM_FIELD_FEATURES | UCP_PARAM_FIELD_NAME;
+    ucp_params.name       = "perftest";
+    ucp_params.features   = replay->plan.features;
+
+    status = ucp_config_read(NULL, NULL, &config);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    /* Do not trace the replay itself */
+    status = ucp_config_modify(config, "OP_TRACE_FILE", "");
+    if (status != UCS_OK) {
+        ucp_config_release(config);
+        return status;
+    }
+
+    status = ucp_init(&ucp_params, config, &replay->context);
+    ucp_config_release(config);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    worker_params.field_mask  = UCP_WORKER_PARAM_FIELD_THREAD_MODE;
+    worker_params.thread_mode = params->thread_mode;
+    status = ucp_worker_create(replay->context, &worker_params,
+                               &replay->worker);
+    if (status != UCS_OK) {
+        goto err_cleanup;
+    }
+
+    mem_params.field_mask = UCP_MEM_MAP_PARAM_FIELD_ADDRESS |
+                            UCP_MEM_MAP_PARAM_FIELD_LENGTH |
+                            UCP_MEM_MAP_PARAM_FIELD_FLAGS;
+    mem_params.address    = NULL;
+    mem_params.length     = replay->length;
+    mem_params.flags      = UCP_MEM_MAP_ALLOCATE;
+    status = ucp_mem_map(replay->context, &mem_params, &replay->memh);
+    if (status != UCS_OK) {
+        goto err_destroy_worker;
+    }
+
+    mem_attr.field_mask = UCP_MEM_ATTR_FIELD_ADDRESS;
+    status              = ucp_mem_query(replay->memh, &mem_attr);
+    if (status != UCS_OK) {
+        goto err_unmap;
+    }
+
+    replay->buffer = mem_attr.address;
+    memset(replay->buffer, 0, replay->length);
+
+    if (replay->plan.features & UCP_FEATURE_AM) {
+        am_param.field_mask = UCP_AM_HANDLER_PARAM_FIELD_ID |
+                              UCP_AM_HANDLER_PARAM_FIELD_FLAGS |
+                              UCP_AM_HANDLER_PARAM_FIELD_CB |
+                              UCP_AM_HANDLER_PARAM_FIELD_ARG;
+        am_param.id         = UCP_PERF_REPLAY_AM_ID;
+        am_param.flags      = UCP_AM_FLAG_WHOLE_MSG;
+        am_param.cb         = ucp_perf_replay_am_cb;
+        am_param.arg        = replay;
+        status = ucp_worker_set_am_recv_handler(replay->worker, &am_param);
+        if (status != UCS_OK) {
+            goto err_unmap;
+        }
+    }
+
+    return UCS_OK;
+
+err_unmap:
+    ucp_mem_unmap(replay->context, replay->memh);
+err_destroy_worker:
+    ucp_worker_destroy(replay->worker);
+err_cleanup:
+    ucp_cleanup(replay->context);
+    return status;
+}
+
+static void ucp_perf_replay_cleanup(ucp_perf_replay_t *replay)
+{
+    ucp_mem_unmap(replay->context, replay->memh);
+    ucp_worker_destroy(replay->worker);
+    ucp_cleanup(replay->context);
+}
+
+static ucs_status_t ucp_perf_replay_connect(ucp_perf_replay_t *replay)
+{
+    const size_t buffer_size        = ADDR_BUF_SIZE;
+    const ucx_perf_params_t *params = replay->params;
+    ucp_perf_replay_info_t info, *remote_info;
+    ucp_request_param_t param;
+    ucp_address_t *address;
+    size_t address_length;
+    ucp_ep_params_t ep_params;
+    void *rkey_buffer;
+    size_t rkey_size;
+    ucs_status_t status;
+    struct iovec vec[3];
+    void *buffer;
+    void *req;
+
+    buffer = malloc(buffer_size);
+    if (buffer == NULL) {
+        ucs_error("failed to allocate RTE buffer");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    status = ucp_worker_get_address(replay->worker, &address,
+                                    &address_length);
+    if (status != UCS_OK) {
+        goto out_free_buffer;
+    }
+
+    rkey_buffer = NULL;
+    rkey_size   = 0;
+    if (replay->plan.features & UCP_FEATURE_RMA) {
+        status = ucp_rkey_pack(replay->context, replay->memh, &rkey_buffer,
+                               &rkey_size);
+        if (status != UCS_OK) {
+            ucs_error("ucp_rkey_pack() failed: %s", ucs_status_string(status));
+            goto out_release_address;
+        }
+    }
+
+    info.address_length = address_length;
+    info.rkey_length    = rkey_size;
+    info.buffer         = (uintptr_t)replay->buffer;
+
+    if ((sizeof(info) + address_length + rkey_size) > buffer_size) {
+        ucs_error("connection information is too large (%zu bytes)",
+                  sizeof(info) + address_length + rkey_size);
+        status = UCS_ERR_BUFFER_TOO_SMALL;
+        goto out_release_rkey;
+    }
+
+    vec[0].iov_base = &info;
+    vec[0].iov_len  = sizeof(info);
+    vec[1].iov_base = address;
+    vec[1].iov_len  = address_length;
+    vec[2].iov_base = rkey_buffer;
+    vec[2].iov_len  = rkey_size;
+
+    params->rte->post_vec(params->rte_group, vec, 3, &req);
+    params->rte->exchange_vec(params->rte_group, req);
+    params->rte->recv(params->rte_group, replay->peer_index, buffer,
+                      buffer_size, req);
+    remote_info = buffer;
+
+    ep_params.field_mask = UCP_EP_PARAM_FIELD_REMOTE_ADDRESS;
+    ep_params.address    = (ucp_address_t*)(remote_info + 1);
+    status = ucp_ep_create(replay->worker, &ep_params, &replay->ep);
+    if (status != UCS_OK) {
+        goto out_release_rkey;
+    }
+
+    if (remote_info->rkey_length != 0) {
+        status = ucp_ep_rkey_unpack(replay->ep,
+                                    UCS_PTR_BYTE_OFFSET(ep_params.address,
+                                            remote_info->address_length),
+                                    &replay->rkey);
+        if (status != UCS_OK) {
+            ucs_error("ucp_ep_rkey_unpack() failed: %s",
+                      ucs_status_string(status));
+            goto out_release_rkey;
+        }
+
+        replay->remote_addr = remote_info->buffer;
+    }
+
+    /* Establish the connection before the measurement */
+    param.op_attr_mask = 0;
+    status = ucp_perf_replay_wait(replay, ucp_ep_flush_nbx(replay->ep,
+                                                           &param));
+
+out_release_rkey:
+    if (rkey_buffer != NULL) {
+        ucp_rkey_buffer_release(rkey_buffer);
+    }
+out_release_address:
+    ucp_worker_release_address(replay->worker, address);
+out_free_buffer:
+    free(buffer);
+    return status;
+}
+
+static void ucp_perf_replay_close_ep(ucp_perf_replay_t *replay)
+{
+    ucp_request_param_t param;
+
+    if (replay->rkey != NULL) {
+        ucp_rkey_destroy(replay->rkey);
+    }
+
+    if (replay->ep != NULL) {
+        param.op_attr_mask = 0;
+        ucp_perf_replay_wait(replay, ucp_ep_close_nbx(replay->ep, &param));
+    }
+}
+
+static ucs_status_ptr_t
+ucp_perf_replay_issue(ucp_perf_replay_t *replay,
+                      const ucp_op_trace_record_t *record)
+{
+    ucp_request_param_t param;
+
+    param.op_attr_mask = 0;
+
+    switch (record->op) {
+    case UCP_OP_TRACE_TAG_SEND:
+        return ucp_tag_send_nbx(replay->ep, replay->buffer, record->length,
+                                record->tag, &param);
+    case UCP_OP_TRACE_TAG_SEND_SYNC:
+        return ucp_tag_send_sync_nbx(replay->ep, replay->buffer,
+                                     record->length, record->tag, &param);
+    case UCP_OP_TRACE_AM_SEND:
+        return ucp_am_send_nbx(replay->ep, UCP_PERF_REPLAY_AM_ID, NULL, 0,
+                               replay->buffer, record->length, &param);
+    case UCP_OP_TRACE_PUT:
+        return ucp_put_nbx(replay->ep, replay->buffer, record->length,
+                           replay->remote_addr, replay->rkey, &param);
+    default:
+        return ucp_get_nbx(replay->ep, replay->buffer, record->length,
+                           replay->remote_addr, replay->rkey, &param);
+    }
+}
+
+/*
+ * Issue the traced operations one by one, waiting for each one to complete.
+ */
+static ucs_status_t ucp_perf_replay_send(ucp_perf_replay_t *replay,
+                                         double *total_time_p)
+{
+    const ucp_op_trace_record_t *record;
+    ucp_request_param_t param;
+    ucs_time_t start, issue, target;
+    ucs_status_t status;
+    uint64_t i;
+
+    start = ucs_get_time();
+    for (i = 0; i < replay->plan.num_ops; ++i) {
+        record = &replay->records[i];
+        if (replay->timed) {
+            target = start + ucs_time_from_sec((record->timestamp -
+                                                replay->records[0].timestamp) *
+                                               1e-9);
+            while (ucs_get_time() < target) {
+                ucp_perf_replay_progress(replay);
+            }
+        }
+
+        issue  = ucs_get_time();
+        status = ucp_perf_replay_wait(replay,
+                                      ucp_perf_replay_issue(replay, record));
+        if (status != UCS_OK) {
+            ucs_error("failed to replay operation %" PRIu64 ": %s", i,
+                      ucs_status_string(status));
+            return status;
+        }
+
+        replay->latency[i] = ucs_time_to_sec(ucs_get_time() - issue);
+    }
+
+    /* Remote completion of RMA operations */
+    param.op_attr_mask = 0;
+    status = ucp_perf_replay_wait(replay,
+                                  ucp_worker_flush_nbx(replay->worker,
+                                                       &param));
+    *total_time_p = ucs_time_to_sec(ucs_get_time() - start);
+    return status;
+}
+
+static ucs_status_t ucp_perf_replay_recv(ucp_perf_replay_t *replay)
+{
+    while ((replay->tag_done < replay->plan.num_tag) ||
+           (replay->am_done < replay->plan.num_am)) {
+        ucp_perf_replay_progress(replay);
+        if (replay->status != UCS_OK) {
+            return replay->status;
+        }
+    }
+
+    return UCS_OK;
+}
+
+static int ucp_perf_replay_double_cmp(const void *a, const void *b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+
+    return (x > y) - (x < y);
+}
+
+static void
+ucp_perf_replay_calc_op(ucx_perf_replay_op_result_t *op_result,
+                        double *latency, uint64_t count)
+{
+    double sum = 0;
+    uint64_t i;
+
+    if (count == 0) {
+        return;
+    }
+
+    qsort(latency, count, sizeof(*latency), ucp_perf_replay_double_cmp);
+    for (i = 0; i < count; ++i) {
+        sum += latency[i];
+    }
+
+    op_result->latency_avg = sum / count;
+    op_result->latency_p50 = latency[(count - 1) / 2];
+    op_result->latency_p90 = latency[((count - 1) * 90) / 100];
+    op_result->latency_p99 = latency[((count - 1) * 99) / 100];
+    op_result->latency_max = latency[count - 1];
+}
+
+static ucs_status_t ucp_perf_replay_calc(ucp_perf_replay_t *replay,
+                                         double total_time,
+                                         ucx_perf_replay_result_t *result)
+{
+    uint64_t num_ops = replay->plan.num_ops;
+    ucx_perf_replay_op_result_t *op_result;
+    const ucp_op_trace_record_t *record;
+    ucx_perf_replay_op_t op;
+    double *latency;
+    uint64_t i;
+
+    latency = malloc(num_ops * sizeof(*latency));
+    if (latency == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    result->num_ops    = num_ops;
+    result->num_peers  = replay->plan.num_peers;
+    result->trace_time = (replay->records[num_ops - 1].timestamp -
+                          replay->records[0].timestamp) * 1e-9;
+    result->total_time = total_time;
+
+    for (op = 0; op < UCX_PERF_REPLAY_OP_LAST; ++op) {
+        op_result = &result->ops[op];
+        for (i = 0; i < num_ops; ++i) {
+            record = &replay->records[i];
+            if (ucp_perf_replay_ops[record->op] == op) {
+                latency[op_result->count++] = replay->latency[i];
+                op_result->bytes           += record->length;
+            }
+        }
+
+        ucp_perf_replay_calc_op(op_result, latency, op_result->count);
+        result->total.bytes += op_result->bytes;
+    }
+
+    result->total.count = num_ops;
+    memcpy(latency, replay->latency, num_ops * sizeof(*latency));
+    ucp_perf_replay_calc_op(&result->total, latency, num_ops);
+
+    free(latency);
+    return UCS_OK;
+}
+
+ucs_status_t ucx_perf_replay(const ucx_perf_params_t *params,
+                             const char *trace_file, int timed,
+                             ucx_perf_replay_result_t *result)
+{
+    unsigned group_size  = params->rte->group_size(params->rte_group);
+    unsigned group_index = params->rte->group_index(params->rte_group);
+    ucx_perf_replay_result_t remote_result;
+    ucs_status_t status, load_status;
+    ucp_perf_replay_t replay;
+    double total_time = 0;
+    struct iovec vec;
+    void *req;
+
+    if (group_size > 2) {
+        ucs_error("trace replay requires 2 processes or loopback mode");
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    memset(&replay, 0, sizeof(replay));
+    memset(result, 0, sizeof(*result));
+    replay.params     = params;
+    replay.timed      = timed;
+    replay.peer_index = (group_size == 1) ? group_index : (1 - group_index);
+
+    load_status = UCS_OK;
+    if (trace_file != NULL) {
+        load_status = ucp_perf_replay_load(&replay, trace_file);
+        if (load_status != UCS_OK) {
+            /* Let the peer know there is nothing to replay */
+            free(replay.records);
+            replay.records = NULL;
+            memset(&replay.plan, 0, sizeof(replay.plan));
+            replay.plan.has_trace = 1;
+        }
+    }
+
+    status = ucp_perf_replay_exchange_plan(&replay);
+    if (status != UCS_OK) {
+        status = (load_status != UCS_OK) ? load_status : status;
+        goto out_free;
+    }
+
+    status = ucp_perf_replay_init(&replay);
+    if (status != UCS_OK) {
+        goto out_free;
+    }
+
+    status = ucp_perf_replay_connect(&replay);
+    if (status != UCS_OK) {
+        goto out_close_ep;
+    }
+
+    ucp_perf_replay_barrier(&replay);
+
+    if (replay.is_sender) {
+        status = ucp_perf_replay_send(&replay, &total_time);
+        if (status != UCS_OK) {
+            goto out_close_ep;
+        }
+    }
+
+    if (replay.is_receiver) {
+        status = ucp_perf_replay_recv(&replay);
+        if (status != UCS_OK) {
+            goto out_close_ep;
+        }
+    }
+
+    /* Keep progressing the target of RMA operations until they complete */
+    ucp_perf_replay_barrier(&replay);
+
+    /* The replaying process calculates the result and shares it */
+    if (replay.is_sender) {
+        status = ucp_perf_replay_calc(&replay, total_time, result);
+        if (status != UCS_OK) {
+            goto out_close_ep;
+        }
+    }
+
+    vec.iov_base = result;
+    vec.iov_len  = sizeof(*result);
+    params->rte->post_vec(params->rte_group, &vec, 1, &req);
+    params->rte->exchange_vec(params->rte_group, req);
+    params->rte->recv(params->rte_group, replay.peer_index, &remote_result,
+                      sizeof(remote_result), req);
+    if (!replay.is_sender) {
+        *result = remote_result;
+    }
+
+out_close_ep:
+    ucp_perf_replay_barrier(&replay);
+    ucp_perf_replay_close_ep(&replay);
+    ucp_perf_replay_barrier(&replay);
+    ucp_perf_replay_cleanup(&replay);
+out_free:
+    free(replay.latency);
+    free(replay.records);
+    return status;
+}
@@ -42,13 +42,16 @@ static ucs_status_t ucx_perf_thread_run_test(void* arg)
 
     /* Run test */
 #pragma omp barrier
+    ucx_perf_dtlb_counter_start(perf);
     status = ucx_perf_funcs[params->api].run(perf);
     ucx_perf_funcs[params->api].barrier(perf);
     if (UCS_OK != status) {
+        ucx_perf_dtlb_counter_stop(perf, result);
         goto out;
     }
 
     ucx_perf_calc_result(perf, result);
+    ucx_perf_dtlb_counter_stop(perf, result);
 
 out:
     return status;
@@ -77,6 +80,10 @@ static void ucx_perf_thread_report_aggregated_results(ucx_perf_context_t *perf)
     agg_result.bandwidth.moment_average = 0.0;
     agg_result.latency.moment_average   = 0.0;
     agg_result.latency.percentile       = 0.0;
+    agg_result.dtlb_misses              = 0.0;
+    agg_result.fairness                 = 0.0;
+    agg_result.num_receivers            = 0;
+    agg_result.receivers                = NULL;
 
     /* in case of multiple threads, we have to aggregate the results so that the
      * final output of the result would show the performance numbers that were
@@ -89,6 +96,12 @@ static void ucx_perf_thread_report_aggregated_results(ucx_perf_context_t *perf)
         agg_result.bandwidth.total_average  += tctx[i].result.bandwidth.total_average;
         agg_result.msgrate.total_average    += tctx[i].result.msgrate.total_average;
         lat_sum_total_avegare               += tctx[i].result.latency.total_average;
+        if ((agg_result.dtlb_misses >= 0) &&
+            (tctx[i].result.dtlb_misses >= 0)) {
+            agg_result.dtlb_misses += tctx[i].result.dtlb_misses;
+        } else {
+            agg_result.dtlb_misses = -1.0;
+        }
     }
 
     agg_result.latency.total_average = lat_sum_total_avegare / thread_count;
@@ -177,6 +177,7 @@ ucs_status_t init_test_params(perftest_params_t *params)
     params->super.api                 = UCX_PERF_API_LAST;
     params->super.command             = UCX_PERF_CMD_LAST;
     params->super.test_type           = UCX_PERF_TEST_TYPE_LAST;
+    params->super.pattern             = UCX_PERF_PATTERN_PAIR;
     params->super.thread_mode         = UCS_THREAD_MODE_SERIALIZED;
     params->super.thread_count        = 1;
     params->super.async_mode          = UCS_ASYNC_THREAD_LOCK_TYPE;
@@ -222,6 +223,7 @@ ucs_status_t init_test_params(perftest_params_t *params)
 
     params->super.msg_size_list[0] = 8;
     params->test_id                = TEST_ID_UNDEFINED;
+    params->replay                 = 0;
 
     return UCS_OK;
 }
@@ -235,7 +237,7 @@ static unsigned sock_rte_group_size(void *rte_group)
 static unsigned sock_rte_group_index(void *rte_group)
 {
     sock_rte_group_t *group = rte_group;
-    return group->is_server ? 0 : 1;
+    return group->index;
 }
 
 static void sock_rte_barrier(void *rte_group, void (*progress)(void *arg),
@@ -313,6 +315,154 @@ err:
     exit(EXIT_FAILURE);
 }
 
+static void sock_rte_group_barrier(void *rte_group,
+                                   void (*progress)(void *arg), void *arg)
+{
+#if _OPENMP
+#  pragma omp barrier
+#  pragma omp master
+#endif
+  {
+    sock_rte_group_t *group = rte_group;
+    const unsigned magic    = 0xdeadbeef;
+    unsigned snc;
+    int i, ret;
+
+    ret = 0;
+    if (group->is_server) {
+        /* Wait for all clients to arrive, then release them */
+        for (i = 1; (i < group->size) && (ret == 0); ++i) {
+            snc = 0;
+            ret = safe_recv(group->fds[i], &snc, sizeof(snc), progress, arg);
+            ucs_assert((ret != 0) || (snc == magic));
+        }
+
+        snc = magic;
+        for (i = 1; (i < group->size) && (ret == 0); ++i) {
+            ret = safe_send(group->fds[i], &snc, sizeof(snc), progress, arg);
+        }
+    } else {
+        snc = magic;
+        ret = safe_send(group->sendfd, &snc, sizeof(snc), progress, arg);
+        if (ret == 0) {
+            snc = 0;
+            ret = safe_recv(group->recvfd, &snc, sizeof(snc), progress, arg);
+            ucs_assert((ret != 0) || (snc == magic));
+        }
+    }
+
+    if (ret != 0) {
+        ucs_error("sock: rte barrier remote peer failure");
+        exit(EXIT_FAILURE);
+    }
+  }
+
+#if _OPENMP
+#  pragma omp barrier
+#endif
+}
+
+static void sock_rte_group_set_vec(sock_rte_group_t *group, unsigned index,
+                                   size_t size)
+{
+    void *vec;
+
+    vec = realloc(group->vec[index], ucs_max(size, 1));
+    if (vec == NULL) {
+        ucs_error("sock: failed to allocate rte buffer of %zu bytes", size);
+        exit(EXIT_FAILURE);
+    }
+
+    group->vec[index]      = vec;
+    group->vec_size[index] = size;
+}
+
+static int sock_rte_group_send_vec(sock_rte_group_t *group, int fd,
+                                   unsigned index)
+{
+    int ret;
+
+    ret = safe_send(fd, &group->vec_size[index], sizeof(size_t), NULL, NULL);
+    if (ret != 0) {
+        return ret;
+    }
+
+    return safe_send(fd, group->vec[index], group->vec_size[index], NULL, NULL);
+}
+
+static int sock_rte_group_recv_vec(sock_rte_group_t *group, int fd,
+                                   unsigned index)
+{
+    size_t size;
+    int ret;
+
+    ret = safe_recv(fd, &size, sizeof(size), NULL, NULL);
+    if (ret != 0) {
+        return ret;
+    }
+
+    sock_rte_group_set_vec(group, index, size);
+    return safe_recv(fd, group->vec[index], size, NULL, NULL);
+}
+
+static void sock_rte_group_post_vec(void *rte_group, const struct iovec *iovec,
+                                    int iovcnt, void **req)
+{
+    sock_rte_group_t *group = rte_group;
+    size_t size             = ucs_iovec_total_length(iovec, iovcnt);
+
+    sock_rte_group_set_vec(group, group->index, size);
+    ucs_iov_copy(iovec, iovcnt, 0, group->vec[group->index], size,
+                 UCS_IOV_COPY_TO_BUF);
+}
+
+/* All-gather of the posted data, relayed by the server */
+static void sock_rte_group_exchange_vec(void *rte_group, void *req)
+{
+    sock_rte_group_t *group = rte_group;
+    int i, j, ret;
+
+    ret = 0;
+    if (group->is_server) {
+        for (i = 1; (i < group->size) && (ret == 0); ++i) {
+            ret = sock_rte_group_recv_vec(group, group->fds[i], i);
+        }
+
+        for (i = 1; i < group->size; ++i) {
+            for (j = 0; (j < group->size) && (ret == 0); ++j) {
+                if (j != i) {
+                    ret = sock_rte_group_send_vec(group, group->fds[i], j);
+                }
+            }
+        }
+    } else {
+        ret = sock_rte_group_send_vec(group, group->sendfd, group->index);
+        for (j = 0; (j < group->size) && (ret == 0); ++j) {
+            if (j != group->index) {
+                ret = sock_rte_group_recv_vec(group, group->recvfd, j);
+            }
+        }
+    }
+
+    if (ret != 0) {
+        ucs_error("sock: rte exchange: remote peer failure");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void sock_rte_group_recv(void *rte_group, unsigned src, void *buffer,
+                                size_t max, void *req)
+{
+    sock_rte_group_t *group = rte_group;
+
+    if ((src >= group->size) || (group->vec[src] == NULL)) {
+        return;
+    }
+
+    ucs_assert_always(group->vec_size[src] <= max);
+    memcpy(buffer, group->vec[src], group->vec_size[src]);
+}
+
 static ucs_status_t sock_rte_setup(void *arg);
 static void sock_rte_cleanup(void *arg);
 
@@ -327,6 +477,17 @@ static ucx_perf_rte_t sock_rte = {
     .exchange_vec = (ucx_perf_rte_exchange_vec_func_t)ucs_empty_function,
 };
 
+static ucx_perf_rte_t sock_group_rte = {
+    .setup        = sock_rte_setup,
+    .cleanup      = sock_rte_cleanup,
+    .group_size   = sock_rte_group_size,
+    .group_index  = sock_rte_group_index,
+    .barrier      = sock_rte_group_barrier,
+    .post_vec     = sock_rte_group_post_vec,
+    .recv         = sock_rte_group_recv,
+    .exchange_vec = sock_rte_group_exchange_vec,
+};
+
 static ucs_status_t setup_sock_rte_loopback(struct perftest_context *ctx)
 {
     int connfds[2];
@@ -342,6 +503,7 @@ static ucs_status_t setup_sock_rte_loopback(struct perftest_context *ctx)
 
     ctx->sock_rte_group.peer      =  0;
     ctx->sock_rte_group.size      =  1;
+    ctx->sock_rte_group.index     =  0;
     ctx->sock_rte_group.is_server =  1;
     ctx->sock_rte_group.sendfd    = connfds[0];
     ctx->sock_rte_group.recvfd    = connfds[1];
@@ -349,6 +511,43 @@ static ucs_status_t setup_sock_rte_loopback(struct perftest_context *ctx)
     return UCS_OK;
 }
 
+static ucs_status_t sock_rte_recv_params(struct perftest_context *ctx,
+                                         int connfd, int merge)
+{
+    perftest_params_t peer_params;
+    ucs_status_t status;
+    int ret;
+
+    ret = safe_recv(connfd, &peer_params, sizeof(peer_params), NULL, NULL);
+    if (ret) {
+        return UCS_ERR_IO_ERROR;
+    }
+
+    if (peer_params.super.msg_size_cnt != 0) {
+        peer_params.super.msg_size_list =
+                calloc(peer_params.super.msg_size_cnt,
+                       sizeof(*peer_params.super.msg_size_list));
+        if (peer_params.super.msg_size_list == NULL) {
+            return UCS_ERR_NO_MEMORY;
+        }
+
+        ret = safe_recv(connfd, peer_params.super.msg_size_list,
+                        sizeof(*peer_params.super.msg_size_list) *
+                        peer_params.super.msg_size_cnt,
+                        NULL, NULL);
+        if (ret) {
+            perftest_params_release_msg_size_list(&peer_params);
+            return UCS_ERR_IO_ERROR;
+        }
+    }
+
+    /* In a group, the test is defined by the first client */
+    status = merge ? perftest_params_merge(&ctx->params, &peer_params) :
+                     UCS_OK;
+    perftest_params_release_msg_size_list(&peer_params);
+    return status;
+}
+
 static ucs_status_t setup_sock_rte_p2p(struct perftest_context *ctx)
 {
     int optval = 1;
@@ -356,13 +555,25 @@ static ucs_status_t setup_sock_rte_p2p(struct perftest_context *ctx)
     char addr_str[UCS_SOCKADDR_STRING_LEN];
     struct sockaddr_storage client_addr;
     socklen_t client_addr_len;
-    int connfd;
+    int *connfds;
     struct addrinfo hints, *res, *t;
     ucs_status_t status;
-    int ret;
+    uint32_t index;
+    int ret, i;
     char service[8];
     char err_str[64];
-    perftest_params_t peer_params;
+
+    /* Server connections, indexed by client rank; 0 is the server itself */
+    connfds = malloc(sizeof(*connfds) * ctx->group_size);
+    if (connfds == NULL) {
+        ucs_error("failed to allocate connections array");
+        status = UCS_ERR_NO_MEMORY;
+        goto out;
+    }
+
+    for (i = 0; i < ctx->group_size; ++i) {
+        connfds[i] = -1;
+    }
 
     ucs_snprintf_safe(service, sizeof(service), "%u", ctx->port);
     memset(&hints, 0, sizeof(hints));
@@ -375,6 +586,7 @@ static ucs_status_t setup_sock_rte_p2p(struct perftest_context *ctx)
         ucs_error("getaddrinfo(server:%s, port:%s) error: [%s]",
                   ctx->server_addr, service, gai_strerror(ret));
         status = UCS_ERR_IO_ERROR;
+        free(connfds);
         goto out;
     }
 
@@ -410,21 +622,30 @@ static ucs_status_t setup_sock_rte_p2p(struct perftest_context *ctx)
                     goto err_close_sockfd;
                 }
 
-                printf("Waiting for connection...\n");
+                if (ctx->group_size > 2) {
+                    printf("Waiting for %d connections...\n",
+                           ctx->group_size - 1);
+                } else {
+                    printf("Waiting for connection...\n");
+                }
 
                 /* Accept next connection */
-                client_addr_len = sizeof(client_addr);
-                connfd          = accept(sockfd, (struct sockaddr*)&client_addr,
-                                         &client_addr_len);
-                if (connfd < 0) {
-                    ucs_error("accept() failed: %m");
-                    status = UCS_ERR_IO_ERROR;
-                    goto err_close_sockfd;
+                for (i = 1; i < ctx->group_size; ++i) {
+                    client_addr_len = sizeof(client_addr);
+                    connfds[i]      = accept(sockfd,
+                                             (struct sockaddr*)&client_addr,
+                                             &client_addr_len);
+                    if (connfds[i] < 0) {
+                        ucs_error("accept() failed: %m");
+                        status = UCS_ERR_IO_ERROR;
+                        goto err_close_sockfd;
+                    }
+
+                    ucs_sockaddr_str((struct sockaddr*)&client_addr, addr_str,
+                                     sizeof(addr_str));
+                    printf("Accepted connection from %s\n", addr_str);
                 }
 
-                ucs_sockaddr_str((struct sockaddr*)&client_addr, addr_str,
-                                 sizeof(addr_str));
-                printf("Accepted connection from %s\n", addr_str);
                 close(sockfd);
                 break;
             }
@@ -438,46 +659,33 @@ static ucs_status_t setup_sock_rte_p2p(struct perftest_context *ctx)
         ucs_error("%s failed. %s",
                   (ctx->server_addr != NULL) ? "client" : "server", err_str);
         status = UCS_ERR_IO_ERROR;
-        goto out_free_res;
+        goto err_close_connfds;
     }
 
     if (ctx->server_addr == NULL) {
-        ret = safe_recv(connfd, &peer_params, sizeof(peer_params), NULL, NULL);
-        if (ret) {
-            status = UCS_ERR_IO_ERROR;
-            goto err_close_connfd;
-        }
-
-        if (peer_params.super.msg_size_cnt != 0) {
-            peer_params.super.msg_size_list =
-                    calloc(peer_params.super.msg_size_cnt,
-                           sizeof(*peer_params.super.msg_size_list));
-            if (peer_params.super.msg_size_list == NULL) {
-                status = UCS_ERR_NO_MEMORY;
-                goto err_close_connfd;
+        for (i = 1; i < ctx->group_size; ++i) {
+            status = sock_rte_recv_params(ctx, connfds[i], i == 1);
+            if (status != UCS_OK) {
+                goto err_close_connfds;
             }
+        }
 
-            ret = safe_recv(connfd, peer_params.super.msg_size_list,
-                            sizeof(*peer_params.super.msg_size_list) *
-                            peer_params.super.msg_size_cnt,
-                            NULL, NULL);
+        /* Assign group ranks to the clients in the order of connection */
+        for (i = 1; (ctx->group_size > 2) && (i < ctx->group_size); ++i) {
+            index = i;
+            ret   = safe_send(connfds[i], &index, sizeof(index), NULL, NULL);
             if (ret) {
-                perftest_params_release_msg_size_list(&peer_params);
                 status = UCS_ERR_IO_ERROR;
-                goto err_close_connfd;
+                goto err_close_connfds;
             }
         }
 
-        status = perftest_params_merge(&ctx->params, &peer_params);
-        perftest_params_release_msg_size_list(&peer_params);
-        if (status != UCS_OK) {
-            goto err_close_connfd;
-        }
-
-        ctx->sock_rte_group.sendfd    = connfd;
-        ctx->sock_rte_group.recvfd    = connfd;
-        ctx->sock_rte_group.peer      = 1;
+        ctx->sock_rte_group.sendfd    = connfds[1];
+        ctx->sock_rte_group.recvfd    = connfds[1];
+        ctx->sock_rte_group.peer      = ctx->group_size - 1;
+        ctx->sock_rte_group.index     = 0;
         ctx->sock_rte_group.is_server = 1;
+        ctx->sock_rte_group.fds       = connfds;
     } else {
         safe_send(sockfd, &ctx->params, sizeof(ctx->params), NULL, NULL);
         if (ctx->params.super.msg_size_cnt != 0) {
@@ -487,28 +695,46 @@ static ucs_status_t setup_sock_rte_p2p(struct perftest_context *ctx)
                       NULL, NULL);
         }
 
+        index = 1;
+        if (ctx->group_size > 2) {
+            ret = safe_recv(sockfd, &index, sizeof(index), NULL, NULL);
+            if (ret) {
+                status = UCS_ERR_IO_ERROR;
+                goto err_close_sockfd;
+            }
+        }
+
         ctx->sock_rte_group.sendfd     = sockfd;
         ctx->sock_rte_group.recvfd     = sockfd;
         ctx->sock_rte_group.peer       = 0;
+        ctx->sock_rte_group.index      = index;
         ctx->sock_rte_group.is_server  = 0;
+        free(connfds);
     }
 
-    ctx->sock_rte_group.size = 2;
+    ctx->sock_rte_group.size = ctx->group_size;
 
+    /* In a group, the server reports the results since all the clients are
+     * equal */
     if (ctx->sock_rte_group.is_server) {
         ctx->flags |= TEST_FLAG_PRINT_TEST;
-    } else {
+        if (ctx->group_size > 2) {
+            ctx->flags |= TEST_FLAG_PRINT_RESULTS;
+        }
+    } else if (ctx->group_size == 2) {
         ctx->flags |= TEST_FLAG_PRINT_RESULTS;
     }
 
     status = UCS_OK;
     goto out_free_res;
 
-err_close_connfd:
-    ucs_close_fd(&connfd);
-    goto out_free_res;
 err_close_sockfd:
     ucs_close_fd(&sockfd);
+err_close_connfds:
+    for (i = 1; i < ctx->group_size; ++i) {
+        ucs_close_fd(&connfds[i]);
+    }
+    free(connfds);
 out_free_res:
     freeaddrinfo(res);
 out:
@@ -518,8 +744,13 @@ out:
 static ucs_status_t sock_rte_setup(void *arg)
 {
     struct perftest_context *ctx = arg;
+    sock_rte_group_t *rte_group  = &ctx->sock_rte_group;
     ucs_status_t status;
 
+    rte_group->fds      = NULL;
+    rte_group->vec      = NULL;
+    rte_group->vec_size = NULL;
+
     if (ctx->params.super.flags & UCX_PERF_TEST_FLAG_LOOPBACK) {
         status = setup_sock_rte_loopback(ctx);
     } else {
@@ -530,9 +761,21 @@ static ucs_status_t sock_rte_setup(void *arg)
         return status;
     }
 
-    ctx->params.super.rte_group  = &ctx->sock_rte_group;
+    ctx->params.super.rte_group  = rte_group;
     ctx->params.super.rte        = &sock_rte;
 
+    if (rte_group->size > 2) {
+        rte_group->vec      = calloc(rte_group->size, sizeof(*rte_group->vec));
+        rte_group->vec_size = calloc(rte_group->size,
+                                     sizeof(*rte_group->vec_size));
+        if ((rte_group->vec == NULL) || (rte_group->vec_size == NULL)) {
+            sock_rte_cleanup(ctx);
+            return UCS_ERR_NO_MEMORY;
+        }
+
+        ctx->params.super.rte = &sock_group_rte;
+    }
+
     return UCS_OK;
 }
 
@@ -540,12 +783,30 @@ static void sock_rte_cleanup(void *arg)
 {
     struct perftest_context *ctx = arg;
     sock_rte_group_t *rte_group  = &ctx->sock_rte_group;
+    int i;
 
     close(rte_group->sendfd);
 
     if (rte_group->sendfd != rte_group->recvfd) {
         close(rte_group->recvfd);
     }
+
+    /* The first client connection is the sendfd */
+    if (rte_group->fds != NULL) {
+        for (i = 2; i < rte_group->size; ++i) {
+            close(rte_group->fds[i]);
+        }
+        free(rte_group->fds);
+    }
+
+    if (rte_group->vec != NULL) {
+        for (i = 0; i < rte_group->size; ++i) {
+            free(rte_group->vec[i]);
+        }
+    }
+
+    free(rte_group->vec);
+    free(rte_group->vec_size);
 }
 
 #if defined (HAVE_MPI)
@@ -19,10 +19,18 @@
 #endif
 
 #define TL_RESOURCE_NAME_NONE   "<none>"
-#define TEST_PARAMS_ARGS        "t:n:s:W:O:w:D:i:H:oSCIqM:r:E:T:d:x:A:BUem:a:R:lyzL:F:Y:"
+#define TEST_PARAMS_ARGS        "t:n:s:W:O:w:D:i:H:oSCIqM:r:E:T:d:x:A:BUem:a:R:lyzZL:F:Y:u:V:j:"
 #define TEST_ID_UNDEFINED       -1
 
 #define DEFAULT_DAEMON_PORT     1338
+#define DEFAULT_REGRESSION_PCT  5.0
+
+
+/* Options which have only a long form */
+enum {
+    TEST_OPT_REPLAY = 256,
+    TEST_OPT_REPLAY_TIMED
+};
 
 typedef struct test_type {
     const char           *name;
@@ -49,6 +57,13 @@ ucs_status_t parse_test_params(perftest_params_t *params, char opt,
                                const char *opt_arg);
 ucs_status_t adjust_test_params(perftest_params_t *params,
                                 const char *error_prefix);
+int perftest_sweep_is_enabled(const struct perftest_context *ctx,
+                              const perftest_params_t *params);
+ucs_status_t perftest_sweep_init(struct perftest_context *ctx);
+void perftest_sweep_cleanup(struct perftest_context *ctx);
+ucs_status_t run_test_sweep(struct perftest_context *ctx,
+                            const perftest_params_t *params);
+ucs_status_t run_test_replay(struct perftest_context *ctx);
 void print_progress(void *UCS_V_UNUSED rte_group,
                     const ucx_perf_result_t *result, void *arg,
                     const char *extra_info, int final, int is_multi_thread);
@@ -14,6 +14,9 @@
 
 #define MAX_BATCH_FILES         32
 #define MAX_CPUS                1024
+#define MAX_SWEEP_SIZES         64
+#define MAX_SWEEP_ROUNDS        100
+#define DEFAULT_SWEEP_ROUNDS    10
 
 
 enum {
@@ -33,19 +36,47 @@ typedef struct sock_rte_group {
     int                          is_server;
     int                          size;
     int                          peer;
+
+    /* Group of more than 2 processes: the server is connected to all clients
+     * and relays the exchanged data between them */
+    int                          index;
+    int                          *fds;       /* Server: connection per client */
+    void                         **vec;      /* Data posted by every process */
+    size_t                       *vec_size;
 } sock_rte_group_t;
 
 
 typedef struct perftest_params {
     ucx_perf_params_t            super;
     int                          test_id;
+
+    /* Message sizes to sweep over, 0 - run with the configured size only */
+    unsigned                     sweep_size_cnt;
+    size_t                       sweep_sizes[MAX_SWEEP_SIZES];
+
+    /* Target relative 95% confidence interval of the latency, in percent.
+     * 0 - run a single round per message size */
+    double                       sweep_ci;
+    unsigned                     sweep_max_rounds;
+
+    /* Replay an operation trace instead of running a test */
+    int                          replay;
 } perftest_params_t;
 
 
+typedef struct perftest_baseline_entry {
+    char                         test[64];
+    char                         batch[256];
+    size_t                       size;
+    double                       latency; /* usec */
+} perftest_baseline_entry_t;
+
+
 struct perftest_context {
     perftest_params_t            params;
     const char                   *server_addr;
     uint16_t                     port;
+    int                          group_size;
     sa_family_t                  af;
     int                          mpi;
     unsigned                     num_cpus;
@@ -57,6 +88,20 @@ struct perftest_context {
     char                         *test_names[MAX_BATCH_FILES];
     const char                   *mad_port;
 
+    /* Machine-readable results and comparison with a previous run */
+    const char                   *json_file;
+    FILE                         *json_fp;
+    unsigned                     json_count;
+    const char                   *baseline_file;
+    double                       regression_threshold;
+    perftest_baseline_entry_t    *baseline;
+    unsigned                     baseline_count;
+    unsigned                     num_regressions;
+
+    /* Operation trace to replay, set only in the replaying process */
+    const char                   *replay_file;
+    int                          replay_timed;
+
     sock_rte_group_t             sock_rte_group;
 };
 
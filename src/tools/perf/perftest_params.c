@@ -19,6 +19,8 @@ const struct option TEST_PARAMS_ARGS_LONG[] =
 {
     {"daemon-local",  required_argument, 0, 'g'},
     {"daemon-remote", required_argument, 0, 'G'},
+    {"replay",        required_argument, 0, TEST_OPT_REPLAY},
+    {"replay-timed",  no_argument,       0, TEST_OPT_REPLAY_TIMED},
     {0, 0, 0, 0}
 };
 
@@ -110,10 +112,37 @@ static void usage(const struct perftest_context *ctx, const char *program)
     printf("\n");
     printf("                        test_tag_bandwidth_64k -t tag_bw -s 65536 -n 10000\n");
     printf("\n");
+    printf("     -u <sizes>     sweep over message sizes, every size is a separate test (off)\n");
+    printf("                        <min>-<max>         - powers of two from min to max, e.g. \"-u 8-1m\"\n");
+    printf("                        <size>,<size>,...   - list of sizes, e.g. \"-u 8,4k,64k\"\n");
+    printf("     -V <ci>[:<rounds>]\n");
+    printf("                    calibrate the number of iterations per message size and\n");
+    printf("                    repeat the test until the 95%% confidence interval of the\n");
+    printf("                    latency is within <ci> percent of the mean, or until\n");
+    printf("                    <rounds> rounds (%d) were measured. Outlier rounds are\n",
+                                DEFAULT_SWEEP_ROUNDS);
+    printf("                    reported and excluded. -n limits the iterations per round.\n");
+    printf("     -j <pattern>   communication pattern of the processes (pair)\n");
+    printf("                        pair        - two processes, each one sends to the other\n");
+    printf("                        many_to_one - all processes send to process 0 (incast)\n");
+    printf("                        one_to_many - process 0 sends to all processes\n");
+    printf("                        all_to_all  - every process sends to every other\n");
+    printf("                    Patterns other than pair support UCP tag_bw, ucp_am_bw and\n");
+    printf("                    ucp_put_bw and report per-receiver bandwidth and fairness.\n");
+    printf("     --replay <file>\n");
+    printf("                    replay an operation trace recorded with UCX_OP_TRACE_FILE\n");
+    printf("                    against the peer instead of running a test, and compare\n");
+    printf("                    the total time and latency distribution with the trace.\n");
+    printf("                    The peer is started without this option.\n");
+    printf("     --replay-timed keep the traced intervals between the operations (off)\n");
     printf("     -R <rank>      percentile rank of the percentile data in latency tests (%.1f)\n",
                                 ctx->params.super.percentile_rank);
     printf("     -p <port>      TCP port to use for data exchange (%d)\n", ctx->port);
     printf("     -6             Use IPv6 address for in data exchange\n");
+    printf("     -k <size>      number of processes in the socket-based group (%d).\n",
+                                ctx->group_size);
+    printf("                    The server waits for <size>-1 clients, each client must\n");
+    printf("                    also be given the same value\n");
 #ifdef HAVE_MPI
     printf("     -P <0|1>       disable/enable MPI mode (%d)\n", ctx->mpi);
 #endif
@@ -126,6 +155,11 @@ static void usage(const struct perftest_context *ctx, const char *program)
     printf("     -v             print CSV-formatted output\n");
     printf("     -X             print extra information about the operation\n");
     printf("     -q             do not print error messages\n");
+    printf("     -J <file>      write results as JSON to <file>, or to stdout if \"-\"\n");
+    printf("     -Q <file>[:<pct>]\n");
+    printf("                    compare with results previously written by -J to <file>\n");
+    printf("                    and flag latency regressions above <pct> percent (%.1f)\n",
+                                DEFAULT_REGRESSION_PCT);
     printf("\n");
     printf("  UCT only:\n");
     printf("     -d <device>    device to use for testing\n");
@@ -173,6 +207,7 @@ static void usage(const struct perftest_context *ctx, const char *program)
                                 ctx->params.super.ucp.am_hdr_size);
     printf("     -y             do additional memcopy to the user memory in active message receive handler\n");
     printf("     -z             pass pre-registered memory handle\n");
+    printf("     -Z             report dTLB load misses per iteration of the measured run\n");
     printf("     -g <IP>[:<port>], --daemon-local <IP>[:<port>]\n");
     printf("                    IP address and port of the local daemon to offload UCP operations to\n");
     printf("                    Port is optional, by default daemon port is (%d)\n",
@@ -460,6 +495,114 @@ static ucs_status_t parse_message_sizes_params(const char *opt_arg,
     return parse_message_sizes_list(opt_arg, params);
 }
 
+static ucs_status_t parse_sweep_size(const char *opt_arg, size_t *size)
+{
+    if ((opt_arg == NULL) || (ucs_str_to_memunits(opt_arg, size) != UCS_OK) ||
+        (*size == 0) || (*size == UCS_MEMUNITS_INF) ||
+        (*size == UCS_MEMUNITS_AUTO)) {
+        ucs_error("invalid sweep message size: '%s'", opt_arg);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    return UCS_OK;
+}
+
+static ucs_status_t parse_sweep_sizes(const char *opt_arg,
+                                      perftest_params_t *params)
+{
+    char *saveptr = NULL;
+    size_t size, max_size;
+    char *token, *arg;
+    ucs_status_t status;
+
+    arg = ucs_alloca(strlen(opt_arg) + 1);
+    strcpy(arg, opt_arg);
+    params->sweep_size_cnt = 0;
+
+    if (strchr(arg, '-') != NULL) {
+        token  = strtok_r(arg, "-", &saveptr);
+        status = parse_sweep_size(token, &size);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        token  = strtok_r(NULL, "-", &saveptr);
+        status = parse_sweep_size(token, &max_size);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        if (size > max_size) {
+            ucs_error("invalid sweep range '%s': minimum exceeds maximum",
+                      opt_arg);
+            return UCS_ERR_INVALID_PARAM;
+        }
+
+        for (; (size <= max_size) && (params->sweep_size_cnt < MAX_SWEEP_SIZES);
+             size *= 2) {
+            params->sweep_sizes[params->sweep_size_cnt++] = size;
+        }
+
+        return UCS_OK;
+    }
+
+    for (token = strtok_r(arg, ",", &saveptr); token != NULL;
+         token = strtok_r(NULL, ",", &saveptr)) {
+        if (params->sweep_size_cnt >= MAX_SWEEP_SIZES) {
+            ucs_error("too many sweep message sizes (maximum is %d)",
+                      MAX_SWEEP_SIZES);
+            return UCS_ERR_INVALID_PARAM;
+        }
+
+        status = parse_sweep_size(token,
+                                  &params->sweep_sizes[params->sweep_size_cnt++]);
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+
+    return UCS_OK;
+}
+
+static ucs_status_t parse_sweep_ci(const char *opt_arg,
+                                   perftest_params_t *params)
+{
+    const char *delim = ":";
+    char *saveptr = NULL;
+    char *token, *arg, *endptr;
+    int max_rounds;
+    ucs_status_t status;
+
+    arg = ucs_alloca(strlen(opt_arg) + 1);
+    strcpy(arg, opt_arg);
+    token = strtok_r(arg, delim, &saveptr);
+    if (token == NULL) {
+        ucs_error("confidence interval is not specified");
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    params->sweep_ci = strtod(token, &endptr);
+    if ((*endptr != '\0') || !(params->sweep_ci > 0)) {
+        ucs_error("invalid confidence interval: '%s'", opt_arg);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    token = strtok_r(NULL, delim, &saveptr);
+    if (token == NULL) {
+        params->sweep_max_rounds = DEFAULT_SWEEP_ROUNDS;
+        return UCS_OK;
+    }
+
+    status = parse_int(token, &max_rounds, "number of rounds", 1,
+                       MAX_SWEEP_ROUNDS);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    params->sweep_max_rounds = max_rounds;
+    return UCS_OK;
+}
+
 static ucs_status_t parse_device_level(const char *opt_arg,
                                        ucs_device_level_t *device_level)
 {
@@ -494,6 +637,33 @@ static ucs_status_t parse_ucp_datatype_params(const char *opt_arg,
     return UCS_OK;
 }
 
+static ucs_status_t parse_pattern(const char *opt_arg,
+                                  ucx_perf_pattern_t *pattern)
+{
+    static const char *pattern_names[] = {
+        [UCX_PERF_PATTERN_PAIR]        = "pair",
+        [UCX_PERF_PATTERN_MANY_TO_ONE] = "many_to_one",
+        [UCX_PERF_PATTERN_ONE_TO_MANY] = "one_to_many",
+        [UCX_PERF_PATTERN_ALL_TO_ALL]  = "all_to_all"
+    };
+    ucx_perf_pattern_t it;
+
+    if (!strcmp(opt_arg, "incast")) {
+        *pattern = UCX_PERF_PATTERN_MANY_TO_ONE;
+        return UCS_OK;
+    }
+
+    for (it = UCX_PERF_PATTERN_PAIR; it < UCX_PERF_PATTERN_LAST; ++it) {
+        if (!strcmp(opt_arg, pattern_names[it])) {
+            *pattern = it;
+            return UCS_OK;
+        }
+    }
+
+    ucs_error("Invalid option argument for -j: %s", opt_arg);
+    return UCS_ERR_INVALID_PARAM;
+}
+
 static ucs_status_t parse_channel_mode(const char *opt_arg,
                                        ucx_perf_channel_mode_t *channel_mode,
                                        unsigned long long *channel_rand_seed)
@@ -669,6 +839,10 @@ ucs_status_t parse_test_params(perftest_params_t *params, char opt,
         return UCS_OK;
     case 's':
         return parse_message_sizes_params(opt_arg, &params->super);
+    case 'u':
+        return parse_sweep_sizes(opt_arg, params);
+    case 'V':
+        return parse_sweep_ci(opt_arg, params);
     case 'H':
         params->super.uct.am_hdr_size = atol(opt_arg);
         params->super.ucp.am_hdr_size = atol(opt_arg);
@@ -762,6 +936,8 @@ ucs_status_t parse_test_params(perftest_params_t *params, char opt,
     case 'F':
         return parse_int(opt_arg, &params->super.device_fc_window,
                          "device flow control window size", 1, INT_MAX);
+    case 'j':
+        return parse_pattern(opt_arg, &params->super.pattern);
     case 'Y':
         return parse_channel_mode(opt_arg, &params->super.device_channel_mode,
                                   &params->super.channel_rand_seed);
@@ -771,6 +947,9 @@ ucs_status_t parse_test_params(perftest_params_t *params, char opt,
     case 'z':
         params->super.flags |= UCX_PERF_TEST_FLAG_PREREG;
         return UCS_OK;
+    case 'Z':
+        params->super.flags |= UCX_PERF_TEST_FLAG_DTLB_MISSES;
+        return UCS_OK;
     default:
        return UCS_ERR_INVALID_PARAM;
     }
@@ -858,6 +1037,26 @@ ucs_status_t check_params(const perftest_params_t *params)
     }
 }
 
+static ucs_status_t parse_baseline(char *opt_arg, struct perftest_context *ctx)
+{
+    char *delim = strrchr(opt_arg, ':');
+    char *endptr;
+
+    ctx->baseline_file = opt_arg;
+    if (delim == NULL) {
+        return UCS_OK;
+    }
+
+    *delim                    = '\0';
+    ctx->regression_threshold = strtod(delim + 1, &endptr);
+    if ((*endptr != '\0') || (ctx->regression_threshold < 0)) {
+        ucs_error("invalid regression threshold: '%s'", delim + 1);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    return UCS_OK;
+}
+
 static ucs_status_t parse_cpus(char *opt_arg, struct perftest_context *ctx)
 {
     char *endptr, *cpu_list = opt_arg;
@@ -909,14 +1108,21 @@ ucs_status_t parse_opts(struct perftest_context *ctx, int mpi_initialized,
     ctx->server_addr     = NULL;
     ctx->num_batch_files = 0;
     ctx->port            = 13337;
+    ctx->group_size      = 2;
     ctx->af              = AF_INET;
     ctx->flags           = 0;
     ctx->mpi             = mpi_initialized;
     ctx->mad_port        = NULL;
+    ctx->json_file       = NULL;
+    ctx->baseline_file   = NULL;
+    ctx->replay_file     = NULL;
+    ctx->replay_timed    = 0;
+
+    ctx->regression_threshold = DEFAULT_REGRESSION_PCT;
 
     optind = 1;
     while ((c = getopt_long(argc, argv,
-                            "p:b:6NfvXc:P:hK:g:G:k" TEST_PARAMS_ARGS,
+                            "p:b:6NfvXc:P:hK:g:G:k:J:Q:" TEST_PARAMS_ARGS,
                             TEST_PARAMS_ARGS_LONG, NULL)) != -1) {
         switch (c) {
         case 'p':
@@ -955,6 +1161,22 @@ ucs_status_t parse_opts(struct perftest_context *ctx, int mpi_initialized,
         case 'K':
             ctx->mad_port = optarg;
             break;
+        case 'k':
+            status = parse_int(optarg, &ctx->group_size,
+                               "number of processes", 2, 1024);
+            if (status != UCS_OK) {
+                goto err;
+            }
+            break;
+        case 'J':
+            ctx->json_file = optarg;
+            break;
+        case 'Q':
+            status = parse_baseline(optarg, ctx);
+            if (status != UCS_OK) {
+                goto err;
+            }
+            break;
         case 'P':
 #ifdef HAVE_MPI
             ctx->mpi = atoi(optarg) && mpi_initialized;
@@ -976,6 +1198,13 @@ ucs_status_t parse_opts(struct perftest_context *ctx, int mpi_initialized,
                 goto err;
             }
             break;
+        case TEST_OPT_REPLAY:
+            ctx->replay_file   = optarg;
+            ctx->params.replay = 1;
+            break;
+        case TEST_OPT_REPLAY_TIMED:
+            ctx->replay_timed = 1;
+            break;
         case 'h':
             usage(ctx, ucs_basename(argv[0]));
             status = UCS_ERR_CANCELED;
@@ -1008,6 +1237,14 @@ ucs_status_t parse_opts(struct perftest_context *ctx, int mpi_initialized,
         }
     }
 
+    if ((ctx->group_size > 2) &&
+        (ctx->params.super.flags & UCX_PERF_TEST_FLAG_LOOPBACK)) {
+        ucs_error("conflicting arguments: group size (-k) cannot be used in "
+                  "loopback (-l) mode");
+        status = UCS_ERR_INVALID_PARAM;
+        goto err;
+    }
+
     return init_daemon_params(&ctx->params.super);
 
 err:
@@ -0,0 +1,115 @@
+/**
+* Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+*
+* See file LICENSE for terms.
+*/
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "perftest.h"
+
+#include <ucs/debug/log.h>
+#include <ucs/sys/string.h>
+
+#include <inttypes.h>
+
+
+static const char *replay_op_names[] = {
+    [UCX_PERF_REPLAY_OP_TAG_SEND]      = "tag_send",
+    [UCX_PERF_REPLAY_OP_TAG_SEND_SYNC] = "tag_send_sync",
+    [UCX_PERF_REPLAY_OP_AM_SEND]       = "am_send",
+    [UCX_PERF_REPLAY_OP_PUT]           = "put",
+    [UCX_PERF_REPLAY_OP_GET]           = "get"
+};
+
+
+static void replay_print_op(const struct perftest_context *ctx,
+                            const char *name,
+                            const ucx_perf_replay_op_result_t *op)
+{
+    const char *fmt;
+
+    if (ctx->flags & TEST_FLAG_PRINT_CSV) {
+        fmt = "%s,%" PRIu64 ",%" PRIu64 ",%.3f,%.3f,%.3f,%.3f,%.3f\n";
+    } else {
+        fmt = "| %-14s %10" PRIu64 " %14" PRIu64
+              " %10.3f %10.3f %10.3f %10.3f %10.3f |\n";
+    }
+
+    printf(fmt, name, op->count, op->bytes, op->latency_avg * 1e6,
+           op->latency_p50 * 1e6, op->latency_p90 * 1e6,
+           op->latency_p99 * 1e6, op->latency_max * 1e6);
+}
+
+static void replay_print_line(void)
+{
+    printf("+----------------------------------------------------------------"
+           "---------------------------------+\n");
+}
+
+static void replay_print(const struct perftest_context *ctx,
+                         const ucx_perf_replay_result_t *result)
+{
+    ucx_perf_replay_op_t op;
+    char line[128];
+
+    if (ctx->flags & TEST_FLAG_PRINT_CSV) {
+        printf("trace_time,replay_time\n%.6f,%.6f\n", result->trace_time,
+               result->total_time);
+        printf("operation,count,bytes,avg_usec,p50_usec,p90_usec,p99_usec,"
+               "max_usec\n");
+    } else {
+        replay_print_line();
+        ucs_snprintf_safe(line, sizeof(line),
+                          "Replay of %" PRIu64 " operations to %u peer(s) as "
+                          "a single peer, %s", result->num_ops,
+                          result->num_peers,
+                          ctx->replay_timed ? "timed" : "back to back");
+        printf("| %-95s |\n", line);
+        ucs_snprintf_safe(line, sizeof(line),
+                          "Trace time (sec): %.6f  Replay time (sec): %.6f  "
+                          "Replay/trace: %.3f", result->trace_time,
+                          result->total_time,
+                          result->total_time /
+                          ucs_max(result->trace_time, 1e-9));
+        printf("| %-95s |\n", line);
+        replay_print_line();
+        printf("| %40s %-54s |\n", "", "latency (usec)");
+        printf("| %-14s %10s %14s %10s %10s %10s %10s %10s |\n", "operation",
+               "count", "bytes", "average", "p50", "p90", "p99", "max");
+        replay_print_line();
+    }
+
+    for (op = 0; op < UCX_PERF_REPLAY_OP_LAST; ++op) {
+        if (result->ops[op].count != 0) {
+            replay_print_op(ctx, replay_op_names[op], &result->ops[op]);
+        }
+    }
+
+    replay_print_op(ctx, "total", &result->total);
+    if (!(ctx->flags & TEST_FLAG_PRINT_CSV)) {
+        replay_print_line();
+    }
+    fflush(stdout);
+}
+
+ucs_status_t run_test_replay(struct perftest_context *ctx)
+{
+    ucx_perf_replay_result_t result;
+    ucs_status_t status;
+
+    status = ucx_perf_replay(&ctx->params.super, ctx->replay_file,
+                             ctx->replay_timed, &result);
+    if (status != UCS_OK) {
+        ucs_error("Failed to replay trace: %s", ucs_status_string(status));
+        return status;
+    }
+
+    if (ctx->flags & TEST_FLAG_PRINT_RESULTS) {
+        replay_print(ctx, &result);
+    }
+
+    return UCS_OK;
+}
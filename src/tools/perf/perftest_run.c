@@ -20,6 +20,28 @@
 #include <locale.h>
 
 
+static void print_receivers(const ucx_perf_result_t *result)
+{
+    const ucx_perf_receiver_result_t *receiver;
+    unsigned i, num_flows;
+
+    num_flows = 0;
+    for (i = 0; i < result->num_receivers; ++i) {
+        receiver   = &result->receivers[i];
+        num_flows += receiver->senders;
+        printf("  receiver %-4u senders: %-4u bandwidth (MB/s): %11.2f  "
+               "msgrate (msg/s): %11.0f  fairness: %.3f\n",
+               receiver->rank, receiver->senders,
+               receiver->bandwidth / (1024.0 * 1024.0), receiver->msgrate,
+               receiver->fairness);
+    }
+
+    printf("  aggregate     flows:   %-4u bandwidth (MB/s): %11.2f  "
+           "msgrate (msg/s): %11.0f  fairness: %.3f\n",
+           num_flows, result->bandwidth.total_average / (1024.0 * 1024.0),
+           result->msgrate.total_average, result->fairness);
+}
+
 void print_progress(void *UCS_V_UNUSED rte_group,
                     const ucx_perf_result_t *result, void *arg,
                     const char *extra_info, int final, int is_multi_thread)
@@ -100,7 +122,21 @@ void print_progress(void *UCS_V_UNUSED rte_group,
         ucs_string_buffer_appendf(&strb, "  %s", extra_info);
     }
 
+    if (final && (ctx->params.super.flags & UCX_PERF_TEST_FLAG_DTLB_MISSES) &&
+        !(ctx->flags & TEST_FLAG_PRINT_CSV)) {
+        if (result->dtlb_misses >= 0) {
+            ucs_string_buffer_appendf(&strb, "  dTLB misses/iter: %.3f",
+                                      result->dtlb_misses);
+        } else {
+            ucs_string_buffer_appendf(&strb, "  dTLB misses/iter: n/a");
+        }
+    }
+
     fprintf(stdout, "%s\n", ucs_string_buffer_cstr(&strb));
+    if (final && (result->num_receivers > 0) &&
+        !(ctx->flags & TEST_FLAG_PRINT_CSV)) {
+        print_receivers(result);
+    }
     fflush(stdout);
 }
 
@@ -176,6 +212,12 @@ static void print_header(struct perftest_context *ctx)
         }
     }
 
+    if ((ctx->flags & TEST_FLAG_PRINT_RESULTS) &&
+        perftest_sweep_is_enabled(ctx, &ctx->params)) {
+        /* Sweep results have their own table, printed for every test */
+        return;
+    }
+
     if (ctx->flags & TEST_FLAG_PRINT_CSV) {
         if (ctx->flags & TEST_FLAG_PRINT_RESULTS) {
             for (i = 0; i < ctx->num_batch_files; ++i) {
@@ -296,6 +338,10 @@ static ucs_status_t run_test_recurs(struct perftest_context *ctx,
             return status;
         }
 
+        if (perftest_sweep_is_enabled(ctx, parent_params)) {
+            return run_test_sweep(ctx, parent_params);
+        }
+
         return ucx_perf_run(&parent_params->super, &result);
     }
 
@@ -346,6 +392,10 @@ ucs_status_t run_test(struct perftest_context *ctx)
     ctx->params.super.report_func = print_progress;
     ctx->params.super.report_arg  = ctx;
 
+    if (ctx->params.replay) {
+        return run_test_replay(ctx);
+    }
+
     /* no batch files, only command line params */
     if (ctx->num_batch_files == 0) {
         error_prefix = (ctx->flags & TEST_FLAG_PRINT_RESULTS) ?
@@ -356,6 +406,11 @@ ucs_status_t run_test(struct perftest_context *ctx)
         }
     }
 
+    status = perftest_sweep_init(ctx);
+    if (status != UCS_OK) {
+        return status;
+    }
+
     print_header(ctx);
 
     status = run_test_recurs(ctx, &ctx->params, 0);
@@ -363,5 +418,6 @@ ucs_status_t run_test(struct perftest_context *ctx)
         ucs_error("Failed to run test: %s", ucs_status_string(status));
     }
 
+    perftest_sweep_cleanup(ctx);
     return status;
 }
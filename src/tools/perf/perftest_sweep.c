@@ -0,0 +1,610 @@
+/**
+* Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+*
+* See file LICENSE for terms.
+*/
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "perftest.h"
+
+#include <ucs/sys/string.h>
+#include <ucs/debug/log.h>
+
+#include <inttypes.h>
+#include <string.h>
+#include <math.h>
+
+
+/* Minimal number of rounds needed to estimate the confidence interval */
+#define SWEEP_MIN_ROUNDS        3
+
+/* Number of iterations used to estimate the duration of a single iteration */
+#define SWEEP_PROBE_ITERS       1000
+
+/* Desired duration of a single measured round, in seconds */
+#define SWEEP_ROUND_TIME        50e-3
+
+/* Round is considered an outlier if it is farther than this number of
+ * (normalized) median absolute deviations from the median */
+#define SWEEP_OUTLIER_MADS      3.0
+
+/* Scale factor which makes MAD a consistent estimator of standard deviation */
+#define SWEEP_MAD_SCALE         1.4826
+
+#define SWEEP_SEPARATOR \
+    "+--------------+--------------+--------+------------+----------+" \
+    "-------------+----------------+------------+"
+
+
+/* Per-size decision of whether to run another round, agreed by all ranks */
+typedef struct {
+    uint32_t           leader; /* Decision was made by the reporting rank */
+    uint32_t           done;   /* Stop measuring the current message size */
+    ucx_perf_counter_t iters;  /* Number of iterations in every round */
+} sweep_decision_t;
+
+
+typedef struct {
+    unsigned           rounds;       /* Number of measured rounds */
+    unsigned           valid;        /* Number of rounds which are not outliers */
+    unsigned           outliers;     /* Number of outlier rounds */
+    int                is_outlier[MAX_SWEEP_ROUNDS];
+    ucx_perf_counter_t iters;        /* Total iterations over all rounds */
+    double             median;       /* Median latency, seconds */
+    double             mean;         /* Mean latency without outliers, seconds */
+    double             stddev;       /* Standard deviation without outliers */
+    double             ci;           /* 95% confidence interval half-width */
+    double             ci_pct;       /* ci relative to the mean, in percent */
+    double             percentile;   /* Average of latency percentiles */
+    double             bandwidth;    /* Average bandwidth, bytes/sec */
+    double             msgrate;      /* Average message rate, msg/sec */
+} sweep_stats_t;
+
+
+/* Student's t distribution two-sided 95% quantiles, for 1..30 degrees of
+ * freedom */
+static const double sweep_t95[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+
+int perftest_sweep_is_enabled(const struct perftest_context *ctx,
+                              const perftest_params_t *params)
+{
+    return (params->sweep_size_cnt > 0) || (params->sweep_ci > 0) ||
+           (ctx->json_file != NULL) || (ctx->baseline_file != NULL);
+}
+
+static double sweep_t_quantile(unsigned dof)
+{
+    ucs_assert(dof > 0);
+    return (dof <= ucs_static_array_size(sweep_t95)) ? sweep_t95[dof - 1] :
+                                                       1.960;
+}
+
+static int sweep_double_cmp(const void *a, const void *b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+
+    return (x > y) - (x < y);
+}
+
+static double sweep_median(const double *values, unsigned count)
+{
+    double sorted[MAX_SWEEP_ROUNDS];
+
+    memcpy(sorted, values, sizeof(*values) * count);
+    qsort(sorted, count, sizeof(*sorted), sweep_double_cmp);
+
+    return (count % 2) ? sorted[count / 2] :
+                         (sorted[(count / 2) - 1] + sorted[count / 2]) / 2;
+}
+
+static void sweep_calc_stats(const ucx_perf_result_t *results, unsigned count,
+                             sweep_stats_t *stats)
+{
+    double latency[MAX_SWEEP_ROUNDS], deviation[MAX_SWEEP_ROUNDS];
+    double mad, sum_sq;
+    unsigned i;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->rounds = count;
+
+    for (i = 0; i < count; ++i) {
+        latency[i]    = results[i].latency.total_average;
+        stats->iters += results[i].iters;
+    }
+
+    stats->median = sweep_median(latency, count);
+    for (i = 0; i < count; ++i) {
+        deviation[i] = fabs(latency[i] - stats->median);
+    }
+    mad = sweep_median(deviation, count) * SWEEP_MAD_SCALE;
+
+    for (i = 0; i < count; ++i) {
+        stats->is_outlier[i] = (mad > 0) &&
+                               (deviation[i] > (SWEEP_OUTLIER_MADS * mad));
+        if (stats->is_outlier[i]) {
+            ++stats->outliers;
+            continue;
+        }
+
+        ++stats->valid;
+        stats->mean       += latency[i];
+        stats->percentile += results[i].latency.percentile;
+        stats->bandwidth  += results[i].bandwidth.total_average;
+        stats->msgrate    += results[i].msgrate.total_average;
+    }
+
+    /* The median is never an outlier, so at least one round is valid */
+    ucs_assert(stats->valid > 0);
+    stats->mean       /= stats->valid;
+    stats->percentile /= stats->valid;
+    stats->bandwidth  /= stats->valid;
+    stats->msgrate    /= stats->valid;
+
+    if (stats->valid < 2) {
+        stats->ci_pct = INFINITY;
+        return;
+    }
+
+    sum_sq = 0;
+    for (i = 0; i < count; ++i) {
+        if (!stats->is_outlier[i]) {
+            sum_sq += (latency[i] - stats->mean) * (latency[i] - stats->mean);
+        }
+    }
+
+    stats->stddev = sqrt(sum_sq / (stats->valid - 1));
+    stats->ci     = sweep_t_quantile(stats->valid - 1) * stats->stddev /
+                    sqrt(stats->valid);
+    stats->ci_pct = (stats->mean > 0) ? (stats->ci / stats->mean * 100.0) :
+                                        INFINITY;
+}
+
+/*
+ * All ranks must run the same sequence of tests, so the decision of the rank
+ * which reports the results overrides the local one.
+ */
+static void sweep_exchange_decision(const struct perftest_context *ctx,
+                                    const ucx_perf_params_t *params,
+                                    sweep_decision_t *decision)
+{
+    unsigned group_size = params->rte->group_size(params->rte_group);
+    sweep_decision_t remote, leader;
+    struct iovec vec;
+    void *req = NULL;
+    unsigned i;
+
+    decision->leader = !!(ctx->flags & TEST_FLAG_PRINT_RESULTS);
+
+    vec.iov_base = decision;
+    vec.iov_len  = sizeof(*decision);
+
+    params->rte->post_vec(params->rte_group, &vec, 1, &req);
+    params->rte->exchange_vec(params->rte_group, req);
+
+    /* Every process may receive the decisions of several others, adopt the
+     * one of the leader */
+    leader = *decision;
+    for (i = 0; i < group_size; ++i) {
+        remote.leader = 0;
+        params->rte->recv(params->rte_group, i, &remote, sizeof(remote), req);
+        if (remote.leader) {
+            leader = remote;
+        }
+    }
+
+    *decision = leader;
+}
+
+static ucx_perf_counter_t
+sweep_calibrate_iters(ucx_perf_counter_t probe_iters, double elapsed,
+                      ucx_perf_counter_t max_iter)
+{
+    double iters;
+
+    if (elapsed <= 0) {
+        return max_iter;
+    }
+
+    iters = probe_iters * SWEEP_ROUND_TIME / elapsed;
+    if (iters >= max_iter) {
+        return max_iter;
+    }
+
+    return (iters < 1) ? 1 : (ucx_perf_counter_t)iters;
+}
+
+static const perftest_baseline_entry_t *
+sweep_baseline_find(const struct perftest_context *ctx, const char *test_name,
+                    const char *batch_name, size_t size)
+{
+    const perftest_baseline_entry_t *entry;
+
+    for (entry = ctx->baseline; entry < ctx->baseline + ctx->baseline_count;
+         ++entry) {
+        if ((entry->size == size) && !strcmp(entry->test, test_name) &&
+            !strcmp(entry->batch, batch_name)) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+static void sweep_json_print_string(FILE *stream, const char *str)
+{
+    fputc('"', stream);
+    for (; *str != '\0'; ++str) {
+        if ((*str == '"') || (*str == '\\')) {
+            fputc('\\', stream);
+        }
+        fputc(*str, stream);
+    }
+    fputc('"', stream);
+}
+
+static void sweep_print_header(const struct perftest_context *ctx,
+                               const perftest_params_t *params)
+{
+    test_type_t *test = &tests[params->test_id];
+    unsigned i;
+
+    if (ctx->flags & TEST_FLAG_PRINT_CSV) {
+        for (i = 0; i < ctx->num_batch_files; ++i) {
+            printf("%s,", ucs_basename(ctx->batch_files[i]));
+        }
+        printf("size,iterations,rounds,avg_lat,ci95_pct,avg_bw,avg_mr,"
+               "outliers,baseline_lat,delta_pct,regression\n");
+        return;
+    }
+
+    printf(SWEEP_SEPARATOR "\n");
+    printf("|   msg size   | # iterations | rounds | %-8s   | ci95 (%%) |"
+           "  bw (MB/s)  |  rate (msg/s)  |  outliers  |\n", test->overhead_lat);
+    printf("|   (bytes)    |              |        |   (usec)   |          |"
+           "             |                |            |\n");
+    printf(SWEEP_SEPARATOR "\n");
+}
+
+static void sweep_report(struct perftest_context *ctx,
+                         const perftest_params_t *params,
+                         const sweep_stats_t *stats)
+{
+    const perftest_baseline_entry_t *baseline;
+    UCS_STRING_BUFFER_ONSTACK(strb, 256);
+    UCS_STRING_BUFFER_ONSTACK(batch_name, 256);
+    const char *test_name, *sep;
+    double delta_pct;
+    int regression;
+    size_t size;
+    unsigned i;
+
+    test_name = tests[params->test_id].name;
+    size      = ucx_perf_get_message_size(&params->super);
+    ucs_string_buffer_append_array(&batch_name, "/", "%s", ctx->test_names,
+                                   ctx->num_batch_files);
+
+    baseline   = sweep_baseline_find(ctx, test_name,
+                                     ucs_string_buffer_cstr(&batch_name),
+                                     size);
+    delta_pct  = (baseline != NULL) ?
+                 ((stats->mean * 1e6 / baseline->latency) - 1.0) * 100.0 : 0;
+    regression = (baseline != NULL) &&
+                 (delta_pct > ctx->regression_threshold);
+    if (regression) {
+        ++ctx->num_regressions;
+    }
+
+    if (ctx->flags & TEST_FLAG_PRINT_CSV) {
+        for (i = 0; i < ctx->num_batch_files; ++i) {
+            ucs_string_buffer_appendf(&strb, "%s,", ctx->test_names[i]);
+        }
+        ucs_string_buffer_appendf(&strb,
+                                  "%zu,%" PRIu64 ",%u,%.3f,%.2f,%.2f,%.0f,%u,",
+                                  size, stats->iters, stats->rounds,
+                                  stats->mean * 1e6, stats->ci_pct,
+                                  stats->bandwidth / (1024.0 * 1024.0),
+                                  stats->msgrate, stats->outliers);
+        if (baseline != NULL) {
+            ucs_string_buffer_appendf(&strb, "%.3f,%.2f,%d", baseline->latency,
+                                      delta_pct, regression);
+        } else {
+            ucs_string_buffer_appendf(&strb, ",,");
+        }
+    } else {
+        ucs_string_buffer_appendf(&strb,
+                                  "%15zu%15" PRIu64 "%9u%13.3f%11.2f%14.2f"
+                                  "%17.0f%13u",
+                                  size, stats->iters, stats->rounds,
+                                  stats->mean * 1e6, stats->ci_pct,
+                                  stats->bandwidth / (1024.0 * 1024.0),
+                                  stats->msgrate, stats->outliers);
+        if (regression) {
+            ucs_string_buffer_appendf(&strb, "  REGRESSION %+.1f%% vs %.3f",
+                                      delta_pct, baseline->latency);
+        } else if ((baseline != NULL) &&
+                   (ctx->flags & TEST_FLAG_PRINT_EXTRA_INFO)) {
+            ucs_string_buffer_appendf(&strb, "  %+.1f%% vs %.3f", delta_pct,
+                                      baseline->latency);
+        }
+    }
+
+    printf("%s\n", ucs_string_buffer_cstr(&strb));
+    fflush(stdout);
+
+    if (ctx->json_fp == NULL) {
+        return;
+    }
+
+    fprintf(ctx->json_fp, "%s    {\"test\": ",
+            (ctx->json_count++ > 0) ? ",\n" : "");
+    sweep_json_print_string(ctx->json_fp, test_name);
+    fprintf(ctx->json_fp, ", \"batch\": ");
+    sweep_json_print_string(ctx->json_fp, ucs_string_buffer_cstr(&batch_name));
+    fprintf(ctx->json_fp,
+            ", \"size\": %zu, \"iterations\": %" PRIu64 ", \"rounds\": %u, "
+            "\"latency_usec\": {\"mean\": %.4f, \"median\": %.4f, "
+            "\"stddev\": %.4f, \"ci95\": %.4f, \"percentile\": %.4f}, "
+            "\"ci95_pct\": %.3f, \"converged\": %s, "
+            "\"bandwidth_mbs\": %.3f, \"msgrate\": %.1f, \"outliers\": [",
+            size, stats->iters, stats->rounds, stats->mean * 1e6,
+            stats->median * 1e6, stats->stddev * 1e6, stats->ci * 1e6,
+            stats->percentile * 1e6,
+            isfinite(stats->ci_pct) ? stats->ci_pct : -1.0,
+            ((params->sweep_ci > 0) && (stats->ci_pct <= params->sweep_ci)) ?
+                    "true" : "false",
+            stats->bandwidth / (1024.0 * 1024.0), stats->msgrate);
+    for (i = 0, sep = ""; i < stats->rounds; ++i) {
+        if (stats->is_outlier[i]) {
+            fprintf(ctx->json_fp, "%s%u", sep, i);
+            sep = ", ";
+        }
+    }
+    fprintf(ctx->json_fp, "]");
+    if (baseline != NULL) {
+        fprintf(ctx->json_fp,
+                ", \"baseline_latency_usec\": %.4f, \"delta_pct\": %.2f, "
+                "\"regression\": %s",
+                baseline->latency, delta_pct, regression ? "true" : "false");
+    }
+    fprintf(ctx->json_fp, "}");
+    fflush(ctx->json_fp);
+}
+
+static ucs_status_t sweep_run_size(struct perftest_context *ctx,
+                                   perftest_params_t *params,
+                                   ucx_perf_counter_t max_iter)
+{
+    sweep_decision_t decision;
+    ucx_perf_result_t *results;
+    ucx_perf_result_t probe;
+    sweep_stats_t stats;
+    ucs_status_t status;
+    unsigned count;
+
+    results = calloc(MAX_SWEEP_ROUNDS, sizeof(*results));
+    if (results == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    decision.iters = max_iter;
+    decision.done  = 0;
+
+    if (params->sweep_ci > 0) {
+        params->super.max_iter = ucs_min(max_iter, SWEEP_PROBE_ITERS);
+        status                 = ucx_perf_run(&params->super, &probe);
+        if (status != UCS_OK) {
+            goto out;
+        }
+
+        decision.iters = sweep_calibrate_iters(params->super.max_iter,
+                                               probe.elapsed_time, max_iter);
+        sweep_exchange_decision(ctx, &params->super, &decision);
+    }
+
+    params->super.max_iter = decision.iters;
+    count                  = 0;
+    do {
+        status = ucx_perf_run(&params->super, &results[count++]);
+        if (status != UCS_OK) {
+            goto out;
+        }
+
+        if (params->sweep_ci == 0) {
+            break;
+        }
+
+        sweep_calc_stats(results, count, &stats);
+        decision.done = (count >= params->sweep_max_rounds) ||
+                        ((stats.valid >= SWEEP_MIN_ROUNDS) &&
+                         (stats.ci_pct <= params->sweep_ci));
+        sweep_exchange_decision(ctx, &params->super, &decision);
+    } while (!decision.done && (count < MAX_SWEEP_ROUNDS));
+
+    if (ctx->flags & TEST_FLAG_PRINT_RESULTS) {
+        sweep_calc_stats(results, count, &stats);
+        sweep_report(ctx, params, &stats);
+    }
+
+out:
+    free(results);
+    return status;
+}
+
+ucs_status_t run_test_sweep(struct perftest_context *ctx,
+                            const perftest_params_t *parent_params)
+{
+    perftest_params_t params;
+    size_t *msg_size_list;
+    ucs_status_t status;
+    unsigned i;
+
+    status = clone_params(&params, parent_params);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    /* Per-round results are reported as a single summary line */
+    params.super.report_func = (ucx_perf_report_func_t)ucs_empty_function;
+
+    if (ctx->flags & TEST_FLAG_PRINT_RESULTS) {
+        sweep_print_header(ctx, &params);
+    }
+
+    if (params.sweep_size_cnt == 0) {
+        status = sweep_run_size(ctx, &params, parent_params->super.max_iter);
+        goto out;
+    }
+
+    msg_size_list = realloc(params.super.msg_size_list,
+                            sizeof(*msg_size_list));
+    if (msg_size_list == NULL) {
+        status = UCS_ERR_NO_MEMORY;
+        goto out;
+    }
+
+    params.super.msg_size_list = msg_size_list;
+    params.super.msg_size_cnt  = 1;
+    for (i = 0; i < params.sweep_size_cnt; ++i) {
+        params.super.msg_size_list[0] = params.sweep_sizes[i];
+        status = sweep_run_size(ctx, &params, parent_params->super.max_iter);
+        if (status != UCS_OK) {
+            break;
+        }
+    }
+
+out:
+    perftest_params_release_msg_size_list(&params);
+    return status;
+}
+
+static ucs_status_t sweep_baseline_load(struct perftest_context *ctx)
+{
+    static const char *test_key    = "\"test\": \"";
+    static const char *batch_key   = "\"batch\": \"";
+    static const char *size_key    = "\"size\": ";
+    static const char *latency_key = "\"latency_usec\": {\"mean\": ";
+    perftest_baseline_entry_t *entry;
+    char *line = NULL;
+    size_t line_size = 0;
+    char *test, *batch, *p, *q;
+    FILE *stream;
+
+    stream = fopen(ctx->baseline_file, "r");
+    if (stream == NULL) {
+        ucs_error("failed to open baseline file '%s': %m", ctx->baseline_file);
+        return UCS_ERR_IO_ERROR;
+    }
+
+    /* The baseline is a JSON file written by a previous run with -J, which
+     * has exactly one result object per line */
+    while (getline(&line, &line_size, stream) != -1) {
+        test  = strstr(line, test_key);
+        batch = strstr(line, batch_key);
+        p     = strstr(line, size_key);
+        q     = strstr(line, latency_key);
+        if ((test == NULL) || (batch == NULL) || (p == NULL) || (q == NULL)) {
+            continue;
+        }
+
+        entry = realloc(ctx->baseline,
+                        sizeof(*entry) * (ctx->baseline_count + 1));
+        if (entry == NULL) {
+            free(line);
+            fclose(stream);
+            return UCS_ERR_NO_MEMORY;
+        }
+
+        ctx->baseline = entry;
+        entry        += ctx->baseline_count++;
+
+        test  += strlen(test_key);
+        batch += strlen(batch_key);
+        ucs_strncpy_zero(entry->test, test,
+                         ucs_min(sizeof(entry->test),
+                                 strcspn(test, "\"") + 1));
+        ucs_strncpy_zero(entry->batch, batch,
+                         ucs_min(sizeof(entry->batch),
+                                 strcspn(batch, "\"") + 1));
+        entry->size    = strtoul(p + strlen(size_key), NULL, 10);
+        entry->latency = strtod(q + strlen(latency_key), NULL);
+    }
+
+    free(line);
+    fclose(stream);
+
+    if (ctx->baseline_count == 0) {
+        ucs_warn("baseline file '%s' does not contain any results",
+                 ctx->baseline_file);
+    }
+
+    return UCS_OK;
+}
+
+ucs_status_t perftest_sweep_init(struct perftest_context *ctx)
+{
+    ucs_status_t status;
+
+    ctx->json_fp         = NULL;
+    ctx->json_count      = 0;
+    ctx->baseline        = NULL;
+    ctx->baseline_count  = 0;
+    ctx->num_regressions = 0;
+
+    if (!(ctx->flags & TEST_FLAG_PRINT_RESULTS)) {
+        return UCS_OK;
+    }
+
+    if (ctx->baseline_file != NULL) {
+        status = sweep_baseline_load(ctx);
+        if (status != UCS_OK) {
+            goto err;
+        }
+    }
+
+    if (ctx->json_file != NULL) {
+        ctx->json_fp = strcmp(ctx->json_file, "-") ?
+                       fopen(ctx->json_file, "w") : stdout;
+        if (ctx->json_fp == NULL) {
+            ucs_error("failed to open '%s' for writing: %m", ctx->json_file);
+            status = UCS_ERR_IO_ERROR;
+            goto err;
+        }
+
+        fprintf(ctx->json_fp, "{\n  \"results\": [\n");
+    }
+
+    return UCS_OK;
+
+err:
+    free(ctx->baseline);
+    ctx->baseline = NULL;
+    return status;
+}
+
+void perftest_sweep_cleanup(struct perftest_context *ctx)
+{
+    if (ctx->json_fp != NULL) {
+        fprintf(ctx->json_fp, "\n  ]\n}\n");
+        if (ctx->json_fp != stdout) {
+            fclose(ctx->json_fp);
+        }
+        ctx->json_fp = NULL;
+    }
+
+    if (ctx->num_regressions > 0) {
+        printf("Detected %u performance regression(s) compared to '%s'\n",
+               ctx->num_regressions, ctx->baseline_file);
+    }
+
+    free(ctx->baseline);
+    ctx->baseline = NULL;
+}
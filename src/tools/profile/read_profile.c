@@ -24,6 +24,7 @@
 #include <assert.h>
 #include <stdio.h>
 #include <errno.h>
+#include <inttypes.h>
 
 
 #define INDENT             4
@@ -53,6 +54,12 @@
     fprintf(stderr, "Error: " _fmt "\n", ## __VA_ARGS__)
 
 
+typedef enum {
+    OUTPUT_FORMAT_TEXT,
+    OUTPUT_FORMAT_CHROME
+} output_format_t;
+
+
 typedef enum {
     TIME_UNITS_NSEC,
     TIME_UNITS_USEC,
@@ -65,6 +72,7 @@ typedef enum {
 typedef struct options {
     const char                   *filename;
     int                          raw;
+    output_format_t              format;
     time_units_t                 time_units;
     int                          thread_list[MAX_THREADS + 1];
 } options_t;
@@ -96,6 +104,21 @@ typedef struct {
 } profile_sorted_location_t;
 
 
+typedef struct {
+    size_t                       id;           /* Sequential request id */
+    const char                   *name;        /* Name of the request span */
+    uint64_t                     last_time;    /* Time of the last request event */
+} profile_request_span_t;
+
+
+typedef struct {
+    const profile_data_t         *data;
+    uint64_t                     base_time;    /* Time of the first event */
+    size_t                       num_events;   /* Number of events written */
+    size_t                       reqid_ctr;    /* Next request id */
+} chrome_trace_t;
+
+
 /* Used to redirect output to a "less" command */
 static int output_pipefds[2] = {-1, -1};
 
@@ -465,6 +488,64 @@ out:
 }
 
 KHASH_MAP_INIT_INT64(request_ids, size_t)
+KHASH_MAP_INIT_INT64(request_spans, profile_request_span_t)
+
+/*
+ * Match every scope begin record of the thread with its scope end record.
+ * Returns an array indexed by record number, which holds the scope end of each
+ * scope begin record, or NULL if the scope was not finished.
+ */
+static const ucs_profile_record_t **
+find_scope_ends(const profile_data_t *data, const profile_thread_data_t *thread,
+                int *min_nesting_p)
+{
+    size_t num_records = thread->header->num_records;
+    const ucs_profile_record_t **stack[UCS_PROFILE_STACK_MAX * 2];
+    const ucs_profile_record_t **scope_ends;
+    const ucs_profile_location_t *loc;
+    const ucs_profile_record_t *rec;
+    const ucs_profile_record_t **sep;
+    int nesting, min_nesting;
+
+    scope_ends = calloc(1, sizeof(*scope_ends) * num_records);
+    if (scope_ends == NULL) {
+        print_error("failed to allocate memory for scope ends");
+        return NULL;
+    }
+
+    memset(stack, 0, sizeof(stack));
+
+    /* Find the first record with minimal nesting level, which is the base of call stack */
+    nesting         = 0;
+    min_nesting     = 0;
+    for (rec = thread->records; rec < thread->records + num_records; ++rec) {
+        loc = &data->locations[rec->location];
+        switch (loc->type) {
+        case UCS_PROFILE_TYPE_SCOPE_BEGIN:
+            stack[nesting + UCS_PROFILE_STACK_MAX] = &scope_ends[rec - thread->records];
+            ++nesting;
+            break;
+        case UCS_PROFILE_TYPE_SCOPE_END:
+            --nesting;
+            if (nesting < min_nesting) {
+                min_nesting     = nesting;
+            }
+            sep = stack[nesting + UCS_PROFILE_STACK_MAX];
+            if (sep != NULL) {
+                *sep = rec;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (min_nesting_p != NULL) {
+        *min_nesting_p = min_nesting;
+    }
+
+    return scope_ends;
+}
 
 static void show_profile_data_log(profile_data_t *data, options_t *opts,
                                   int thread_idx)
@@ -472,10 +553,9 @@ static void show_profile_data_log(profile_data_t *data, options_t *opts,
     profile_thread_data_t *thread = &data->threads[thread_idx];
     size_t num_records            = thread->header->num_records;
     size_t reqid_ctr              = 1;
-    const ucs_profile_record_t **stack[UCS_PROFILE_STACK_MAX * 2];
     const ucs_profile_record_t **scope_ends;
     const ucs_profile_location_t *loc;
-    const ucs_profile_record_t *rec, *se, **sep;
+    const ucs_profile_record_t *rec, *se;
     int nesting, min_nesting;
     uint64_t prev_time;
     const char *action;
@@ -497,9 +577,8 @@ static void show_profile_data_log(profile_data_t *data, options_t *opts,
                                 ucs_basename(loc->file), loc->line, \
                                 loc->function, CLEAR_COLOR)
 
-    scope_ends = calloc(1, sizeof(*scope_ends) * num_records);
+    scope_ends = find_scope_ends(data, thread, &min_nesting);
     if (scope_ends == NULL) {
-        print_error("failed to allocate memory for scope ends");
         return;
     }
 
@@ -510,33 +589,6 @@ static void show_profile_data_log(profile_data_t *data, options_t *opts,
            CLEAR_COLOR);
     printf("\n");
 
-    memset(stack, 0, sizeof(stack));
-
-    /* Find the first record with minimal nesting level, which is the base of call stack */
-    nesting         = 0;
-    min_nesting     = 0;
-    for (rec = thread->records; rec < thread->records + num_records; ++rec) {
-        loc = &data->locations[rec->location];
-        switch (loc->type) {
-        case UCS_PROFILE_TYPE_SCOPE_BEGIN:
-            stack[nesting + UCS_PROFILE_STACK_MAX] = &scope_ends[rec - thread->records];
-            ++nesting;
-            break;
-        case UCS_PROFILE_TYPE_SCOPE_END:
-            --nesting;
-            if (nesting < min_nesting) {
-                min_nesting     = nesting;
-            }
-            sep = stack[nesting + UCS_PROFILE_STACK_MAX];
-            if (sep != NULL) {
-                *sep = rec;
-            }
-            break;
-        default:
-            break;
-        }
-    }
-
     if (num_records > 0) {
         prev_time = thread->records[0].timestamp;
     } else {
@@ -629,6 +681,272 @@ static void show_profile_data_log(profile_data_t *data, options_t *opts,
     free(scope_ends);
 }
 
+static void print_json_string(const char *str, size_t max_length)
+{
+    size_t i;
+
+    putchar('"');
+    for (i = 0; (i < max_length) && (str[i] != '\0'); ++i) {
+        if ((str[i] == '"') || (str[i] == '\\')) {
+            printf("\\%c", str[i]);
+        } else if ((unsigned char)str[i] < ' ') {
+            printf("\\u%04x", (unsigned char)str[i]);
+        } else {
+            putchar(str[i]);
+        }
+    }
+    putchar('"');
+}
+
+static double chrome_time_usec(const chrome_trace_t *trace, uint64_t time)
+{
+    return (time - trace->base_time) * 1e6 / trace->data->header->one_second;
+}
+
+/* Start a trace event object, the caller adds optional fields and closes it */
+static void chrome_event_start(chrome_trace_t *trace, const char *phase,
+                               const char *name, size_t max_name_length,
+                               uint32_t tid, uint64_t time)
+{
+    printf("%s\n{\"ph\":\"%s\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f,\"name\":",
+           (trace->num_events++ > 0) ? "," : "", phase,
+           trace->data->header->pid, tid, chrome_time_usec(trace, time));
+    print_json_string(name, max_name_length);
+}
+
+static void chrome_location_args(const ucs_profile_location_t *loc)
+{
+    printf(",\"args\":{\"location\":\"%s:%d\",\"function\":",
+           ucs_basename(loc->file), loc->line);
+    print_json_string(loc->function, sizeof(loc->function));
+    printf("}");
+}
+
+static void chrome_thread_name(chrome_trace_t *trace, int thread_idx)
+{
+    const profile_thread_data_t *thread = &trace->data->threads[thread_idx];
+    uint32_t tid                        = thread->header->tid;
+    char name[64];
+
+    snprintf(name, sizeof(name), "thread %d (tid %u%s)", thread_idx + 1, tid,
+             (tid == trace->data->header->pid) ? ", main" : "");
+    chrome_event_start(trace, "M", "thread_name", SIZE_MAX, tid,
+                       trace->base_time);
+    printf(",\"args\":{\"name\":");
+    print_json_string(name, sizeof(name));
+    printf("}}");
+}
+
+static void chrome_request_event(chrome_trace_t *trace, const char *phase,
+                                 const char *name, size_t max_name_length,
+                                 uint32_t tid, uint64_t time, size_t reqid)
+{
+    chrome_event_start(trace, phase, name, max_name_length, tid, time);
+    printf(",\"cat\":\"request\",\"id\":\"0x%zx\"", reqid);
+}
+
+/*
+ * Requests are shown as asynchronous spans from their allocation until they
+ * are released, which may happen on different threads. Every request event
+ * is shown as a nested span which starts at the previous event of the same
+ * request, so the time between protocol stages is visible.
+ */
+static void chrome_request_record(chrome_trace_t *trace,
+                                  khash_t(request_spans) *spans, uint32_t tid,
+                                  const ucs_profile_record_t *rec)
+{
+    const ucs_profile_location_t *loc = &trace->data->locations[rec->location];
+    profile_request_span_t *span;
+    khiter_t hash_it;
+    int hash_status;
+
+    if (loc->type == UCS_PROFILE_TYPE_REQUEST_NEW) {
+        hash_it = kh_put(request_spans, spans, rec->param64, &hash_status);
+        if (hash_status == UCS_KH_PUT_FAILED) {
+            return;
+        }
+
+        span = &kh_value(spans, hash_it);
+        if (hash_status == UCS_KH_PUT_KEY_PRESENT) {
+            /* The old request was not released, close its span */
+            chrome_request_event(trace, "e", span->name, sizeof(loc->name),
+                                 tid, rec->timestamp, span->id);
+            printf("}");
+        }
+
+        span->id        = trace->reqid_ctr++;
+        span->name      = loc->name;
+        span->last_time = rec->timestamp;
+        chrome_request_event(trace, "b", span->name, sizeof(loc->name), tid,
+                             rec->timestamp, span->id);
+        printf(",\"args\":{\"request\":\"0x%" PRIx64 "\",\"param\":%u}}",
+               rec->param64, rec->param32);
+        return;
+    }
+
+    hash_it = kh_get(request_spans, spans, rec->param64);
+    if (hash_it == kh_end(spans)) {
+        /* Request was allocated before profiling started, or is not tracked */
+        chrome_event_start(trace, "i", loc->name, sizeof(loc->name), tid,
+                           rec->timestamp);
+        printf(",\"s\":\"t\"");
+        chrome_location_args(loc);
+        printf("}");
+        return;
+    }
+
+    span = &kh_value(spans, hash_it);
+    if (loc->type == UCS_PROFILE_TYPE_REQUEST_EVENT) {
+        chrome_request_event(trace, "b", loc->name, sizeof(loc->name), tid,
+                             span->last_time, span->id);
+        printf(",\"args\":{\"param\":%u}}", rec->param32);
+        chrome_request_event(trace, "e", loc->name, sizeof(loc->name), tid,
+                             rec->timestamp, span->id);
+        chrome_location_args(loc);
+        printf("}");
+        span->last_time = rec->timestamp;
+    } else {
+        chrome_request_event(trace, "e", span->name, sizeof(loc->name), tid,
+                             rec->timestamp, span->id);
+        printf("}");
+        kh_del(request_spans, spans, hash_it);
+    }
+}
+
+static void chrome_record(chrome_trace_t *trace, khash_t(request_spans) *spans,
+                          int thread_idx, const ucs_profile_record_t *rec,
+                          const ucs_profile_record_t **scope_ends)
+{
+    const profile_thread_data_t *thread = &trace->data->threads[thread_idx];
+    const ucs_profile_location_t *loc   = &trace->data->locations[rec->location];
+    uint32_t tid                        = thread->header->tid;
+    const ucs_profile_location_t *end_loc;
+    const ucs_profile_record_t *se;
+
+    switch (loc->type) {
+    case UCS_PROFILE_TYPE_SCOPE_BEGIN:
+        se = scope_ends[rec - thread->records];
+        if (se == NULL) {
+            break; /* Unfinished scope */
+        }
+
+        /* The scope name is stored in its end location */
+        end_loc = &trace->data->locations[se->location];
+        chrome_event_start(trace, "X", end_loc->name, sizeof(end_loc->name),
+                           tid, rec->timestamp);
+        printf(",\"dur\":%.3f", chrome_time_usec(trace, se->timestamp) -
+                                chrome_time_usec(trace, rec->timestamp));
+        chrome_location_args(end_loc);
+        printf("}");
+        break;
+    case UCS_PROFILE_TYPE_SAMPLE:
+        chrome_event_start(trace, "i", loc->name, sizeof(loc->name), tid,
+                           rec->timestamp);
+        printf(",\"s\":\"t\"");
+        chrome_location_args(loc);
+        printf("}");
+        break;
+    case UCS_PROFILE_TYPE_REQUEST_NEW:
+    case UCS_PROFILE_TYPE_REQUEST_EVENT:
+    case UCS_PROFILE_TYPE_REQUEST_FREE:
+        chrome_request_record(trace, spans, tid, rec);
+        break;
+    default:
+        break;
+    }
+}
+
+/*
+ * Export the log records in Chrome trace-event JSON format, which can be loaded
+ * by chrome://tracing or https://ui.perfetto.dev. Every thread is shown as a
+ * separate track.
+ */
+static int show_profile_data_chrome(profile_data_t *data, options_t *opts)
+{
+    const ucs_profile_record_t **scope_ends[MAX_THREADS] = {NULL};
+    size_t next_record[MAX_THREADS]                      = {0};
+    const profile_thread_data_t *thread;
+    const ucs_profile_record_t *rec, *next;
+    khash_t(request_spans) spans;
+    chrome_trace_t trace;
+    int thread_idx, ret;
+    int *t;
+
+    if (!(data->header->mode & UCS_BIT(UCS_PROFILE_MODE_LOG))) {
+        print_error("trace export requires a profile collected in log mode");
+        return -EINVAL;
+    }
+
+    trace.data       = data;
+    trace.base_time  = UINT64_MAX;
+    trace.num_events = 0;
+    trace.reqid_ctr  = 1;
+
+    for (t = opts->thread_list; *t != -1; ++t) {
+        thread          = &data->threads[*t - 1];
+        trace.base_time = ucs_min(trace.base_time, thread->header->start_time);
+        if (thread->header->num_records > 0) {
+            trace.base_time = ucs_min(trace.base_time,
+                                      thread->records[0].timestamp);
+        }
+
+        scope_ends[*t - 1] = find_scope_ends(data, thread, NULL);
+        if (scope_ends[*t - 1] == NULL) {
+            ret = -ENOMEM;
+            goto out;
+        }
+    }
+
+    printf("{\"displayTimeUnit\":\"ns\",\"otherData\":{\"command\":");
+    print_json_string(data->header->cmdline, sizeof(data->header->cmdline));
+    printf(",\"host\":");
+    print_json_string(data->header->hostname, sizeof(data->header->hostname));
+    printf(",\"ucs_lib\":");
+    print_json_string(data->header->ucs_path, sizeof(data->header->ucs_path));
+    printf("},\"traceEvents\":[");
+
+    for (t = opts->thread_list; *t != -1; ++t) {
+        chrome_thread_name(&trace, *t - 1);
+    }
+
+    /* Go over the records of all threads in timestamp order, since requests
+     * may be allocated, progressed and released by different threads */
+    kh_init_inplace(request_spans, &spans);
+    for (;;) {
+        rec        = NULL;
+        thread_idx = -1;
+        for (t = opts->thread_list; *t != -1; ++t) {
+            thread = &data->threads[*t - 1];
+            if (next_record[*t - 1] >= thread->header->num_records) {
+                continue;
+            }
+
+            next = &thread->records[next_record[*t - 1]];
+            if ((rec == NULL) || (next->timestamp < rec->timestamp)) {
+                rec        = next;
+                thread_idx = *t - 1;
+            }
+        }
+
+        if (rec == NULL) {
+            break;
+        }
+
+        ++next_record[thread_idx];
+        chrome_record(&trace, &spans, thread_idx, rec, scope_ends[thread_idx]);
+    }
+
+    kh_destroy_inplace(request_spans, &spans);
+    printf("\n]}\n");
+    ret = 0;
+
+out:
+    for (t = opts->thread_list; *t != -1; ++t) {
+        free(scope_ends[*t - 1]);
+    }
+    return ret;
+}
+
 static void close_pipes()
 {
     close(output_pipefds[0]);
@@ -798,6 +1116,10 @@ static int show_profile_data(profile_data_t *data, options_t *opts)
         }
     }
 
+    if (opts->format == OUTPUT_FORMAT_CHROME) {
+        return show_profile_data_chrome(data, opts);
+    }
+
     /* redirect output if needed */
     if (!opts->raw) {
         ret = redirect_output(data, opts);
@@ -828,6 +1150,11 @@ static void usage()
     printf("Usage: ucx_read_profile [options] [profile-file]\n");
     printf("Options are:\n");
     printf("  -r              Show raw output\n");
+    printf("  -f <format>     Select output format:\n");
+    printf("                     text   - human-readable text (default)\n");
+    printf("                     chrome - Chrome trace-event JSON, which can "
+           "be loaded by\n");
+    printf("                              chrome://tracing or Perfetto UI\n");
     printf("  -T <threads>    Comma-separated list of threads to show, "
            "e.g. \"1,2,3\", or \"all\" to show all threads\n");
     printf("  -t <units>      Select time units to use:\n");
@@ -843,17 +1170,29 @@ static int parse_args(int argc, char **argv, options_t *opts)
     int ret, c;
 
     opts->raw         = !isatty(fileno(stdout));
+    opts->format      = OUTPUT_FORMAT_TEXT;
     opts->time_units  = TIME_UNITS_USEC;
     ret = parse_thread_list(opts->thread_list, "all");
     if (ret < 0) {
         return ret;
     }
 
-    while ( (c = getopt(argc, argv, "rT:t:h")) != -1 ) {
+    while ( (c = getopt(argc, argv, "rf:T:t:h")) != -1 ) {
         switch (c) {
         case 'r':
             opts->raw = 1;
             break;
+        case 'f':
+            if (!strcasecmp(optarg, "text")) {
+                opts->format = OUTPUT_FORMAT_TEXT;
+            } else if (!strcasecmp(optarg, "chrome")) {
+                opts->format = OUTPUT_FORMAT_CHROME;
+            } else {
+                print_error("invalid output format '%s'\n", optarg);
+                usage();
+                return -1;
+            }
+            break;
         case 'T':
             ret = parse_thread_list(opts->thread_list, optarg);
             if (ret < 0) {
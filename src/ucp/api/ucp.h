@@ -244,7 +244,20 @@ typedef enum {
     /**< Pack addresses of network devices only. Using such shortened addresses
      *   for the remote node peers will reduce the amount of wireup data being
      *   exchanged during connection establishment phase. */
-    UCP_WORKER_ADDRESS_FLAG_NET_ONLY = UCS_BIT(0)
+    UCP_WORKER_ADDRESS_FLAG_NET_ONLY = UCS_BIT(0),
+
+    /**< Pack a compact address, which contains only the per-worker device and
+     *   interface addresses and refers to an address template with the
+     *   device and interface attributes. All workers with the same set of
+     *   resources share the same template, so in a homogeneous job it can be
+     *   exchanged once, instead of being repeated in every worker address.
+     *   The template is obtained with
+     *   @ref UCP_WORKER_ATTR_FIELD_ADDRESS_TEMPLATE and passed to
+     *   @ref ucp_ep_create with
+     *   @ref UCP_EP_PARAM_FIELD_REMOTE_ADDRESS_TEMPLATE.
+     *   Compact addresses can be unpacked only by UCX versions which
+     *   support them. */
+    UCP_WORKER_ADDRESS_FLAG_COMPACT  = UCS_BIT(1)
 } ucp_worker_address_flags_t;
 
 
@@ -268,7 +281,9 @@ enum ucp_ep_params_field {
     /**< Connection request field */
     UCP_EP_PARAM_FIELD_CONN_REQUEST      = UCS_BIT(6),
     UCP_EP_PARAM_FIELD_NAME              = UCS_BIT(7), /**< Endpoint name */
-    UCP_EP_PARAM_FIELD_LOCAL_SOCK_ADDR   = UCS_BIT(8)  /**< Local socket Address */
+    UCP_EP_PARAM_FIELD_LOCAL_SOCK_ADDR   = UCS_BIT(8), /**< Local socket Address */
+    /**< Address template of a compact remote address */
+    UCP_EP_PARAM_FIELD_REMOTE_ADDRESS_TEMPLATE = UCS_BIT(9)
 };
 
 
@@ -297,7 +312,7 @@ enum ucp_ep_params_flags_field {
                                                            send to a particular
                                                            remote endpoint, for
                                                            example stream */
-    UCP_EP_PARAMS_FLAGS_SEND_CLIENT_ID = UCS_BIT(2)   /**< Send client id
+    UCP_EP_PARAMS_FLAGS_SEND_CLIENT_ID = UCS_BIT(2),  /**< Send client id
                                                            when connecting to remote
                                                            socket address as part of the
                                                            connection request payload.
@@ -305,6 +320,20 @@ enum ucp_ep_params_flags_field {
                                                            can be obtained from
                                                            @ref ucp_conn_request_h using
                                                            @ref ucp_conn_request_query */
+    UCP_EP_PARAMS_FLAGS_LAZY_CONNECT   = UCS_BIT(3)   /**< Defer the connection
+                                                           establishment until the
+                                                           endpoint is first used.
+                                                           Only the remote worker
+                                                           address is stored by
+                                                           @ref ucp_ep_create, and the
+                                                           transport endpoints are
+                                                           created, and wireup is
+                                                           started, by the first
+                                                           operation or flush on the
+                                                           endpoint, or when the
+                                                           remote peer connects to
+                                                           it. Can be used only with
+                                                           @ref ucp_ep_params_t::address */
 };
 
 
@@ -456,8 +485,10 @@ enum ucp_worker_attr_field {
     UCP_WORKER_ATTR_FIELD_MAX_AM_HEADER   = UCS_BIT(3), /**< Maximum header size
                                                              used by UCP AM API */
     UCP_WORKER_ATTR_FIELD_NAME            = UCS_BIT(4), /**< UCP worker name */
-    UCP_WORKER_ATTR_FIELD_MAX_INFO_STRING = UCS_BIT(5)  /**< Maximum size of
+    UCP_WORKER_ATTR_FIELD_MAX_INFO_STRING = UCS_BIT(5), /**< Maximum size of
                                                              info string */
+    UCP_WORKER_ATTR_FIELD_ADDRESS_TEMPLATE = UCS_BIT(6) /**< UCP address
+                                                             template */
 };
 
 
@@ -1386,6 +1417,21 @@ typedef struct ucp_worker_attr {
      * Maximum debug string size that can be filled with @ref ucp_request_query.
      */
     size_t                max_debug_string;
+
+    /**
+     * Template of the compact worker address, see
+     * @ref UCP_WORKER_ADDRESS_FLAG_COMPACT. Address flags other than
+     * @ref UCP_WORKER_ADDRESS_FLAG_COMPACT apply to the template as well.
+     * The memory is allocated by @ref ucp_worker_query "ucp_worker_query()"
+     * routine, and must be released by using @ref ucp_worker_release_address
+     * "ucp_worker_release_address()" routine.
+     */
+    ucp_address_t         *address_template;
+
+    /**
+     * Size of the worker address template in bytes.
+     */
+    size_t                address_template_length;
 } ucp_worker_attr_t;
 
 
@@ -2541,6 +2587,86 @@ ucs_status_t ucp_worker_get_efd(ucp_worker_h worker, int *fd);
 ucs_status_t ucp_worker_wait(ucp_worker_h worker);
 
 
+/**
+ * @ingroup UCP_WAKEUP
+ * @brief UCP worker adaptive wait attributes field mask.
+ *
+ * The enumeration allows specifying which fields in
+ * @ref ucp_worker_wait_attr_t are present. It is used to enable backward
+ * compatibility support.
+ */
+enum ucp_worker_wait_attr_field {
+    UCP_WORKER_WAIT_ATTR_FIELD_SPIN_TIME  = UCS_BIT(0), /**< Time spent polling */
+    UCP_WORKER_WAIT_ATTR_FIELD_BLOCK_TIME = UCS_BIT(1), /**< Time spent blocked */
+    UCP_WORKER_WAIT_ATTR_FIELD_SPIN_LIMIT = UCS_BIT(2)  /**< Polling interval */
+};
+
+
+/**
+ * @ingroup UCP_WAKEUP
+ * @brief UCP worker adaptive wait attributes.
+ *
+ * The structure reports how @ref ucp_worker_wait_adaptive spent its time.
+ */
+typedef struct ucp_worker_wait_attr {
+    /**
+     * Mask of valid fields in this structure, using bits from
+     * @ref ucp_worker_wait_attr_field.
+     * Fields not specified in this mask will be ignored.
+     * Provides ABI compatibility with respect to adding new fields.
+     */
+    uint64_t field_mask;
+
+    /**
+     * Time, in seconds, spent polling the worker before an event was found or
+     * the worker was armed.
+     */
+    double   spin_time;
+
+    /**
+     * Time, in seconds, spent blocked on the worker event file descriptor.
+     */
+    double   block_time;
+
+    /**
+     * Polling interval, in seconds, which was used by this call. It is derived
+     * from the recent waiting times of the worker.
+     */
+    double   spin_limit;
+} ucp_worker_wait_attr_t;
+
+
+/**
+ * @ingroup UCP_WAKEUP
+ * @brief Wait for an event of the worker, polling it before blocking.
+ *
+ * This routine progresses the worker until an event occurs. It polls the
+ * @a worker with @ref ucp_worker_progress for a limited interval, and if no
+ * event is found in that interval, it blocks as @ref ucp_worker_wait does, and
+ * then progresses the worker once.
+ *
+ * The polling interval is learned from the time that recent calls waited for
+ * events: when events arrive shortly, the routine polls long enough to catch
+ * them with busy-polling latency, and when the worker is mostly idle, it blocks
+ * right away and does not consume CPU. The maximal polling interval is set by
+ * the UCX_WAIT_SPIN_MAX configuration parameter.
+ *
+ * A typical event loop calls this routine instead of a sequence of
+ * @ref ucp_worker_progress, @ref ucp_worker_arm and @ref ucp_worker_wait.
+ *
+ * @note UCP @ref ucp_feature "features" have to be triggered
+ *   with @ref UCP_FEATURE_WAKEUP to select proper transport
+ *
+ * @param [in]    worker    Worker to wait for events on.
+ * @param [inout] attr      If not NULL, filled with the fields requested by
+ *                          @ref ucp_worker_wait_attr_t::field_mask.
+ *
+ * @return Error code as defined by @ref ucs_status_t
+ */
+ucs_status_t ucp_worker_wait_adaptive(ucp_worker_h worker,
+                                      ucp_worker_wait_attr_t *attr);
+
+
 /**
  * @ingroup UCP_WAKEUP
  * @brief Wait for memory update on the address
@@ -2780,6 +2906,37 @@ ucs_status_t ucp_ep_create(ucp_worker_h worker, const ucp_ep_params_t *params,
                            ucp_ep_h *ep_p);
 
 
+/**
+ * @ingroup UCP_ENDPOINT
+ * @brief Create and connect a batch of endpoints.
+ *
+ * This routine is equivalent to calling @ref ucp_ep_create for every element
+ * of @a params, but is optimized for connecting to many peers at once, for
+ * example during all-to-all connection establishment. The worker lock is taken
+ * once for the whole call, an address template shared by consecutive peers is
+ * registered once, and lane selection is shared between peers which have the
+ * same address layout.
+ *
+ * @param [in]  worker      Handle to the worker; the endpoints
+ *                          are associated with the worker.
+ * @param [in]  params      Array of @a count endpoint parameters. Every
+ *                          element has to specify
+ *                          ucp_ep_params_t::address.
+ * @param [in]  count       Number of endpoints to create.
+ * @param [out] ep_p        Array of @a count endpoint handles, filled with the
+ *                          created endpoints. An element is set to NULL if the
+ *                          respective endpoint could not be created.
+ *
+ * @return UCS_OK if all endpoints were created, otherwise the error code of
+ *         the first endpoint which failed. The endpoints which were created
+ *         successfully remain valid also in case of an error, and have to be
+ *         closed by the user.
+ */
+ucs_status_t ucp_ep_create_bulk(ucp_worker_h worker,
+                                const ucp_ep_params_t *params, size_t count,
+                                ucp_ep_h *ep_p);
+
+
 /**
  * @ingroup UCP_ENDPOINT
  *
@@ -788,6 +788,18 @@ typedef struct ucp_ep_params {
      */
     ucs_sock_addr_t         local_sockaddr;
 
+    /**
+     * Address template which the destination @ref ucp_ep_params_t::address
+     * refers to, if it is a compact address obtained with
+     * @ref UCP_WORKER_ADDRESS_FLAG_COMPACT. The template is decoded once and
+     * cached by the worker, so it may be omitted for subsequent endpoints
+     * whose addresses refer to the same template. This field should be set
+     * along with its corresponding bit in the field_mask - @ref
+     * UCP_EP_PARAM_FIELD_REMOTE_ADDRESS_TEMPLATE and must be obtained using
+     * @ref ucp_worker_query with @ref UCP_WORKER_ATTR_FIELD_ADDRESS_TEMPLATE.
+     */
+    const ucp_address_t     *address_template;
+
 } ucp_ep_params_t;
 
 
@@ -55,6 +55,7 @@ ucs_status_t ucp_am_init(ucp_worker_h worker)
                                 sizeof(ucs_mpool_elem_t));
     mp_params.ops             = &ucp_am_frag_tree_mpool_ops;
     mp_params.name            = "ucp_am_frag_tree_nodes";
+    mp_params.numa_node       = worker->numa_node;
     status = ucs_mpool_init(&mp_params, &worker->am.frag_tree_mpool);
     if (status != UCS_OK) {
         ucs_array_cleanup_dynamic(&worker->am.cbs);
@@ -1000,6 +1001,7 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_am_send_nbx,
     }
 
     UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
+    UCP_OP_TRACE(worker, UCP_OP_TRACE_AM_SEND, ep, buffer, count, param, id);
 
     status = ucp_am_send_nbx_check_header_length(worker, header_length);
     if (status != UCS_OK) {
@@ -1007,6 +1009,12 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_am_send_nbx,
         goto out;
     }
 
+    status = ucp_ep_lazy_connect_check(ep);
+    if (ucs_unlikely(status != UCS_OK)) {
+        ret = UCS_STATUS_PTR(status);
+        goto out;
+    }
+
     flags     = ucp_request_param_flags(param);
     attr_mask = param->op_attr_mask &
                 (UCP_OP_ATTR_FIELD_DATATYPE | UCP_OP_ATTR_FLAG_NO_IMM_CMPL);
@@ -392,6 +392,12 @@ static ucs_config_field_t ucp_context_config_table[] = {
    "another thread, or incoming active messages, but consumes more resources.",
    ucs_offsetof(ucp_context_config_t, flush_worker_eps), UCS_CONFIG_TYPE_BOOL},
 
+  {"FLUSH_WORKER_DIRTY_EPS", "y",
+   "When flushing the worker by flushing its endpoints, flush only the endpoints\n"
+   "which issued RMA or atomic operations since the previous worker flush,\n"
+   "instead of going over all endpoints.",
+   ucs_offsetof(ucp_context_config_t, flush_worker_dirty_eps), UCS_CONFIG_TYPE_BOOL},
+
   {"FENCE_MODE", "auto",
    "Fence mode used in ucp_worker_fence routine.\n"
    " weak     - use weak fence mode.\n"
@@ -433,6 +439,27 @@ static ucs_config_field_t ucp_context_config_table[] = {
    ucs_offsetof(ucp_context_config_t, keepalive_interval),
    UCS_CONFIG_TYPE_TIME_UNITS},
 
+  {"WAIT_SPIN_MAX", "100us",
+   "Maximal time to poll the worker in ucp_worker_wait_adaptive() before\n"
+   "blocking. The actual polling time is learned from recent waiting times,\n"
+   "and polling is skipped when events are not expected within this time.",
+   ucs_offsetof(ucp_context_config_t, wait_spin_max),
+   UCS_CONFIG_TYPE_TIME_UNITS},
+
+  {"PROGRESS_THREAD", "n",
+   "Create an internal thread per worker which progresses communication in\n"
+   "the background, to overlap rendezvous, emulated RMA/AMO and fragmented\n"
+   "messages with application computation. The worker is made thread-safe,\n"
+   "and completion callbacks may be invoked from the progress thread.\n"
+   "Requires the library to be built with multi-thread support.",
+   ucs_offsetof(ucp_context_config_t, progress_thread), UCS_CONFIG_TYPE_BOOL},
+
+  {"PROGRESS_THREAD_CPU", "auto",
+   "CPU core to bind the worker progress thread to. \"auto\" leaves the thread\n"
+   "with the affinity of the process.",
+   ucs_offsetof(ucp_context_config_t, progress_thread_cpu),
+   UCS_CONFIG_TYPE_ULUNITS},
+
   {"KEEPALIVE_NUM_EPS", "128",
    "Maximal number of endpoints to check on every keepalive round\n"
    "(inf - check all endpoints on every round, must be greater than 0)",
@@ -483,6 +510,34 @@ static ucs_config_field_t ucp_context_config_table[] = {
    "dynamically allocated memory.",
    ucs_offsetof(ucp_context_config_t, rkey_mpool_max_md), UCS_CONFIG_TYPE_INT},
 
+  {"RKEY_CACHE_SIZE", "0",
+   "Maximum number of remote keys unpacked by ucp_ep_rkey_unpack() to keep in\n"
+   "a per-worker cache. Unpacking the same packed buffer on the same endpoint\n"
+   "again returns the cached remote key handle instead of creating a new one.\n"
+   "The least recently used entry is evicted when the cache is full.\n"
+   "0 disables the cache.",
+   ucs_offsetof(ucp_context_config_t, rkey_cache_size), UCS_CONFIG_TYPE_UINT},
+
+  {"WIREUP_LANES_CACHE_SIZE", "256",
+   "Maximum number of lane selection results to keep in a per-worker cache.\n"
+   "Endpoints to remote workers whose addresses have the same shape - same\n"
+   "transports, device attributes and reachability from the local resources -\n"
+   "reuse the cached selection instead of scoring all transports again.\n"
+   "The cache is flushed when it is full. 0 disables the cache.",
+   ucs_offsetof(ucp_context_config_t, wireup_lanes_cache_size),
+   UCS_CONFIG_TYPE_UINT},
+
+  {"MPOOL_HUGE_PAGES", "auto",
+   "Huge pages usage for the worker request and active message buffer pools.\n"
+   " - on   : use hugetlb pages if available, otherwise transparent huge pages\n"
+   "          with pool chunks rounded up to the huge page size. This reduces\n"
+   "          TLB misses with many outstanding requests, at the expense of a\n"
+   "          larger memory footprint.\n"
+   " - off  : use regular pages.\n"
+   " - auto : use hugetlb pages if available, otherwise regular pages.",
+   ucs_offsetof(ucp_context_config_t, mpool_huge_pages),
+   UCS_CONFIG_TYPE_ON_OFF_AUTO},
+
   {"ADDRESS_VERSION", "v1",
    "Defines UCP worker address format obtained with ucp_worker_get_address() or\n"
    "ucp_worker_query() routines.",
@@ -509,6 +564,17 @@ static ucs_config_field_t ucp_context_config_table[] = {
    "directory.",
    ucs_offsetof(ucp_context_config_t, proto_info_dir), UCS_CONFIG_TYPE_STRING},
 
+  {"OP_TRACE_FILE", "",
+   "If non-empty, record every tag send, active message send and RMA operation\n"
+   "issued through the UCP API to this file, for replay by 'ucx_perftest --replay'.\n"
+   "Each record holds the operation type, length, tag, peer endpoint index and\n"
+   "timestamp. The file name may contain the following substitutions:\n"
+   " %h - host name\n"
+   " %p - process id\n"
+   " %t - time\n"
+   "Every worker after the first one in the process appends '.<n>' to the name.",
+   ucs_offsetof(ucp_context_config_t, op_trace_file), UCS_CONFIG_TYPE_STRING},
+
   {"REG_NONBLOCK_MEM_TYPES", "",
    "Perform only non-blocking memory registration for these memory types.\n"
    "Non-blocking registration means that the page registration may be\n"
@@ -136,6 +136,8 @@ typedef struct ucp_context_config {
     size_t                                 estimated_num_ppn;
     /** Enable flushing endpoints while flushing a worker */
     int                                    flush_worker_eps;
+    /** Flush only endpoints with RMA/AMO operations while flushing a worker */
+    int                                    flush_worker_dirty_eps;
     /** Fence mode */
     ucp_fence_mode_t                       fence_mode;
     /** Enable optimizations suitable for homogeneous systems */
@@ -154,6 +156,12 @@ typedef struct ucp_context_config {
     /** Maximal number of endpoints to check on every keepalive round
      * (0 - disabled, inf - check all endpoints on every round) */
     unsigned                               keepalive_num_eps;
+    /** Maximal time to poll the worker before blocking in adaptive wait */
+    ucs_time_t                             wait_spin_max;
+    /** Whether to progress each worker from an internal thread */
+    int                                    progress_thread;
+    /** CPU core to bind the progress thread to, or UCS_ULUNITS_AUTO */
+    size_t                                 progress_thread_cpu;
     /** Time period between dynamic transport switching rounds */
     ucs_time_t                             dynamic_tl_switch_interval;
     /** Number of usage tracker rounds performed for each progress operation */
@@ -174,6 +182,14 @@ typedef struct ucp_context_config {
     /** Remote keys with that many remote MDs or less would be allocated from a
       * memory pool.*/
     int                                    rkey_mpool_max_md;
+    /** Maximal number of remote keys in the per-worker unpack cache
+      * (0 - disabled) */
+    unsigned                               rkey_cache_size;
+    /** Maximal number of lane selection results in the per-worker cache
+      * (0 - disabled) */
+    unsigned                               wireup_lanes_cache_size;
+    /** Huge pages usage for request and AM buffer pools */
+    ucs_on_off_auto_value_t                mpool_huge_pages;
     /** Worker address format version */
     ucp_object_version_t                   worker_addr_version;
     /** Threshold for enabling RNDV data split alignment */
@@ -184,6 +200,8 @@ typedef struct ucp_context_config {
     char                                   *select_distance_md;
     /** Directory to write protocol selection information */
     char                                   *proto_info_dir;
+    /** File to record the issued operations to */
+    char                                   *op_trace_file;
     /** Memory types that perform non-blocking registration by default */
     uint64_t                               reg_nb_mem_types;
     /** Enable fallback to blocking registration if no MDs support nonblocking */
@@ -214,6 +214,7 @@ static void ucp_ep_deallocate(ucp_ep_h ep)
 {
     UCS_STATS_NODE_FREE(ep->stats);
     ucs_free(ep->ext->uct_eps);
+    ucs_free(ep->ext->lazy_conn);
     ucs_free(ep->ext);
     ucs_strided_alloc_put(&ep->worker->ep_alloc, ep);
 }
@@ -221,7 +222,6 @@ static void ucp_ep_deallocate(ucp_ep_h ep)
 static ucp_ep_h ucp_ep_allocate(ucp_worker_h worker, const char *peer_name)
 {
     ucp_ep_h ep;
-    ucp_lane_index_t lane;
     ucs_status_t status;
 
     ep = ucs_strided_alloc_get(&worker->ep_alloc, "ucp_ep");
@@ -250,6 +250,9 @@ static ucp_ep_h ucp_ep_allocate(ucp_worker_h worker, const char *peer_name)
 #endif
     ep->ext->user_data                    = NULL;
     ep->ext->cm_idx                       = UCP_NULL_RESOURCE;
+    ep->ext->flush_dirty_idx              =
+            worker->context->config.ext.flush_worker_dirty_eps ?
+            UCP_EP_FLUSH_DIRTY_IDX_NONE : UCP_EP_FLUSH_DIRTY_IDX_UNTRACKED;
     ep->ext->local_ep_id                  = UCS_PTR_MAP_KEY_INVALID;
     ep->ext->remote_ep_id                 = UCS_PTR_MAP_KEY_INVALID;
     ep->ext->err_cb                       = NULL;
@@ -262,6 +265,7 @@ static ucp_ep_h ucp_ep_allocate(ucp_worker_h worker, const char *peer_name)
     ep->ext->fence_seq                    = 0;
     ep->ext->uct_eps                      = NULL;
     ep->ext->flush_sys_dev_map            = 0;
+    ep->ext->lazy_conn                    = NULL;
 
     UCS_STATIC_ASSERT(sizeof(ep->ext->ep_match) >=
                       sizeof(ep->ext->flush_state));
@@ -269,9 +273,8 @@ static ucp_ep_h ucp_ep_allocate(ucp_worker_h worker, const char *peer_name)
 
     ucs_hlist_head_init(&ep->ext->proto_reqs);
 
-    for (lane = 0; lane < UCP_MAX_FAST_PATH_LANES; ++lane) {
-        ucp_ep_set_lane(ep, lane, NULL);
-    }
+    /* Not using ucp_ep_set_lane(), since the lanes are not initialized yet */
+    memset(ep->uct_eps, 0, sizeof(ep->uct_eps));
 #if ENABLE_DEBUG_DATA
     ucs_snprintf_zero(ep->peer_name, UCP_WORKER_ADDRESS_NAME_MAX, "%s",
                       peer_name);
@@ -519,6 +522,21 @@ static int ucp_ep_remove_filter(const ucs_callbackq_elem_t *elem, void *arg)
     return 0;
 }
 
+static void ucp_ep_unmap_lanes(ucp_ep_h ep)
+{
+    ucp_lane_index_t num_lanes = UCP_MAX_FAST_PATH_LANES;
+    ucp_lane_index_t lane;
+
+    if ((ep->cfg_index != UCP_WORKER_CFG_INDEX_NULL) &&
+        (ep->ext->uct_eps != NULL)) {
+        num_lanes = ucs_max(num_lanes, ucp_ep_num_lanes(ep));
+    }
+
+    for (lane = 0; lane < num_lanes; ++lane) {
+        ucp_ep_set_lane(ep, lane, NULL);
+    }
+}
+
 void ucp_ep_destroy_base(ucp_ep_h ep)
 {
     ucp_worker_h worker = ep->worker;
@@ -536,8 +554,11 @@ void ucp_ep_destroy_base(ucp_ep_h ep)
     }
 
     ucp_worker_keepalive_remove_ep(ep);
+    ucp_rkey_cache_purge_ep(ep);
     ucp_ep_release_id(ep);
+    ucp_worker_flush_dirty_ep_remove(ep);
     ucs_list_del(&ep->ext->ep_list);
+    ucp_ep_unmap_lanes(ep);
 
     ucs_vfs_obj_remove(ep);
     ucs_callbackq_remove_oneshot(&worker->uct->progress_q, ep,
@@ -643,7 +664,10 @@ ucp_ep_adjust_params(ucp_ep_h ep, const ucp_ep_params_t *params)
 {
     ucs_status_t status;
 
-    if (params->field_mask & UCP_EP_PARAM_FIELD_ERR_HANDLING_MODE) {
+    /* An endpoint which is not connected yet has no configuration, and its
+     * error handling mode is taken from the same parameters */
+    if ((params->field_mask & UCP_EP_PARAM_FIELD_ERR_HANDLING_MODE) &&
+        (ep->cfg_index != UCP_WORKER_CFG_INDEX_NULL)) {
         status = ucp_ep_config_err_mode_check_mismatch(ep, params->err_mode);
         if (status != UCS_OK) {
             return status;
@@ -670,15 +694,16 @@ ucs_status_t ucp_ep_evaluate_perf(ucp_ep_h ep,
 {
     const ucp_worker_h worker               = ep->worker;
     const ucp_context_h context             = worker->context;
-    const ucp_ep_config_key_t *key          = &ucp_ep_config(ep)->key;
     double max_bandwidth                    = 0;
     ucp_rsc_index_t max_bandwidth_rsc_index = 0;
+    const ucp_ep_config_key_t *key;
     ucp_rsc_index_t rsc_index;
     double bandwidth;
     ucp_lane_index_t lane;
     ucp_worker_iface_t *wiface;
     uct_iface_attr_t *iface_attr;
     ucs_linear_func_t estimated_time;
+    ucs_status_t status;
 
     if (!ucs_test_all_flags(attr->field_mask,
                             UCP_EP_PERF_ATTR_FIELD_ESTIMATED_TIME &
@@ -686,6 +711,13 @@ ucs_status_t ucp_ep_evaluate_perf(ucp_ep_h ep,
         return UCS_ERR_INVALID_PARAM;
     }
 
+    status = ucp_ep_lazy_connect_check(ep);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    key = &ucp_ep_config(ep)->key;
+
     for (lane = 0; lane < ucp_ep_num_lanes(ep); ++lane) {
         if (lane == key->cm_lane) {
             /* Skip CM lanes for bandwidth calculation */
@@ -1098,33 +1130,165 @@ ucp_ep_create_api_conn_request(ucp_worker_h worker,
 }
 
 static ucs_status_t
-ucp_ep_create_api_to_worker_addr(ucp_worker_h worker,
-                                 const ucp_ep_params_t *params, ucp_ep_h *ep_p)
+ucp_ep_create_api_unpack_address(ucp_worker_h worker,
+                                 const ucp_ep_params_t *params,
+                                 const void **last_template_p,
+                                 ucp_unpacked_address_t *remote_address,
+                                 size_t *address_length_p)
 {
-    ucp_context_h context  = worker->context;
-    unsigned ep_init_flags = ucp_ep_init_flags(worker, params);
-    unsigned addr_indices[UCP_MAX_LANES];
-    ucp_unpacked_address_t remote_address;
-    ucp_ep_match_conn_sn_t conn_sn;
     ucs_status_t status;
-    unsigned flags;
-    ucp_ep_h ep;
 
     if (!(params->field_mask & UCP_EP_PARAM_FIELD_REMOTE_ADDRESS)) {
-        status = UCS_ERR_INVALID_PARAM;
         ucs_error("remote worker address is missing");
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    UCP_CHECK_PARAM_NON_NULL(params->address, status, return status);
+
+    if ((params->field_mask & UCP_EP_PARAM_FIELD_REMOTE_ADDRESS_TEMPLATE) &&
+        (params->address_template != *last_template_p)) {
+        UCP_CHECK_PARAM_NON_NULL(params->address_template, status,
+                                 return status);
+        status = ucp_address_template_add(worker, params->address_template,
+                                          NULL);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        *last_template_p = params->address_template;
+    }
+
+    return ucp_address_unpack_with_length(
+            worker, params->address,
+            ucp_worker_default_address_pack_flags(worker), remote_address,
+            address_length_p);
+}
+
+static ucs_status_t
+ucp_ep_create_lazy(ucp_worker_h worker, unsigned ep_init_flags,
+                   const ucp_unpacked_address_t *remote_address,
+                   const void *address, size_t address_length, ucp_ep_h *ep_p)
+{
+    ucp_ep_lazy_conn_t *lazy_conn;
+    ucs_status_t status;
+    ucp_ep_h ep;
+
+    lazy_conn = ucs_malloc(sizeof(*lazy_conn) + address_length,
+                           "ucp_ep_lazy_conn");
+    if (lazy_conn == NULL) {
+        ucs_error("failed to allocate lazy connection of %zu bytes",
+                  address_length);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    status = ucp_ep_create_base(worker, ep_init_flags, remote_address->name,
+                                "lazy from api call", &ep);
+    if (status != UCS_OK) {
+        ucs_free(lazy_conn);
+        return status;
+    }
+
+    /* Keep a copy of the remote address, since the user may release it */
+    lazy_conn->ep_init_flags  = ep_init_flags;
+    lazy_conn->address_length = address_length;
+    memcpy(lazy_conn->address, address, address_length);
+
+    ep->ext->lazy_conn = lazy_conn;
+    ucp_ep_update_flags(ep, UCP_EP_FLAG_LAZY_CONNECT, 0);
+
+    *ep_p = ep;
+    return UCS_OK;
+}
+
+static ucs_status_t
+ucp_ep_create_resolve_remote_id(ucp_ep_h ep, unsigned ep_init_flags)
+{
+    ucp_worker_h worker   = ep->worker;
+    ucp_context_h context = worker->context;
+
+    if ((context->config.ext.resolve_remote_ep_id == UCS_CONFIG_ON) ||
+        ((context->config.ext.resolve_remote_ep_id == UCS_CONFIG_AUTO) &&
+         (ep_init_flags & UCP_EP_INIT_ERR_MODE_FAILOVER_MASK) &&
+         ucp_worker_keepalive_is_enabled(worker))) {
+        /* If resolving remote ID forced by configuration or PEER_FAILURE
+         * and keepalive were requested, resolve remote endpoint ID prior to
+         * communicating with a peer to make sure that remote peer's endpoint
+         * won't be changed during runtime */
+        return ucp_ep_resolve_remote_id(ep, ep->am_lane);
+    }
+
+    return UCS_OK;
+}
+
+ucs_status_t ucp_ep_lazy_connect(ucp_ep_h ep)
+{
+    ucp_worker_h worker = ep->worker;
+    unsigned addr_indices[UCP_MAX_LANES];
+    ucp_unpacked_address_t remote_address;
+    ucp_ep_lazy_conn_t *lazy_conn;
+    ucs_status_t status;
+    int am_need_flush;
+
+    UCS_ASYNC_BLOCK(&worker->async);
+
+    if (!(ep->flags & UCP_EP_FLAG_LAZY_CONNECT)) {
+        status = UCS_OK;
         goto out;
     }
 
-    UCP_CHECK_PARAM_NON_NULL(params->address, status, goto out);
+    lazy_conn = ep->ext->lazy_conn;
+    status    = ucp_address_unpack(worker, lazy_conn->address,
+                                   ucp_worker_default_address_pack_flags(
+                                           worker),
+                                   &remote_address);
+    if (status != UCS_OK) {
+        goto out;
+    }
 
-    status = ucp_address_unpack(worker, params->address,
-                                ucp_worker_default_address_pack_flags(worker),
-                                &remote_address);
+    status = ucp_wireup_init_lanes(ep, lazy_conn->ep_init_flags,
+                                   &ucp_tl_bitmap_max, &remote_address,
+                                   addr_indices, &am_need_flush);
+    ucs_free(remote_address.address_list);
     if (status != UCS_OK) {
         goto out;
     }
 
+    ucs_debug("ep %p: connected on first use", ep);
+    ucp_ep_update_flags(ep, 0, UCP_EP_FLAG_LAZY_CONNECT);
+    ep->ext->lazy_conn = NULL;
+
+    /* if needed, send initial wireup message */
+    if (!(ep->flags & UCP_EP_FLAG_LOCAL_CONNECTED)) {
+        ucs_assert(!(ep->flags & UCP_EP_FLAG_CONNECT_REQ_QUEUED));
+        status = ucp_wireup_send_request(ep);
+        if (status != UCS_OK) {
+            goto out_free_lazy_conn;
+        }
+    }
+
+    status = ucp_ep_create_resolve_remote_id(ep, lazy_conn->ep_init_flags);
+
+out_free_lazy_conn:
+    ucs_free(lazy_conn);
+out:
+    UCS_ASYNC_UNBLOCK(&worker->async);
+    return status;
+}
+
+static ucs_status_t
+ucp_ep_create_api_to_unpacked_addr(ucp_worker_h worker,
+                                   const ucp_ep_params_t *params,
+                                   const ucp_unpacked_address_t *remote_address,
+                                   size_t address_length, ucp_ep_h *ep_p)
+{
+    ucp_context_h context  = worker->context;
+    unsigned ep_init_flags = ucp_ep_init_flags(worker, params);
+    unsigned flags         = UCP_PARAM_VALUE(EP, params, flags, FLAGS, 0);
+    unsigned addr_indices[UCP_MAX_LANES];
+    ucp_ep_match_conn_sn_t conn_sn;
+    ucs_status_t status;
+    ucp_ep_h ep;
+
     /* Check if there is already an unconnected internal endpoint to the same
      * destination address.
      * In case of loopback connection, search the hash table for an endpoint with
@@ -1136,10 +1300,10 @@ ucp_ep_create_api_to_worker_addr(ucp_worker_h worker,
      * dst_ep != 0. So, ucp_wireup_request() will not create an unexpected ep
      * in ep_match.
      */
-    conn_sn = ucp_ep_match_get_sn(worker, remote_address.uuid);
-    ep      = ucp_ep_match_retrieve(worker, remote_address.uuid,
+    conn_sn = ucp_ep_match_get_sn(worker, remote_address->uuid);
+    ep      = ucp_ep_match_retrieve(worker, remote_address->uuid,
                                     conn_sn ^
-                                    (remote_address.uuid == worker->uuid),
+                                    (remote_address->uuid == worker->uuid),
                                     UCS_CONN_MATCH_QUEUE_UNEXP);
     if (ep != NULL) {
         status = ucp_ep_adjust_params(ep, params);
@@ -1151,11 +1315,17 @@ ucp_ep_create_api_to_worker_addr(ucp_worker_h worker,
         goto out_resolve_remote_id;
     }
 
-    status = ucp_ep_create_to_worker_addr(worker, &ucp_tl_bitmap_max,
-                                          &remote_address, ep_init_flags,
-                                          "from api call", addr_indices, &ep);
+    if (flags & UCP_EP_PARAMS_FLAGS_LAZY_CONNECT) {
+        status = ucp_ep_create_lazy(worker, ep_init_flags, remote_address,
+                                    params->address, address_length, &ep);
+    } else {
+        status = ucp_ep_create_to_worker_addr(worker, &ucp_tl_bitmap_max,
+                                              remote_address, ep_init_flags,
+                                              "from api call", addr_indices,
+                                              &ep);
+    }
     if (status != UCS_OK) {
-        goto out_free_address;
+        goto out;
     }
 
     status = ucp_ep_adjust_params(ep, params);
@@ -1171,11 +1341,10 @@ ucp_ep_create_api_to_worker_addr(ucp_worker_h worker,
      * Otherwise, add the new ep to the matching context as an expected endpoint,
      * waiting for connection request from the peer endpoint
      */
-    flags = UCP_PARAM_VALUE(EP, params, flags, FLAGS, 0);
-    if ((remote_address.uuid == worker->uuid) &&
+    if ((remote_address->uuid == worker->uuid) &&
         !(flags & UCP_EP_PARAMS_FLAGS_NO_LOOPBACK)) {
         ucp_ep_update_remote_id(ep, ucp_ep_local_id(ep));
-    } else if (!ucp_ep_match_insert(worker, ep, remote_address.uuid, conn_sn,
+    } else if (!ucp_ep_match_insert(worker, ep, remote_address->uuid, conn_sn,
                                     UCS_CONN_MATCH_QUEUE_EXP)) {
         if (context->config.features & UCP_FEATURE_STREAM) {
             status = UCS_ERR_EXCEEDS_LIMIT;
@@ -1185,33 +1354,23 @@ ucp_ep_create_api_to_worker_addr(ucp_worker_h worker,
         }
     }
 
+    if (ep->flags & UCP_EP_FLAG_LAZY_CONNECT) {
+        /* Wireup is started by the first use of the endpoint */
+        status = UCS_OK;
+        goto out;
+    }
+
     /* if needed, send initial wireup message */
     if (!(ep->flags & UCP_EP_FLAG_LOCAL_CONNECTED)) {
         ucs_assert(!(ep->flags & UCP_EP_FLAG_CONNECT_REQ_QUEUED));
         status = ucp_wireup_send_request(ep);
         if (status != UCS_OK) {
-            goto out_free_address;
+            goto out;
         }
     }
 
-    status = UCS_OK;
-
 out_resolve_remote_id:
-    if ((context->config.ext.resolve_remote_ep_id == UCS_CONFIG_ON) ||
-        ((context->config.ext.resolve_remote_ep_id == UCS_CONFIG_AUTO) &&
-         (ep_init_flags & UCP_EP_INIT_ERR_MODE_FAILOVER_MASK) &&
-         ucp_worker_keepalive_is_enabled(worker))) {
-        /* If resolving remote ID forced by configuration or PEER_FAILURE
-         * and keepalive were requested, resolve remote endpoint ID prior to
-         * communicating with a peer to make sure that remote peer's endpoint
-         * won't be changed during runtime */
-        status = ucp_ep_resolve_remote_id(ep, ep->am_lane);
-        if (ucs_unlikely(status != UCS_OK)) {
-            goto out_free_address;
-        }
-    }
-out_free_address:
-    ucs_free(remote_address.address_list);
+    status = ucp_ep_create_resolve_remote_id(ep, ep_init_flags);
 out:
     if (status == UCS_OK) {
         *ep_p = ep;
@@ -1220,7 +1379,30 @@ out:
 
 err_destroy_ep:
     ucp_ep_destroy_internal(ep);
-    goto out_free_address;
+    goto out;
+}
+
+static ucs_status_t
+ucp_ep_create_api_to_worker_addr(ucp_worker_h worker,
+                                 const ucp_ep_params_t *params, ucp_ep_h *ep_p)
+{
+    const void *last_template = NULL;
+    ucp_unpacked_address_t remote_address;
+    size_t address_length;
+    ucs_status_t status;
+
+    status = ucp_ep_create_api_unpack_address(worker, params, &last_template,
+                                              &remote_address,
+                                              &address_length);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    status = ucp_ep_create_api_to_unpacked_addr(worker, params,
+                                                &remote_address,
+                                                address_length, ep_p);
+    ucs_free(remote_address.address_list);
+    return status;
 }
 
 static void ucp_ep_params_check_err_handling(ucp_ep_h ep,
@@ -1239,6 +1421,31 @@ static void ucp_ep_params_check_err_handling(ucp_ep_h ep,
              "keepalive and indirect id", ep);
 }
 
+static void ucp_ep_create_api_complete(ucp_worker_h worker,
+                                       const ucp_ep_params_t *params,
+                                       ucs_status_t status, ucp_ep_h ep,
+                                       ucp_ep_h *ep_p)
+{
+    if (status == UCS_OK) {
+#if ENABLE_DEBUG_DATA
+        if ((params->field_mask & UCP_EP_PARAM_FIELD_NAME) &&
+            (params->name != NULL)) {
+            ucs_snprintf_zero(ep->name, UCP_ENTITY_NAME_MAX, "%s",
+                              params->name);
+        } else {
+            ucs_snprintf_zero(ep->name, UCP_ENTITY_NAME_MAX, "%p", ep);
+        }
+#endif
+
+        ucp_ep_params_check_err_handling(ep, params);
+        ucp_ep_update_flags(ep, UCP_EP_FLAG_USED, 0);
+        *ep_p = ep;
+    } else {
+        ++worker->counters.ep_creation_failures;
+    }
+    ++worker->counters.ep_creations;
+}
+
 ucs_status_t ucp_ep_create(ucp_worker_h worker, const ucp_ep_params_t *params,
                            ucp_ep_h *ep_p)
 {
@@ -1258,24 +1465,49 @@ ucs_status_t ucp_ep_create(ucp_worker_h worker, const ucp_ep_params_t *params,
         status = UCS_ERR_INVALID_PARAM;
     }
 
-    if (status == UCS_OK) {
-#if ENABLE_DEBUG_DATA
-        if ((params->field_mask & UCP_EP_PARAM_FIELD_NAME) &&
-            (params->name != NULL)) {
-            ucs_snprintf_zero(ep->name, UCP_ENTITY_NAME_MAX, "%s",
-                              params->name);
-        } else {
-            ucs_snprintf_zero(ep->name, UCP_ENTITY_NAME_MAX, "%p", ep);
+    ucp_ep_create_api_complete(worker, params, status, ep, ep_p);
+
+    UCS_ASYNC_UNBLOCK(&worker->async);
+    return status;
+}
+
+ucs_status_t ucp_ep_create_bulk(ucp_worker_h worker,
+                                const ucp_ep_params_t *params, size_t count,
+                                ucp_ep_h *ep_p)
+{
+    const void *last_template = NULL;
+    ucs_status_t status       = UCS_OK;
+    ucp_unpacked_address_t remote_address;
+    size_t address_length;
+    ucs_status_t ep_status;
+    size_t i;
+
+    UCS_ASYNC_BLOCK(&worker->async);
+
+    for (i = 0; i < count; ++i) {
+        ep_p[i] = NULL;
+
+        /* Peers sharing an address template register it only once, and peers
+         * with the same address layout share the lanes selection result
+         * through the worker lanes cache */
+        ep_status = ucp_ep_create_api_unpack_address(worker, &params[i],
+                                                     &last_template,
+                                                     &remote_address,
+                                                     &address_length);
+        if (ep_status == UCS_OK) {
+            ep_status = ucp_ep_create_api_to_unpacked_addr(worker, &params[i],
+                                                           &remote_address,
+                                                           address_length,
+                                                           &ep_p[i]);
+            ucs_free(remote_address.address_list);
         }
-#endif
 
-        ucp_ep_params_check_err_handling(ep, params);
-        ucp_ep_update_flags(ep, UCP_EP_FLAG_USED, 0);
-        *ep_p = ep;
-    } else {
-        ++worker->counters.ep_creation_failures;
+        ucp_ep_create_api_complete(worker, &params[i], ep_status, ep_p[i],
+                                   &ep_p[i]);
+        if ((ep_status != UCS_OK) && (status == UCS_OK)) {
+            status = ep_status;
+        }
     }
-    ++worker->counters.ep_creations;
 
     UCS_ASYNC_UNBLOCK(&worker->async);
     return status;
@@ -1813,6 +2045,11 @@ void ucp_ep_cleanup_lanes(ucp_ep_h ep)
 
     ucs_debug("ep %p: cleanup lanes", ep);
 
+    if (ep->cfg_index == UCP_WORKER_CFG_INDEX_NULL) {
+        /* Lanes were not created, e.g. the endpoint was never connected */
+        return;
+    }
+
     ucp_ep_failed_tl_iface_init();
 
     ucp_ep_extract_failed_lanes(ep, UCS_MASK(ucp_ep_num_lanes(ep)),
@@ -1956,12 +2193,22 @@ ucs_status_ptr_t ucp_ep_close_nbx(ucp_ep_h ep, const ucp_request_param_t *param)
     ucp_request_t *close_req;
 
     if ((ucp_request_param_flags(param) & UCP_EP_CLOSE_FLAG_FORCE) &&
+        !(ep->flags & UCP_EP_FLAG_LAZY_CONNECT) &&
         !ucp_ep_config_err_handling_enabled(ep)) {
         return UCS_STATUS_PTR(UCS_ERR_INVALID_PARAM);
     }
 
     UCS_ASYNC_BLOCK(&worker->async);
 
+    if (ep->flags & UCP_EP_FLAG_LAZY_CONNECT) {
+        /* Nothing was sent on the endpoint, so it can be released right away */
+        ucs_debug("ep %p: close before connection was established", ep);
+        ucp_ep_update_flags(ep, UCP_EP_FLAG_CLOSED, 0);
+        ucp_ep_disconnected(ep, 1);
+        ++worker->counters.ep_closures;
+        goto out;
+    }
+
     ucs_debug("ep %p flags 0x%x cfg_index %d: close_nbx(flags=0x%x)", ep,
               ep->flags, ep->cfg_index, ucp_request_param_flags(param));
 
@@ -3383,8 +3630,8 @@ static void ucp_ep_config_print(FILE *stream, ucp_worker_h worker,
 static void ucp_ep_print_info_internal(ucp_ep_h ep, const char *name,
                                        FILE *stream)
 {
-    ucp_worker_h worker     = ep->worker;
-    ucp_ep_config_t *config = ucp_ep_config(ep);
+    ucp_worker_h worker = ep->worker;
+    ucp_ep_config_t *config;
     ucp_rsc_index_t aux_rsc_index;
     ucp_lane_index_t wireup_msg_lane;
     ucs_string_buffer_t strb;
@@ -3397,6 +3644,14 @@ static void ucp_ep_print_info_internal(ucp_ep_h ep, const char *name,
     fprintf(stream, "#\n");
     fprintf(stream, "#               peer: %s\n", ucp_ep_peer_name(ep));
 
+    if (ep->flags & UCP_EP_FLAG_LAZY_CONNECT) {
+        fprintf(stream, "#         connection: deferred until first use\n");
+        fprintf(stream, "#\n");
+        goto out;
+    }
+
+    config = ucp_ep_config(ep);
+
     /* if there is a wireup lane, set aux_rsc_index to the stub ep resource */
     aux_rsc_index   = UCP_NULL_RESOURCE;
     wireup_msg_lane = config->key.wireup_msg_lane;
@@ -3418,6 +3673,7 @@ static void ucp_ep_print_info_internal(ucp_ep_h ep, const char *name,
         ucs_string_buffer_cleanup(&strb);
     }
 
+out:
     UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
 }
 
@@ -3820,10 +4076,16 @@ static ucs_status_t ucp_ep_query_transport(ucp_ep_h ep, ucp_ep_attr_t *attr)
 
 ucs_status_t ucp_ep_query_sockaddr(ucp_ep_h ep, ucp_ep_attr_t *attr)
 {
-    uct_ep_h uct_cm_ep = ucp_ep_get_cm_uct_ep(ep);
     uct_ep_attr_t uct_cm_ep_attr;
     ucs_status_t status;
+    uct_ep_h uct_cm_ep;
 
+    if (ep->flags & UCP_EP_FLAG_LAZY_CONNECT) {
+        ucs_debug("ep %p: not connected yet", ep);
+        return UCS_ERR_NOT_CONNECTED;
+    }
+
+    uct_cm_ep = ucp_ep_get_cm_uct_ep(ep);
     if ((uct_cm_ep == NULL) || ucp_is_uct_ep_failed(uct_cm_ep)) {
         ucs_debug("ep %p: no cm", ep);
         return UCS_ERR_NOT_CONNECTED;
@@ -3884,9 +4146,14 @@ ucs_status_t ucp_ep_query(ucp_ep_h ep, ucp_ep_attr_t *attr)
     }
 
     if (attr->field_mask & UCP_EP_ATTR_FIELD_TRANSPORTS) {
-        status = ucp_ep_query_transport(ep, attr);
-        if (status != UCS_OK) {
-            return status;
+        if (ep->flags & UCP_EP_FLAG_LAZY_CONNECT) {
+            /* No transports are used until the endpoint is connected */
+            attr->transports.num_entries = 0;
+        } else {
+            status = ucp_ep_query_transport(ep, attr);
+            if (status != UCS_OK) {
+                return status;
+            }
         }
     }
 
@@ -3905,6 +4172,16 @@ ucs_status_t ucp_ep_realloc_lanes(ucp_ep_h ep, unsigned new_num_lanes)
     unsigned old_num_lanes;
     uct_ep_h *tmp;
 
+    old_num_lanes = (ep->cfg_index != UCP_WORKER_CFG_INDEX_NULL) ?
+                            ucp_ep_num_lanes(ep) :
+                            0;
+
+    /* Remove the slow path lanes which are about to be released */
+    for (lane = ucs_max(new_num_lanes, UCP_MAX_FAST_PATH_LANES);
+         lane < old_num_lanes; ++lane) {
+        ucp_ep_set_lane(ep, lane, NULL);
+    }
+
     if (num_slow_lanes <= 0) {
         ucs_free(ep_ext->uct_eps);
         ep_ext->uct_eps = NULL;
@@ -3920,12 +4197,13 @@ ucs_status_t ucp_ep_realloc_lanes(ucp_ep_h ep, unsigned new_num_lanes)
 
     ep_ext->uct_eps = tmp;
 
-    old_num_lanes = (ep->cfg_index != UCP_WORKER_CFG_INDEX_NULL) ?
-                            ucp_ep_num_lanes(ep) :
-                            0;
-
     for (lane = old_num_lanes; lane < new_num_lanes; ++lane) {
-        ucp_ep_set_lane(ep, lane, NULL);
+        if (lane < UCP_MAX_FAST_PATH_LANES) {
+            ucp_ep_set_lane(ep, lane, NULL);
+        } else {
+            /* Newly allocated slow path lane */
+            ep_ext->uct_eps[lane - UCP_MAX_FAST_PATH_LANES] = NULL;
+        }
     }
 
     return UCS_OK;
@@ -26,6 +26,13 @@
 #define UCP_MAX_IOV                16UL
 
 
+/* Endpoint is not on the worker's array of endpoints to flush */
+#define UCP_EP_FLUSH_DIRTY_IDX_NONE      UINT32_MAX
+
+/* Endpoint is never added to the worker's array of endpoints to flush */
+#define UCP_EP_FLUSH_DIRTY_IDX_UNTRACKED (UINT32_MAX - 1)
+
+
 /* Endpoint flags type */
 #if ENABLE_DEBUG_DATA || UCS_ENABLE_ASSERT
 typedef uint32_t                   ucp_ep_flags_t;
@@ -104,7 +111,9 @@ enum {
                                                         while merging pending queues */
     UCP_EP_FLAG_CONNECT_PRE_REQ_QUEUED = UCS_BIT(9), /* Pre-Connection request was queued */
     UCP_EP_FLAG_CLOSED                 = UCS_BIT(10),/* EP was closed */
-    /* 11 bit is vacant for a flag */
+    UCP_EP_FLAG_LAZY_CONNECT           = UCS_BIT(11),/* Connection establishment is deferred
+                                                        until the first use, the remote
+                                                        address is kept in ext->lazy_conn */
     UCP_EP_FLAG_ERR_HANDLER_INVOKED    = UCS_BIT(12),/* error handler was called */
     UCP_EP_FLAG_INTERNAL               = UCS_BIT(13),/* the internal EP which holds
                                                         temporary wireup configuration or
@@ -492,6 +501,17 @@ typedef struct {
 } ucp_ep_flush_state_t;
 
 
+/**
+ * Deferred connection of an endpoint created with
+ * @ref UCP_EP_PARAMS_FLAGS_LAZY_CONNECT
+ */
+typedef struct {
+    unsigned ep_init_flags;  /* Endpoint initialization flags */
+    size_t   address_length; /* Length of the packed remote address */
+    uint8_t  address[0];     /* Copy of the packed remote address */
+} ucp_ep_lazy_conn_t;
+
+
 /**
  * Endpoint extension
  */
@@ -500,6 +520,9 @@ typedef struct ucp_ep_ext {
     void                          *user_data;    /* User data associated with ep */
     ucs_list_link_t               ep_list;       /* List entry in worker's all eps list */
     ucp_rsc_index_t               cm_idx;        /* CM index */
+    uint32_t                      flush_dirty_idx; /* Index in worker's array of
+                                                      endpoints to flush, or
+                                                      UCP_EP_FLUSH_DIRTY_IDX_* */
     ucs_ptr_map_key_t             local_ep_id;   /* Local EP ID */
     ucs_ptr_map_key_t             remote_ep_id;  /* Remote EP ID */
     ucp_err_handler_cb_t          err_cb;        /* Error handler */
@@ -550,6 +573,9 @@ typedef struct ucp_ep_ext {
      * Map of system devices that require a flush operation
      */
     ucp_sys_dev_map_t             flush_sys_dev_map;
+
+    /* Deferred connection, valid if UCP_EP_FLAG_LAZY_CONNECT is set */
+    ucp_ep_lazy_conn_t            *lazy_conn;
 } ucp_ep_ext_t;
 
 
@@ -740,6 +766,16 @@ void ucp_ep_disconnected(ucp_ep_h ep, int force);
 
 void ucp_ep_destroy_internal(ucp_ep_h ep);
 
+/**
+ * Create the transport lanes and start the wireup of an endpoint which was
+ * created with @ref UCP_EP_PARAMS_FLAGS_LAZY_CONNECT.
+ *
+ * @param [in] ep  Endpoint to connect.
+ *
+ * @return Error code as defined by @ref ucs_status_t
+ */
+ucs_status_t ucp_ep_lazy_connect(ucp_ep_h ep);
+
 void ucp_ep_set_lanes_failed(ucp_ep_h ucp_ep, ucp_lane_map_t lanes,
                              ucs_status_t status);
 
@@ -44,13 +44,25 @@ ucp_ep_get_lane(ucp_ep_h ep, ucp_lane_index_t lane_index)
 static UCS_F_ALWAYS_INLINE void ucp_ep_set_lane(ucp_ep_h ep, size_t lane_index,
                                                 uct_ep_h uct_ep)
 {
+    uct_ep_h *uct_ep_p;
+
     ucs_assert(lane_index != UCP_NULL_LANE);
 
     if (lane_index < UCP_MAX_FAST_PATH_LANES) {
-        ep->uct_eps[lane_index] = uct_ep;
+        uct_ep_p = &ep->uct_eps[lane_index];
     } else {
-        ep->ext->uct_eps[lane_index - UCP_MAX_FAST_PATH_LANES] = uct_ep;
+        uct_ep_p = &ep->ext->uct_eps[lane_index - UCP_MAX_FAST_PATH_LANES];
+    }
+
+    /* Keep the worker reverse index of lanes up to date */
+    if (*uct_ep_p != NULL) {
+        ucp_worker_uct_ep_hash_remove(ep->worker, ep, *uct_ep_p);
     }
+    if (uct_ep != NULL) {
+        ucp_worker_uct_ep_hash_add(ep->worker, ep, uct_ep);
+    }
+
+    *uct_ep_p = uct_ep;
 }
 
 static inline ucp_lane_index_t ucp_ep_get_am_lane(ucp_ep_h ep)
@@ -322,4 +334,15 @@ static UCS_F_ALWAYS_INLINE ucp_lane_map_t ucp_ep_get_live_lanes(ucp_ep_h ep)
     return lane_map;
 }
 
+/* Connect an endpoint created with UCP_EP_PARAMS_FLAGS_LAZY_CONNECT on its
+ * first use */
+static UCS_F_ALWAYS_INLINE ucs_status_t ucp_ep_lazy_connect_check(ucp_ep_h ep)
+{
+    if (ucs_likely(!(ep->flags & UCP_EP_FLAG_LAZY_CONNECT))) {
+        return UCS_OK;
+    }
+
+    return ucp_ep_lazy_connect(ep);
+}
+
 #endif
@@ -125,6 +125,11 @@ void ucp_ep_vfs_init(ucp_ep_h ep)
     ucs_vfs_obj_add_ro_file(ep, ucp_ep_vfs_read_peer_name, NULL, 0,
                             "peer_name");
 
+    if (ep->cfg_index == UCP_WORKER_CFG_INDEX_NULL) {
+        /* Endpoint is not connected yet */
+        return;
+    }
+
     err_mode = ucp_ep_config(ep)->key.err_mode;
     ucs_vfs_obj_add_ro_file(ep, ucs_vfs_show_primitive,
                             (void*)ucp_err_handling_mode_names[err_mode],
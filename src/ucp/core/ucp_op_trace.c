@@ -0,0 +1,228 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "ucp_op_trace.h"
+#include "ucp_context.h"
+#include "ucp_worker.h"
+#include "ucp_request.inl"
+
+#include <ucp/dt/dt_contig.h>
+#include <ucp/dt/dt_iov.h>
+#include <ucs/arch/atomic.h>
+#include <ucs/datastruct/khash.h>
+#include <ucs/debug/log.h>
+#include <ucs/debug/memtrack_int.h>
+#include <ucs/sys/string.h>
+#include <ucs/time/time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+/* Records are written to the file in blocks of this size */
+#define UCP_OP_TRACE_BUFFER_RECORDS 4096
+
+
+KHASH_MAP_INIT_INT64(ucp_op_trace_peers, uint32_t);
+
+
+/* Number of trace files opened by the process */
+static uint32_t ucp_op_trace_seq = 0;
+
+
+struct ucp_op_trace {
+    int                         fd;
+    char                        filename[PATH_MAX];
+    ucs_time_t                  start_time;
+    uint64_t                    num_records;
+    khash_t(ucp_op_trace_peers) peers;    /* Endpoint -> peer index */
+    unsigned                    buffered; /* Records in the buffer */
+    ucp_op_trace_record_t       buffer[UCP_OP_TRACE_BUFFER_RECORDS];
+};
+
+
+static ucs_status_t
+ucp_op_trace_write(ucp_op_trace_t *trace, const void *data, size_t length,
+                   off_t offset)
+{
+    ssize_t ret;
+
+    while (length > 0) {
+        ret = pwrite(trace->fd, data, length, offset);
+        if (ret < 0) {
+            ucs_error("failed to write operation trace to '%s': %m",
+                      trace->filename);
+            return UCS_ERR_IO_ERROR;
+        }
+
+        data    = UCS_PTR_BYTE_OFFSET(data, ret);
+        length -= ret;
+        offset += ret;
+    }
+
+    return UCS_OK;
+}
+
+static ucs_status_t ucp_op_trace_write_header(ucp_op_trace_t *trace)
+{
+    ucp_op_trace_header_t header = {
+        .magic       = UCP_OP_TRACE_MAGIC,
+        .version     = UCP_OP_TRACE_VERSION,
+        .record_size = sizeof(ucp_op_trace_record_t),
+        .num_records = trace->num_records,
+        .num_peers   = kh_size(&trace->peers),
+        .pid         = getpid()
+    };
+
+    return ucp_op_trace_write(trace, &header, sizeof(header), 0);
+}
+
+static void ucp_op_trace_flush(ucp_op_trace_t *trace)
+{
+    off_t offset = sizeof(ucp_op_trace_header_t) +
+                   ((trace->num_records - trace->buffered) *
+                    sizeof(ucp_op_trace_record_t));
+
+    /* On error the records are dropped, to keep the application running */
+    ucp_op_trace_write(trace, trace->buffer,
+                       trace->buffered * sizeof(ucp_op_trace_record_t),
+                       offset);
+    trace->buffered = 0;
+}
+
+ucs_status_t ucp_op_trace_open(ucp_worker_h worker)
+{
+    ucp_context_h context = worker->context;
+    char filename[PATH_MAX];
+    ucp_op_trace_t *trace;
+    ucs_status_t status;
+    uint32_t seq;
+
+    worker->op_trace = NULL;
+    if (!strlen(context->config.ext.op_trace_file)) {
+        return UCS_OK;
+    }
+
+    trace = ucs_malloc(sizeof(*trace), "ucp_op_trace");
+    if (trace == NULL) {
+        ucs_error("failed to allocate operation trace");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    /* Every worker writes its own file */
+    ucs_fill_filename_template(context->config.ext.op_trace_file, filename,
+                               sizeof(filename));
+    seq = ucs_atomic_fadd32(&ucp_op_trace_seq, 1);
+    if (seq == 0) {
+        ucs_strncpy_safe(trace->filename, filename, sizeof(trace->filename));
+    } else {
+        ucs_snprintf_safe(trace->filename, sizeof(trace->filename), "%s.%u",
+                          filename, seq);
+    }
+
+    trace->fd = open(trace->filename, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (trace->fd < 0) {
+        ucs_error("failed to open operation trace file '%s': %m",
+                  trace->filename);
+        status = UCS_ERR_IO_ERROR;
+        goto err_free;
+    }
+
+    kh_init_inplace(ucp_op_trace_peers, &trace->peers);
+    trace->num_records = 0;
+    trace->buffered    = 0;
+
+    status = ucp_op_trace_write_header(trace);
+    if (status != UCS_OK) {
+        goto err_close;
+    }
+
+    trace->start_time = ucs_get_time();
+    worker->op_trace  = trace;
+    ucs_debug("worker %p: tracing operations to '%s'", worker,
+              trace->filename);
+    return UCS_OK;
+
+err_close:
+    kh_destroy_inplace(ucp_op_trace_peers, &trace->peers);
+    close(trace->fd);
+err_free:
+    ucs_free(trace);
+    return status;
+}
+
+void ucp_op_trace_close(ucp_worker_h worker)
+{
+    ucp_op_trace_t *trace = worker->op_trace;
+
+    if (trace == NULL) {
+        return;
+    }
+
+    ucp_op_trace_flush(trace);
+    ucp_op_trace_write_header(trace);
+    ucs_debug("worker %p: wrote %" PRIu64 " operations to '%s'", worker,
+              trace->num_records, trace->filename);
+
+    kh_destroy_inplace(ucp_op_trace_peers, &trace->peers);
+    close(trace->fd);
+    ucs_free(trace);
+    worker->op_trace = NULL;
+}
+
+static uint32_t ucp_op_trace_peer(ucp_op_trace_t *trace, ucp_ep_h ep)
+{
+    khiter_t iter;
+    int ret;
+
+    iter = kh_put(ucp_op_trace_peers, &trace->peers, (uintptr_t)ep, &ret);
+    if (ret == UCS_KH_PUT_FAILED) {
+        return UINT32_MAX;
+    } else if (ret != UCS_KH_PUT_KEY_PRESENT) {
+        kh_value(&trace->peers, iter) = kh_size(&trace->peers) - 1;
+    }
+
+    return kh_value(&trace->peers, iter);
+}
+
+static size_t
+ucp_op_trace_length(const void *buffer, size_t count,
+                    const ucp_request_param_t *param)
+{
+    ucp_datatype_t datatype = ucp_request_param_datatype(param);
+
+    switch (datatype & UCP_DATATYPE_CLASS_MASK) {
+    case UCP_DATATYPE_CONTIG:
+        return ucp_contig_dt_length(datatype, count);
+    case UCP_DATATYPE_IOV:
+        return ucp_dt_iov_length(buffer, count);
+    default:
+        /* Packed size of a generic datatype is known only to the user */
+        return count;
+    }
+}
+
+void ucp_op_trace_record(ucp_op_trace_t *trace, ucp_op_trace_op_t op,
+                         ucp_ep_h ep, const void *buffer, size_t count,
+                         const ucp_request_param_t *param, uint64_t tag)
+{
+    ucp_op_trace_record_t *record = &trace->buffer[trace->buffered];
+
+    record->timestamp = ucs_time_to_nsec(ucs_get_time() - trace->start_time);
+    record->length    = ucp_op_trace_length(buffer, count, param);
+    record->tag       = tag;
+    record->peer      = ucp_op_trace_peer(trace, ep);
+    record->op        = op;
+    memset(record->reserved, 0, sizeof(record->reserved));
+
+    ++trace->num_records;
+    if (++trace->buffered == UCP_OP_TRACE_BUFFER_RECORDS) {
+        ucp_op_trace_flush(trace);
+    }
+}
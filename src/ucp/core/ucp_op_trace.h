@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCP_OP_TRACE_H_
+#define UCP_OP_TRACE_H_
+
+#include <ucp/api/ucp.h>
+#include <ucs/sys/compiler_def.h>
+#include <ucs/type/status.h>
+#include <stdint.h>
+
+
+/*
+ * Operation trace file format: ucp_op_trace_header_t followed by fixed-size
+ * ucp_op_trace_record_t entries, in the order the operations were issued.
+ */
+#define UCP_OP_TRACE_MAGIC   0x4543415254504355ul /* "UCPTRACE" */
+#define UCP_OP_TRACE_VERSION 1u
+
+
+/**
+ * Type of a traced operation.
+ */
+typedef enum {
+    UCP_OP_TRACE_TAG_SEND,
+    UCP_OP_TRACE_TAG_SEND_SYNC,
+    UCP_OP_TRACE_AM_SEND,
+    UCP_OP_TRACE_PUT,
+    UCP_OP_TRACE_GET,
+    UCP_OP_TRACE_LAST
+} ucp_op_trace_op_t;
+
+
+typedef struct {
+    uint64_t magic;       /* UCP_OP_TRACE_MAGIC */
+    uint32_t version;     /* UCP_OP_TRACE_VERSION */
+    uint32_t record_size; /* sizeof(ucp_op_trace_record_t) */
+    uint64_t num_records; /* Updated when the trace is closed, 0 if the
+                             process did not close it */
+    uint32_t num_peers;   /* Number of distinct endpoints in the trace */
+    uint32_t pid;         /* Process which recorded the trace */
+} UCS_S_PACKED ucp_op_trace_header_t;
+
+
+typedef struct {
+    uint64_t timestamp;   /* Nanoseconds since the trace was opened */
+    uint64_t length;      /* Payload length in bytes */
+    uint64_t tag;         /* Tag, active message id or remote address */
+    uint32_t peer;        /* Endpoint index, in order of first use */
+    uint8_t  op;          /* ucp_op_trace_op_t */
+    uint8_t  reserved[3];
+} UCS_S_PACKED ucp_op_trace_record_t;
+
+
+typedef struct ucp_op_trace ucp_op_trace_t;
+
+
+/**
+ * Record an operation issued on an endpoint, if the worker traces operations.
+ * Must be called with the worker lock held.
+ */
+#define UCP_OP_TRACE(_worker, _op, _ep, _buffer, _count, _param, _tag) \
+    if (ucs_unlikely((_worker)->op_trace != NULL)) { \
+        ucp_op_trace_record((_worker)->op_trace, _op, _ep, _buffer, _count, \
+                            _param, _tag); \
+    }
+
+
+/**
+ * Open the operation trace file of a worker, if configured by
+ * UCX_OP_TRACE_FILE.
+ *
+ * @param [in]  worker  Worker to trace.
+ *
+ * @return Error code if the trace file could not be opened.
+ */
+ucs_status_t ucp_op_trace_open(ucp_worker_h worker);
+
+
+/**
+ * Write the remaining records and close the trace file of a worker.
+ *
+ * @param [in]  worker  Traced worker.
+ */
+void ucp_op_trace_close(ucp_worker_h worker);
+
+
+void ucp_op_trace_record(ucp_op_trace_t *trace, ucp_op_trace_op_t op,
+                         ucp_ep_h ep, const void *buffer, size_t count,
+                         const ucp_request_param_t *param, uint64_t tag);
+
+#endif
@@ -305,12 +305,22 @@ ucp_request_mpool_obj_str(ucs_mpool_t *mp, void *obj, ucs_string_buffer_t *strb)
     ucp_request_str(req, worker, strb, 0);
 }
 
-ucs_mpool_ops_t ucp_request_mpool_ops = {
-    .chunk_alloc   = ucs_mpool_hugetlb_malloc,
-    .chunk_release = ucs_mpool_hugetlb_free,
-    .obj_init      = ucp_worker_request_init_proxy,
-    .obj_cleanup   = ucp_worker_request_fini_proxy,
-    .obj_str       = ucp_request_mpool_obj_str
+#define UCP_REQUEST_MPOOL_OPS(_chunk_alloc, _chunk_release) \
+    { \
+        .chunk_alloc   = _chunk_alloc, \
+        .chunk_release = _chunk_release, \
+        .obj_init      = ucp_worker_request_init_proxy, \
+        .obj_cleanup   = ucp_worker_request_fini_proxy, \
+        .obj_str       = ucp_request_mpool_obj_str \
+    }
+
+ucs_mpool_ops_t ucp_request_mpool_ops[] = {
+    [UCS_CONFIG_OFF]  = UCP_REQUEST_MPOOL_OPS(ucs_mpool_chunk_malloc,
+                                              ucs_mpool_chunk_free),
+    [UCS_CONFIG_ON]   = UCP_REQUEST_MPOOL_OPS(ucs_mpool_huge_malloc,
+                                              ucs_mpool_hugetlb_free),
+    [UCS_CONFIG_AUTO] = UCP_REQUEST_MPOOL_OPS(ucs_mpool_hugetlb_malloc,
+                                              ucs_mpool_hugetlb_free)
 };
 
 ucs_mpool_ops_t ucp_rndv_get_mpool_ops = {
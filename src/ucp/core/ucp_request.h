@@ -489,6 +489,10 @@ struct ucp_request {
             ucp_send_nbx_callback_t cb;           /* Completion callback */
             uct_worker_cb_id_t      prog_id;      /* Progress callback ID */
             ucp_ep_ext_t            *next_ep_ext; /* Extension of the next endpoint to flush */
+            ucp_ep_h                *dirty_eps;   /* Endpoints with RMA/AMO operations
+                                                     to flush before the list walk */
+            unsigned                num_dirty_eps; /* Number of entries in dirty_eps */
+            unsigned                dirty_ep_idx; /* Next entry in dirty_eps to flush */
             int                     comp_count;   /* Countdown to request completion */
             unsigned                uct_flags;    /* Flags to pass to @ref uct_ep_flush */
         } flush_worker;
@@ -551,7 +555,8 @@ struct ucp_request_send_proto {
 };
 
 
-extern ucs_mpool_ops_t ucp_request_mpool_ops;
+/* Request memory pool operations, indexed by huge pages usage mode */
+extern ucs_mpool_ops_t ucp_request_mpool_ops[UCS_CONFIG_ON_OFF_LAST];
 extern ucs_mpool_ops_t ucp_rndv_get_mpool_ops;
 extern const ucp_request_param_t ucp_request_null_param;
 
@@ -15,6 +15,7 @@
 #include <ucp/core/ucp_mm.inl>
 #include <ucp/rma/rma.h>
 #include <ucp/proto/proto_debug.h>
+#include <ucs/algorithm/crc.h>
 #include <ucs/datastruct/mpool.inl>
 #include <ucs/profile/profile.h>
 #include <ucs/type/float8.h>
@@ -24,6 +25,10 @@
 #include <inttypes.h>
 
 
+KHASH_IMPL(ucp_worker_rkey_cache, uint64_t, ucp_rkey_cache_entry_t*, 1,
+           kh_int64_hash_func, kh_int64_hash_equal);
+
+
 typedef struct {
     uint8_t   sys_dev;
     ucs_fp8_t latency;
@@ -910,6 +915,35 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_rkey_proto_resolve,
                                       &rkey->cfg_index);
 }
 
+static void ucp_rkey_release_tl_rkeys(ucp_rkey_h rkey)
+{
+    unsigned remote_md_index, rkey_index;
+
+    rkey_index = 0;
+    ucs_for_each_bit(remote_md_index, rkey->md_map) {
+        if (rkey->tl_rkey[rkey_index].rkey.rkey != UCT_INVALID_RKEY) {
+            uct_rkey_release(rkey->tl_rkey[rkey_index].cmpt,
+                             &rkey->tl_rkey[rkey_index].rkey);
+        }
+        ++rkey_index;
+    }
+}
+
+static void ucp_rkey_free_desc(ucp_rkey_h rkey)
+{
+    ucp_worker_h UCS_V_UNUSED worker;
+
+    if (rkey->flags & UCP_RKEY_DESC_FLAG_POOL) {
+        worker = ucs_container_of(ucs_mpool_obj_owner(rkey), ucp_worker_t,
+                                  rkey_mp);
+        UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
+        ucs_mpool_put_inline(rkey);
+        UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
+    } else {
+        ucs_free(rkey);
+    }
+}
+
 UCS_PROFILE_FUNC(ucs_status_t, ucp_ep_rkey_unpack_internal,
                  (ep, buffer, length, unpack_md_map, skip_md_map, sys_dev,
                   rkey_p),
@@ -1054,13 +1088,242 @@ out:
     return status;
 }
 
+static size_t ucp_rkey_cache_packed_length(const void *buffer)
+{
+    const void *p = buffer;
+    ucp_md_map_t md_map;
+    unsigned md_index;
+    uint8_t tl_rkey_size;
+
+    md_map = *ucs_serialize_next(&p, const ucp_md_map_t);
+    ucs_serialize_next(&p, const uint8_t); /* mem_type */
+    ucs_for_each_bit(md_index, md_map) {
+        tl_rkey_size = *ucs_serialize_next(&p, const uint8_t);
+        ucs_serialize_next_raw(&p, const void, tl_rkey_size);
+    }
+
+    return UCS_PTR_BYTE_DIFF(buffer, p);
+}
+
+static uint64_t
+ucp_rkey_cache_digest(ucp_ep_h ep, const void *buffer, size_t length)
+{
+    uint32_t crc;
+
+    crc = ucs_crc32(0, &ep, sizeof(ep));
+    crc = ucs_crc32(crc, buffer, length);
+    return ((uint64_t)length << 32) | crc;
+}
+
+static void ucp_rkey_cache_entry_put(ucp_rkey_cache_entry_t *entry)
+{
+    ucs_assert(entry->refcount > 0);
+    if (--entry->refcount > 0) {
+        return;
+    }
+
+    ucs_trace("worker %p: release cached rkey %p ep %p digest 0x%" PRIx64,
+              entry->worker, &entry->rkey, entry->ep, entry->digest);
+    ucp_rkey_release_tl_rkeys(&entry->rkey);
+    ucs_free(entry);
+}
+
+static void
+ucp_rkey_cache_evict(ucp_worker_h worker, khiter_t khiter)
+{
+    ucp_rkey_cache_entry_t *entry = kh_val(&worker->rkey_cache.hash, khiter);
+
+    kh_del(ucp_worker_rkey_cache, &worker->rkey_cache.hash, khiter);
+    ucp_rkey_cache_entry_put(entry);
+}
+
+static void ucp_rkey_cache_evict_lru(ucp_worker_h worker)
+{
+    ucs_lru_element_t *elem;
+    khiter_t khiter;
+    uint64_t digest;
+
+    elem   = ucs_lru_pop(worker->rkey_cache.lru);
+    digest = (uint64_t)elem->key;
+    ucs_free(elem);
+
+    khiter = kh_get(ucp_worker_rkey_cache, &worker->rkey_cache.hash, digest);
+    ucs_assert(khiter != kh_end(&worker->rkey_cache.hash));
+    ucp_rkey_cache_evict(worker, khiter);
+}
+
+static ucs_status_t
+ucp_rkey_cache_add(ucp_ep_h ep, const void *buffer, size_t length,
+                   uint64_t digest, ucp_rkey_h *rkey_p)
+{
+    ucp_worker_h worker = ep->worker;
+    ucp_rkey_cache_entry_t *entry;
+    size_t tl_rkeys_size;
+    ucs_status_t status;
+    ucp_rkey_h rkey;
+    khiter_t khiter;
+    int ret;
+
+    status = ucp_ep_rkey_unpack_reachable(ep, buffer, 0, &rkey);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    tl_rkeys_size = sizeof(rkey->tl_rkey[0]) * ucs_popcount(rkey->md_map);
+    entry         = ucs_malloc(sizeof(*entry) + tl_rkeys_size + length,
+                               "ucp_rkey_cache_entry");
+    if (entry == NULL) {
+        /* The rkey is still valid, just don't cache it */
+        goto out;
+    }
+
+    /* Move the unpacked rkey into the cache entry; UCT rkeys are owned by the
+     * entry from now on, so release only the original descriptor */
+    memcpy(&entry->rkey, rkey, sizeof(*rkey) + tl_rkeys_size);
+    entry->rkey.flags = (rkey->flags & ~UCP_RKEY_DESC_FLAG_POOL) |
+                        UCP_RKEY_DESC_FLAG_CACHED;
+    ucp_rkey_free_desc(rkey);
+
+    entry->worker   = worker;
+    entry->ep       = ep;
+    entry->digest   = digest;
+    entry->refcount = 1; /* User handle */
+    entry->length   = length;
+    entry->buffer   = UCS_PTR_BYTE_OFFSET(entry->rkey.tl_rkey, tl_rkeys_size);
+    memcpy((void*)entry->buffer, buffer, length);
+    rkey            = &entry->rkey;
+
+    if (ucs_lru_size(worker->rkey_cache.lru) >=
+        worker->context->config.ext.rkey_cache_size) {
+        ucp_rkey_cache_evict_lru(worker);
+    }
+
+    khiter = kh_put(ucp_worker_rkey_cache, &worker->rkey_cache.hash, digest,
+                    &ret);
+    if (ret == UCS_KH_PUT_FAILED) {
+        goto out;
+    }
+
+    ucs_assert((ret == UCS_KH_PUT_BUCKET_EMPTY) ||
+               (ret == UCS_KH_PUT_BUCKET_CLEAR));
+    kh_val(&worker->rkey_cache.hash, khiter) = entry;
+    ucs_lru_push(worker->rkey_cache.lru, (void*)digest);
+    ++entry->refcount; /* Cache reference */
+
+    ucs_trace("ep %p: cached rkey %p digest 0x%" PRIx64, ep, rkey, digest);
+
+out:
+    *rkey_p = rkey;
+    return UCS_OK;
+}
+
+static ucs_status_t
+ucp_rkey_cache_unpack(ucp_ep_h ep, const void *buffer, ucp_rkey_h *rkey_p)
+{
+    ucp_worker_h worker = ep->worker;
+    ucp_rkey_cache_entry_t *entry;
+    uint64_t digest;
+    khiter_t khiter;
+    size_t length;
+
+    length = ucp_rkey_cache_packed_length(buffer);
+    digest = ucp_rkey_cache_digest(ep, buffer, length);
+    khiter = kh_get(ucp_worker_rkey_cache, &worker->rkey_cache.hash, digest);
+    if (khiter == kh_end(&worker->rkey_cache.hash)) {
+        return ucp_rkey_cache_add(ep, buffer, length, digest, rkey_p);
+    }
+
+    entry = kh_val(&worker->rkey_cache.hash, khiter);
+    if (ucs_unlikely((entry->ep != ep) || (entry->length != length) ||
+                     memcmp(entry->buffer, buffer, length))) {
+        /* Digest collision, bypass the cache */
+        return ucp_ep_rkey_unpack_reachable(ep, buffer, 0, rkey_p);
+    }
+
+    ++entry->refcount;
+    ucs_lru_push(worker->rkey_cache.lru, (void*)digest);
+    *rkey_p = &entry->rkey;
+    return UCS_OK;
+}
+
+ucs_status_t ucp_rkey_cache_init(ucp_worker_h worker)
+{
+    unsigned capacity = worker->context->config.ext.rkey_cache_size;
+
+    kh_init_inplace(ucp_worker_rkey_cache, &worker->rkey_cache.hash);
+    if (capacity == 0) {
+        worker->rkey_cache.lru = NULL;
+        return UCS_OK;
+    }
+
+    return ucs_lru_create(capacity, &worker->rkey_cache.lru);
+}
+
+void ucp_rkey_cache_cleanup(ucp_worker_h worker)
+{
+    khiter_t khiter;
+
+    if (worker->rkey_cache.lru != NULL) {
+        for (khiter = kh_begin(&worker->rkey_cache.hash);
+             khiter != kh_end(&worker->rkey_cache.hash); ++khiter) {
+            if (kh_exist(&worker->rkey_cache.hash, khiter)) {
+                ucp_rkey_cache_evict(worker, khiter);
+            }
+        }
+
+        ucs_lru_destroy(worker->rkey_cache.lru);
+        worker->rkey_cache.lru = NULL;
+    }
+
+    kh_destroy_inplace(ucp_worker_rkey_cache, &worker->rkey_cache.hash);
+}
+
+void ucp_rkey_cache_purge_ep(ucp_ep_h ep)
+{
+    ucp_worker_h worker = ep->worker;
+    ucp_rkey_cache_entry_t *entry;
+    khiter_t khiter;
+
+    if ((worker->rkey_cache.lru == NULL) ||
+        (kh_size(&worker->rkey_cache.hash) == 0)) {
+        return;
+    }
+
+    /* Cached rkeys which are still referenced by the user remain valid until
+     * released by ucp_rkey_destroy(), but are not returned by unpack anymore */
+    for (khiter = kh_begin(&worker->rkey_cache.hash);
+         khiter != kh_end(&worker->rkey_cache.hash); ++khiter) {
+        if (!kh_exist(&worker->rkey_cache.hash, khiter)) {
+            continue;
+        }
+
+        entry = kh_val(&worker->rkey_cache.hash, khiter);
+        if (entry->ep == ep) {
+            ucs_lru_remove(worker->rkey_cache.lru, (void*)entry->digest);
+            ucp_rkey_cache_evict(worker, khiter);
+        }
+    }
+}
+
 ucs_status_t ucp_ep_rkey_unpack(ucp_ep_h ep, const void *rkey_buffer,
                                 ucp_rkey_h *rkey_p)
 {
     ucs_status_t status;
 
     UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(ep->worker);
-    status = ucp_ep_rkey_unpack_reachable(ep, rkey_buffer, 0, rkey_p);
+    /* Remote key unpacking depends on the endpoint lanes */
+    status = ucp_ep_lazy_connect_check(ep);
+    if (status != UCS_OK) {
+        goto out;
+    }
+
+    if (ep->worker->rkey_cache.lru != NULL) {
+        status = ucp_rkey_cache_unpack(ep, rkey_buffer, rkey_p);
+    } else {
+        status = ucp_ep_rkey_unpack_reachable(ep, rkey_buffer, 0, rkey_p);
+    }
+
+out:
     UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(ep->worker);
 
     return status;
@@ -1131,27 +1394,20 @@ ucs_status_t ucp_rkey_ptr(ucp_rkey_h rkey, uint64_t raddr, void **addr_p)
 
 void ucp_rkey_destroy(ucp_rkey_h rkey)
 {
-    unsigned remote_md_index, rkey_index;
     ucp_worker_h UCS_V_UNUSED worker;
+    ucp_rkey_cache_entry_t *entry;
 
-    rkey_index = 0;
-    ucs_for_each_bit(remote_md_index, rkey->md_map) {
-        if (rkey->tl_rkey[rkey_index].rkey.rkey != UCT_INVALID_RKEY) {
-            uct_rkey_release(rkey->tl_rkey[rkey_index].cmpt,
-                             &rkey->tl_rkey[rkey_index].rkey);
-        }
-        ++rkey_index;
-    }
-
-    if (rkey->flags & UCP_RKEY_DESC_FLAG_POOL) {
-        worker = ucs_container_of(ucs_mpool_obj_owner(rkey), ucp_worker_t,
-                                  rkey_mp);
+    if (rkey->flags & UCP_RKEY_DESC_FLAG_CACHED) {
+        entry  = ucs_container_of(rkey, ucp_rkey_cache_entry_t, rkey);
+        worker = entry->worker;
         UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
-        ucs_mpool_put_inline(rkey);
+        ucp_rkey_cache_entry_put(entry);
         UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
-    } else {
-        ucs_free(rkey);
+        return;
     }
+
+    ucp_rkey_release_tl_rkeys(rkey);
+    ucp_rkey_free_desc(rkey);
 }
 
 ucp_lane_index_t ucp_rkey_find_rma_lane(ucp_context_h context,
@@ -39,8 +39,10 @@ typedef struct ucp_tl_rkey {
  * Rkey flags
  */
 enum {
-    UCP_RKEY_DESC_FLAG_POOL       = UCS_BIT(0)  /* Descriptor was allocated from pool
+    UCP_RKEY_DESC_FLAG_POOL       = UCS_BIT(0), /* Descriptor was allocated from pool
                                                    and must be returned to pool, not free */
+    UCP_RKEY_DESC_FLAG_CACHED     = UCS_BIT(1)  /* Descriptor is embedded in a worker
+                                                   rkey cache entry */
 };
 
 
@@ -133,6 +135,22 @@ typedef struct ucp_rkey {
 } ucp_rkey_t;
 
 
+/**
+ * Entry of the worker rkey unpack cache. The remote key handle returned to the
+ * user is embedded at the end of the entry, followed by its UCT rkeys and by a
+ * copy of the packed buffer it was unpacked from.
+ */
+typedef struct ucp_rkey_cache_entry {
+    ucp_worker_h                      worker;   /* Worker the entry belongs to */
+    ucp_ep_h                          ep;       /* Endpoint the rkey was unpacked on */
+    uint64_t                          digest;   /* Hash of endpoint and packed buffer */
+    unsigned                          refcount; /* User handles + 1 if in cache */
+    size_t                            length;   /* Length of the packed buffer */
+    const void                        *buffer;  /* Copy of the packed buffer */
+    ucp_rkey_t                        rkey;     /* Must be last */
+} ucp_rkey_cache_entry_t;
+
+
 typedef struct ucp_unpacked_exported_tl_mkey {
     ucp_md_map_t   local_md_map; /* Local MD map of packed TL mkeys */
     uint8_t        tl_mkey_size; /* Size of the mkey buffer */
@@ -236,6 +254,15 @@ ucs_status_t ucp_ep_rkey_unpack_internal(ucp_ep_h ep, const void *buffer,
                                          ucp_rkey_h *rkey_p);
 
 
+ucs_status_t ucp_rkey_cache_init(ucp_worker_h worker);
+
+
+void ucp_rkey_cache_cleanup(ucp_worker_h worker);
+
+
+void ucp_rkey_cache_purge_ep(ucp_ep_h ep);
+
+
 void ucp_rkey_dump_packed(const void *buffer, size_t length,
                           ucs_string_buffer_t *strb);
 
@@ -106,12 +106,23 @@ static ucs_stats_class_t ucp_worker_stats_class = {
 static void ucp_am_mpool_obj_str(ucs_mpool_t *mp, void *obj,
                                  ucs_string_buffer_t *strb);
 
-ucs_mpool_ops_t ucp_am_mpool_ops = {
-    .chunk_alloc   = ucs_mpool_hugetlb_malloc,
-    .chunk_release = ucs_mpool_hugetlb_free,
-    .obj_init      = (ucs_mpool_obj_init_func_t)ucs_empty_function,
-    .obj_cleanup   = (ucs_mpool_obj_cleanup_func_t)ucs_empty_function,
-    .obj_str       = ucp_am_mpool_obj_str
+#define UCP_AM_MPOOL_OPS(_chunk_alloc, _chunk_release) \
+    { \
+        .chunk_alloc   = _chunk_alloc, \
+        .chunk_release = _chunk_release, \
+        .obj_init      = (ucs_mpool_obj_init_func_t)ucs_empty_function, \
+        .obj_cleanup   = (ucs_mpool_obj_cleanup_func_t)ucs_empty_function, \
+        .obj_str       = ucp_am_mpool_obj_str \
+    }
+
+/* Indexed by huge pages usage mode */
+ucs_mpool_ops_t ucp_am_mpool_ops[] = {
+    [UCS_CONFIG_OFF]  = UCP_AM_MPOOL_OPS(ucs_mpool_chunk_malloc,
+                                         ucs_mpool_chunk_free),
+    [UCS_CONFIG_ON]   = UCP_AM_MPOOL_OPS(ucs_mpool_huge_malloc,
+                                         ucs_mpool_hugetlb_free),
+    [UCS_CONFIG_AUTO] = UCP_AM_MPOOL_OPS(ucs_mpool_hugetlb_malloc,
+                                         ucs_mpool_hugetlb_free)
 };
 
 ucs_mpool_ops_t ucp_reg_mpool_ops = {
@@ -138,6 +149,10 @@ KHASH_IMPL(ucp_worker_discard_uct_ep_hash, uct_ep_h, ucp_request_t*, 1,
            ucp_worker_discard_uct_ep_hash_key, kh_int64_hash_equal);
 
 
+KHASH_IMPL(ucp_worker_uct_ep_hash, uct_ep_h, ucp_ep_h, 1,
+           ucp_worker_discard_uct_ep_hash_key, kh_int64_hash_equal);
+
+
 static ucs_status_t ucp_worker_wakeup_ctl_fd(ucp_worker_h worker,
                                              ucp_worker_event_fd_op_t op,
                                              int event_fd)
@@ -500,7 +515,6 @@ static ucp_ep_h ucp_worker_find_lane(ucs_list_link_t *ep_list, uct_ep_h uct_ep,
     ucp_ep_h ucp_ep;
     ucp_lane_index_t lane;
 
-    /* TODO: need to optimize uct_ep -> ucp_ep lookup */
     ucs_list_for_each(ep_ext, ep_list, ep_list) {
         ucp_ep = ep_ext->ep;
         lane   = ucp_ep_lookup_lane(ucp_ep, uct_ep);
@@ -513,6 +527,62 @@ static ucp_ep_h ucp_worker_find_lane(ucs_list_link_t *ep_list, uct_ep_h uct_ep,
     return NULL;
 }
 
+void ucp_worker_uct_ep_hash_add(ucp_worker_h worker, ucp_ep_h ucp_ep,
+                                uct_ep_h uct_ep)
+{
+    khiter_t iter;
+    int ret;
+
+    iter = kh_put(ucp_worker_uct_ep_hash, &worker->uct_ep_hash, uct_ep, &ret);
+    if (ret == UCS_KH_PUT_FAILED) {
+        /* Not fatal: lookup falls back to scanning the endpoints list */
+        ucs_debug("worker %p: failed to add uct_ep %p of ep %p to the hash",
+                  worker, uct_ep, ucp_ep);
+        return;
+    }
+
+    kh_value(&worker->uct_ep_hash, iter) = ucp_ep;
+}
+
+void ucp_worker_uct_ep_hash_remove(ucp_worker_h worker, ucp_ep_h ucp_ep,
+                                   uct_ep_h uct_ep)
+{
+    khiter_t iter;
+
+    iter = kh_get(ucp_worker_uct_ep_hash, &worker->uct_ep_hash, uct_ep);
+    if ((iter != kh_end(&worker->uct_ep_hash)) &&
+        (kh_value(&worker->uct_ep_hash, iter) == ucp_ep)) {
+        kh_del(ucp_worker_uct_ep_hash, &worker->uct_ep_hash, iter);
+    }
+}
+
+static ucp_ep_h ucp_worker_lookup_lane(ucp_worker_h worker, uct_ep_h uct_ep,
+                                       ucp_lane_index_t *lane_p)
+{
+    ucp_lane_index_t lane;
+    ucp_ep_h ucp_ep;
+    khiter_t iter;
+
+    iter = kh_get(ucp_worker_uct_ep_hash, &worker->uct_ep_hash, uct_ep);
+    if (iter != kh_end(&worker->uct_ep_hash)) {
+        ucp_ep = kh_value(&worker->uct_ep_hash, iter);
+        lane   = ucp_ep_lookup_lane(ucp_ep, uct_ep);
+        if (lane != UCP_NULL_LANE) {
+            *lane_p = lane;
+            return ucp_ep;
+        }
+    }
+
+    /* The hash holds only UCT EPs which are set as lanes, so a UCT EP owned
+     * by a wireup or proxy EP is found by scanning all endpoints */
+    ucp_ep = ucp_worker_find_lane(&worker->all_eps, uct_ep, lane_p);
+    if (ucp_ep == NULL) {
+        ucp_ep = ucp_worker_find_lane(&worker->internal_eps, uct_ep, lane_p);
+    }
+
+    return ucp_ep;
+}
+
 /**
  * FLUSH_CANCEL operation might be on pending queue due to
  * UCS_ERR_NO_RESOURCES, so need to purge the queue to resubmit the
@@ -554,16 +624,13 @@ ucp_worker_iface_error_handler(void *arg, uct_ep_h uct_ep, ucs_status_t status)
         goto out;
     }
 
-    ucp_ep = ucp_worker_find_lane(&worker->all_eps, uct_ep, &lane);
+    ucp_ep = ucp_worker_lookup_lane(worker, uct_ep, &lane);
     if (ucp_ep == NULL) {
-        ucp_ep = ucp_worker_find_lane(&worker->internal_eps, uct_ep, &lane);
-        if (ucp_ep == NULL) {
-            ucs_error("worker %p: uct_ep %p isn't associated with any UCP"
-                      " endpoint and was not scheduled to be discarded",
-                      worker, uct_ep);
-            status = UCS_ERR_NO_ELEM;
-            goto out;
-        }
+        ucs_error("worker %p: uct_ep %p isn't associated with any UCP"
+                  " endpoint and was not scheduled to be discarded",
+                  worker, uct_ep);
+        status = UCS_ERR_NO_ELEM;
+        goto out;
     }
 
     status = ucp_worker_iface_handle_uct_ep_failure(ucp_ep, lane, uct_ep,
@@ -2011,8 +2078,10 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
     mp_params.elem_size       = sizeof(ucp_request_t) +
                                 context->config.request.size;
     mp_params.elems_per_chunk = 128;
-    mp_params.ops             = &ucp_request_mpool_ops;
+    mp_params.ops             = &ucp_request_mpool_ops[
+                                        context->config.ext.mpool_huge_pages];
     mp_params.name            = "ucp_requests";
+    mp_params.numa_node       = worker->numa_node;
     /* Create memory pool for requests */
     status = ucs_mpool_init(&mp_params, &worker->req_mp);
     if (status != UCS_OK) {
@@ -2055,6 +2124,7 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
         mp_params.elems_per_chunk = 128;
         mp_params.ops             = &ucp_rkey_mpool_ops;
         mp_params.name            = "ucp_rkeys";
+        mp_params.numa_node       = worker->numa_node;
         status = ucs_mpool_init(&mp_params, &worker->rkey_mp);
         if (status != UCS_OK) {
             goto err_req_mp_cleanup;
@@ -2081,7 +2151,9 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
                                     max_mp_entry_size, 0,
                                     UCP_WORKER_HEADROOM_SIZE + worker->am.alignment,
                                     0, UCS_SYS_CACHE_LINE_SIZE, 128, UINT_MAX,
-                                    &ucp_am_mpool_ops, "ucp_am_bufs");
+                                    &ucp_am_mpool_ops[
+                                        context->config.ext.mpool_huge_pages],
+                                    "ucp_am_bufs");
         if (status != UCS_OK) {
             goto err_reg_mp_cleanup;
         }
@@ -2588,6 +2660,78 @@ static void ucp_worker_usage_tracker_destroy(ucp_worker_h worker)
     ucs_usage_tracker_destroy(worker->usage_tracker.handle);
 }
 
+static void *ucp_worker_progress_thread_func(void *arg)
+{
+    ucp_worker_h worker = arg;
+
+    ucs_debug("worker %p: progress thread started", worker);
+
+    while (!worker->progress_thread.stop) {
+        if (ucp_worker_progress(worker) == 0) {
+            /* Let the application thread take the worker lock when there is
+             * nothing to progress */
+            sched_yield();
+        }
+    }
+
+    ucs_debug("worker %p: progress thread stopped", worker);
+    return NULL;
+}
+
+static void ucp_worker_progress_thread_bind(ucp_worker_h worker)
+{
+    size_t cpu = worker->context->config.ext.progress_thread_cpu;
+    ucs_sys_cpuset_t cpuset;
+    int ret;
+
+    if (cpu == UCS_ULUNITS_AUTO) {
+        return;
+    }
+
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    ret = pthread_setaffinity_np(worker->progress_thread.thread_id,
+                                 sizeof(cpuset), &cpuset);
+    if (ret != 0) {
+        ucs_warn("worker %p: failed to bind progress thread to cpu %zu: %s",
+                 worker, cpu, strerror(ret));
+    }
+}
+
+static ucs_status_t ucp_worker_progress_thread_start(ucp_worker_h worker)
+{
+    ucs_status_t status;
+
+    worker->progress_thread.stop   = 0;
+    worker->progress_thread.active = 0;
+
+    if (!worker->context->config.ext.progress_thread) {
+        return UCS_OK;
+    }
+
+    status = ucs_pthread_create(&worker->progress_thread.thread_id,
+                                ucp_worker_progress_thread_func, worker,
+                                "ucp_progress");
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    ucp_worker_progress_thread_bind(worker);
+    worker->progress_thread.active = 1;
+    return UCS_OK;
+}
+
+static void ucp_worker_progress_thread_stop(ucp_worker_h worker)
+{
+    if (!worker->progress_thread.active) {
+        return;
+    }
+
+    worker->progress_thread.stop = 1;
+    pthread_join(worker->progress_thread.thread_id, NULL);
+    worker->progress_thread.active = 0;
+}
+
 ucs_status_t ucp_worker_create(ucp_context_h context,
                                const ucp_worker_params_t *params,
                                ucp_worker_h *worker_p)
@@ -2605,6 +2749,7 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
     worker->context              = context;
     worker->uuid                 = ucs_generate_uuid((uintptr_t)worker);
     worker->flush_ops_count      = 0;
+    worker->flush_dirty_overflow = 0;
     worker->fence_seq            = 0;
     worker->inprogress           = 0;
     worker->num_active_ifaces    = 0;
@@ -2613,13 +2758,16 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
     worker->rkey_ptr_cb_id       = UCS_CALLBACKQ_ID_NULL;
     worker->num_all_eps          = 0;
     ucp_worker_keepalive_reset(worker);
+    worker->wait_adaptive.avg_idle = context->config.ext.wait_spin_max / 2;
     ucs_queue_head_init(&worker->rkey_ptr_reqs);
     ucs_list_head_init(&worker->arm_ifaces);
     ucs_list_head_init(&worker->stream_ready_eps);
     ucs_list_head_init(&worker->all_eps);
     ucs_list_head_init(&worker->internal_eps);
+    ucs_array_init_dynamic(&worker->flush_dirty_eps);
     kh_init_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
     kh_init_inplace(ucp_worker_discard_uct_ep_hash, &worker->discard_uct_ep_hash);
+    kh_init_inplace(ucp_worker_uct_ep_hash, &worker->uct_ep_hash);
     kh_init_inplace(ucp_worker_remote_flush, &worker->remote_flush_hash);
     worker->counters.ep_creations         = 0;
     worker->counters.ep_creation_failures = 0;
@@ -2659,6 +2807,20 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
         goto err_free;
     }
 
+    if (context->config.ext.progress_thread) {
+#if ENABLE_MT
+        /* The worker is shared between the progress thread and the user */
+        uct_thread_mode = UCS_THREAD_MODE_SERIALIZED;
+        worker->flags   = (worker->flags & ~UCP_WORKER_FLAG_THREAD_SERIALIZED) |
+                          UCP_WORKER_FLAG_THREAD_MULTI;
+#else
+        ucs_error("worker progress thread is requested, but library is built "
+                  "without multi-thread support");
+        status = UCS_ERR_UNSUPPORTED;
+        goto err_free;
+#endif
+    }
+
     /* Initialize endpoint allocator */
     ucs_strided_alloc_init(&worker->ep_alloc, sizeof(ucp_ep_t), 1);
 
@@ -2737,9 +2899,15 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
     }
 
     if (params->field_mask & UCP_WORKER_PARAM_FIELD_CPU_MASK) {
-        worker->cpu_mask = params->cpu_mask;
+        worker->cpu_mask  = params->cpu_mask;
+        worker->numa_node = ucs_numa_node_of_cpuset(&worker->cpu_mask);
     } else {
         UCS_CPU_ZERO(&worker->cpu_mask);
+        worker->numa_node = UCS_NUMA_NODE_UNDEFINED;
+    }
+
+    if (worker->numa_node == UCS_NUMA_NODE_UNDEFINED) {
+        worker->numa_node = ucs_numa_node_of_current_thread();
     }
 
     /* Initialize connection matching structure */
@@ -2804,9 +2972,36 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
         goto err_am_cleanup;
     }
 
+    status = ucp_rkey_cache_init(worker);
+    if (status != UCS_OK) {
+        goto err_usage_tracker_destroy;
+    }
+
+    ucp_wireup_lanes_cache_init(worker);
+    ucp_address_template_cache_init(worker);
+
+    status = ucp_op_trace_open(worker);
+    if (status != UCS_OK) {
+        goto err_caches_cleanup;
+    }
+
+    /* Start the progress thread last, when the worker is fully initialized */
+    status = ucp_worker_progress_thread_start(worker);
+    if (status != UCS_OK) {
+        goto err_op_trace_close;
+    }
+
     *worker_p = worker;
     return UCS_OK;
 
+err_op_trace_close:
+    ucp_op_trace_close(worker);
+err_caches_cleanup:
+    ucp_address_template_cache_cleanup(worker);
+    ucp_wireup_lanes_cache_cleanup(worker);
+    ucp_rkey_cache_cleanup(worker);
+err_usage_tracker_destroy:
+    ucp_worker_usage_tracker_destroy(worker);
 err_am_cleanup:
     ucp_am_cleanup(worker);
 err_tag_match_cleanup:
@@ -2838,8 +3033,10 @@ err_free:
     ucs_strided_alloc_cleanup(&worker->ep_alloc);
     kh_destroy_inplace(ucp_worker_discard_uct_ep_hash,
                        &worker->discard_uct_ep_hash);
+    kh_destroy_inplace(ucp_worker_uct_ep_hash, &worker->uct_ep_hash);
     kh_destroy_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
     kh_destroy_inplace(ucp_worker_remote_flush, &worker->remote_flush_hash);
+    ucs_array_cleanup_dynamic(&worker->flush_dirty_eps);
     ucp_worker_destroy_configs(worker);
     ucs_free(worker);
     return status;
@@ -3040,12 +3237,18 @@ void ucp_worker_destroy(ucp_worker_h worker)
         ucp_worker_trace_configs(worker);
     }
 
+    ucp_worker_progress_thread_stop(worker);
+    ucp_op_trace_close(worker);
+
     UCS_ASYNC_BLOCK(&worker->async);
     uct_worker_progress_unregister_safe(worker->uct, &worker->keepalive.cb_id);
     ucp_worker_usage_tracker_destroy(worker);
     ucp_worker_discard_uct_ep_cleanup(worker);
     ucp_worker_destroy_eps(worker, &worker->all_eps, "all");
     ucp_worker_destroy_eps(worker, &worker->internal_eps, "internal");
+    ucp_rkey_cache_cleanup(worker);
+    ucp_wireup_lanes_cache_cleanup(worker);
+    ucp_address_template_cache_cleanup(worker);
     ucp_am_cleanup(worker);
     /* Put ucp_worker_remove_am_handlers after ucp_worker_discard_uct_ep_cleanup
      * to make sure iface->am[] always cleared.
@@ -3092,12 +3295,34 @@ void ucp_worker_destroy(ucp_worker_h worker)
     ucs_strided_alloc_cleanup(&worker->ep_alloc);
     kh_destroy_inplace(ucp_worker_discard_uct_ep_hash,
                        &worker->discard_uct_ep_hash);
+    kh_destroy_inplace(ucp_worker_uct_ep_hash, &worker->uct_ep_hash);
     kh_destroy_inplace(ucp_worker_remote_flush, &worker->remote_flush_hash);
+    ucs_array_cleanup_dynamic(&worker->flush_dirty_eps);
     kh_destroy_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
     ucp_worker_destroy_configs(worker);
     ucs_free(worker);
 }
 
+static void ucp_worker_address_tl_bitmap(ucp_worker_h worker,
+                                         uint32_t address_flags,
+                                         ucp_tl_bitmap_t *tl_bitmap)
+{
+    ucp_rsc_index_t tl_id;
+    const uct_iface_attr_t *iface_attr;
+
+    if (address_flags & UCP_WORKER_ADDRESS_FLAG_NET_ONLY) {
+        UCS_STATIC_BITMAP_RESET_ALL(tl_bitmap);
+        UCS_STATIC_BITMAP_FOR_EACH_BIT(tl_id, &worker->context->tl_bitmap) {
+            iface_attr = ucp_worker_iface_get_attr(worker, tl_id);
+            if (iface_attr->cap.flags & UCT_IFACE_FLAG_INTER_NODE) {
+                UCS_STATIC_BITMAP_SET(tl_bitmap, tl_id);
+            }
+        }
+    } else {
+        UCS_STATIC_BITMAP_SET_ALL(tl_bitmap);
+    }
+}
+
 static ucs_status_t ucp_worker_address_pack(ucp_worker_h worker,
                                             uint32_t address_flags,
                                             size_t *address_length_p,
@@ -3106,8 +3331,6 @@ static ucs_status_t ucp_worker_address_pack(ucp_worker_h worker,
     ucp_context_h context = worker->context;
     unsigned flags        = ucp_worker_default_address_pack_flags(worker);
     ucp_tl_bitmap_t tl_bitmap;
-    ucp_rsc_index_t tl_id;
-    const uct_iface_attr_t *iface_attr;
 
     /* Make sure that UUID is packed to the address intended for the user,
      * because ucp_worker_address_query routine assumes that uuid is always
@@ -3115,16 +3338,10 @@ static ucs_status_t ucp_worker_address_pack(ucp_worker_h worker,
      */
     ucs_assert(flags & UCP_ADDRESS_PACK_FLAG_WORKER_UUID);
 
-    if (address_flags & UCP_WORKER_ADDRESS_FLAG_NET_ONLY) {
-        UCS_STATIC_BITMAP_RESET_ALL(&tl_bitmap);
-        UCS_STATIC_BITMAP_FOR_EACH_BIT(tl_id, &worker->context->tl_bitmap) {
-            iface_attr = ucp_worker_iface_get_attr(worker, tl_id);
-            if (iface_attr->cap.flags & UCT_IFACE_FLAG_INTER_NODE) {
-                UCS_STATIC_BITMAP_SET(&tl_bitmap, tl_id);
-            }
-        }
-    } else {
-        UCS_STATIC_BITMAP_SET_ALL(&tl_bitmap);
+    ucp_worker_address_tl_bitmap(worker, address_flags, &tl_bitmap);
+    if (address_flags & UCP_WORKER_ADDRESS_FLAG_COMPACT) {
+        return ucp_address_pack_compact(worker, &tl_bitmap, flags, NULL, NULL,
+                                        address_length_p, address_p);
     }
 
     return ucp_address_pack(worker, NULL, &tl_bitmap, flags,
@@ -3135,8 +3352,9 @@ static ucs_status_t ucp_worker_address_pack(ucp_worker_h worker,
 ucs_status_t ucp_worker_query(ucp_worker_h worker,
                               ucp_worker_attr_t *attr)
 {
-    ucs_status_t status = UCS_OK;
+    ucp_tl_bitmap_t tl_bitmap;
     uint32_t address_flags;
+    ucs_status_t status;
 
     if (attr->field_mask & UCP_WORKER_ATTR_FIELD_THREAD_MODE) {
         attr->thread_mode = ucp_worker_get_thread_mode(worker->flags);
@@ -3148,6 +3366,22 @@ ucs_status_t ucp_worker_query(ucp_worker_h worker,
         status        = ucp_worker_address_pack(worker, address_flags,
                                                 &attr->address_length,
                                                 (void**)&attr->address);
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+
+    if (attr->field_mask & UCP_WORKER_ATTR_FIELD_ADDRESS_TEMPLATE) {
+        address_flags = UCP_ATTR_VALUE(WORKER, attr, address_flags,
+                                       ADDRESS_FLAGS, 0);
+        ucp_worker_address_tl_bitmap(worker, address_flags, &tl_bitmap);
+        status        = ucp_address_pack_compact(
+                worker, &tl_bitmap, ucp_worker_default_address_pack_flags(worker),
+                &attr->address_template_length,
+                (void**)&attr->address_template, NULL, NULL);
+        if (status != UCS_OK) {
+            goto err_release_address;
+        }
     }
 
     if (attr->field_mask & UCP_WORKER_ATTR_FIELD_MAX_AM_HEADER) {
@@ -3162,6 +3396,12 @@ ucs_status_t ucp_worker_query(ucp_worker_h worker,
         attr->max_debug_string = UCP_WORKER_MAX_DEBUG_STRING_SIZE;
     }
 
+    return UCS_OK;
+
+err_release_address:
+    if (attr->field_mask & UCP_WORKER_ATTR_FIELD_ADDRESS) {
+        ucp_worker_release_address(worker, attr->address);
+    }
     return status;
 }
 
@@ -3405,6 +3645,90 @@ out:
     return status;
 }
 
+static ucs_time_t ucp_worker_wait_spin_limit(ucp_worker_h worker)
+{
+    ucs_time_t spin_max = worker->context->config.ext.wait_spin_max;
+    ucs_time_t avg_idle = worker->wait_adaptive.avg_idle;
+
+    /* Polling is wasted if the next event is not expected within the limit */
+    if (avg_idle > spin_max) {
+        return 0;
+    }
+
+    return ucs_min(avg_idle * 2, spin_max);
+}
+
+static void ucp_worker_wait_update_idle(ucp_worker_h worker, ucs_time_t idle)
+{
+    ucs_time_t spin_max = worker->context->config.ext.wait_spin_max;
+
+    /* Clamp long idle periods, so that the polling resumes shortly after the
+     * events start arriving again */
+    idle                           = ucs_min(idle, spin_max * 2);
+    worker->wait_adaptive.avg_idle = ((worker->wait_adaptive.avg_idle * 3) +
+                                      idle) / 4;
+}
+
+ucs_status_t
+ucp_worker_wait_adaptive(ucp_worker_h worker, ucp_worker_wait_attr_t *attr)
+{
+    ucs_time_t start_time, spin_end_time, end_time, spin_limit;
+    ucs_status_t status;
+
+    ucs_trace_func("worker %p", worker);
+
+    UCP_CONTEXT_CHECK_FEATURE_FLAGS(worker->context, UCP_FEATURE_WAKEUP,
+                                    return UCS_ERR_INVALID_PARAM);
+
+    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
+    spin_limit = ucp_worker_wait_spin_limit(worker);
+    UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
+
+    /* Progress the worker at least once, to drain existing events before
+     * blocking */
+    start_time = ucs_get_time();
+    do {
+        if (ucp_worker_progress(worker) != 0) {
+            spin_end_time = end_time = ucs_get_time();
+            status        = UCS_OK;
+            goto out;
+        }
+
+        spin_end_time = ucs_get_time();
+    } while ((spin_end_time - start_time) < spin_limit);
+
+    status   = ucp_worker_wait(worker);
+    end_time = ucs_get_time();
+    if (status != UCS_OK) {
+        goto out;
+    }
+
+    ucp_worker_progress(worker);
+
+out:
+    if (status == UCS_OK) {
+        UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
+        ucp_worker_wait_update_idle(worker, end_time - start_time);
+        UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
+    }
+
+    if (attr != NULL) {
+        if (attr->field_mask & UCP_WORKER_WAIT_ATTR_FIELD_SPIN_TIME) {
+            attr->spin_time = ucs_time_to_sec(spin_end_time - start_time);
+        }
+
+        if (attr->field_mask & UCP_WORKER_WAIT_ATTR_FIELD_BLOCK_TIME) {
+            attr->block_time = ucs_time_to_sec(end_time - spin_end_time);
+        }
+
+        if (attr->field_mask & UCP_WORKER_WAIT_ATTR_FIELD_SPIN_LIMIT) {
+            attr->spin_limit = ucs_time_to_sec(spin_limit);
+        }
+    }
+
+    return status;
+}
+
 ucs_status_t ucp_worker_signal(ucp_worker_h worker)
 {
     ucs_trace_func("worker %p", worker);
@@ -12,6 +12,7 @@
 #include "ucp_context.h"
 #include "ucp_thread.h"
 #include "ucp_rkey.h"
+#include "ucp_op_trace.h"
 
 #include <ucp/core/ucp_am.h>
 #include <ucp/tag/tag_match.h>
@@ -22,6 +23,7 @@
 #include <ucs/datastruct/conn_match.h>
 #include <ucs/datastruct/ptr_map.h>
 #include <ucs/datastruct/usage_tracker.h>
+#include <ucs/datastruct/lru.h>
 #include <ucs/arch/bitops.h>
 
 #include <ucs/datastruct/array.h>
@@ -213,11 +215,33 @@ KHASH_TYPE(ucp_worker_rkey_config, ucp_rkey_config_key_t, ucp_worker_cfg_index_t
 typedef khash_t(ucp_worker_rkey_config) ucp_worker_rkey_config_hash_t;
 
 
+/* Hash map to find a cached unpacked rkey by the digest of its packed buffer */
+KHASH_TYPE(ucp_worker_rkey_cache, uint64_t, ucp_rkey_cache_entry_t*);
+typedef khash_t(ucp_worker_rkey_cache) ucp_worker_rkey_cache_hash_t;
+
+
+/* Hash map to find cached lane selection by the digest of a remote address
+ * shape */
+typedef struct ucp_wireup_lanes_cache_entry ucp_wireup_lanes_cache_entry_t;
+KHASH_TYPE(ucp_worker_lanes_cache, uint64_t, ucp_wireup_lanes_cache_entry_t*);
+typedef khash_t(ucp_worker_lanes_cache) ucp_worker_lanes_cache_hash_t;
+
+
+/* Hash map to find a decoded address template by its digest */
+KHASH_TYPE(ucp_worker_addr_template, uint64_t, ucp_address_template_t*);
+typedef khash_t(ucp_worker_addr_template) ucp_worker_addr_template_hash_t;
+
+
 /* Hash map of UCT EPs that are being discarded on UCP Worker */
 KHASH_TYPE(ucp_worker_discard_uct_ep_hash, uct_ep_h, ucp_request_t*);
 typedef khash_t(ucp_worker_discard_uct_ep_hash) ucp_worker_discard_uct_ep_hash_t;
 
 
+/* Hash map to find the UCP EP which uses a UCT EP as one of its lanes */
+KHASH_TYPE(ucp_worker_uct_ep_hash, uct_ep_h, ucp_ep_h);
+typedef khash_t(ucp_worker_uct_ep_hash) ucp_worker_uct_ep_hash_t;
+
+
 typedef struct ucp_worker_mpool_key {
     ucs_memory_type_t mem_type;  /* memory type of the buffer pool */
     ucs_sys_device_t  sys_dev;   /* identifier for the device,
@@ -295,6 +319,9 @@ UCS_PTR_MAP_TYPE(request, 0);
 /* rkey configuration storage */
 UCS_ARRAY_DECLARE_TYPE(ucp_rkey_config_arr_t, unsigned, ucp_rkey_config_t);
 
+/* Array of endpoints */
+UCS_ARRAY_DECLARE_TYPE(ucp_ep_ptr_arr_t, unsigned, ucp_ep_h);
+
 
 /**
  * UCP worker (thread context).
@@ -317,6 +344,10 @@ typedef struct ucp_worker {
     char                             address_name[UCP_WORKER_ADDRESS_NAME_MAX];
 
     unsigned                         flush_ops_count;     /* Number of pending operations */
+    ucp_ep_ptr_arr_t                 flush_dirty_eps;     /* Endpoints which issued RMA/AMO
+                                                             operations since last flush */
+    int                              flush_dirty_overflow; /* Failed to track an endpoint,
+                                                              next flush goes over all */
     uint64_t                         fence_seq;           /* Sequence number of
                                                              the last fence */
 
@@ -360,9 +391,23 @@ typedef struct ucp_worker {
 
     ucs_cpu_set_t                    cpu_mask;            /* Save CPU mask for subsequent calls to
                                                              ucp_worker_listen */
+    ucs_numa_node_t                  numa_node;           /* NUMA node to place worker
+                                                             memory pools on */
 
     ucp_worker_rkey_config_hash_t    rkey_config_hash;    /* RKEY config key -> index */
+    struct {
+        ucs_lru_h                    lru;                 /* Recently used digests,
+                                                             NULL if disabled */
+        ucp_worker_rkey_cache_hash_t hash;                /* Digest -> cache entry */
+    } rkey_cache;
+    ucp_worker_lanes_cache_hash_t    lanes_cache;         /* Remote address shape
+                                                             digest -> selected
+                                                             lanes */
+    ucp_worker_addr_template_hash_t  addr_templates;      /* Template digest ->
+                                                             decoded address
+                                                             template */
     ucp_worker_discard_uct_ep_hash_t discard_uct_ep_hash; /* Hash of discarded UCT EPs */
+    ucp_worker_uct_ep_hash_t         uct_ep_hash;         /* Lane UCT EP -> UCP EP */
     UCS_PTR_MAP_T(ep)                ep_map;              /* UCP ep key to ptr
                                                              mapping */
     UCS_PTR_MAP_T(request)           request_map;         /* UCP requests key to
@@ -385,6 +430,21 @@ typedef struct ucp_worker {
         size_t                       round_count;         /* Number of rounds done */
     } keepalive;
 
+    struct {
+        ucs_time_t                   avg_idle;            /* Moving average of time
+                                                           * waiting for events */
+    } wait_adaptive;
+
+    struct {
+        pthread_t                    thread_id;           /* Progress thread */
+        volatile int                 stop;                /* Set to stop the thread */
+        int                          active;              /* Whether the thread is running */
+    } progress_thread;
+
+    ucp_op_trace_t                   *op_trace;           /* Issued operations
+                                                             trace, NULL if
+                                                             disabled */
+
     struct {
         /* Number of requests to create endpoint */
         uint64_t                     ep_creations;
@@ -453,6 +513,12 @@ void ucp_worker_keepalive_remove_ep(ucp_ep_h ep);
 /* must be called with async lock held */
 int ucp_worker_is_uct_ep_discarding(ucp_worker_h worker, uct_ep_h uct_ep);
 
+void ucp_worker_uct_ep_hash_add(ucp_worker_h worker, ucp_ep_h ucp_ep,
+                                uct_ep_h uct_ep);
+
+void ucp_worker_uct_ep_hash_remove(ucp_worker_h worker, ucp_ep_h ucp_ep,
+                                   uct_ep_h uct_ep);
+
 /* must be called with async lock held */
 ucs_status_t ucp_worker_discard_uct_ep(ucp_ep_h ucp_ep, uct_ep_h uct_ep,
                                        ucp_rsc_index_t rsc_index,
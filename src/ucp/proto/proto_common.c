@@ -739,6 +739,8 @@ void ucp_proto_request_zcopy_completion(uct_completion_t *self)
     ucp_request_t *req = ucs_container_of(self, ucp_request_t,
                                           send.state.uct_comp);
 
+    UCS_PROFILE_REQUEST_EVENT(req, "uct_completion", self->status);
+
     /* request should NOT be on pending queue because when we decrement the last
      * refcount the request is not on the pending queue any more
      */
@@ -208,6 +208,14 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_atomic_op_nbx,
                   param->datatype, remote_addr, rkey, ucp_ep_peer_name(ep),
                   ucp_request_param_send_callback(param));
 
+    status = ucp_ep_lazy_connect_check(ep);
+    if (ucs_unlikely(status != UCS_OK)) {
+        status_p = UCS_STATUS_PTR(status);
+        goto out;
+    }
+
+    ucp_ep_rma_mark_dirty(ep);
+
     req = ucp_request_get_param(worker, param,
                                 {status_p = UCS_STATUS_PTR(UCS_ERR_NO_MEMORY);
                                  goto out;});
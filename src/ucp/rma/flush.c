@@ -493,6 +493,11 @@ ucs_status_ptr_t ucp_ep_flush_internal(ucp_ep_h ep, unsigned req_flags,
 
     ucs_debug("%s ep %p", debug_name, ep);
 
+    if (ep->flags & UCP_EP_FLAG_LAZY_CONNECT) {
+        /* Nothing could be sent on an endpoint which is not connected yet */
+        return UCS_STATUS_PTR(UCS_OK);
+    }
+
     req = ucp_request_get_param(ep->worker, param,
                                 {return UCS_STATUS_PTR(UCS_ERR_NO_MEMORY);});
 
@@ -552,13 +557,21 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_ep_flush_nb, (ep, flags, cb),
 UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_ep_flush_nbx, (ep, param),
                  ucp_ep_h ep, const ucp_request_param_t *param)
 {
+    ucs_status_t status;
     void *request;
 
     UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(ep->worker);
 
+    status = ucp_ep_lazy_connect_check(ep);
+    if (ucs_unlikely(status != UCS_OK)) {
+        request = UCS_STATUS_PTR(status);
+        goto out;
+    }
+
     request = ucp_ep_flush_internal(ep, 0, param, NULL, ucp_ep_flushed_callback,
                                     "flush_nbx", UCT_FLUSH_FLAG_LOCAL);
 
+out:
     UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(ep->worker);
 
     return request;
@@ -591,6 +604,69 @@ static ucs_status_t ucp_worker_flush_check(ucp_worker_h worker)
     return UCS_OK;
 }
 
+void ucp_worker_flush_dirty_ep_add(ucp_ep_h ep)
+{
+    ucp_worker_h worker = ep->worker;
+    ucp_ep_h *ep_p;
+
+    ucs_assert(ep->ext->flush_dirty_idx == UCP_EP_FLUSH_DIRTY_IDX_NONE);
+
+    if (worker->flush_dirty_overflow) {
+        /* Next worker flush goes over all endpoints anyway */
+        return;
+    }
+
+    ep_p = ucs_array_append(&worker->flush_dirty_eps,
+                            {
+                                ucs_diag("worker %p: failed to track ep %p "
+                                         "for flush", worker, ep);
+                                worker->flush_dirty_overflow = 1;
+                                return;
+                            });
+
+    *ep_p                    = ep;
+    ep->ext->flush_dirty_idx = ucs_array_length(&worker->flush_dirty_eps) - 1;
+}
+
+void ucp_worker_flush_dirty_ep_remove(ucp_ep_h ep)
+{
+    ucp_worker_h worker = ep->worker;
+    uint32_t idx        = ep->ext->flush_dirty_idx;
+    ucp_ep_h last_ep;
+
+    if (idx >= UCP_EP_FLUSH_DIRTY_IDX_UNTRACKED) {
+        return;
+    }
+
+    /* Move the last element to the vacated slot */
+    ucs_assert(ucs_array_elem(&worker->flush_dirty_eps, idx) == ep);
+    last_ep = *ucs_array_last(&worker->flush_dirty_eps);
+    ucs_array_elem(&worker->flush_dirty_eps, idx) = last_ep;
+    last_ep->ext->flush_dirty_idx                 = idx;
+    ucs_array_pop_back(&worker->flush_dirty_eps);
+
+    ep->ext->flush_dirty_idx = UCP_EP_FLUSH_DIRTY_IDX_NONE;
+}
+
+static void ucp_worker_flush_dirty_eps_reset(ucp_worker_h worker)
+{
+    ucp_ep_h *ep_p;
+
+    ucs_array_for_each(ep_p, &worker->flush_dirty_eps) {
+        (*ep_p)->ext->flush_dirty_idx = UCP_EP_FLUSH_DIRTY_IDX_NONE;
+    }
+
+    ucs_array_clear(&worker->flush_dirty_eps);
+    worker->flush_dirty_overflow = 0;
+}
+
+static UCS_F_ALWAYS_INLINE int
+ucp_worker_flush_eps_enabled(ucp_worker_h worker, unsigned uct_flags)
+{
+    return worker->context->config.ext.flush_worker_eps ||
+           (uct_flags & UCT_FLUSH_FLAG_REMOTE);
+}
+
 static UCS_F_ALWAYS_INLINE ucp_ep_h
 ucp_worker_flush_req_set_next_ep(ucp_request_t *req, int is_current_ep_valid,
                                  ucs_list_link_t *next_ep_iter)
@@ -619,6 +695,59 @@ ucp_worker_flush_req_set_next_ep(ucp_request_t *req, int is_current_ep_valid,
     return ucp_ep_refcount_remove(current_ep, flush) ? NULL : current_ep;
 }
 
+static UCS_F_ALWAYS_INLINE int
+ucp_worker_flush_req_has_next_ep(ucp_request_t *req)
+{
+    return (req->flush_worker.dirty_ep_idx < req->flush_worker.num_dirty_eps) ||
+           (&req->flush_worker.next_ep_ext->ep_list !=
+            &req->flush_worker.worker->all_eps);
+}
+
+static ucp_ep_h ucp_worker_flush_req_get_next_ep(ucp_request_t *req)
+{
+    ucp_ep_h ep;
+
+    if (req->flush_worker.dirty_ep_idx == req->flush_worker.num_dirty_eps) {
+        return ucp_worker_flush_req_set_next_ep(
+                req, 1, req->flush_worker.next_ep_ext->ep_list.next);
+    }
+
+    ep = req->flush_worker.dirty_eps[req->flush_worker.dirty_ep_idx++];
+    return ucp_ep_refcount_remove(ep, flush) ? NULL : ep;
+}
+
+/*
+ * Take the endpoints which issued RMA/AMO operations since the previous worker
+ * flush, instead of going over all endpoints of the worker.
+ */
+static void ucp_worker_flush_req_take_dirty_eps(ucp_request_t *req)
+{
+    ucp_worker_h worker = req->flush_worker.worker;
+    ucp_ep_h *ep_p;
+
+    ucs_array_for_each(ep_p, &worker->flush_dirty_eps) {
+        (*ep_p)->ext->flush_dirty_idx = UCP_EP_FLUSH_DIRTY_IDX_NONE;
+        ucp_ep_refcount_add(*ep_p, flush);
+    }
+
+    req->flush_worker.num_dirty_eps = ucs_array_length(&worker->flush_dirty_eps);
+    req->flush_worker.dirty_eps     =
+            ucs_array_extract_buffer(&worker->flush_dirty_eps);
+}
+
+static void ucp_worker_flush_req_release_dirty_eps(ucp_request_t *req)
+{
+    ucp_ep_h ep;
+
+    while (req->flush_worker.dirty_ep_idx < req->flush_worker.num_dirty_eps) {
+        ep = req->flush_worker.dirty_eps[req->flush_worker.dirty_ep_idx++];
+        ucp_ep_refcount_remove(ep, flush);
+    }
+
+    ucs_array_buffer_free(req->flush_worker.dirty_eps);
+    req->flush_worker.dirty_eps = NULL;
+}
+
 static void ucp_worker_flush_complete_one(ucp_request_t *req, ucs_status_t status,
                                           int force_progress_unreg)
 {
@@ -641,6 +770,8 @@ static void ucp_worker_flush_complete_one(ucp_request_t *req, ucs_status_t statu
             ucp_worker_flush_req_set_next_ep(req, 1, &worker->all_eps);
         }
 
+        ucp_worker_flush_req_release_dirty_eps(req);
+
         /* Coverity wrongly resolves completion callback function to
          * 'ucp_cm_server_conn_request_progress' */
         /* coverity[offset_free] */
@@ -656,9 +787,8 @@ static void ucp_worker_flush_ep_flushed_cb(ucp_request_t *req)
 
 static unsigned ucp_worker_flush_progress(void *arg)
 {
-    ucp_request_t *req        = arg;
-    ucp_worker_h worker       = req->flush_worker.worker;
-    ucp_ep_ext_t *next_ep_ext = req->flush_worker.next_ep_ext;
+    ucp_request_t *req  = arg;
+    ucp_worker_h worker = req->flush_worker.worker;
     void *ep_flush_request;
     ucs_status_t status;
     ucp_ep_h ep;
@@ -666,7 +796,7 @@ static unsigned ucp_worker_flush_progress(void *arg)
     if (worker->flush_ops_count == 0) {
         /* all scheduled progress operations on worker were completed */
         status = ucp_worker_flush_check(worker);
-        if ((status == UCS_OK) || (&next_ep_ext->ep_list == &worker->all_eps)) {
+        if ((status == UCS_OK) || !ucp_worker_flush_req_has_next_ep(req)) {
             /* If all ifaces are flushed, or we finished going over all
              * endpoints, no need to progress this request actively anymore
              * and we complete the flush operation with UCS_OK status. */
@@ -681,12 +811,11 @@ static unsigned ucp_worker_flush_progress(void *arg)
         }
     }
 
-    if ((worker->context->config.ext.flush_worker_eps ||
-         (req->flush_worker.uct_flags & UCT_FLUSH_FLAG_REMOTE)) &&
-        (&next_ep_ext->ep_list != &worker->all_eps)) {
-        /* Some endpoints are not flushed yet. Take the endpoint from the list
-         * and start flush operation on it. */
-        ep = ucp_worker_flush_req_set_next_ep(req, 1, next_ep_ext->ep_list.next);
+    if (ucp_worker_flush_eps_enabled(worker, req->flush_worker.uct_flags) &&
+        ucp_worker_flush_req_has_next_ep(req)) {
+        /* Some endpoints are not flushed yet. Take the next endpoint and start
+         * flush operation on it. */
+        ep = ucp_worker_flush_req_get_next_ep(req);
         if (ep == NULL) {
             goto out;
         }
@@ -723,6 +852,9 @@ ucp_worker_flush_nbx_internal(ucp_worker_h worker,
         status = ucp_worker_flush_check(worker);
         if ((status != UCS_INPROGRESS) && (status != UCS_ERR_NO_RESOURCE)) {
             /* UCS_OK is returned here as well */
+            if (status == UCS_OK) {
+                ucp_worker_flush_dirty_eps_reset(worker);
+            }
             return UCS_STATUS_PTR(status);
         }
     }
@@ -730,15 +862,31 @@ ucp_worker_flush_nbx_internal(ucp_worker_h worker,
     req = ucp_request_get_param(worker, param,
                                 {return UCS_STATUS_PTR(UCS_ERR_NO_MEMORY);});
 
-    req->flags                   = 0;
-    req->status                  = UCS_OK;
-    req->flush_worker.worker     = worker;
-    req->flush_worker.comp_count = 1; /* counting starts from 1, and decremented
-                                         when finished going over all endpoints */
-    req->flush_worker.uct_flags  = uct_flags;
-    req->flush_worker.prog_id    = UCS_CALLBACKQ_ID_NULL;
+    req->flags                      = 0;
+    req->status                     = UCS_OK;
+    req->flush_worker.worker        = worker;
+    req->flush_worker.comp_count    = 1; /* counting starts from 1, and
+                                            decremented when finished going
+                                            over all endpoints */
+    req->flush_worker.uct_flags     = uct_flags;
+    req->flush_worker.prog_id       = UCS_CALLBACKQ_ID_NULL;
+    req->flush_worker.dirty_eps     = NULL;
+    req->flush_worker.num_dirty_eps = 0;
+    req->flush_worker.dirty_ep_idx  = 0;
+
+    if (ucp_worker_flush_eps_enabled(worker, uct_flags) &&
+        worker->context->config.ext.flush_worker_dirty_eps &&
+        !worker->flush_dirty_overflow) {
+        ucp_worker_flush_req_take_dirty_eps(req);
+        ucp_worker_flush_req_set_next_ep(req, 0, &worker->all_eps);
+    } else {
+        if (ucp_worker_flush_eps_enabled(worker, uct_flags)) {
+            /* Going over all endpoints covers the tracked ones as well */
+            ucp_worker_flush_dirty_eps_reset(worker);
+        }
+        ucp_worker_flush_req_set_next_ep(req, 0, worker->all_eps.next);
+    }
 
-    ucp_worker_flush_req_set_next_ep(req, 0, worker->all_eps.next);
     ucp_request_set_send_callback_param(param, req, flush_worker);
     uct_worker_progress_register_safe(worker->uct, ucp_worker_flush_progress,
                                       req, 0, &req->flush_worker.prog_id);
@@ -799,10 +947,13 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_ep_flush, (ep), ucp_ep_h ep)
 
     UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(ep->worker);
 
-    request = ucp_ep_flush_internal(ep, 0, &ucp_request_null_param, NULL,
-                                    ucp_ep_flushed_callback, "flush",
-                                    UCT_FLUSH_FLAG_LOCAL);
-    status = ucp_flush_wait(ep->worker, request);
+    status = ucp_ep_lazy_connect_check(ep);
+    if (ucs_likely(status == UCS_OK)) {
+        request = ucp_ep_flush_internal(ep, 0, &ucp_request_null_param, NULL,
+                                        ucp_ep_flushed_callback, "flush",
+                                        UCT_FLUSH_FLAG_LOCAL);
+        status  = ucp_flush_wait(ep->worker, request);
+    }
 
     UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(ep->worker);
     return status;
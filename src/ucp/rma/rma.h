@@ -94,4 +94,8 @@ ucs_status_t ucp_ep_fence_weak(ucp_ep_h ep);
 
 ucs_status_t ucp_ep_fence_strong(ucp_ep_h ep);
 
+void ucp_worker_flush_dirty_ep_add(ucp_ep_h ep);
+
+void ucp_worker_flush_dirty_ep_remove(ucp_ep_h ep);
+
 #endif
@@ -56,6 +56,17 @@ ucp_rma_send_request(ucp_request_t *req, const ucp_request_param_t *param)
     return req + 1;
 }
 
+/*
+ * Add the endpoint to the set of endpoints flushed by the next worker flush.
+ */
+static UCS_F_ALWAYS_INLINE void ucp_ep_rma_mark_dirty(ucp_ep_h ep)
+{
+    if (ucs_unlikely(ep->ext->flush_dirty_idx ==
+                     UCP_EP_FLUSH_DIRTY_IDX_NONE)) {
+        ucp_worker_flush_dirty_ep_add(ep);
+    }
+}
+
 static inline ucs_status_t ucp_rma_wait(ucp_worker_h worker, void *user_req,
                                         const char *op_name)
 {
@@ -130,6 +130,16 @@ ucs_status_ptr_t ucp_put_nbx(ucp_ep_h ep, const void *buffer, size_t count,
                   " rkey %p to %s cb %p",
                   buffer, count, remote_addr, rkey, ucp_ep_peer_name(ep),
                   ucp_request_param_send_callback(param));
+    UCP_OP_TRACE(worker, UCP_OP_TRACE_PUT, ep, buffer, count, param,
+                 remote_addr);
+
+    status = ucp_ep_lazy_connect_check(ep);
+    if (ucs_unlikely(status != UCS_OK)) {
+        ret = UCS_STATUS_PTR(status);
+        goto out_unlock;
+    }
+
+    ucp_ep_rma_mark_dirty(ep);
 
     if (ucs_unlikely(!worker->context->config.ext.proto_enable)) {
         ret = UCS_STATUS_PTR(UCS_ERR_UNSUPPORTED);
@@ -202,6 +212,7 @@ ucs_status_ptr_t ucp_get_nbx(ucp_ep_h ep, void *buffer, size_t count,
     ucp_worker_h worker  = ep->worker;
     size_t contig_length = 0;
     ucs_status_ptr_t ret;
+    ucs_status_t status;
     ucp_request_t *req;
     uintptr_t datatype;
 
@@ -213,6 +224,16 @@ ucs_status_ptr_t ucp_get_nbx(ucp_ep_h ep, void *buffer, size_t count,
                   " rkey %p from %s cb %p",
                   buffer, count, remote_addr, rkey, ucp_ep_peer_name(ep),
                   ucp_request_param_send_callback(param));
+    UCP_OP_TRACE(worker, UCP_OP_TRACE_GET, ep, buffer, count, param,
+                 remote_addr);
+
+    status = ucp_ep_lazy_connect_check(ep);
+    if (ucs_unlikely(status != UCS_OK)) {
+        ret = UCS_STATUS_PTR(status);
+        goto out_unlock;
+    }
+
+    ucp_ep_rma_mark_dirty(ep);
 
     if (ucs_unlikely(!worker->context->config.ext.proto_enable)) {
         ret = UCS_STATUS_PTR(UCS_ERR_UNSUPPORTED);
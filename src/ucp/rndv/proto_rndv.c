@@ -821,6 +821,8 @@ UCS_PROFILE_FUNC_VOID(ucp_proto_rndv_receive_start,
         return;
     }, "RTS on non-existing endpoint");
 
+    UCS_PROFILE_REQUEST_EVENT(recv_req, "rndv_rts_recv", rts->size);
+
     req = ucp_request_get(worker);
     if (req == NULL) {
         ucs_error("failed to allocate rendezvous reply");
@@ -928,6 +930,7 @@ ucp_proto_rndv_handle_rtr(void *arg, void *data, size_t length, unsigned flags)
 
     ucp_trace_req(req, "recv RTR offset %zu length %zu/%zu req %p", rtr->offset,
                   rtr->size, req->send.state.dt_iter.length, req);
+    UCS_PROFILE_REQUEST_EVENT(req, "rndv_rtr_recv", rtr->size);
 
     if (req->flags & UCP_REQUEST_FLAG_OFFLOADED) {
         ucp_tag_offload_cancel_rndv(req);
@@ -146,6 +146,12 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_stream_send_nbx,
                   count, ucp_ep_peer_name(ep),
                   ucp_request_param_send_callback(param));
 
+    status = ucp_ep_lazy_connect_check(ep);
+    if (ucs_unlikely(status != UCS_OK)) {
+        ret = UCS_STATUS_PTR(status);
+        goto out;
+    }
+
     status = ucp_ep_resolve_remote_id(ep, ep->am_lane);
     if (status != UCS_OK) {
         ret = UCS_STATUS_PTR(status);
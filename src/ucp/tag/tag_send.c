@@ -153,22 +153,57 @@ ucp_tag_send_inline(ucp_ep_h ep, const void *buffer, size_t length,
 {
     ucs_status_t status;
 
-    if (ucp_proto_is_inline(ep, &ucp_ep_config(ep)->tag.max_eager_short,
-                            length, param)) {
-        UCS_STATIC_ASSERT(sizeof(ucp_tag_t) == sizeof(ucp_eager_hdr_t));
-        UCS_STATIC_ASSERT(sizeof(ucp_tag_t) == sizeof(uint64_t));
-        status = uct_ep_am_short(ucp_ep_get_am_uct_ep(ep), UCP_AM_ID_EAGER_ONLY,
-                                 tag, buffer, length);
-    } else if (ucp_proto_is_inline(ep,
-                                   &ucp_ep_config(ep)->tag.offload.max_eager_short,
-                                   length, param)) {
-        UCS_STATIC_ASSERT(sizeof(ucp_tag_t) == sizeof(uct_tag_t));
-        status = uct_ep_tag_eager_short(ucp_ep_get_tag_uct_ep(ep), tag, buffer,
-                                        length);
+    /* Short send on the AM lane was already tried by
+     * ucp_tag_send_contig_short() */
+    if (!ucp_proto_is_inline(ep,
+                             &ucp_ep_config(ep)->tag.offload.max_eager_short,
+                             length, param)) {
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    UCS_STATIC_ASSERT(sizeof(ucp_tag_t) == sizeof(uct_tag_t));
+    status = uct_ep_tag_eager_short(ucp_ep_get_tag_uct_ep(ep), tag, buffer,
+                                    length);
+    if (status != UCS_ERR_NO_RESOURCE) {
+        UCP_EP_STAT_TAG_OP(ep, EAGER);
+    }
+
+    return status;
+}
+
+/*
+ * Specialized path for the most common send: a contiguous host memory message
+ * which fits the short eager threshold of the AM lane. It decodes only the
+ * request parameters which can affect this case and calls uct_ep_am_short()
+ * directly. Returns UCS_ERR_NO_RESOURCE if the generic path must be taken.
+ */
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_tag_send_contig_short(ucp_ep_h ep, const void *buffer, size_t count,
+                          ucp_tag_t tag, const ucp_request_param_t *param)
+{
+    uint32_t attr_mask = param->op_attr_mask;
+    size_t length;
+    ucs_status_t status;
+
+    if (ucs_likely(!(attr_mask & UCP_OP_ATTR_FIELD_DATATYPE))) {
+        length = count;
+    } else if (ucs_likely(UCP_DT_IS_CONTIG(param->datatype))) {
+        length = ucp_contig_dt_length(param->datatype, count);
     } else {
         return UCS_ERR_NO_RESOURCE;
     }
 
+    if (ucs_unlikely((attr_mask & UCP_OP_ATTR_FLAG_NO_IMM_CMPL) ||
+                     !ucp_proto_is_inline(ep,
+                                          &ucp_ep_config(ep)->tag.max_eager_short,
+                                          length, param))) {
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    UCS_STATIC_ASSERT(sizeof(ucp_tag_t) == sizeof(ucp_eager_hdr_t));
+    UCS_STATIC_ASSERT(sizeof(ucp_tag_t) == sizeof(uint64_t));
+    status = uct_ep_am_short(ucp_ep_get_am_uct_ep(ep), UCP_AM_ID_EAGER_ONLY,
+                             tag, buffer, length);
     if (status != UCS_ERR_NO_RESOURCE) {
         UCP_EP_STAT_TAG_OP(ep, EAGER);
     }
@@ -249,6 +284,17 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_tag_send_nbx,
 
     ucs_trace_req("send_nbx buffer %p count %zu tag %"PRIx64" to %s",
                   buffer, count, tag, ucp_ep_peer_name(ep));
+    UCP_OP_TRACE(ep->worker, UCP_OP_TRACE_TAG_SEND, ep, buffer, count, param,
+                 tag);
+
+    status = ucp_ep_lazy_connect_check(ep);
+    if (ucs_unlikely(status != UCS_OK)) {
+        ret = UCS_STATUS_PTR(status);
+        goto out;
+    }
+
+    status = ucp_tag_send_contig_short(ep, buffer, count, tag, param);
+    ucp_request_send_check_status(status, ret, goto out);
 
     attr_mask = param->op_attr_mask &
                 (UCP_OP_ATTR_FIELD_DATATYPE | UCP_OP_ATTR_FLAG_NO_IMM_CMPL);
@@ -327,6 +373,14 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_tag_send_sync_nbx,
 
     ucs_trace_req("send_sync_nbx buffer %p count %zu tag %"PRIx64" to %s",
                   buffer, count, tag, ucp_ep_peer_name(ep));
+    UCP_OP_TRACE(worker, UCP_OP_TRACE_TAG_SEND_SYNC, ep, buffer, count, param,
+                 tag);
+
+    status = ucp_ep_lazy_connect_check(ep);
+    if (ucs_unlikely(status != UCS_OK)) {
+        ret = UCS_STATUS_PTR(status);
+        goto out;
+    }
 
     status = ucp_ep_resolve_remote_id(ep, ucp_ep_config(ep)->tag.lane);
     if (status != UCS_OK) {
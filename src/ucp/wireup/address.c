@@ -13,6 +13,7 @@
 
 #include <ucp/core/ucp_worker.h>
 #include <ucp/core/ucp_ep.inl>
+#include <ucs/algorithm/crc.h>
 #include <ucs/arch/bitops.h>
 #include <ucs/datastruct/array.h>
 #include <ucs/debug/log.h>
@@ -111,6 +112,21 @@
  */
 
 
+/* Compact address format:
+ *
+ * [ header(16bit) | uuid(64bit) | client_id | worker_name(string) ]
+ * [ template_digest(64bit) ]
+ * [ device and interface addresses, in the order of the template entries ]
+ *
+ *   * The header is the same as in address version 2, with the TEMPLATE flag.
+ *   * The template is a version 2 address packed without uuid, client id,
+ *     worker name and endpoint addresses, in which all device and interface
+ *     addresses are zeroed. It is identical for all workers with the same
+ *     resources, so it can be exchanged once per job.
+ *   * A device address shared by several template entries appears once.
+ */
+
+
 typedef struct {
     size_t           dev_addr_len;
     ucp_tl_bitmap_t  tl_bitmap;
@@ -225,9 +241,36 @@ enum {
     UCP_ADDRESS_HEADER_FLAG_DEBUG_INFO  = UCS_BIT(0),  /* Address has debug info */
     UCP_ADDRESS_HEADER_FLAG_WORKER_UUID = UCS_BIT(1),  /* Worker unique id */
     UCP_ADDRESS_HEADER_FLAG_CLIENT_ID   = UCS_BIT(2),  /* Worker client id */
-    UCP_ADDRESS_HEADER_FLAG_AM_ONLY     = UCS_BIT(3)   /* Only AM lane info */
+    UCP_ADDRESS_HEADER_FLAG_AM_ONLY     = UCS_BIT(3),  /* Only AM lane info */
+    UCP_ADDRESS_HEADER_FLAG_TEMPLATE    = UCS_BIT(4)   /* Compact address which
+                                                          refers to a template */
+};
+
+
+/* Offsets of the per-worker addresses of an address template entry inside the
+ * payload of a compact address */
+typedef struct {
+    size_t                 dev_addr;
+    size_t                 iface_addr;
+} ucp_address_template_offset_t;
+
+
+/* Decoded address template */
+struct ucp_address_template {
+    uint64_t                      digest;         /* Digest of packed template */
+    size_t                        length;         /* Packed template length */
+    size_t                        payload_length; /* Length of the per-worker
+                                                     addresses */
+    ucp_unpacked_address_t        unpacked;       /* Decoded template, with
+                                                     zeroed addresses */
+    ucp_address_template_offset_t *offsets;       /* Per-entry payload offsets */
+    const void                    *packed;        /* Packed template */
 };
 
+
+KHASH_IMPL(ucp_worker_addr_template, uint64_t, ucp_address_template_t*, 1,
+           kh_int64_hash_func, kh_int64_hash_equal);
+
 static size_t ucp_address_iface_attr_size(ucp_worker_t *worker, uint64_t flags,
                                           ucp_object_version_t addr_version)
 {
@@ -463,23 +506,17 @@ ucp_address_gather_devices(ucp_worker_h worker, const ucp_ep_config_key_t *key,
     return UCS_OK;
 }
 
-static ssize_t
-ucp_address_packed_size(ucp_worker_h worker,
-                        const ucp_address_packed_device_t *devices,
-                        ucp_rsc_index_t num_devices, uint64_t pack_flags,
-                        ucp_object_version_t addr_version)
+static size_t ucp_address_worker_info_size(ucp_worker_h worker,
+                                           uint64_t pack_flags,
+                                           ucp_object_version_t addr_version)
 {
-    size_t size = 0;
-    ssize_t value_size;
-    const ucp_address_packed_device_t *dev;
-    ucp_md_index_t md_index;
-    const ucp_tl_resource_desc_t *rsc;
+    size_t size;
 
     /* header: version and flags */
     if (addr_version == UCP_OBJECT_VERSION_V1) {
-        size += sizeof(uint8_t);
+        size = sizeof(uint8_t);
     } else {
-        size += sizeof(uint16_t);
+        size = sizeof(uint16_t);
     }
 
     if (pack_flags & UCP_ADDRESS_PACK_FLAG_WORKER_UUID) {
@@ -495,6 +532,22 @@ ucp_address_packed_size(ucp_worker_h worker,
         size += strlen(ucp_worker_get_address_name(worker)) + 1;
     }
 
+    return size;
+}
+
+static ssize_t
+ucp_address_packed_size(ucp_worker_h worker,
+                        const ucp_address_packed_device_t *devices,
+                        ucp_rsc_index_t num_devices, uint64_t pack_flags,
+                        ucp_object_version_t addr_version)
+{
+    size_t size;
+    ssize_t value_size;
+    const ucp_address_packed_device_t *dev;
+    ucp_md_index_t md_index;
+    const ucp_tl_resource_desc_t *rsc;
+
+    size = ucp_address_worker_info_size(worker, pack_flags, addr_version);
     if (num_devices == 0) {
         size += 1; /* NULL md_index */
     } else {
@@ -1179,7 +1232,7 @@ uint64_t ucp_address_get_client_id(const void *address)
     return *ucs_serialize_next(&offset, uint64_t);
 }
 
-uint8_t ucp_address_is_am_only(const void *address)
+static uint8_t ucp_address_get_flags(const void *address)
 {
     uint8_t addr_flags;
     ucp_object_version_t addr_version;
@@ -1187,43 +1240,24 @@ uint8_t ucp_address_is_am_only(const void *address)
 
     ucp_address_unpack_header(address, &addr_version, &addr_flags,
                               &dst_version);
-    return addr_flags & UCP_ADDRESS_HEADER_FLAG_AM_ONLY;
+    return addr_flags;
 }
 
-static ucs_status_t
-ucp_address_do_pack(ucp_worker_h worker, ucp_ep_h ep, void *buffer, size_t size,
-                    unsigned pack_flags, ucp_object_version_t addr_version,
-                    const ucp_lane_index_t *lanes2remote,
-                    const ucp_address_packed_device_t *devices,
-                    ucp_rsc_index_t num_devices)
+uint8_t ucp_address_is_am_only(const void *address)
 {
-    ucp_context_h context = worker->context;
-    const ucp_address_packed_device_t *dev;
-    uint8_t *address_header_p;
-    uct_iface_attr_t *iface_attr;
-    ucp_md_index_t md_index;
-    ucp_worker_iface_t *wiface;
-    ucp_rsc_index_t rsc_index;
-    ucp_lane_index_t lane, remote_lane;
-    ucp_tl_bitmap_t dev_tl_bitmap;
-    unsigned num_ep_addrs;
-    ucs_status_t status;
-    size_t iface_addr_len;
-    size_t ep_addr_len;
-    uint8_t *ep_lane_ptr;
-    void *flags_ptr, *dev_flags_ptr;
-    unsigned addr_index;
-    int attr_len;
+    return ucp_address_get_flags(address) & UCP_ADDRESS_HEADER_FLAG_AM_ONLY;
+}
+
+/* Pack the address header and the worker information */
+static void *ucp_address_pack_worker_info(ucp_worker_h worker, void *buffer,
+                                          unsigned pack_flags,
+                                          ucp_object_version_t addr_version,
+                                          uint8_t addr_flags)
+{
+    uint8_t *address_header_p = buffer;
     void *ptr;
-    int enable_amo;
-    uint8_t addr_flags;
 
-    ptr               = buffer;
-    addr_index        = 0;
-    addr_flags        = 0;
-    address_header_p  = ptr;
-    ptr               = ucp_address_pack_header(address_header_p, addr_version);
-    dev_flags_ptr     = NULL;
+    ptr = ucp_address_pack_header(address_header_p, addr_version);
 
     if (pack_flags & UCP_ADDRESS_PACK_FLAG_AM_ONLY) {
         addr_flags |= UCP_ADDRESS_HEADER_FLAG_AM_ONLY;
@@ -1253,6 +1287,39 @@ ucp_address_do_pack(ucp_worker_h worker, ucp_ep_h ep, void *buffer, size_t size,
     }
 
     ucp_address_pack_header_flags(address_header_p, addr_version, addr_flags);
+    return ptr;
+}
+
+static ucs_status_t
+ucp_address_do_pack(ucp_worker_h worker, ucp_ep_h ep, void *buffer, size_t size,
+                    unsigned pack_flags, ucp_object_version_t addr_version,
+                    const ucp_lane_index_t *lanes2remote,
+                    const ucp_address_packed_device_t *devices,
+                    ucp_rsc_index_t num_devices)
+{
+    ucp_context_h context = worker->context;
+    const ucp_address_packed_device_t *dev;
+    uct_iface_attr_t *iface_attr;
+    ucp_md_index_t md_index;
+    ucp_worker_iface_t *wiface;
+    ucp_rsc_index_t rsc_index;
+    ucp_lane_index_t lane, remote_lane;
+    ucp_tl_bitmap_t dev_tl_bitmap;
+    unsigned num_ep_addrs;
+    ucs_status_t status;
+    size_t iface_addr_len;
+    size_t ep_addr_len;
+    uint8_t *ep_lane_ptr;
+    void *flags_ptr, *dev_flags_ptr;
+    unsigned addr_index;
+    int attr_len;
+    void *ptr;
+    int enable_amo;
+
+    addr_index    = 0;
+    dev_flags_ptr = NULL;
+    ptr           = ucp_address_pack_worker_info(worker, buffer, pack_flags,
+                                                 addr_version, 0);
 
     if (num_devices == 0) {
         *((uint8_t*)ptr) = UCP_NULL_RESOURCE;
@@ -1646,9 +1713,72 @@ ucp_address_adjust_unpacked_md_index(ucp_unpacked_address_t *unpacked_address)
     }
 }
 
-ucs_status_t ucp_address_unpack(ucp_worker_t *worker, const void *buffer,
-                                unsigned unpack_flags,
-                                ucp_unpacked_address_t *unpacked_address)
+static ucs_status_t
+ucp_address_unpack_compact(ucp_worker_t *worker, const void *ptr,
+                           unsigned unpack_flags,
+                           ucp_unpacked_address_t *unpacked_address,
+                           const void **end_p)
+{
+    ucp_address_template_t *tmpl;
+    ucp_address_entry_t *address;
+    uint64_t digest;
+    khiter_t khiter;
+    unsigned i;
+
+    digest = *ucs_serialize_next(&ptr, const uint64_t);
+    khiter = kh_get(ucp_worker_addr_template, &worker->addr_templates, digest);
+    if (khiter == kh_end(&worker->addr_templates)) {
+        ucp_address_error(unpack_flags,
+                          "failed to unpack address: unknown address template"
+                          " 0x%" PRIx64, digest);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    tmpl = kh_val(&worker->addr_templates, khiter);
+    if (tmpl->unpacked.address_count > 0) {
+        unpacked_address->address_list =
+                ucs_malloc(sizeof(*address) * tmpl->unpacked.address_count,
+                           "ucp_address_list");
+        if (unpacked_address->address_list == NULL) {
+            ucs_error("failed to allocate address list");
+            return UCS_ERR_NO_MEMORY;
+        }
+
+        memcpy(unpacked_address->address_list, tmpl->unpacked.address_list,
+               sizeof(*address) * tmpl->unpacked.address_count);
+    }
+
+    /* Point device and interface addresses to the payload of the compact
+     * address */
+    for (i = 0; i < tmpl->unpacked.address_count; ++i) {
+        address = &unpacked_address->address_list[i];
+        if (address->dev_addr != NULL) {
+            address->dev_addr = UCS_PTR_BYTE_OFFSET(ptr,
+                                                    tmpl->offsets[i].dev_addr);
+        }
+        if (address->iface_addr != NULL) {
+            address->iface_addr = UCS_PTR_BYTE_OFFSET(
+                    ptr, tmpl->offsets[i].iface_addr);
+        }
+    }
+
+    unpacked_address->addr_version  = tmpl->unpacked.addr_version;
+    unpacked_address->dst_version   = tmpl->unpacked.dst_version;
+    unpacked_address->address_count = tmpl->unpacked.address_count;
+    *end_p                          = UCS_PTR_BYTE_OFFSET(ptr,
+                                                          tmpl->payload_length);
+
+    ucp_address_trace(unpack_flags,
+                      "unpacked compact address with template 0x%" PRIx64
+                      " %u entries", digest, unpacked_address->address_count);
+    return UCS_OK;
+}
+
+static ucs_status_t
+ucp_address_do_unpack(ucp_worker_t *worker, const void *buffer,
+                      unsigned unpack_flags,
+                      ucp_unpacked_address_t *unpacked_address,
+                      size_t *length_p)
 {
     UCS_ARRAY_DEFINE_ONSTACK(ucp_address_remote_device_array_t,
                              remote_device_array, UCP_MAX_RESOURCES);
@@ -1714,13 +1844,22 @@ ucs_status_t ucp_address_unpack(ucp_worker_t *worker, const void *buffer,
                          sizeof(unpacked_address->name));
     }
 
+    if (addr_flags & UCP_ADDRESS_HEADER_FLAG_TEMPLATE) {
+        status = ucp_address_unpack_compact(worker, ptr, unpack_flags,
+                                            unpacked_address, &ptr);
+        goto out;
+    }
+
     /* Empty address list */
     if (*(uint8_t*)ptr == UCP_NULL_RESOURCE) {
-        return UCS_OK;
+        ptr    = UCS_PTR_TYPE_OFFSET(ptr, uint8_t);
+        status = UCS_OK;
+        goto out;
     }
 
-    /* Allocate address list */
-    address_list = ucs_calloc(UCP_MAX_RESOURCES, sizeof(*address_list),
+    /* Allocate address list, entries are initialized when they are unpacked
+     * since only a few of them are typically used */
+    address_list = ucs_malloc(UCP_MAX_RESOURCES * sizeof(*address_list),
                               "ucp_address_list");
     if (address_list == NULL) {
         ucs_error("failed to allocate address list");
@@ -1779,6 +1918,8 @@ ucs_status_t ucp_address_unpack(ucp_worker_t *worker, const void *buffer,
                 goto err_free;
             }
 
+            memset(address, 0, sizeof(*address));
+
             /* tl_name_csum */
             address->tl_name_csum = *(uint16_t*)ptr;
             ptr = UCS_PTR_TYPE_OFFSET(ptr, address->tl_name_csum);
@@ -1805,8 +1946,9 @@ ucs_status_t ucp_address_unpack(ucp_worker_t *worker, const void *buffer,
             ptr       = ucp_address_unpack_tl_length(
                                           worker, flags_ptr, ptr, addr_version,
                                           &iface_addr_len, 0, &last_tl);
-            address->iface_addr   = (iface_addr_len > 0) ? ptr : NULL;
-            address->num_ep_addrs = 0;
+            address->iface_addr     = (iface_addr_len > 0) ? ptr : NULL;
+            address->iface_addr_len = iface_addr_len;
+            address->num_ep_addrs   = 0;
             ptr                   = UCS_PTR_BYTE_OFFSET(ptr, iface_addr_len);
             last_ep_addr          = !(*(uint8_t*)flags_ptr &
                                       UCP_ADDRESS_FLAG_HAS_EP_ADDR);
@@ -1872,9 +2014,298 @@ ucs_status_t ucp_address_unpack(ucp_worker_t *worker, const void *buffer,
     unpacked_address->address_list  = address_list;
 
     ucp_address_adjust_unpacked_md_index(unpacked_address);
-    return UCS_OK;
+    status = UCS_OK;
+
+out:
+    if ((status == UCS_OK) && (length_p != NULL)) {
+        *length_p = UCS_PTR_BYTE_DIFF(buffer, ptr);
+    }
+    return status;
 
 err_free:
     ucs_free(address_list);
     return UCS_ERR_INVALID_PARAM;
 }
+
+ucs_status_t ucp_address_unpack(ucp_worker_t *worker, const void *buffer,
+                                unsigned unpack_flags,
+                                ucp_unpacked_address_t *unpacked_address)
+{
+    return ucp_address_do_unpack(worker, buffer, unpack_flags,
+                                 unpacked_address, NULL);
+}
+
+ucs_status_t
+ucp_address_unpack_with_length(ucp_worker_h worker, const void *buffer,
+                               unsigned unpack_flags,
+                               ucp_unpacked_address_t *unpacked_address,
+                               size_t *length_p)
+{
+    return ucp_address_do_unpack(worker, buffer, unpack_flags,
+                                 unpacked_address, length_p);
+}
+
+/* Assign payload offsets to the device and interface addresses of the
+ * template entries, and return the total payload length */
+static size_t
+ucp_address_template_set_offsets(const ucp_unpacked_address_t *unpacked,
+                                 ucp_address_template_offset_t *offsets)
+{
+    const uct_device_addr_t *prev_dev_addr = NULL;
+    size_t payload_length                  = 0;
+    size_t dev_addr_offset                 = 0;
+    const ucp_address_entry_t *ae;
+    unsigned addr_index;
+
+    ucp_unpacked_address_for_each(ae, unpacked) {
+        addr_index = ucp_unpacked_address_index(unpacked, ae);
+        if ((ae->dev_addr != NULL) && (ae->dev_addr != prev_dev_addr)) {
+            dev_addr_offset = payload_length;
+            prev_dev_addr   = ae->dev_addr;
+            payload_length += ae->dev_addr_len;
+        }
+
+        offsets[addr_index].dev_addr   = dev_addr_offset;
+        offsets[addr_index].iface_addr = payload_length;
+        if (ae->iface_addr != NULL) {
+            payload_length += ae->iface_addr_len;
+        }
+    }
+
+    return payload_length;
+}
+
+static void ucp_address_template_free(ucp_address_template_t *tmpl)
+{
+    ucs_free(tmpl->unpacked.address_list);
+    ucs_free(tmpl);
+}
+
+ucs_status_t ucp_address_template_add(ucp_worker_h worker, const void *buffer,
+                                      ucp_address_template_t **tmpl_p)
+{
+    unsigned unpack_flags = ucp_worker_default_address_pack_flags(worker) &
+                            ~(UCP_ADDRESS_PACK_FLAG_WORKER_NAME |
+                              UCP_ADDRESS_PACK_FLAG_EP_ADDR);
+    ucp_unpacked_address_t unpacked;
+    ucp_address_template_t *tmpl;
+    ucs_status_t status;
+    unsigned count;
+    uint64_t digest;
+    khiter_t khiter;
+    size_t length;
+    void *packed;
+    int ret;
+
+    if (ucp_address_get_flags(buffer) & UCP_ADDRESS_HEADER_FLAG_TEMPLATE) {
+        ucs_error("compact address %p cannot be used as address template",
+                  buffer);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    /* Find the template length */
+    status = ucp_address_do_unpack(worker, buffer,
+                                   unpack_flags | UCP_ADDRESS_PACK_FLAG_NO_TRACE,
+                                   &unpacked, &length);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    count = unpacked.address_count;
+    ucs_free(unpacked.address_list);
+
+    digest = ((uint64_t)length << 32) | ucs_crc32(0, buffer, length);
+    khiter = kh_get(ucp_worker_addr_template, &worker->addr_templates, digest);
+    if (khiter != kh_end(&worker->addr_templates)) {
+        tmpl = kh_val(&worker->addr_templates, khiter);
+        if (memcmp(tmpl->packed, buffer, length) != 0) {
+            ucs_error("address template %p conflicts with cached template"
+                      " 0x%" PRIx64, buffer, digest);
+            return UCS_ERR_ALREADY_EXISTS;
+        }
+
+        goto out;
+    }
+
+    /* The unpacked template points into a copy owned by the cache entry */
+    tmpl = ucs_malloc(sizeof(*tmpl) + (sizeof(*tmpl->offsets) * count) +
+                      length, "ucp_address_template");
+    if (tmpl == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    tmpl->offsets = (ucp_address_template_offset_t*)(tmpl + 1);
+    packed        = tmpl->offsets + count;
+    memcpy(packed, buffer, length);
+
+    status = ucp_address_do_unpack(worker, packed, unpack_flags,
+                                   &tmpl->unpacked, NULL);
+    if (status != UCS_OK) {
+        goto err_free;
+    }
+
+    ucs_assert(tmpl->unpacked.address_count == count);
+    tmpl->digest         = digest;
+    tmpl->length         = length;
+    tmpl->packed         = packed;
+    tmpl->payload_length = ucp_address_template_set_offsets(&tmpl->unpacked,
+                                                            tmpl->offsets);
+
+    khiter = kh_put(ucp_worker_addr_template, &worker->addr_templates, digest,
+                    &ret);
+    if (ret == UCS_KH_PUT_FAILED) {
+        status = UCS_ERR_NO_MEMORY;
+        goto err_free_unpacked;
+    }
+
+    kh_val(&worker->addr_templates, khiter) = tmpl;
+    ucs_debug("worker %p: added address template 0x%" PRIx64 " length %zu"
+              " with %u entries, payload length %zu", worker, digest, length,
+              count, tmpl->payload_length);
+
+out:
+    if (tmpl_p != NULL) {
+        *tmpl_p = tmpl;
+    }
+    return UCS_OK;
+
+err_free_unpacked:
+    ucs_free(tmpl->unpacked.address_list);
+err_free:
+    ucs_free(tmpl);
+    return status;
+}
+
+ucs_status_t
+ucp_address_pack_compact(ucp_worker_h worker, const ucp_tl_bitmap_t *tl_bitmap,
+                         unsigned pack_flags, size_t *template_length_p,
+                         void **template_p, size_t *size_p, void **buffer_p)
+{
+    unsigned template_flags = pack_flags &
+                              ~(UCP_ADDRESS_PACK_FLAG_WORKER_UUID |
+                                UCP_ADDRESS_PACK_FLAG_WORKER_NAME |
+                                UCP_ADDRESS_PACK_FLAG_CLIENT_ID |
+                                UCP_ADDRESS_PACK_FLAG_EP_ADDR);
+    void *buffer            = NULL;
+    void *payload           = NULL;
+    ucp_address_template_offset_t *offsets;
+    ucp_unpacked_address_t unpacked;
+    ucp_address_template_t *tmpl;
+    const ucp_address_entry_t *ae;
+    size_t template_length, size;
+    size_t payload_length;
+    unsigned addr_index;
+    ucs_status_t status;
+    void *template;
+
+    status = ucp_address_pack(worker, NULL, tl_bitmap, template_flags,
+                              UCP_OBJECT_VERSION_V2, NULL, UINT_MAX,
+                              &template_length, &template);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    status = ucp_address_unpack(worker, template,
+                                template_flags | UCP_ADDRESS_PACK_FLAG_NO_TRACE,
+                                &unpacked);
+    if (status != UCS_OK) {
+        goto out_free_template;
+    }
+
+    offsets = ucs_malloc(sizeof(*offsets) * ucs_max(unpacked.address_count, 1),
+                         "ucp_address_template_offsets");
+    if (offsets == NULL) {
+        status = UCS_ERR_NO_MEMORY;
+        goto out_free_unpacked;
+    }
+
+    payload_length = ucp_address_template_set_offsets(&unpacked, offsets);
+
+    if (buffer_p != NULL) {
+        size   = ucp_address_worker_info_size(worker, pack_flags,
+                                              UCP_OBJECT_VERSION_V2) +
+                 sizeof(uint64_t) + payload_length;
+        buffer = ucs_malloc(size, "ucp_compact_address");
+        if (buffer == NULL) {
+            status = UCS_ERR_NO_MEMORY;
+            goto out_free_offsets;
+        }
+
+        payload = ucp_address_pack_worker_info(
+                worker, buffer, pack_flags, UCP_OBJECT_VERSION_V2,
+                UCP_ADDRESS_HEADER_FLAG_TEMPLATE);
+        payload = UCS_PTR_TYPE_OFFSET(payload, uint64_t); /* digest */
+        ucs_assert(UCS_PTR_BYTE_OFFSET(payload, payload_length) ==
+                   UCS_PTR_BYTE_OFFSET(buffer, size));
+    }
+
+    /* Move the per-worker addresses from the template to the payload */
+    ucp_unpacked_address_for_each(ae, &unpacked) {
+        addr_index = ucp_unpacked_address_index(&unpacked, ae);
+        if (ae->dev_addr != NULL) {
+            if (payload != NULL) {
+                memcpy(UCS_PTR_BYTE_OFFSET(payload,
+                                           offsets[addr_index].dev_addr),
+                       ae->dev_addr, ae->dev_addr_len);
+            }
+            memset((void*)ae->dev_addr, 0, ae->dev_addr_len);
+        }
+        if (ae->iface_addr != NULL) {
+            if (payload != NULL) {
+                memcpy(UCS_PTR_BYTE_OFFSET(payload,
+                                           offsets[addr_index].iface_addr),
+                       ae->iface_addr, ae->iface_addr_len);
+            }
+            memset((void*)ae->iface_addr, 0, ae->iface_addr_len);
+        }
+    }
+
+    /* Make the template known to the local worker as well */
+    status = ucp_address_template_add(worker, template, &tmpl);
+    if (status != UCS_OK) {
+        goto out_free_buffer;
+    }
+
+    ucs_assertv(tmpl->payload_length == payload_length,
+                "template payload length %zu, expected %zu",
+                tmpl->payload_length, payload_length);
+
+    if (buffer_p != NULL) {
+        *(uint64_t*)UCS_PTR_BYTE_OFFSET(payload, -sizeof(uint64_t)) =
+                tmpl->digest;
+        *size_p   = size;
+        *buffer_p = buffer;
+        buffer    = NULL;
+    }
+
+    if (template_p != NULL) {
+        *template_length_p = template_length;
+        *template_p        = template;
+        template           = NULL;
+    }
+
+out_free_buffer:
+    ucs_free(buffer);
+out_free_offsets:
+    ucs_free(offsets);
+out_free_unpacked:
+    ucs_free(unpacked.address_list);
+out_free_template:
+    ucs_free(template);
+    return status;
+}
+
+void ucp_address_template_cache_init(ucp_worker_h worker)
+{
+    kh_init_inplace(ucp_worker_addr_template, &worker->addr_templates);
+}
+
+void ucp_address_template_cache_cleanup(ucp_worker_h worker)
+{
+    ucp_address_template_t *tmpl;
+
+    kh_foreach_value(&worker->addr_templates, tmpl, {
+        ucp_address_template_free(tmpl);
+    })
+    kh_destroy_inplace(ucp_worker_addr_template, &worker->addr_templates);
+}
@@ -145,6 +145,7 @@ struct ucp_address_entry {
     const uct_device_addr_t     *dev_addr;      /* Points to device address */
     size_t                      dev_addr_len;   /* Device address length */
     const uct_iface_addr_t      *iface_addr;    /* Interface address, NULL if not available */
+    size_t                      iface_addr_len; /* Interface address length */
     unsigned                    num_ep_addrs;   /* How many endpoint address are in ep_addrs */
     ucp_address_entry_ep_addr_t ep_addrs[UCP_MAX_LANES]; /* Endpoint addresses */
     ucp_address_iface_attr_t    iface_attr;     /* Interface attributes information */
@@ -257,6 +258,70 @@ ucs_status_t ucp_address_unpack(ucp_worker_h worker, const void *buffer,
                                 ucp_unpacked_address_t *unpacked_address);
 
 
+/**
+ * Unpack a list of addresses, and return the length of the packed address.
+ *
+ * @param [in]  worker           Worker object.
+ * @param [in]  buffer           Buffer with data to unpack.
+ * @param [in]  unpack_flags     UCP_ADDRESS_PACK_FLAG_xx flags, same as in
+ *                               @ref ucp_address_unpack.
+ * @param [out] unpacked_address Filled with remote address data.
+ * @param [out] length_p         Filled with the length of the packed address
+ *                               in @a buffer.
+ */
+ucs_status_t
+ucp_address_unpack_with_length(ucp_worker_h worker, const void *buffer,
+                               unsigned unpack_flags,
+                               ucp_unpacked_address_t *unpacked_address,
+                               size_t *length_p);
+
+
+/**
+ * Pack a compact worker address and the address template it refers to.
+ *
+ * The template contains the device and interface attributes, which are the
+ * same for all workers with the same set of resources, while the compact
+ * address contains only the worker information and the device and interface
+ * addresses. The template is added to the local worker's template cache.
+ *
+ * @param [in]  worker            Worker object whose address to pack.
+ * @param [in]  tl_bitmap         Specifies the resources to pack.
+ * @param [in]  pack_flags        UCP_ADDRESS_PACK_FLAG_xx flags to specify
+ *                                the compact address format.
+ * @param [out] template_length_p Filled with template length.
+ * @param [out] template_p        Filled with the packed template, can be NULL
+ *                                if the template is not needed. It should be
+ *                                released by ucs_free().
+ * @param [out] size_p            Filled with compact address length.
+ * @param [out] buffer_p          Filled with the compact address, can be NULL
+ *                                if only the template is needed. It should be
+ *                                released by ucs_free().
+ */
+ucs_status_t
+ucp_address_pack_compact(ucp_worker_h worker, const ucp_tl_bitmap_t *tl_bitmap,
+                         unsigned pack_flags, size_t *template_length_p,
+                         void **template_p, size_t *size_p, void **buffer_p);
+
+
+/**
+ * Decode an address template and add it to the worker's template cache, so
+ * compact addresses which refer to it could be unpacked by
+ * @ref ucp_address_unpack. Does nothing if the template is already cached.
+ *
+ * @param [in]  worker   Worker object.
+ * @param [in]  buffer   Packed address template.
+ * @param [out] tmpl_p   Filled with the cached template, can be NULL.
+ */
+ucs_status_t ucp_address_template_add(ucp_worker_h worker, const void *buffer,
+                                      ucp_address_template_t **tmpl_p);
+
+
+void ucp_address_template_cache_init(ucp_worker_h worker);
+
+
+void ucp_address_template_cache_cleanup(ucp_worker_h worker);
+
+
 /**
  * Unpack worker unique id from the given address.
  *
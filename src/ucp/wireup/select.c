@@ -13,6 +13,7 @@
 #include "wireup_cm.h"
 #include "address.h"
 
+#include <ucs/algorithm/crc.h>
 #include <ucs/algorithm/qsort_r.h>
 #include <ucs/datastruct/array.h>
 #include <ucs/datastruct/queue.h>
@@ -106,6 +107,9 @@ typedef struct {
 UCS_ARRAY_DECLARE_TYPE(ucp_proto_select_info_array_t, unsigned,
                        ucp_wireup_select_info_t);
 
+KHASH_IMPL(ucp_worker_lanes_cache, uint64_t, ucp_wireup_lanes_cache_entry_t*,
+           1, kh_int64_hash_func, kh_int64_hash_equal);
+
 static const char *ucp_wireup_cmpt_flags[] = {
     [ucs_ilog2(UCT_COMPONENT_FLAG_RKEY_PTR)]     = "obtain remote memory pointer",
 };
@@ -2811,8 +2815,216 @@ ucp_wireup_construct_lanes(const ucp_wireup_select_params_t *select_params,
         key->am_bw_lanes[0] = key->am_lane;
     }
 
-    return ucp_wireup_select_set_locality_flags(select_params, addr_indices,
-                                                key);
+    return UCS_OK;
+}
+
+/*
+ * Lane selection result cached by the shape of the remote address
+ */
+struct ucp_wireup_lanes_cache_entry {
+    uint64_t            digest;                      /* Digest of the shape */
+    size_t              shape_length;                /* Length of the shape */
+    ucp_ep_config_key_t key;                         /* Selected lanes, without
+                                                        locality flags */
+    unsigned            addr_indices[UCP_MAX_LANES]; /* Remote address index
+                                                        of every lane */
+    /* Followed by the shape */
+};
+
+
+/*
+ * Everything the lane selection depends on, except the remote address entries
+ */
+typedef struct {
+    ucp_tl_bitmap_t         tl_bitmap;
+    unsigned                ep_init_flags;
+    unsigned                key_flags;
+    unsigned                dst_version;
+    unsigned                address_count;
+    ucp_err_handling_mode_t err_mode;
+    ucp_object_version_t    addr_version;
+    int                     uuid_cmp;
+    int                     local_connected;
+} ucp_wireup_lanes_shape_hdr_t;
+
+
+/*
+ * Remote address entry, as seen by the lane selection
+ */
+typedef struct {
+    ucp_tl_bitmap_t             reachable_tls; /* Local resources which can
+                                                  reach the entry */
+    ucp_tl_iface_atomic_flags_t atomic;
+    uint64_t                    iface_flags;
+    double                      overhead;
+    double                      bandwidth;
+    double                      lat_ovh;
+    size_t                      seg_size;
+    size_t                      dev_addr_len;
+    int                         priority;
+    unsigned                    num_ep_addrs;
+    unsigned                    dev_num_paths;
+    int                         has_iface_addr;
+    uint16_t                    tl_name_csum;
+    ucp_md_index_t              md_index;
+    ucs_sys_device_t            sys_dev;
+    ucp_rsc_index_t             dev_index;
+} ucp_wireup_lanes_shape_entry_t;
+
+
+static size_t
+ucp_wireup_lanes_shape_length(const ucp_unpacked_address_t *remote_address)
+{
+    return sizeof(ucp_wireup_lanes_shape_hdr_t) +
+           (remote_address->address_count *
+            sizeof(ucp_wireup_lanes_shape_entry_t));
+}
+
+static void
+ucp_wireup_lanes_shape_pack(ucp_ep_h ep, unsigned ep_init_flags,
+                            const ucp_tl_bitmap_t *tl_bitmap,
+                            const ucp_unpacked_address_t *remote_address,
+                            const ucp_ep_config_key_t *key, void *shape)
+{
+    ucp_worker_h worker                  = ep->worker;
+    ucp_context_h context                = worker->context;
+    ucp_wireup_lanes_shape_hdr_t *hdr    = shape;
+    ucp_wireup_lanes_shape_entry_t *sent = UCS_PTR_TYPE_OFFSET(hdr, *hdr);
+    const ucp_address_entry_t *ae;
+    ucp_rsc_index_t rsc_index;
+
+    /* Zero all padding, since the shape is hashed and compared as a buffer */
+    memset(shape, 0, ucp_wireup_lanes_shape_length(remote_address));
+
+    hdr->tl_bitmap       = *tl_bitmap;
+    hdr->ep_init_flags   = ep_init_flags;
+    hdr->key_flags       = key->flags;
+    hdr->dst_version     = remote_address->dst_version;
+    hdr->address_count   = remote_address->address_count;
+    hdr->err_mode        = key->err_mode;
+    hdr->addr_version    = remote_address->addr_version;
+    hdr->uuid_cmp        = (worker->uuid > remote_address->uuid) -
+                           (worker->uuid < remote_address->uuid);
+    hdr->local_connected = !!(ep->flags & UCP_EP_FLAG_LOCAL_CONNECTED);
+
+    ucp_unpacked_address_for_each(ae, remote_address) {
+        UCS_STATIC_BITMAP_FOR_EACH_BIT(rsc_index, tl_bitmap) {
+            if ((context->tl_rscs[rsc_index].tl_name_csum == ae->tl_name_csum) &&
+                ucp_wireup_is_reachable(ep, ep_init_flags, rsc_index, ae, NULL,
+                                        0)) {
+                UCS_STATIC_BITMAP_SET(&sent->reachable_tls, rsc_index);
+            }
+        }
+
+        sent->atomic         = ae->iface_attr.atomic;
+        sent->iface_flags    = ae->iface_attr.flags;
+        sent->overhead       = ae->iface_attr.overhead;
+        sent->bandwidth      = ae->iface_attr.bandwidth;
+        sent->lat_ovh        = ae->iface_attr.lat_ovh;
+        sent->seg_size       = ae->iface_attr.seg_size;
+        sent->dev_addr_len   = ae->dev_addr_len;
+        sent->priority       = ae->iface_attr.priority;
+        sent->num_ep_addrs   = ae->num_ep_addrs;
+        sent->dev_num_paths  = ae->dev_num_paths;
+        sent->has_iface_addr = (ae->iface_addr != NULL);
+        sent->tl_name_csum   = ae->tl_name_csum;
+        sent->md_index       = ae->md_index;
+        sent->sys_dev        = ae->sys_dev;
+        sent->dev_index      = ae->dev_index;
+        ++sent;
+    }
+}
+
+static uint64_t ucp_wireup_lanes_cache_digest(const void *shape, size_t length)
+{
+    return ((uint64_t)length << 32) | ucs_crc32(0, shape, length);
+}
+
+static ucp_wireup_lanes_cache_entry_t *
+ucp_wireup_lanes_cache_lookup(ucp_worker_h worker, uint64_t digest,
+                              const void *shape, size_t length)
+{
+    ucp_wireup_lanes_cache_entry_t *entry;
+    khiter_t khiter;
+
+    khiter = kh_get(ucp_worker_lanes_cache, &worker->lanes_cache, digest);
+    if (khiter == kh_end(&worker->lanes_cache)) {
+        return NULL;
+    }
+
+    entry = kh_val(&worker->lanes_cache, khiter);
+    if ((entry->shape_length != length) ||
+        (memcmp(entry + 1, shape, length) != 0)) {
+        /* Digest collision */
+        return NULL;
+    }
+
+    return entry;
+}
+
+static void ucp_wireup_lanes_cache_flush(ucp_worker_h worker)
+{
+    ucp_wireup_lanes_cache_entry_t *entry;
+
+    kh_foreach_value(&worker->lanes_cache, entry, {
+        ucs_free(entry);
+    })
+    kh_clear(ucp_worker_lanes_cache, &worker->lanes_cache);
+}
+
+static void
+ucp_wireup_lanes_cache_add(ucp_worker_h worker, uint64_t digest,
+                           const void *shape, size_t length,
+                           const unsigned *addr_indices,
+                           const ucp_ep_config_key_t *key)
+{
+    ucp_wireup_lanes_cache_entry_t *entry;
+    khiter_t khiter;
+    int ret;
+
+    entry = ucs_malloc(sizeof(*entry) + length, "ucp_wireup_lanes_cache_entry");
+    if (entry == NULL) {
+        return;
+    }
+
+    entry->digest           = digest;
+    entry->shape_length     = length;
+    entry->key              = *key;
+    entry->key.dst_md_cmpts = NULL;
+    memcpy(entry->addr_indices, addr_indices,
+           sizeof(*addr_indices) * key->num_lanes);
+    memcpy(entry + 1, shape, length);
+
+    if (kh_size(&worker->lanes_cache) >=
+        worker->context->config.ext.wireup_lanes_cache_size) {
+        ucs_debug("worker %p: flushing lanes cache with %u entries", worker,
+                  kh_size(&worker->lanes_cache));
+        ucp_wireup_lanes_cache_flush(worker);
+    }
+
+    khiter = kh_put(ucp_worker_lanes_cache, &worker->lanes_cache, digest, &ret);
+    if (ret == UCS_KH_PUT_FAILED) {
+        ucs_free(entry);
+        return;
+    }
+
+    if (ret == UCS_KH_PUT_KEY_PRESENT) {
+        /* Replace the entry whose shape has the same digest */
+        ucs_free(kh_val(&worker->lanes_cache, khiter));
+    }
+
+    kh_val(&worker->lanes_cache, khiter) = entry;
+}
+
+void ucp_wireup_lanes_cache_init(ucp_worker_h worker)
+{
+    kh_init_inplace(ucp_worker_lanes_cache, &worker->lanes_cache);
+}
+
+void ucp_wireup_lanes_cache_cleanup(ucp_worker_h worker)
+{
+    ucp_wireup_lanes_cache_flush(worker);
+    kh_destroy_inplace(ucp_worker_lanes_cache, &worker->lanes_cache);
 }
 
 ucs_status_t
@@ -2828,8 +3040,37 @@ ucp_wireup_select_lanes(ucp_ep_h ep, unsigned ep_init_flags,
        will support specifying a reason */
     ucp_wireup_select_context_t select_ctx;
     ucp_wireup_select_params_t select_params;
+    ucp_wireup_lanes_cache_entry_t *entry;
+    ucp_rsc_index_t *dst_md_cmpts;
+    uint64_t digest     = 0;
+    void *shape         = NULL;
+    size_t shape_length = ucp_wireup_lanes_shape_length(remote_address);
     ucs_status_t status;
 
+    if (worker->context->config.ext.wireup_lanes_cache_size > 0) {
+        shape = ucs_alloc_on_stack(shape_length, "lanes_shape");
+        if (shape != NULL) {
+            ucp_wireup_lanes_shape_pack(ep, ep_init_flags, &tl_bitmap,
+                                        remote_address, key, shape);
+            digest = ucp_wireup_lanes_cache_digest(shape, shape_length);
+            entry  = ucp_wireup_lanes_cache_lookup(worker, digest, shape,
+                                                   shape_length);
+            if (entry != NULL) {
+                ucs_trace("ep %p: using cached lanes, digest 0x%" PRIx64, ep,
+                          digest);
+                dst_md_cmpts      = key->dst_md_cmpts;
+                *key              = entry->key;
+                key->dst_md_cmpts = dst_md_cmpts;
+                memcpy(addr_indices, entry->addr_indices,
+                       sizeof(*addr_indices) * key->num_lanes);
+                ucp_wireup_select_params_init(&select_params, ep,
+                                              ep_init_flags, remote_address,
+                                              tl_bitmap, show_error);
+                goto out_set_locality;
+            }
+        }
+    }
+
     UCS_STATIC_BITMAP_AND_INPLACE(&scalable_tl_bitmap, tl_bitmap);
 
     if (!UCS_STATIC_BITMAP_IS_ZERO(scalable_tl_bitmap)) {
@@ -2851,14 +3092,26 @@ ucp_wireup_select_lanes(ucp_ep_h ep, unsigned ep_init_flags,
     status = ucp_wireup_search_lanes(&select_params, key->err_mode,
                                      &select_ctx);
     if (status != UCS_OK) {
-        return status;
+        goto out_free_shape;
     }
 
 out:
     status = ucp_wireup_construct_lanes(&select_params, &select_ctx,
                                         addr_indices, key);
     if (status != UCS_OK) {
-        return status;
+        goto out_free_shape;
+    }
+
+    if (shape != NULL) {
+        ucp_wireup_lanes_cache_add(worker, digest, shape, shape_length,
+                                   addr_indices, key);
+    }
+
+out_set_locality:
+    status = ucp_wireup_select_set_locality_flags(&select_params, addr_indices,
+                                                  key);
+    if (status != UCS_OK) {
+        goto out_free_shape;
     }
 
     /* Only two lanes must be created during CM phase (CM lane and TL lane) of
@@ -2868,7 +3121,11 @@ out:
                                    UCP_EP_INIT_CM_PHASE) ||
                (key->num_lanes == 2));
 
-    return UCS_OK;
+out_free_shape:
+    if (shape != NULL) {
+        ucs_free_on_stack(shape, shape_length);
+    }
+    return status;
 }
 
 ucs_status_t
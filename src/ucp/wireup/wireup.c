@@ -677,6 +677,14 @@ ucp_wireup_process_request(ucp_worker_h worker, ucp_ep_h ep,
                 }
             }
         } else {
+            /* The peer connected first to an endpoint which was created with
+             * deferred connection, so connect it now and resolve the
+             * simultaneous connect below */
+            status = ucp_ep_lazy_connect_check(ep);
+            if (status != UCS_OK) {
+                goto err_set_ep_failed;
+            }
+
             status = ucp_ep_config_err_mode_check_mismatch(ep, msg->err_mode);
             if (status != UCS_OK) {
                 goto err_set_ep_failed;
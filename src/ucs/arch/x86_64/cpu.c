@@ -623,6 +623,12 @@ static size_t ucs_cpu_memcpy_thresh(size_t user_val, size_t auto_val)
 
 static size_t ucs_cpu_nt_bt_thresh_min(size_t user_val)
 {
+    if (!UCS_ARCH_X86_NT_BUFFER_TRANSFER ||
+        !(ucs_arch_get_cpu_flag() & UCS_CPU_FLAG_AVX)) {
+        /* AVX copy routines are not available on this build or CPU */
+        return UCS_MEMUNITS_INF;
+    }
+
     if (user_val != UCS_MEMUNITS_AUTO) {
         return user_val;
     }
@@ -765,8 +771,9 @@ ucs_status_t ucs_arch_get_cache_size(size_t *cache_sizes)
     return cache_count == UCS_CPU_CACHE_LAST ? UCS_OK : UCS_ERR_UNSUPPORTED;
 }
 
-#ifdef __AVX__
-static size_t ucs_x86_nt_all_buffer_transfer(void *dst, const void *src, size_t len)
+#if UCS_ARCH_X86_NT_BUFFER_TRANSFER
+static UCS_F_X86_AVX size_t
+ucs_x86_nt_all_buffer_transfer(void *dst, const void *src, size_t len)
 {
     size_t offset;
     __m256i y0, y1, y2, y3, y4, y5, y6, y7;
@@ -866,7 +873,7 @@ static size_t ucs_x86_nt_all_buffer_transfer(void *dst, const void *src, size_t
     return len;
 }
 
-static UCS_F_ALWAYS_INLINE
+static UCS_F_ALWAYS_INLINE UCS_F_X86_AVX
 size_t ucs_x86_nt_dst_buffer_transfer(void *dst, const void *src, size_t len,
                                       size_t total_len)
 {
@@ -996,7 +1003,7 @@ size_t ucs_x86_nt_dst_buffer_transfer(void *dst, const void *src, size_t len,
     return len;
 }
 
-static UCS_F_ALWAYS_INLINE
+static UCS_F_ALWAYS_INLINE UCS_F_X86_AVX
 size_t ucs_x86_nt_src_buffer_transfer(void *dst, const void *src, size_t len)
 {
     __m256i y0, y1, y2, y3;
@@ -1085,7 +1092,7 @@ size_t ucs_x86_nt_src_buffer_transfer(void *dst, const void *src, size_t len)
     return len;
 }
 
-static UCS_F_ALWAYS_INLINE void
+static UCS_F_ALWAYS_INLINE UCS_F_X86_AVX void
 ucs_x86_copy_bytes_le_128(void *dst, const void *src, uint32_t len)
 {
     __m256i y0, y1, y2, y3;
@@ -1151,8 +1158,9 @@ ucs_x86_copy_bytes_le_128(void *dst, const void *src, uint32_t len)
  * TODO: Provide an option to copy from backwards, in this way
  * application can choose the cache hotness of the final buffer
  */
-void ucs_x86_nt_buffer_transfer(void *dst, const void *src, size_t len,
-                                ucs_arch_memcpy_hint_t hint, size_t total_len)
+UCS_F_X86_AVX void
+ucs_x86_nt_buffer_transfer(void *dst, const void *src, size_t len,
+                           ucs_arch_memcpy_hint_t hint, size_t total_len)
 {
     size_t tail_bytes;
 
@@ -20,7 +20,24 @@
 #ifdef __SSE4_1__
 #  include <smmintrin.h>
 #endif
-#ifdef __AVX__
+
+/*
+ * AVX non-temporal buffer transfer routines are available either when the
+ * whole library is built with AVX, or when the compiler can enable AVX per
+ * function. In the latter case they are used only if the CPU supports AVX.
+ */
+#if defined(__AVX__)
+#  define UCS_ARCH_X86_NT_BUFFER_TRANSFER 1
+#  define UCS_F_X86_AVX
+#elif defined(HAVE_ATTRIBUTE_TARGET_AVX) && (HAVE_ATTRIBUTE_TARGET_AVX == 1)
+#  define UCS_ARCH_X86_NT_BUFFER_TRANSFER 1
+#  define UCS_F_X86_AVX __attribute__((target("avx")))
+#else
+#  define UCS_ARCH_X86_NT_BUFFER_TRANSFER 0
+#  define UCS_F_X86_AVX
+#endif
+
+#if UCS_ARCH_X86_NT_BUFFER_TRANSFER
 #  include <immintrin.h>
 #endif
 #ifdef __SSE2__
@@ -119,7 +136,7 @@ static inline void *ucs_memcpy_relaxed(void *dst, const void *src, size_t len,
     }
 #endif
 
-#ifdef __AVX__
+#if UCS_ARCH_X86_NT_BUFFER_TRANSFER
     if (ucs_unlikely(total_len >= ucs_global_opts.arch.nt_buffer_transfer_min)) {
         ucs_x86_nt_buffer_transfer(dst, src, len, hint, total_len);
         return dst;
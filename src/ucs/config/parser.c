@@ -32,6 +32,10 @@
 /* width of titles in docstring */
 #define UCS_CONFIG_PARSER_DOCSTR_WIDTH         10
 
+/* FNV-1a parameters for the environment digest */
+#define UCS_CONFIG_SNAPSHOT_DIGEST_INIT        0xcbf29ce484222325ul
+#define UCS_CONFIG_SNAPSHOT_DIGEST_PRIME       0x100000001b3ul
+
 
 /* list of prefixes for a configuration variable, used to dump all possible
  * aliases.
@@ -49,6 +53,39 @@ KHASH_SET_INIT_STR(ucs_config_env_vars)
 KHASH_MAP_INIT_STR(ucs_config_map, char*)
 
 
+/* Configuration variable in the environment snapshot */
+typedef struct {
+    const char                  *name;
+    const char                  *value;
+    int                         from_env; /* Variable owned by the snapshot */
+} ucs_config_snapshot_var_t;
+
+
+/* Sorted snapshot of environment and configuration file variables. Variables
+ * are ordered by name, and an environment variable precedes a configuration
+ * file variable with the same name, so a single binary search resolves both
+ * exact lookups and prefix queries. */
+typedef struct {
+    ucs_config_snapshot_var_t   *vars;
+    size_t                      count;
+    char                        **env;      /* Environment at snapshot time */
+    size_t                      env_count;
+    uint64_t                    env_digest;
+    unsigned                    file_vars_gen;
+    int                         valid;
+} ucs_config_snapshot_t;
+
+
+/* Parsed configuration table, cloned to fill subsequent requests */
+typedef struct {
+    ucs_config_field_t          *fields;
+    void                        *opts;
+} ucs_config_table_cache_entry_t;
+
+
+KHASH_MAP_INIT_STR(ucs_config_table_cache, ucs_config_table_cache_entry_t)
+
+
 /* Process environment variables */
 extern char **environ;
 
@@ -57,6 +94,10 @@ UCS_LIST_HEAD(ucs_config_global_list);
 static khash_t(ucs_config_env_vars) ucs_config_parser_env_vars = {0};
 static khash_t(ucs_config_map) ucs_config_file_vars            = {0};
 static pthread_mutex_t ucs_config_parser_env_vars_hash_lock    = PTHREAD_MUTEX_INITIALIZER;
+static unsigned ucs_config_file_vars_gen                       = 0;
+static ucs_config_snapshot_t ucs_config_snapshot               = {0};
+static khash_t(ucs_config_table_cache) ucs_config_table_cache  = {0};
+static pthread_mutex_t ucs_config_snapshot_lock                = PTHREAD_MUTEX_INITIALIZER;
 static char ucs_config_parser_negate                           = '^';
 static ucs_init_once_t ucs_config_range_regex_init             = UCS_INIT_ONCE_INITIALIZER;
 static regex_t ucs_config_range_regex;
@@ -1765,6 +1806,199 @@ static char *ucs_config_get_value_from_config_file(const char *name)
     return kh_val(&ucs_config_file_vars, iter);
 }
 
+static uint64_t ucs_config_snapshot_env_digest(size_t *count_p)
+{
+    uint64_t digest = UCS_CONFIG_SNAPSHOT_DIGEST_INIT;
+    char **envp;
+
+    /* setenv() and unsetenv() replace the entry pointers, so hashing the
+     * pointers is enough to detect environment changes without scanning the
+     * strings */
+    for (envp = environ; *envp != NULL; ++envp) {
+        digest = (digest ^ (uintptr_t)*envp) * UCS_CONFIG_SNAPSHOT_DIGEST_PRIME;
+    }
+
+    *count_p = envp - environ;
+    return digest;
+}
+
+static int ucs_config_snapshot_var_compare(const void *elem1, const void *elem2)
+{
+    const ucs_config_snapshot_var_t *var1 = elem1;
+    const ucs_config_snapshot_var_t *var2 = elem2;
+    int ret;
+
+    ret = strcmp(var1->name, var2->name);
+    if (ret != 0) {
+        return ret;
+    }
+
+    /* Environment variables have precedence over file config */
+    return var2->from_env - var1->from_env;
+}
+
+static void ucs_config_snapshot_release(ucs_config_snapshot_t *snapshot)
+{
+    size_t i;
+
+    for (i = 0; i < snapshot->count; ++i) {
+        if (snapshot->vars[i].from_env) {
+            ucs_free((void*)snapshot->vars[i].name);
+        }
+    }
+
+    ucs_free(snapshot->vars);
+    snapshot->vars  = NULL;
+    snapshot->count = 0;
+    snapshot->valid = 0;
+}
+
+static void ucs_config_table_cache_flush()
+{
+    ucs_config_table_cache_entry_t cache_entry;
+    const char *key;
+
+    kh_foreach(&ucs_config_table_cache, key, cache_entry, {
+        ucs_config_parser_release_opts(cache_entry.opts, cache_entry.fields);
+        ucs_free(cache_entry.opts);
+        ucs_free((void*)key);
+    })
+    kh_clear(ucs_config_table_cache, &ucs_config_table_cache);
+}
+
+static void ucs_config_snapshot_build(ucs_config_snapshot_t *snapshot)
+{
+    size_t max_count = snapshot->env_count + kh_size(&ucs_config_file_vars);
+    ucs_config_snapshot_var_t *var;
+    const char *name;
+    char *value, *str;
+    char **envp;
+
+    snapshot->vars = ucs_malloc(sizeof(*snapshot->vars) * ucs_max(max_count, 1),
+                                "config_snapshot");
+    if (snapshot->vars == NULL) {
+        /* Leave the snapshot invalid, so lookups fall back to getenv() */
+        return;
+    }
+
+    var = snapshot->vars;
+    for (envp = snapshot->env; *envp != NULL; ++envp) {
+        str = ucs_strdup(*envp, "config_snapshot_var");
+        if (str == NULL) {
+            goto err;
+        }
+
+        value = strchr(str, '=');
+        if (value == NULL) {
+            ucs_free(str);
+            continue;
+        }
+
+        *(value++)    = '\0';
+        var->name     = str;
+        var->value    = value;
+        var->from_env = 1;
+        ++var;
+        ++snapshot->count;
+    }
+
+    kh_foreach(&ucs_config_file_vars, name, value, {
+        var->name     = name;
+        var->value    = value;
+        var->from_env = 0;
+        ++var;
+        ++snapshot->count;
+    })
+
+    qsort(snapshot->vars, snapshot->count, sizeof(*snapshot->vars),
+          ucs_config_snapshot_var_compare);
+    snapshot->valid = 1;
+    return;
+
+err:
+    ucs_config_snapshot_release(snapshot);
+}
+
+/* Rebuild the snapshot if the environment or the configuration file variables
+ * were changed since it was taken. Must be called with the snapshot lock. */
+static void ucs_config_snapshot_update()
+{
+    ucs_config_snapshot_t *snapshot = &ucs_config_snapshot;
+    size_t env_count;
+    uint64_t env_digest;
+
+    env_digest = ucs_config_snapshot_env_digest(&env_count);
+    if (snapshot->valid && (snapshot->env == environ) &&
+        (snapshot->env_count == env_count) &&
+        (snapshot->env_digest == env_digest) &&
+        (snapshot->file_vars_gen == ucs_config_file_vars_gen)) {
+        return;
+    }
+
+    ucs_config_table_cache_flush();
+    ucs_config_snapshot_release(snapshot);
+
+    snapshot->env           = environ;
+    snapshot->env_count     = env_count;
+    snapshot->env_digest    = env_digest;
+    snapshot->file_vars_gen = ucs_config_file_vars_gen;
+    ucs_config_snapshot_build(snapshot);
+}
+
+/* Return the index of the first variable whose name is not less than 'name' */
+static size_t ucs_config_snapshot_lower_bound(const char *name)
+{
+    size_t low  = 0;
+    size_t high = ucs_config_snapshot.count;
+    size_t mid;
+
+    while (low < high) {
+        mid = (low + high) / 2;
+        if (strcmp(ucs_config_snapshot.vars[mid].name, name) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+static int ucs_config_snapshot_has_prefix(const char *prefix)
+{
+    size_t index;
+
+    if (!ucs_config_snapshot.valid) {
+        return 1;
+    }
+
+    index = ucs_config_snapshot_lower_bound(prefix);
+    return (index < ucs_config_snapshot.count) &&
+           !strncmp(ucs_config_snapshot.vars[index].name, prefix,
+                    strlen(prefix));
+}
+
+static const char *ucs_config_snapshot_get_value(const char *name)
+{
+    const char *value;
+    size_t index;
+
+    if (!ucs_config_snapshot.valid) {
+        /* Env variable has precedence over file config */
+        value = getenv(name);
+        return (value != NULL) ? value :
+                                 ucs_config_get_value_from_config_file(name);
+    }
+
+    index = ucs_config_snapshot_lower_bound(name);
+    if ((index < ucs_config_snapshot.count) &&
+        !strcmp(ucs_config_snapshot.vars[index].name, name)) {
+        return ucs_config_snapshot.vars[index].value;
+    }
+
+    return NULL;
+}
+
 static int ucs_config_parse_check_filter(const char *name, const char *value)
 {
     typedef struct {
@@ -1827,6 +2061,10 @@ static int ucs_config_parse_config_file_line(void *arg, const char *section,
     iter = kh_get(ucs_config_map, &ucs_config_file_vars, name);
     if (iter != kh_end(&ucs_config_file_vars)) {
         if (parse_arg->override) {
+            if (!strcmp(kh_val(&ucs_config_file_vars, iter), value)) {
+                return 1; /* Same value, keep the snapshot valid */
+            }
+
             ucs_free(kh_val(&ucs_config_file_vars, iter));
         } else {
             ucs_error("found duplicate '%s' in config map", name);
@@ -1842,6 +2080,7 @@ static int ucs_config_parse_config_file_line(void *arg, const char *section,
     }
 
     kh_val(&ucs_config_file_vars, iter) = ucs_strdup(value, "config_value");
+    ++ucs_config_file_vars_gen;
     return 1;
 }
 
@@ -1896,11 +2135,17 @@ ucs_config_apply_config_vars(void *opts, ucs_config_field_t *fields,
     const char *env_value;
     void *var;
     char buf[256];
-    int added;
+    int added, has_vars;
+
+    /* All variables of this table and its sub-tables start with the prefix */
+    if (!ucs_config_snapshot_has_prefix(prefix)) {
+        return UCS_OK;
+    }
 
     /* Put prefix in the buffer. Later we replace only the variable name part */
     snprintf(buf, sizeof(buf) - 1, "%s%s", prefix, table_prefix ? table_prefix : "");
     prefix_len = strlen(buf);
+    has_vars   = ucs_config_snapshot_has_prefix(buf);
 
     /* Parse environment variables */
     for (field = fields; !ucs_config_field_is_last(field); ++field) {
@@ -1921,7 +2166,7 @@ ucs_config_apply_config_vars(void *opts, ucs_config_field_t *fields,
             }
 
             /* Possible override with my prefix */
-            if (table_prefix) {
+            if (table_prefix && has_vars) {
                 status = ucs_config_apply_config_vars(var, sub_fields, prefix,
                                                       table_prefix, 0,
                                                       ignore_errors);
@@ -1929,16 +2174,11 @@ ucs_config_apply_config_vars(void *opts, ucs_config_field_t *fields,
                     return status;
                 }
             }
-        } else {
+        } else if (has_vars) {
             /* Read and parse environment variable */
             strncpy(buf + prefix_len, field->name, sizeof(buf) - prefix_len - 1);
 
-            /* Env variable has precedence over file config */
-            env_value = getenv(buf);
-            if (env_value == NULL) {
-                env_value = ucs_config_get_value_from_config_file(buf);
-            }
-
+            env_value = ucs_config_snapshot_get_value(buf);
             if (env_value == NULL) {
                 continue;
             }
@@ -2038,12 +2278,12 @@ void ucs_config_parse_config_files()
     ucs_config_parse_config_file(".", UCX_CONFIG_FILE_NAME, 1);
 }
 
-ucs_status_t
-ucs_config_parser_fill_opts(void *opts, ucs_config_global_list_entry_t *entry,
-                            const char *env_prefix, int ignore_errors)
+static ucs_status_t
+ucs_config_parser_fill_opts_internal(void *opts,
+                                     ucs_config_global_list_entry_t *entry,
+                                     const char *env_prefix, int ignore_errors)
 {
     const char   *sub_prefix = NULL;
-    static ucs_init_once_t config_file_parse = UCS_INIT_ONCE_INITIALIZER;
     ucs_status_t status;
 
     /* Set default values */
@@ -2058,10 +2298,6 @@ ucs_config_parser_fill_opts(void *opts, ucs_config_global_list_entry_t *entry,
         goto err;
     }
 
-    UCS_INIT_ONCE(&config_file_parse) {
-        ucs_config_parse_config_files();
-    }
-
     /* Apply environment variables */
     if (sub_prefix != NULL) {
         status = ucs_config_apply_config_vars(opts, entry->table, sub_prefix,
@@ -2078,7 +2314,6 @@ ucs_config_parser_fill_opts(void *opts, ucs_config_global_list_entry_t *entry,
         goto err_free;
     }
 
-    entry->flags |= UCS_CONFIG_TABLE_FLAG_LOADED;
     return UCS_OK;
 
 err_free:
@@ -2088,6 +2323,96 @@ err:
     return status;
 }
 
+/* Save a copy of the parsed table, to be cloned by subsequent requests with
+ * the same prefixes as long as the snapshot remains valid */
+static void
+ucs_config_table_cache_add(const char *key, const void *opts,
+                           ucs_config_global_list_entry_t *entry)
+{
+    ucs_config_table_cache_entry_t *cache_entry;
+    khiter_t iter;
+    char *key_dup;
+    void *opts_dup;
+    int ret;
+
+    opts_dup = ucs_calloc(1, entry->size, "config_table_cache");
+    if (opts_dup == NULL) {
+        return;
+    }
+
+    if (ucs_config_parser_clone_opts(opts, opts_dup, entry->table) != UCS_OK) {
+        goto err_free_opts;
+    }
+
+    key_dup = ucs_strdup(key, "config_table_cache_key");
+    if (key_dup == NULL) {
+        goto err_release_opts;
+    }
+
+    iter = kh_put(ucs_config_table_cache, &ucs_config_table_cache, key_dup,
+                  &ret);
+    if ((ret == UCS_KH_PUT_FAILED) || (ret == UCS_KH_PUT_KEY_PRESENT)) {
+        goto err_free_key;
+    }
+
+    cache_entry         = &kh_val(&ucs_config_table_cache, iter);
+    cache_entry->fields = entry->table;
+    cache_entry->opts   = opts_dup;
+    return;
+
+err_free_key:
+    ucs_free(key_dup);
+err_release_opts:
+    ucs_config_parser_release_opts(opts_dup, entry->table);
+err_free_opts:
+    ucs_free(opts_dup);
+}
+
+ucs_status_t
+ucs_config_parser_fill_opts(void *opts, ucs_config_global_list_entry_t *entry,
+                            const char *env_prefix, int ignore_errors)
+{
+    static ucs_init_once_t config_file_parse = UCS_INIT_ONCE_INITIALIZER;
+    ucs_config_table_cache_entry_t *cache_entry;
+    ucs_status_t status;
+    khiter_t iter;
+    char key[256];
+
+    UCS_INIT_ONCE(&config_file_parse) {
+        ucs_config_parse_config_files();
+    }
+
+    pthread_mutex_lock(&ucs_config_snapshot_lock);
+
+    ucs_config_snapshot_update();
+
+    ucs_snprintf_safe(key, sizeof(key), "%p:%zu:%s:%s:%d", entry->table,
+                      entry->size, entry->prefix ? entry->prefix : "",
+                      env_prefix, ignore_errors);
+    iter = kh_get(ucs_config_table_cache, &ucs_config_table_cache, key);
+    if (iter != kh_end(&ucs_config_table_cache)) {
+        cache_entry = &kh_val(&ucs_config_table_cache, iter);
+        status      = ucs_config_parser_clone_opts(cache_entry->opts, opts,
+                                                   entry->table);
+    } else {
+        status = ucs_config_parser_fill_opts_internal(opts, entry, env_prefix,
+                                                      ignore_errors);
+        if ((status == UCS_OK) && ucs_config_snapshot.valid &&
+            (entry->size != 0)) {
+            ucs_config_table_cache_add(key, opts, entry);
+        }
+    }
+
+    pthread_mutex_unlock(&ucs_config_snapshot_lock);
+
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    entry->flags |= UCS_CONFIG_TABLE_FLAG_LOADED;
+    return UCS_OK;
+}
+
 ucs_status_t ucs_config_parser_set_value(void *opts, ucs_config_field_t *fields,
                                          const char *prefix, const char *name,
                                          const char *value)
@@ -2680,6 +3005,10 @@ void ucs_config_parser_cleanup()
     })
     kh_destroy_inplace(ucs_config_map, &ucs_config_file_vars);
 
+    ucs_config_table_cache_flush();
+    kh_destroy_inplace(ucs_config_table_cache, &ucs_config_table_cache);
+    ucs_config_snapshot_release(&ucs_config_snapshot);
+
     UCS_CLEANUP_ONCE(&ucs_config_range_regex_init) {
         regfree(&ucs_config_range_regex);
     }
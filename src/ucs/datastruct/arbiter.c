@@ -25,6 +25,17 @@ void ucs_arbiter_group_init(ucs_arbiter_group_t *group)
     UCS_ARBITER_GROUP_GUARD_INIT(group);
 }
 
+void ucs_arbiter_drr_group_init(ucs_arbiter_drr_group_t *group,
+                                unsigned weight)
+{
+    ucs_assert(weight > 0);
+
+    ucs_arbiter_group_init(&group->super);
+    group->weight  = weight;
+    group->deficit = 0;
+    group->backlog = 0;
+}
+
 void ucs_arbiter_cleanup(ucs_arbiter_t *arbiter)
 {
     ucs_assert_always(ucs_arbiter_is_empty(arbiter));
@@ -171,6 +182,23 @@ void ucs_arbiter_group_purge(ucs_arbiter_t *arbiter,
     }
 }
 
+void ucs_arbiter_drr_group_cleanup(ucs_arbiter_drr_group_t *group)
+{
+    ucs_assert_always(group->backlog == 0);
+    ucs_arbiter_group_cleanup(&group->super);
+}
+
+void ucs_arbiter_drr_group_purge(ucs_arbiter_t *arbiter,
+                                 ucs_arbiter_drr_group_t *group,
+                                 ucs_arbiter_callback_t cb, void *cb_arg)
+{
+    ucs_arbiter_group_purge(arbiter, &group->super, cb, cb_arg);
+    group->backlog = ucs_arbiter_group_num_elems(&group->super);
+    if (group->backlog == 0) {
+        group->deficit = 0;
+    }
+}
+
 size_t ucs_arbiter_group_num_elems(ucs_arbiter_group_t *group)
 {
     ucs_arbiter_elem_t *elem = group->tail;
@@ -404,6 +432,161 @@ out:
     ucs_list_splice_tail(&arbiter->list, &resched_list);
 }
 
+/*
+ * Put back the group elements which were not consumed by a batch callback, in
+ * front of the elements pushed to the group during the callback, and return
+ * the new group head, or NULL if the group is empty.
+ */
+static ucs_arbiter_elem_t *
+ucs_arbiter_drr_group_restore(ucs_arbiter_group_t *group,
+                              ucs_arbiter_elem_t *first,
+                              ucs_arbiter_elem_t *last)
+{
+    ucs_arbiter_elem_t *new_tail = group->tail;
+    ucs_arbiter_elem_t *new_head;
+
+    if (first == NULL) {
+        return (new_tail == NULL) ? NULL : new_tail->next;
+    }
+
+    if (new_tail == NULL) {
+        last->next  = first;
+        group->tail = last;
+        ucs_arbiter_group_head_reset(first);
+        return first;
+    }
+
+    new_head       = new_tail->next;
+    last->next     = new_head;
+    new_tail->next = first;
+    if (ucs_arbiter_group_head_is_scheduled(new_head)) {
+        /* take over a recursively scheduled group */
+        ucs_list_replace(&new_head->list, &first->list);
+        ucs_arbiter_group_head_reset(new_head);
+    } else {
+        ucs_arbiter_group_head_reset(first);
+    }
+
+    return first;
+}
+
+void ucs_arbiter_dispatch_drr_nonempty(ucs_arbiter_t *arbiter, unsigned quantum,
+                                       ucs_arbiter_batch_callback_t cb,
+                                       void *cb_arg)
+{
+    ucs_arbiter_elem_t *elems[UCS_ARBITER_DRR_BATCH_MAX];
+    ucs_arbiter_elem_t *group_head, *tail, *rest;
+    ucs_arbiter_drr_group_t *drr_group;
+    ucs_arbiter_cb_result_t result;
+    ucs_arbiter_group_t *group;
+    unsigned count, removed, i;
+    unsigned visit_credits;
+    UCS_LIST_HEAD(resched_list);
+
+    ucs_assert(!ucs_list_is_empty(&arbiter->list));
+    ucs_assert(quantum > 0);
+
+    do {
+        group_head = ucs_list_extract_head(&arbiter->list, ucs_arbiter_elem_t,
+                                           list);
+        ucs_assert(group_head != NULL);
+        ucs_arbiter_group_head_reset(group_head);
+
+        group         = group_head->group;
+        drr_group     = ucs_derived_of(group, ucs_arbiter_drr_group_t);
+        visit_credits = quantum * drr_group->weight;
+        drr_group->deficit += visit_credits;
+        UCS_ARBITER_GROUP_GUARD_CHECK(group);
+
+        for (;;) {
+            ucs_assert(group->tail->next == group_head);
+            ucs_assert(drr_group->backlog > 0);
+
+            /* collect the batch, and detach the whole group so the callback
+             * could push new elements to it */
+            tail  = group->tail;
+            rest  = group_head;
+            count = 0;
+            do {
+                elems[count++] = rest;
+                rest           = (rest == tail) ? NULL : rest->next;
+            } while ((rest != NULL) && (count < drr_group->deficit) &&
+                     (count < UCS_ARBITER_DRR_BATCH_MAX));
+
+            for (i = 0; i < count; ++i) {
+                ucs_arbiter_elem_init(elems[i]);
+            }
+            group->tail = NULL;
+
+            ucs_trace_poll("dispatching %u arbiter elements from group %p",
+                           count, group);
+            result = UCS_ARBITER_CB_RESULT_NEXT_GROUP;
+            UCS_ARBITER_GROUP_GUARD_ENTER(group);
+            removed = cb(arbiter, group, elems, count, &result, cb_arg);
+            UCS_ARBITER_GROUP_GUARD_EXIT(group);
+            ucs_trace_poll("dispatch removed %u, result: %d", removed, result);
+
+            ucs_assert(removed <= count);
+            ucs_assert(drr_group->backlog >= removed);
+            drr_group->backlog -= removed;
+            drr_group->deficit -= ucs_min(removed, drr_group->deficit);
+
+            for (i = removed; i < count; ++i) {
+                ucs_arbiter_elem_set_scheduled(elems[i], group);
+            }
+
+            group_head = ucs_arbiter_drr_group_restore(
+                    group, (removed < count) ? elems[removed] : rest, tail);
+            if (group_head == NULL) {
+                /* group is empty now */
+                drr_group->deficit = 0;
+                UCS_ARBITER_GROUP_ARBITER_SET(group, NULL);
+                break;
+            }
+
+            if (removed < count) {
+                /* keep up to one visit's worth of credits for the next time */
+                drr_group->deficit = ucs_min(drr_group->deficit, visit_credits);
+                if (result == UCS_ARBITER_CB_RESULT_DESCHED_GROUP) {
+                    if (!ucs_arbiter_group_head_is_scheduled(group_head)) {
+                        UCS_ARBITER_GROUP_ARBITER_SET(group, NULL);
+                    }
+                    break;
+                }
+
+                /* remove a recursively scheduled group, give priority to the
+                 * original order */
+                ucs_arbiter_remove_and_reset_if_scheduled(group_head);
+                if (result == UCS_ARBITER_CB_RESULT_NEXT_GROUP) {
+                    ucs_list_add_tail(&arbiter->list, &group_head->list);
+                } else if (result == UCS_ARBITER_CB_RESULT_RESCHED_GROUP) {
+                    ucs_list_add_tail(&resched_list, &group_head->list);
+                } else if (result == UCS_ARBITER_CB_RESULT_STOP) {
+                    ucs_list_add_head(&arbiter->list, &group_head->list);
+                    goto out;
+                } else {
+                    ucs_bug("unexpected return value from arbiter callback");
+                }
+                break;
+            }
+
+            if (ucs_arbiter_group_head_is_scheduled(group_head)) {
+                /* the group was scheduled by the callback */
+                break;
+            } else if (drr_group->deficit == 0) {
+                /* out of credits, continue to next group */
+                ucs_list_add_tail(&arbiter->list, &group_head->list);
+                break;
+            }
+
+            /* the whole batch was consumed, continue with new group head */
+        }
+    } while (!ucs_list_is_empty(&arbiter->list));
+
+out:
+    ucs_list_splice_tail(&arbiter->list, &resched_list);
+}
+
 void ucs_arbiter_dump(ucs_arbiter_t *arbiter, FILE *stream)
 {
     static const int max_groups = 100;
@@ -77,9 +77,16 @@
  *
  */
 
-typedef struct ucs_arbiter        ucs_arbiter_t;
-typedef struct ucs_arbiter_group  ucs_arbiter_group_t;
-typedef struct ucs_arbiter_elem   ucs_arbiter_elem_t;
+typedef struct ucs_arbiter           ucs_arbiter_t;
+typedef struct ucs_arbiter_group     ucs_arbiter_group_t;
+typedef struct ucs_arbiter_elem      ucs_arbiter_elem_t;
+typedef struct ucs_arbiter_drr_group ucs_arbiter_drr_group_t;
+
+
+/**
+ * Maximal number of elements passed to a single batch dispatch callback.
+ */
+#define UCS_ARBITER_DRR_BATCH_MAX 32
 
 
 /**
@@ -142,6 +149,32 @@ typedef ucs_arbiter_cb_result_t (*ucs_arbiter_callback_t)(ucs_arbiter_t *arbiter
                                                           void *arg);
 
 
+/**
+ * Arbiter batch callback function, used by deficit-round-robin dispatch.
+ *
+ * @param [in]  arbiter   The arbiter.
+ * @param [in]  group     Group which is dispatched.
+ * @param [in]  elems     Array of the first @a count group elements, in order.
+ * @param [in]  count     Number of elements in @a elems.
+ * @param [out] result_p  What to do with the group if not all elements were
+ *                        consumed. Any value except REMOVE_ELEM is allowed.
+ * @param [in]  arg       User-defined argument.
+ *
+ * @return Number of leading elements of @a elems which were consumed and must
+ *         be removed from the group. The callback may release them, but must
+ *         not modify the rest of the elements.
+ *
+ * @note The group is detached while the callback runs, so it looks empty; new
+ *       elements pushed by the callback are queued after the remaining ones.
+ */
+typedef unsigned (*ucs_arbiter_batch_callback_t)(ucs_arbiter_t *arbiter,
+                                                 ucs_arbiter_group_t *group,
+                                                 ucs_arbiter_elem_t **elems,
+                                                 unsigned count,
+                                                 ucs_arbiter_cb_result_t *result_p,
+                                                 void *arg);
+
+
 /**
  * Top-level arbiter.
  */
@@ -171,6 +204,20 @@ struct ucs_arbiter_elem {
 };
 
 
+/**
+ * Arbitration group for deficit-round-robin dispatch. Every time the group is
+ * visited it gains quantum * weight credits, and every dispatched element
+ * consumes one credit. The group also tracks its backlog, so it must be used
+ * only with the ucs_arbiter_drr_* functions and ucs_arbiter_dispatch_drr().
+ */
+struct ucs_arbiter_drr_group {
+    ucs_arbiter_group_t     super;
+    unsigned                weight;     /* Quantum multiplier */
+    unsigned                deficit;    /* Credits left from previous visits */
+    size_t                  backlog;    /* Number of queued elements */
+};
+
+
 /**
  * Initialize the arbiter object.
  *
@@ -189,6 +236,17 @@ void ucs_arbiter_group_init(ucs_arbiter_group_t *group);
 void ucs_arbiter_group_cleanup(ucs_arbiter_group_t *group);
 
 
+/**
+ * Initialize a deficit-round-robin group object.
+ *
+ * @param [in]  group    Group to initialize.
+ * @param [in]  weight   Relative share of the group, must be nonzero.
+ */
+void ucs_arbiter_drr_group_init(ucs_arbiter_drr_group_t *group,
+                                unsigned weight);
+void ucs_arbiter_drr_group_cleanup(ucs_arbiter_drr_group_t *group);
+
+
 /**
  * Initialize an element object.
  *
@@ -233,6 +291,14 @@ void ucs_arbiter_group_purge(ucs_arbiter_t *arbiter, ucs_arbiter_group_t *group,
                              ucs_arbiter_callback_t cb, void *cb_arg);
 
 
+/**
+ * Same as @ref ucs_arbiter_group_purge, for a deficit-round-robin group.
+ */
+void ucs_arbiter_drr_group_purge(ucs_arbiter_t *arbiter,
+                                 ucs_arbiter_drr_group_t *group,
+                                 ucs_arbiter_callback_t cb, void *cb_arg);
+
+
 /**
  * @return Number of elements in the group
  */
@@ -257,6 +323,12 @@ void ucs_arbiter_dispatch_nonempty(ucs_arbiter_t *arbiter, unsigned per_group,
                                    ucs_arbiter_callback_t cb, void *cb_arg);
 
 
+/* Internal function */
+void ucs_arbiter_dispatch_drr_nonempty(ucs_arbiter_t *arbiter, unsigned quantum,
+                                       ucs_arbiter_batch_callback_t cb,
+                                       void *cb_arg);
+
+
 /**
  * Return true if arbiter has no groups scheduled
  *
@@ -388,6 +460,82 @@ ucs_arbiter_dispatch(ucs_arbiter_t *arbiter, unsigned per_group,
 }
 
 
+/**
+ * Add a new work element to a deficit-round-robin group if it is not already
+ * there.
+ *
+ * @param [in]  group    Group to add the element to.
+ * @param [in]  elem     Work element to add.
+ */
+static inline void
+ucs_arbiter_drr_group_push_elem(ucs_arbiter_drr_group_t *group,
+                                ucs_arbiter_elem_t *elem)
+{
+    if (ucs_arbiter_elem_is_scheduled(elem)) {
+        return;
+    }
+
+    ucs_arbiter_group_push_elem_always(&group->super, elem);
+    ++group->backlog;
+}
+
+
+/**
+ * Add a new work element to the head of a deficit-round-robin group if it is
+ * not already there.
+ *
+ * @param [in]  group    Group to add the element to.
+ * @param [in]  elem     Work element to add.
+ */
+static inline void
+ucs_arbiter_drr_group_push_head_elem(ucs_arbiter_drr_group_t *group,
+                                     ucs_arbiter_elem_t *elem)
+{
+    if (ucs_arbiter_elem_is_scheduled(elem)) {
+        return;
+    }
+
+    ucs_arbiter_group_push_head_elem_always(&group->super, elem);
+    ++group->backlog;
+}
+
+
+/**
+ * @return Number of elements queued on a deficit-round-robin group, including
+ *         the ones being dispatched right now.
+ */
+static inline size_t
+ucs_arbiter_drr_group_backlog(const ucs_arbiter_drr_group_t *group)
+{
+    return group->backlog;
+}
+
+
+/**
+ * Dispatch work elements in deficit-round-robin order. Every time a group is
+ * visited, its credits grow by quantum * weight, and its leading elements are
+ * passed to the callback in batches of up to @ref UCS_ARBITER_DRR_BATCH_MAX,
+ * until either the credits or the group elements are exhausted, or the
+ * callback does not consume the whole batch. Unused credits are kept, up to
+ * one visit's worth, so a group which ran out of resources gets its share on
+ * the next dispatch. All groups on the arbiter must be
+ * @ref ucs_arbiter_drr_group_t.
+ *
+ * @param [in]  arbiter    Arbiter object to dispatch work on.
+ * @param [in]  quantum    Credits added to a group of weight 1 on every visit.
+ * @param [in]  cb         User-defined callback to be called for each batch.
+ * @param [in]  cb_arg     Last argument for the callback.
+ */
+static inline void
+ucs_arbiter_dispatch_drr(ucs_arbiter_t *arbiter, unsigned quantum,
+                         ucs_arbiter_batch_callback_t cb, void *cb_arg)
+{
+    if (ucs_unlikely(!ucs_arbiter_is_empty(arbiter))) {
+        ucs_arbiter_dispatch_drr_nonempty(arbiter, quantum, cb, cb_arg);
+    }
+}
+
+
 /**
  * @return true if element is the only one in the group
  */
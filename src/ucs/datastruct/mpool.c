@@ -56,6 +56,7 @@ void ucs_mpool_params_reset(ucs_mpool_params_t *params)
     params->grow_factor     = 1.0;
     params->ops             = NULL;
     params->name            = "";
+    params->numa_node       = UCS_NUMA_NODE_UNDEFINED;
 }
 
 static size_t ucs_mpool_chunk_size(ucs_mpool_t *mp, unsigned num_elems)
@@ -101,6 +102,7 @@ ucs_status_t ucs_mpool_init(const ucs_mpool_params_t *params, ucs_mpool_t *mp)
     mp->data->tail            = NULL;
     mp->data->chunks          = NULL;
     mp->data->ops             = params->ops;
+    mp->data->numa_node       = params->numa_node;
     mp->data->name            = ucs_strdup(params->name, "mpool_data_name");
 
     if (mp->data->name == NULL) {
@@ -300,9 +302,49 @@ void *ucs_mpool_get_grow(ucs_mpool_t *mp)
     return ucs_mpool_get(mp);
 }
 
+static void ucs_mpool_chunk_numa_bind(ucs_mpool_t *mp, void *ptr, size_t size)
+{
+    ucs_status_t status;
+
+    if (mp->data->numa_node == UCS_NUMA_NODE_UNDEFINED) {
+        return;
+    }
+
+    status = ucs_numa_mbind(ptr, size, mp->data->numa_node);
+    if (status != UCS_OK) {
+        ucs_debug("mpool %s: failed to bind chunk %p to numa node %d: %s",
+                  ucs_mpool_name(mp), ptr, mp->data->numa_node,
+                  ucs_status_string(status));
+    }
+}
+
+/* Allocate a chunk from glibc. If the pool has a NUMA node, the chunk is made
+ * of whole pages, so the memory policy does not affect other allocations */
+static void *ucs_mpool_chunk_glibc_alloc(ucs_mpool_t *mp, size_t *size_p)
+{
+    size_t page_size;
+    void *ptr;
+    int ret;
+
+    if (mp->data->numa_node == UCS_NUMA_NODE_UNDEFINED) {
+        return ucs_malloc(*size_p, ucs_mpool_name(mp));
+    }
+
+    page_size = ucs_get_page_size();
+    *size_p   = ucs_align_up(*size_p, page_size);
+    ret       = ucs_posix_memalign(&ptr, page_size, *size_p,
+                                   ucs_mpool_name(mp));
+    if (ret != 0) {
+        return NULL;
+    }
+
+    ucs_mpool_chunk_numa_bind(mp, ptr, *size_p);
+    return ptr;
+}
+
 ucs_status_t ucs_mpool_chunk_malloc(ucs_mpool_t *mp, size_t *size_p, void **chunk_p)
 {
-    *chunk_p = ucs_malloc(*size_p, ucs_mpool_name(mp));
+    *chunk_p = ucs_mpool_chunk_glibc_alloc(mp, size_p);
     return (*chunk_p == NULL) ? UCS_ERR_NO_MEMORY : UCS_OK;
 }
 
@@ -328,6 +370,7 @@ ucs_status_t ucs_mpool_chunk_mmap(ucs_mpool_t *mp, size_t *size_p, void **chunk_
         return UCS_ERR_NO_MEMORY;
     }
 
+    ucs_mpool_chunk_numa_bind(mp, chunk, real_size);
     chunk->size = real_size;
     *size_p     = real_size - sizeof(*chunk);
     *chunk_p    = chunk + 1;
@@ -346,15 +389,20 @@ typedef struct ucs_hugetlb_mpool_chunk_hdr {
     int hugetlb;
 } ucs_hugetlb_mpool_chunk_hdr_t;
 
-ucs_status_t ucs_mpool_hugetlb_malloc(ucs_mpool_t *mp, size_t *size_p, void **chunk_p)
+static ucs_status_t
+ucs_mpool_hugetlb_chunk_alloc(ucs_mpool_t *mp, size_t *size_p, void **chunk_p,
+                              int try_thp)
 {
     ucs_hugetlb_mpool_chunk_hdr_t *chunk;
     size_t real_size;
-#ifdef SHM_HUGETLB
     void *ptr;
+#ifdef SHM_HUGETLB
     ucs_status_t status;
     int shmid;
 #endif
+#ifdef MADV_HUGEPAGE
+    ssize_t huge_page_size;
+#endif
 
 #ifdef SHM_HUGETLB
     ptr = NULL;
@@ -364,15 +412,36 @@ ucs_status_t ucs_mpool_hugetlb_malloc(ucs_mpool_t *mp, size_t *size_p, void **ch
     status = ucs_sysv_alloc(&real_size, real_size * 2, (void**)&ptr, SHM_HUGETLB,
                             ucs_mpool_name(mp), &shmid);
     if (status == UCS_OK) {
+        ucs_mpool_chunk_numa_bind(mp, ptr, real_size);
         chunk = ptr;
         chunk->hugetlb = 1;
         goto out_ok;
     }
 #endif
 
+#ifdef MADV_HUGEPAGE
+    /* Then, try transparent huge pages with huge page aligned chunks */
+    huge_page_size = try_thp ? ucs_get_huge_page_size() : -1;
+    if ((huge_page_size > 0) && ucs_is_thp_enabled()) {
+        real_size = ucs_align_up(*size_p, huge_page_size);
+        if (ucs_posix_memalign(&ptr, huge_page_size, real_size,
+                               ucs_mpool_name(mp)) == 0) {
+            if (madvise(ptr, real_size, MADV_HUGEPAGE) != 0) {
+                ucs_debug("madvise(address=%p, length=%zu, HUGEPAGE) "
+                          "failed: %m", ptr, real_size);
+            }
+
+            ucs_mpool_chunk_numa_bind(mp, ptr, real_size);
+            chunk = ptr;
+            chunk->hugetlb = 0;
+            goto out_ok;
+        }
+    }
+#endif
+
     /* Fallback to glibc */
     real_size = *size_p;
-    chunk = ucs_malloc(real_size, ucs_mpool_name(mp));
+    chunk = ucs_mpool_chunk_glibc_alloc(mp, &real_size);
     if (chunk != NULL) {
         chunk->hugetlb = 0;
         goto out_ok;
@@ -386,6 +455,16 @@ out_ok:
     return UCS_OK;
 }
 
+ucs_status_t ucs_mpool_hugetlb_malloc(ucs_mpool_t *mp, size_t *size_p, void **chunk_p)
+{
+    return ucs_mpool_hugetlb_chunk_alloc(mp, size_p, chunk_p, 0);
+}
+
+ucs_status_t ucs_mpool_huge_malloc(ucs_mpool_t *mp, size_t *size_p, void **chunk_p)
+{
+    return ucs_mpool_hugetlb_chunk_alloc(mp, size_p, chunk_p, 1);
+}
+
 void ucs_mpool_hugetlb_free(ucs_mpool_t *mp, void *chunk)
 {
     ucs_hugetlb_mpool_chunk_hdr_t *hdr;
@@ -11,6 +11,7 @@
 #include <ucs/type/status.h>
 #include <ucs/sys/compiler_def.h>
 #include <ucs/datastruct/string_buffer.h>
+#include <ucs/memory/numa.h>
 
 
 BEGIN_C_DECLS
@@ -86,6 +87,7 @@ struct ucs_mpool_data {
     ucs_mpool_chunk_t      *chunks;         /* List of allocated chunks */
     const ucs_mpool_ops_t  *ops;            /* Memory pool operations */
     char                   *name;           /* Name - used for debugging */
+    ucs_numa_node_t        numa_node;       /* NUMA node to allocate chunks on */
 };
 
 
@@ -239,6 +241,12 @@ typedef struct ucs_mpool_params {
      * Memory pool name.
      */
     const char            *name;
+
+    /**
+     * NUMA node to place the chunks on, if the chunk allocator supports it.
+     * @ref UCS_NUMA_NODE_UNDEFINED means no placement policy.
+     */
+    ucs_numa_node_t       numa_node;
 } ucs_mpool_params_t;
 
 
@@ -366,6 +374,14 @@ void ucs_mpool_chunk_munmap(ucs_mpool_t *mp, void *chunk);
 ucs_status_t ucs_mpool_hugetlb_malloc(ucs_mpool_t *mp, size_t *size_p, void **chunk_p);
 void ucs_mpool_hugetlb_free(ucs_mpool_t *mp, void *chunk);
 
+
+/**
+ * Huge pages chunk allocator: tries hugetlb, then transparent huge pages with
+ * chunks rounded up to the huge page size, and falls back to glibc. Chunks are
+ * released by @ref ucs_mpool_hugetlb_free.
+ */
+ucs_status_t ucs_mpool_huge_malloc(ucs_mpool_t *mp, size_t *size_p, void **chunk_p);
+
 END_C_DECLS
 
 #endif /* MPOOL_H_ */
@@ -0,0 +1,368 @@
+/**
+* Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+*
+* See file LICENSE for terms.
+*/
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "mpool_mt.h"
+#include "mpool.inl"
+
+#include <ucs/arch/atomic.h>
+#include <ucs/arch/cpu.h>
+#include <ucs/debug/log.h>
+#include <ucs/debug/memtrack_int.h>
+#include <ucs/sys/compiler.h>
+
+
+#define UCS_MPOOL_MT_DEPOT_INDEX_MASK UCS_MASK(32)
+
+
+/* Array of cached objects, exchanged as a whole with the depot */
+struct ucs_mpool_mt_magazine {
+    uint32_t                 next;   /* Next magazine index + 1 in the depot */
+    unsigned                 count;  /* Number of objects in the magazine */
+    void                     *objs[];
+};
+
+
+/* Per-thread cache: a loaded magazine and a previous one, which is kept either
+ * full or empty, to absorb alternating get/put without touching the depot */
+typedef struct {
+    ucs_mpool_mt_t           *mp;
+    ucs_mpool_mt_magazine_t  *loaded;
+    ucs_mpool_mt_magazine_t  *prev;
+    ucs_list_link_t          list;
+} ucs_mpool_mt_cache_t;
+
+
+static UCS_F_ALWAYS_INLINE ucs_mpool_mt_magazine_t *
+ucs_mpool_mt_magazine(ucs_mpool_mt_t *mp, uint32_t index)
+{
+    return UCS_PTR_BYTE_OFFSET(mp->magazines, index * mp->magazine_size);
+}
+
+static void ucs_mpool_mt_depot_push(ucs_mpool_mt_t *mp,
+                                    ucs_mpool_mt_depot_t *depot,
+                                    ucs_mpool_mt_magazine_t *magazine)
+{
+    uint64_t index = UCS_PTR_BYTE_DIFF(mp->magazines, magazine) /
+                     mp->magazine_size;
+    uint64_t head, new_head;
+
+    do {
+        head           = depot->head;
+        magazine->next = head & UCS_MPOOL_MT_DEPOT_INDEX_MASK;
+        new_head       = ((head >> 32) + 1) << 32 | (index + 1);
+    } while (!ucs_atomic_bool_cswap64(&depot->head, head, new_head));
+}
+
+static ucs_mpool_mt_magazine_t *
+ucs_mpool_mt_depot_pop(ucs_mpool_mt_t *mp, ucs_mpool_mt_depot_t *depot)
+{
+    ucs_mpool_mt_magazine_t *magazine;
+    uint64_t head, new_head;
+    uint32_t top;
+
+    do {
+        head = depot->head;
+        top  = head & UCS_MPOOL_MT_DEPOT_INDEX_MASK;
+        if (top == 0) {
+            return NULL;
+        }
+
+        /* Magazines are never released while the pool is alive, so reading
+         * 'next' is safe even if the magazine was popped by another thread;
+         * the generation tag makes the exchange fail in that case */
+        magazine = ucs_mpool_mt_magazine(mp, top - 1);
+        new_head = ((head >> 32) + 1) << 32 | magazine->next;
+    } while (!ucs_atomic_bool_cswap64(&depot->head, head, new_head));
+
+    return magazine;
+}
+
+static void ucs_mpool_mt_magazine_flush(ucs_mpool_mt_t *mp,
+                                        ucs_mpool_mt_magazine_t *magazine)
+{
+    while (magazine->count > 0) {
+        ucs_mpool_put_inline(magazine->objs[--magazine->count]);
+    }
+}
+
+static void ucs_mpool_mt_cache_release(ucs_mpool_mt_cache_t *cache)
+{
+    ucs_mpool_mt_magazine_t *magazines[] = {cache->loaded, cache->prev};
+    ucs_mpool_mt_t *mp                   = cache->mp;
+    int i;
+
+    for (i = 0; i < ucs_static_array_size(magazines); ++i) {
+        if (magazines[i] == NULL) {
+            continue;
+        }
+
+        if (magazines[i]->count == mp->magazine_elems) {
+            ucs_mpool_mt_depot_push(mp, &mp->full, magazines[i]);
+        } else {
+            ucs_spin_lock(&mp->lock);
+            ucs_mpool_mt_magazine_flush(mp, magazines[i]);
+            ucs_spin_unlock(&mp->lock);
+            ucs_mpool_mt_depot_push(mp, &mp->empty, magazines[i]);
+        }
+    }
+
+    ucs_spin_lock(&mp->lock);
+    ucs_list_del(&cache->list);
+    ucs_spin_unlock(&mp->lock);
+    ucs_free(cache);
+}
+
+static void ucs_mpool_mt_cache_destructor(void *arg)
+{
+    ucs_mpool_mt_cache_release(arg);
+}
+
+static UCS_F_NOINLINE ucs_mpool_mt_cache_t *
+ucs_mpool_mt_cache_create(ucs_mpool_mt_t *mp)
+{
+    ucs_mpool_mt_cache_t *cache;
+
+    cache = ucs_malloc(sizeof(*cache), "ucs_mpool_mt_cache");
+    if (cache == NULL) {
+        ucs_error("mpool %s: failed to allocate thread cache",
+                  ucs_mpool_name(&mp->mp));
+        return NULL;
+    }
+
+    cache->mp     = mp;
+    cache->loaded = ucs_mpool_mt_depot_pop(mp, &mp->empty);
+    cache->prev   = ucs_mpool_mt_depot_pop(mp, &mp->empty);
+
+    ucs_spin_lock(&mp->lock);
+    ucs_list_add_tail(&mp->caches, &cache->list);
+    ucs_spin_unlock(&mp->lock);
+
+    pthread_setspecific(mp->key, cache);
+    return cache;
+}
+
+static UCS_F_ALWAYS_INLINE ucs_mpool_mt_cache_t *
+ucs_mpool_mt_cache(ucs_mpool_mt_t *mp)
+{
+    ucs_mpool_mt_cache_t *cache = pthread_getspecific(mp->key);
+
+    if (ucs_likely(cache != NULL)) {
+        return cache;
+    }
+
+    return ucs_mpool_mt_cache_create(mp);
+}
+
+ucs_status_t ucs_mpool_mt_init(const ucs_mpool_params_t *params,
+                               unsigned magazine_elems, unsigned num_magazines,
+                               ucs_mpool_mt_t *mp)
+{
+    ucs_status_t status;
+    unsigned i;
+    int ret;
+
+    if ((magazine_elems == 0) || (num_magazines == 0) ||
+        (num_magazines > UCS_MPOOL_MT_DEPOT_INDEX_MASK)) {
+        ucs_error("invalid thread-safe mpool parameters: magazine_elems=%u "
+                  "num_magazines=%u", magazine_elems, num_magazines);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    status = ucs_mpool_init(params, &mp->mp);
+    if (status != UCS_OK) {
+        goto err;
+    }
+
+    status = ucs_spinlock_init(&mp->lock, 0);
+    if (status != UCS_OK) {
+        goto err_mpool_cleanup;
+    }
+
+    ret = pthread_key_create(&mp->key, ucs_mpool_mt_cache_destructor);
+    if (ret != 0) {
+        ucs_error("mpool %s: pthread_key_create() failed: %m", params->name);
+        status = UCS_ERR_IO_ERROR;
+        goto err_spinlock_destroy;
+    }
+
+    mp->magazine_elems = magazine_elems;
+    mp->num_magazines  = num_magazines;
+    mp->magazine_size  = ucs_align_up_pow2(sizeof(ucs_mpool_mt_magazine_t) +
+                                           (magazine_elems * sizeof(void*)),
+                                           UCS_SYS_CACHE_LINE_SIZE);
+    mp->magazines      = ucs_calloc(num_magazines, mp->magazine_size,
+                                    "ucs_mpool_mt_magazines");
+    if (mp->magazines == NULL) {
+        ucs_error("mpool %s: failed to allocate %u magazines", params->name,
+                  num_magazines);
+        status = UCS_ERR_NO_MEMORY;
+        goto err_key_delete;
+    }
+
+    mp->full.head  = 0;
+    mp->empty.head = 0;
+    ucs_list_head_init(&mp->caches);
+    for (i = 0; i < num_magazines; ++i) {
+        ucs_mpool_mt_depot_push(mp, &mp->empty, ucs_mpool_mt_magazine(mp, i));
+    }
+
+    return UCS_OK;
+
+err_key_delete:
+    pthread_key_delete(mp->key);
+err_spinlock_destroy:
+    ucs_spinlock_destroy(&mp->lock);
+err_mpool_cleanup:
+    ucs_mpool_cleanup(&mp->mp, 0);
+err:
+    return status;
+}
+
+void ucs_mpool_mt_cleanup(ucs_mpool_mt_t *mp, int leak_check)
+{
+    ucs_mpool_mt_magazine_t *magazine;
+    ucs_mpool_mt_cache_t *cache;
+
+    /* Destructors are not called after the key is deleted, so release caches
+     * of all threads which are still alive */
+    pthread_key_delete(mp->key);
+    while (!ucs_list_is_empty(&mp->caches)) {
+        cache = ucs_list_head(&mp->caches, ucs_mpool_mt_cache_t, list);
+        ucs_mpool_mt_cache_release(cache);
+    }
+
+    while ((magazine = ucs_mpool_mt_depot_pop(mp, &mp->full)) != NULL) {
+        ucs_mpool_mt_magazine_flush(mp, magazine);
+    }
+
+    ucs_free(mp->magazines);
+    ucs_spinlock_destroy(&mp->lock);
+    ucs_mpool_cleanup(&mp->mp, leak_check);
+}
+
+static UCS_F_NOINLINE void *
+ucs_mpool_mt_get_slow(ucs_mpool_mt_t *mp, ucs_mpool_mt_cache_t *cache)
+{
+    ucs_mpool_mt_magazine_t *full;
+    void *obj;
+
+    if (cache == NULL) {
+        goto get_locked;
+    }
+
+    full = ucs_mpool_mt_depot_pop(mp, &mp->full);
+    if (full != NULL) {
+        /* Both magazines are empty, so return the previous one to the depot */
+        if (cache->prev != NULL) {
+            ucs_mpool_mt_depot_push(mp, &mp->empty, cache->prev);
+        }
+        cache->prev   = cache->loaded;
+        cache->loaded = full;
+        return full->objs[--full->count];
+    }
+
+    if (cache->loaded != NULL) {
+        /* Refill half of the loaded magazine from the backing pool, to leave
+         * room for objects released by this thread */
+        ucs_spin_lock(&mp->lock);
+        while (cache->loaded->count < (mp->magazine_elems / 2)) {
+            obj = ucs_mpool_get_inline(&mp->mp);
+            if (obj == NULL) {
+                break;
+            }
+            cache->loaded->objs[cache->loaded->count++] = obj;
+        }
+        obj = ucs_mpool_get_inline(&mp->mp);
+        ucs_spin_unlock(&mp->lock);
+        return obj;
+    }
+
+get_locked:
+    ucs_spin_lock(&mp->lock);
+    obj = ucs_mpool_get_inline(&mp->mp);
+    ucs_spin_unlock(&mp->lock);
+    return obj;
+}
+
+void *ucs_mpool_mt_get(ucs_mpool_mt_t *mp)
+{
+    ucs_mpool_mt_cache_t *cache = ucs_mpool_mt_cache(mp);
+    ucs_mpool_mt_magazine_t *magazine;
+
+    if (ucs_likely(cache != NULL)) {
+        magazine = cache->loaded;
+        if (ucs_likely((magazine != NULL) && (magazine->count > 0))) {
+            return magazine->objs[--magazine->count];
+        }
+
+        magazine = cache->prev;
+        if ((magazine != NULL) && (magazine->count > 0)) {
+            /* Previous magazine is full */
+            cache->prev   = cache->loaded;
+            cache->loaded = magazine;
+            return magazine->objs[--magazine->count];
+        }
+    }
+
+    return ucs_mpool_mt_get_slow(mp, cache);
+}
+
+static UCS_F_NOINLINE void
+ucs_mpool_mt_put_slow(ucs_mpool_mt_t *mp, ucs_mpool_mt_cache_t *cache,
+                      void *obj)
+{
+    ucs_mpool_mt_magazine_t *empty;
+
+    if ((cache != NULL) && (cache->loaded != NULL)) {
+        empty = ucs_mpool_mt_depot_pop(mp, &mp->empty);
+        if (empty != NULL) {
+            /* Both magazines are full, so pass the previous one to the depot */
+            if (cache->prev != NULL) {
+                ucs_mpool_mt_depot_push(mp, &mp->full, cache->prev);
+            }
+            cache->prev               = cache->loaded;
+            cache->loaded             = empty;
+            empty->objs[empty->count++] = obj;
+            return;
+        }
+    }
+
+    ucs_spin_lock(&mp->lock);
+    ucs_mpool_put_inline(obj);
+    ucs_spin_unlock(&mp->lock);
+}
+
+void ucs_mpool_mt_put(void *obj)
+{
+    ucs_mpool_mt_t *mp = ucs_container_of(ucs_mpool_obj_owner(obj),
+                                          ucs_mpool_mt_t, mp);
+    ucs_mpool_mt_cache_t *cache = ucs_mpool_mt_cache(mp);
+    ucs_mpool_mt_magazine_t *magazine;
+
+    if (ucs_likely(cache != NULL)) {
+        magazine = cache->loaded;
+        if (ucs_likely((magazine != NULL) &&
+                       (magazine->count < mp->magazine_elems))) {
+            magazine->objs[magazine->count++] = obj;
+            return;
+        }
+
+        magazine = cache->prev;
+        if ((magazine != NULL) && (magazine->count == 0)) {
+            /* Previous magazine is empty */
+            cache->prev               = cache->loaded;
+            cache->loaded             = magazine;
+            magazine->objs[magazine->count++] = obj;
+            return;
+        }
+    }
+
+    ucs_mpool_mt_put_slow(mp, cache, obj);
+}
@@ -0,0 +1,106 @@
+/**
+* Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+*
+* See file LICENSE for terms.
+*/
+
+#ifndef UCS_MPOOL_MT_H_
+#define UCS_MPOOL_MT_H_
+
+#include "mpool.h"
+
+#include <ucs/datastruct/list.h>
+#include <ucs/type/spinlock.h>
+#include <pthread.h>
+#include <stdint.h>
+
+BEGIN_C_DECLS
+
+/** @file mpool_mt.h */
+
+typedef struct ucs_mpool_mt_magazine ucs_mpool_mt_magazine_t;
+
+
+/**
+ * Lock-free stack of magazines. The head holds a generation tag in the upper
+ * 32 bits, to avoid ABA, and the index of the top magazine plus one in the
+ * lower 32 bits (0 means the stack is empty).
+ */
+typedef struct {
+    volatile uint64_t          head;
+} ucs_mpool_mt_depot_t;
+
+
+/**
+ * Thread-safe memory pool.
+ *
+ * Every thread caches objects in a pair of private magazines, so get/put
+ * operations are served without any atomic operation most of the time. Full
+ * and empty magazines are exchanged with a global lock-free depot. The backing
+ * @ref ucs_mpool_t is accessed under a spinlock only when the depot cannot
+ * satisfy the request, which also allows objects to be released by a different
+ * thread than the one which allocated them.
+ */
+typedef struct ucs_mpool_mt {
+    ucs_mpool_t                mp;             /* Backing memory pool */
+    ucs_spinlock_t             lock;           /* Protects 'mp' and 'caches' */
+    pthread_key_t              key;            /* Per-thread cache */
+    ucs_list_link_t            caches;         /* List of per-thread caches */
+    ucs_mpool_mt_depot_t       full;           /* Depot of full magazines */
+    ucs_mpool_mt_depot_t       empty;          /* Depot of empty magazines */
+    void                       *magazines;     /* Array of all magazines */
+    size_t                     magazine_size;  /* Size of a magazine in bytes */
+    unsigned                   magazine_elems; /* Objects per magazine */
+    unsigned                   num_magazines;  /* Number of magazines */
+} ucs_mpool_mt_t;
+
+
+/**
+ * Initialize a thread-safe memory pool.
+ *
+ * @param [in]  params          Backing memory pool parameters.
+ * @param [in]  magazine_elems  Number of objects in a single magazine.
+ * @param [in]  num_magazines   Total number of magazines. Every thread
+ *                              using the pool holds up to two magazines,
+ *                              and the rest are kept in the depot.
+ * @param [out] mp              Memory pool structure to initialize.
+ *
+ * @return UCS status code.
+ */
+ucs_status_t ucs_mpool_mt_init(const ucs_mpool_params_t *params,
+                               unsigned magazine_elems, unsigned num_magazines,
+                               ucs_mpool_mt_t *mp);
+
+
+/**
+ * Cleanup a thread-safe memory pool and release all its memory. Must not be
+ * called concurrently with any other operation on the pool.
+ *
+ * @param [in]  mp          Memory pool structure.
+ * @param [in]  leak_check  Whether to check for leaks.
+ */
+void ucs_mpool_mt_cleanup(ucs_mpool_mt_t *mp, int leak_check);
+
+
+/**
+ * Get an element from a thread-safe memory pool. Can be called from any
+ * thread.
+ *
+ * @param [in]  mp          Memory pool structure.
+ *
+ * @return New allocated object, or NULL if cannot allocate.
+ */
+void *ucs_mpool_mt_get(ucs_mpool_mt_t *mp);
+
+
+/**
+ * Return an object to the thread-safe memory pool it was allocated from. Can
+ * be called from any thread.
+ *
+ * @param [in]  obj         Object to return.
+ */
+void ucs_mpool_mt_put(void *obj);
+
+END_C_DECLS
+
+#endif
@@ -19,12 +19,16 @@
 #include <stdint.h>
 #include <sched.h>
 #include <dirent.h>
+#include <errno.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 #define UCS_NUMA_MIN_DISTANCE       10
 #define UCS_NUMA_NODE_MAX           INT16_MAX
 #define UCS_NUMA_CORE_DIR_PATH      UCS_SYS_FS_CPUS_PATH "/cpu%d"
 #define UCS_NUMA_NODES_DIR_PATH     UCS_SYS_FS_SYSTEM_PATH "/node"
 #define UCS_NUMA_NODE_DISTANCE_PATH UCS_NUMA_NODES_DIR_PATH "/node%d/distance"
+#define UCS_NUMA_MPOL_PREFERRED     1 /* MPOL_PREFERRED from numaif.h */
 
 
 KHASH_MAP_INIT_INT(numa_distance, ucs_numa_distance_t);
@@ -151,6 +155,70 @@ ucs_numa_node_t ucs_numa_node_of_cpu(int cpu)
     return cpu_numa_node[cpu] - 1;
 }
 
+ucs_numa_node_t ucs_numa_node_of_cpuset(const ucs_cpu_set_t *cpu_mask)
+{
+    ucs_numa_node_t node = UCS_NUMA_NODE_UNDEFINED;
+    ucs_numa_node_t cpu_node;
+    unsigned cpu, num_cpus;
+
+    num_cpus = ucs_min(ucs_numa_num_configured_cpus(), UCS_CPU_SETSIZE);
+    for (cpu = 0; cpu < num_cpus; ++cpu) {
+        if (!ucs_cpu_is_set(cpu, cpu_mask)) {
+            continue;
+        }
+
+        cpu_node = ucs_numa_node_of_cpu(cpu);
+        if (node == UCS_NUMA_NODE_UNDEFINED) {
+            node = cpu_node;
+        } else if (node != cpu_node) {
+            return UCS_NUMA_NODE_UNDEFINED;
+        }
+    }
+
+    return node;
+}
+
+ucs_numa_node_t ucs_numa_node_of_current_thread()
+{
+    ucs_sys_cpuset_t sys_cpuset;
+    ucs_cpu_set_t cpu_mask;
+
+    if (ucs_sys_pthread_getaffinity(&sys_cpuset) != UCS_OK) {
+        return UCS_NUMA_NODE_UNDEFINED;
+    }
+
+    ucs_sys_cpuset_copy(&cpu_mask, &sys_cpuset);
+    return ucs_numa_node_of_cpuset(&cpu_mask);
+}
+
+ucs_status_t ucs_numa_mbind(void *address, size_t length, ucs_numa_node_t node)
+{
+#ifdef __NR_mbind
+    unsigned long nodemask[UCS_NUMA_NODE_MAX / UCS_NCPUBITS + 1] = {0};
+    long ret;
+
+    if ((node < 0) || (node >= ucs_numa_num_configured_nodes())) {
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    nodemask[node / UCS_NCPUBITS] |= UCS_BIT(node % UCS_NCPUBITS);
+
+    /* Use the syscall directly to avoid a dependency on libnuma */
+    ret = syscall(__NR_mbind, address, length, UCS_NUMA_MPOL_PREFERRED,
+                  nodemask, node + 2, 0);
+    if (ret != 0) {
+        ucs_debug("mbind(address=%p length=%zu node=%d) failed: %m", address,
+                  length, node);
+        return ((errno == ENOSYS) || (errno == EPERM)) ? UCS_ERR_UNSUPPORTED :
+                                                         UCS_ERR_INVALID_PARAM;
+    }
+
+    return UCS_OK;
+#else
+    return UCS_ERR_UNSUPPORTED;
+#endif
+}
+
 ucs_numa_node_t ucs_numa_node_of_device(const char *dev_path)
 {
     long parsed_node;
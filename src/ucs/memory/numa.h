@@ -8,6 +8,9 @@
 #define UCS_NUMA_H_
 
 #include <ucs/sys/compiler_def.h>
+#include <ucs/type/cpu_set.h>
+#include <ucs/type/status.h>
+#include <stddef.h>
 #include <stdint.h>
 
 BEGIN_C_DECLS
@@ -50,6 +53,38 @@ unsigned ucs_numa_num_configured_nodes(void);
 ucs_numa_node_t ucs_numa_node_of_cpu(int cpu);
 
 
+/**
+ * @param [in]  cpu_mask CPU set to query.
+ *
+ * @return The NUMA node that all CPUs in the set belong to, or
+ *         @ref UCS_NUMA_NODE_UNDEFINED if the set is empty or spans more than
+ *         one node.
+ */
+ucs_numa_node_t ucs_numa_node_of_cpuset(const ucs_cpu_set_t *cpu_mask);
+
+
+/**
+ * @return The NUMA node that the calling thread is bound to by its CPU
+ *         affinity, or @ref UCS_NUMA_NODE_UNDEFINED if the thread may run on
+ *         more than one node.
+ */
+ucs_numa_node_t ucs_numa_node_of_current_thread(void);
+
+
+/**
+ * Set a preferred NUMA memory policy for a memory range, so its pages are
+ * allocated on the given node when they are first touched.
+ *
+ * @param [in]  address  Page-aligned start of the memory range.
+ * @param [in]  length   Length of the memory range.
+ * @param [in]  node     NUMA node to allocate the memory on.
+ *
+ * @return UCS_OK if the policy was set, UCS_ERR_UNSUPPORTED if NUMA memory
+ *         policies are not available, or other error code otherwise.
+ */
+ucs_status_t ucs_numa_mbind(void *address, size_t length, ucs_numa_node_t node);
+
+
 /**
  * @param [in]  dev_path sysfs path of the device.
  *
@@ -658,6 +658,23 @@ UCS_CLASS_CLEANUP_FUNC(uct_iface_t)
 UCS_CLASS_DEFINE(uct_iface_t, void);
 
 
+/* NUMA node of the CPUs the interface is going to be used from */
+static ucs_numa_node_t
+uct_iface_params_numa_node(const uct_iface_params_t *params)
+{
+    ucs_numa_node_t node = UCS_NUMA_NODE_UNDEFINED;
+
+    if (params->field_mask & UCT_IFACE_PARAM_FIELD_CPU_MASK) {
+        node = ucs_numa_node_of_cpuset(&params->cpu_mask);
+    }
+
+    if (node == UCS_NUMA_NODE_UNDEFINED) {
+        node = ucs_numa_node_of_current_thread();
+    }
+
+    return node;
+}
+
 UCS_CLASS_INIT_FUNC(uct_base_iface_t, uct_iface_ops_t *ops,
                     uct_iface_internal_ops_t *internal_ops, uct_md_h md,
                     uct_worker_h worker, const uct_iface_params_t *params,
@@ -696,6 +713,7 @@ UCS_CLASS_INIT_FUNC(uct_base_iface_t, uct_iface_ops_t *ops,
     self->err_handler_arg   = UCT_IFACE_PARAM_VALUE(params, err_handler_arg,
                                                     ERR_HANDLER_ARG, NULL);
     self->progress_flags    = 0;
+    self->numa_node         = uct_iface_params_numa_node(params);
 
     uct_worker_progress_init(&self->prog);
 
@@ -351,6 +351,7 @@ typedef struct uct_base_iface {
     uct_worker_progress_t    prog;             /* Will be removed once all transports
                                                   support progress control */
     unsigned                 progress_flags;   /* Which progress is currently enabled */
+    ucs_numa_node_t          numa_node;        /* NUMA node to place memory on */
 
     struct {
         unsigned             num_alloc_methods;
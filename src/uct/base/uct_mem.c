@@ -365,6 +365,27 @@ static int uct_iface_is_allowed_alloc_method(uct_base_iface_t *iface,
     return 0;
 }
 
+/* Set the memory policy before the memory is touched or registered, so its
+ * pages are placed on the NUMA node of the interface */
+static void uct_iface_mem_numa_bind(uct_base_iface_t *iface,
+                                    const uct_allocated_memory_t *mem)
+{
+    size_t page_size = ucs_get_page_size();
+    void *start, *end;
+
+    if (iface->numa_node == UCS_NUMA_NODE_UNDEFINED) {
+        return;
+    }
+
+    start = ucs_align_up_pow2_ptr(mem->address, page_size);
+    end   = ucs_align_down_pow2_ptr(UCS_PTR_BYTE_OFFSET(mem->address,
+                                                        mem->length),
+                                    page_size);
+    if (start < end) {
+        ucs_numa_mbind(start, UCS_PTR_BYTE_DIFF(start, end), iface->numa_node);
+    }
+}
+
 ucs_status_t uct_iface_mem_alloc(uct_iface_h tl_iface, size_t length, unsigned flags,
                                  const char *name, uct_allocated_memory_t *mem)
 {
@@ -419,6 +440,8 @@ ucs_status_t uct_iface_mem_alloc(uct_iface_h tl_iface, size_t length, unsigned f
         goto err;
     }
 
+    uct_iface_mem_numa_bind(iface, mem);
+
     /* If the memory was not allocated using MD, register it if needed */
     if (mem->method != UCT_ALLOC_METHOD_MD) {
         if (need_mem_reg && support_mem_reg) {
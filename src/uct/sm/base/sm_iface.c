@@ -15,7 +15,35 @@
 #include <ucs/sys/string.h>
 #include <ucs/sys/sys.h>
 #include <ucs/arch/cpu.h>
+#include <ucs/time/time.h>
 #include <ucs/type/init_once.h>
+#include <float.h>
+#include <fcntl.h>
+
+
+/* Memory copy bandwidth measurement parameters */
+#define UCT_SM_PERF_MEMCPY_SIZE     (32 * UCS_MBYTE)
+#define UCT_SM_PERF_MEMCPY_ITERS    4
+
+/* Cache-to-cache latency measurement parameters */
+#define UCT_SM_PERF_C2C_ITERS       10000
+#define UCT_SM_PERF_C2C_TIMEOUT     1.0 /* seconds */
+
+
+typedef struct {
+    volatile uint64_t seq;     /* Ping-pong sequence number */
+    volatile int      stop;    /* Set when the measurement is aborted */
+} UCS_V_ALIGNED(UCS_SYS_CACHE_LINE_SIZE) uct_sm_perf_c2c_line_t;
+
+
+/* Measured memory performance of the local host */
+static struct {
+    ucs_init_once_t init_once;
+    double          memcpy_bw;   /* Memory copy bandwidth, bytes per second */
+    double          c2c_latency; /* One-way cache-to-cache latency, seconds */
+} uct_sm_perf = {
+    .init_once = UCS_INIT_ONCE_INITIALIZER
+};
 
 
 ucs_config_field_t uct_sm_iface_config_table[] = {
@@ -27,6 +55,20 @@ ucs_config_field_t uct_sm_iface_config_table[] = {
      "Effective memory bandwidth",
      ucs_offsetof(uct_sm_iface_config_t, bandwidth), UCS_CONFIG_TYPE_BW},
 
+    {"CALIBRATE", "n",
+     "Measure the memory copy bandwidth, cache-to-cache latency and system call\n"
+     "overhead of the local host when the interface is created, and use them\n"
+     "for performance estimation instead of the BW and default overhead values.",
+     ucs_offsetof(uct_sm_iface_config_t, calibrate), UCS_CONFIG_TYPE_BOOL},
+
+    {"CALIBRATE_CACHE", "",
+     "File to cache the measured values in, so they are measured only once per\n"
+     "host. The file name may contain the following templates:\n"
+     " %h - host name\n"
+     " %u - user name\n"
+     "If empty, the values are measured once per process.",
+     ucs_offsetof(uct_sm_iface_config_t, calib_cache), UCS_CONFIG_TYPE_STRING},
+
     {NULL}
 };
 
@@ -77,6 +119,178 @@ size_t uct_sm_iface_get_device_addr_len()
                    sizeof(uct_iface_local_addr_ns_t);
 }
 
+static int uct_sm_perf_cache_read(const char *path, const char *name,
+                                  double *value_p)
+{
+    char key[64];
+    double value;
+    FILE *stream;
+    int found;
+
+    stream = fopen(path, "r");
+    if (stream == NULL) {
+        return 0;
+    }
+
+    found = 0;
+    while (fscanf(stream, "%63s %lf", key, &value) == 2) {
+        if (!strcmp(key, name)) {
+            *value_p = value;
+            found    = 1;
+            break;
+        }
+    }
+
+    fclose(stream);
+    return found;
+}
+
+static void
+uct_sm_perf_cache_write(const char *path, const char *name, double value)
+{
+    char line[128];
+    int fd, length;
+
+    fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        ucs_debug("failed to open '%s' for writing: %m", path);
+        return;
+    }
+
+    /* Single append of a short line is atomic with respect to other processes
+     * writing to the same file */
+    ucs_snprintf_safe(line, sizeof(line), "%s %.6e\n", name, value);
+    length = strlen(line);
+    if (write(fd, line, length) != length) {
+        ucs_debug("failed to write to '%s': %m", path);
+    }
+
+    close(fd);
+}
+
+double uct_sm_perf_get(const uct_sm_iface_config_t *config, const char *name,
+                       uct_sm_perf_measure_func_t measure_func)
+{
+    char path[PATH_MAX];
+    double value;
+
+    if (strlen(config->calib_cache) > 0) {
+        ucs_fill_filename_template(config->calib_cache, path, sizeof(path));
+        if (uct_sm_perf_cache_read(path, name, &value)) {
+            ucs_debug("%s: %e (cached in '%s')", name, value, path);
+            return value;
+        }
+    }
+
+    value = measure_func();
+    ucs_debug("%s: %e (measured)", name, value);
+
+    if ((strlen(config->calib_cache) > 0) && (value > 0)) {
+        uct_sm_perf_cache_write(path, name, value);
+    }
+
+    return value;
+}
+
+static double uct_sm_perf_measure_memcpy_bw(void)
+{
+    double best_time = DBL_MAX;
+    ucs_time_t start_time;
+    void *src, *dst;
+    unsigned i;
+
+    src = ucs_malloc(UCT_SM_PERF_MEMCPY_SIZE, "sm_perf_src");
+    dst = ucs_malloc(UCT_SM_PERF_MEMCPY_SIZE, "sm_perf_dst");
+    if ((src == NULL) || (dst == NULL)) {
+        ucs_free(src);
+        ucs_free(dst);
+        return 0;
+    }
+
+    /* Fault in the pages before measuring */
+    memset(src, 0, UCT_SM_PERF_MEMCPY_SIZE);
+    memset(dst, 0, UCT_SM_PERF_MEMCPY_SIZE);
+
+    for (i = 0; i < UCT_SM_PERF_MEMCPY_ITERS; ++i) {
+        start_time = ucs_get_time();
+        memcpy(dst, src, UCT_SM_PERF_MEMCPY_SIZE);
+        ucs_compiler_fence();
+        best_time = ucs_min(best_time,
+                            ucs_time_to_sec(ucs_get_time() - start_time));
+    }
+
+    ucs_free(dst);
+    ucs_free(src);
+    return (best_time > 0) ? (UCT_SM_PERF_MEMCPY_SIZE / best_time) : 0;
+}
+
+static void *uct_sm_perf_c2c_thread(void *arg)
+{
+    uct_sm_perf_c2c_line_t *line = arg;
+    uint64_t seq;
+
+    for (seq = 1; seq < (2 * UCT_SM_PERF_C2C_ITERS); seq += 2) {
+        while (line->seq != seq) {
+            if (line->stop) {
+                return NULL;
+            }
+        }
+        line->seq = seq + 1;
+    }
+
+    return NULL;
+}
+
+static double uct_sm_perf_measure_c2c_latency(void)
+{
+    uct_sm_perf_c2c_line_t line = {0};
+    ucs_time_t start_time, timeout;
+    ucs_sys_cpuset_t cpuset;
+    double latency;
+    pthread_t tid;
+    uint64_t seq;
+
+    /* Spinning threads sharing a single core would measure the scheduler */
+    if ((ucs_sys_getaffinity(&cpuset) != 0) || (CPU_COUNT(&cpuset) < 2)) {
+        return 0;
+    }
+
+    if (ucs_pthread_create(&tid, uct_sm_perf_c2c_thread, &line,
+                           "sm_perf") != UCS_OK) {
+        return 0;
+    }
+
+    start_time = ucs_get_time();
+    timeout    = start_time + ucs_time_from_sec(UCT_SM_PERF_C2C_TIMEOUT);
+    latency    = 0;
+    for (seq = 1; seq < (2 * UCT_SM_PERF_C2C_ITERS); seq += 2) {
+        line.seq = seq;
+        while (line.seq == seq) {
+            if (ucs_get_time() > timeout) {
+                line.stop = 1;
+                goto out;
+            }
+        }
+    }
+
+    latency = ucs_time_to_sec(ucs_get_time() - start_time) /
+              (2 * UCT_SM_PERF_C2C_ITERS);
+
+out:
+    pthread_join(tid, NULL);
+    return latency;
+}
+
+static void uct_sm_iface_calibrate(const uct_sm_iface_config_t *config)
+{
+    UCS_INIT_ONCE(&uct_sm_perf.init_once) {
+        uct_sm_perf.memcpy_bw   = uct_sm_perf_get(config, "memcpy_bw",
+                                                  uct_sm_perf_measure_memcpy_bw);
+        uct_sm_perf.c2c_latency = uct_sm_perf_get(
+                config, "c2c_latency", uct_sm_perf_measure_c2c_latency);
+    }
+}
+
 UCS_CLASS_INIT_FUNC(uct_sm_iface_t, uct_iface_ops_t *ops,
                     uct_iface_internal_ops_t *internal_ops, uct_md_h md,
                     uct_worker_h worker, const uct_iface_params_t *params,
@@ -100,6 +314,15 @@ UCS_CLASS_INIT_FUNC(uct_sm_iface_t, uct_iface_ops_t *ops,
                             NULL) UCS_STATS_ARG(params->mode.device.dev_name));
 
     self->config.bandwidth = sm_config->bandwidth;
+    self->config.latency   = 0;
+
+    if (sm_config->calibrate) {
+        uct_sm_iface_calibrate(sm_config);
+        if (uct_sm_perf.memcpy_bw > 0) {
+            self->config.bandwidth = uct_sm_perf.memcpy_bw;
+        }
+        self->config.latency = uct_sm_perf.c2c_latency;
+    }
 
     return UCS_OK;
 }
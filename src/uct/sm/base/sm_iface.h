@@ -21,17 +21,28 @@ extern ucs_config_field_t uct_sm_iface_config_table[];
 
 typedef struct uct_sm_iface_common_config {
     uct_iface_config_t     super;
-    double                 bandwidth; /* Memory bandwidth in bytes per second */
+    double                 bandwidth;   /* Memory bandwidth in bytes per second */
+    int                    calibrate;   /* Measure performance of the host */
+    char                   *calib_cache; /* File to cache measured values */
 } uct_sm_iface_config_t;
 
 typedef struct uct_sm_iface {
     uct_base_iface_t       super;
     struct {
         double             bandwidth; /* Memory bandwidth in bytes per second */
+        double             latency;   /* Cache-to-cache latency in seconds,
+                                         0 if not measured */
     } config;
 } uct_sm_iface_t;
 
 
+/**
+ * Function which measures a performance value of the local host. Returns 0 if
+ * the value could not be measured.
+ */
+typedef double (*uct_sm_perf_measure_func_t)(void);
+
+
 ucs_status_t
 uct_sm_base_query_tl_devices(uct_md_h md, uct_tl_device_resource_t **tl_devices_p,
                              unsigned *num_tl_devices_p);
@@ -48,6 +59,9 @@ size_t uct_sm_iface_get_device_addr_len();
 
 ucs_status_t uct_sm_ep_fence(uct_ep_t *tl_ep, unsigned flags);
 
+double uct_sm_perf_get(const uct_sm_iface_config_t *config, const char *name,
+                       uct_sm_perf_measure_func_t measure_func);
+
 UCS_CLASS_DECLARE(uct_sm_iface_t, uct_iface_ops_t*, uct_iface_internal_ops_t*,
                   uct_md_h, uct_worker_h, const uct_iface_params_t*,
                   const uct_iface_config_t*);
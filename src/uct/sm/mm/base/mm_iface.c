@@ -67,6 +67,11 @@ ucs_config_field_t uct_mm_iface_config_table[] = {
     {"ERROR_HANDLING", "n", "Expose error handling support capability",
      ucs_offsetof(uct_mm_iface_config_t, error_handling), UCS_CONFIG_TYPE_BOOL},
 
+    {"RX_PREFETCH", "0",
+     "How many bytes of the next ready bcopy message payload to prefetch into\n"
+     "the cache while the current message is being processed. 0 - disabled.",
+     ucs_offsetof(uct_mm_iface_config_t, rx_prefetch), UCS_CONFIG_TYPE_MEMUNITS},
+
     {"SEND_OVERHEAD", UCS_PP_MAKE_STRING(UCT_MM_IFACE_OVERHEAD),
      "Time spent after the message request has been passed to the hardware or\n"
      "system software layers and before operation has been finalized", 0,
@@ -342,6 +347,27 @@ uct_mm_iface_fifo_has_new_data(uct_mm_iface_t *iface)
             (iface->read_index_elem->flags & 1));
 }
 
+static UCS_F_ALWAYS_INLINE void
+uct_mm_iface_prefetch_next(uct_mm_iface_t *iface)
+{
+    uint64_t next_index = iface->read_index + 1;
+    uct_mm_fifo_element_t *elem;
+    size_t length, offset;
+
+    elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, iface->recv_fifo_elems,
+                                      next_index & iface->fifo_mask);
+    if ((((next_index >> iface->fifo_shift) & 1) != (elem->flags & 1)) ||
+        (elem->flags & UCT_MM_FIFO_ELEM_FLAG_INLINE)) {
+        return;
+    }
+
+    /* the payload is only hinted to the cache, so a stale length is harmless */
+    length = ucs_min(elem->length, iface->config.rx_prefetch);
+    for (offset = 0; offset < length; offset += UCS_SYS_CACHE_LINE_SIZE) {
+        ucs_read_prefetch(UCS_PTR_BYTE_OFFSET(elem->desc_data, offset));
+    }
+}
+
 static UCS_F_ALWAYS_INLINE unsigned
 uct_mm_iface_poll_fifo(uct_mm_iface_t *iface)
 {
@@ -354,6 +380,11 @@ uct_mm_iface_poll_fifo(uct_mm_iface_t *iface)
     ucs_assert(iface->read_index <=
                (iface->recv_fifo_ctl->head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED));
 
+    /* overlap fetching the next bcopy payload with processing this one */
+    if (iface->config.rx_prefetch != 0) {
+        uct_mm_iface_prefetch_next(iface);
+    }
+
     uct_mm_iface_process_recv(iface);
 
     /* raise the read_index */
@@ -587,7 +618,10 @@ uct_mm_estimate_perf(uct_iface_h tl_iface, uct_perf_attr_t *perf_attr)
     }
 
     if (perf_attr->field_mask & UCT_PERF_ATTR_FIELD_LATENCY) {
-        perf_attr->latency = UCT_MM_IFACE_LATENCY;
+        perf_attr->latency = (iface->super.config.latency > 0) ?
+                             ucs_linear_func_make(iface->super.config.latency,
+                                                  0) :
+                             UCT_MM_IFACE_LATENCY;
     }
 
     if (perf_attr->field_mask & UCT_PERF_ATTR_FIELD_MAX_INFLIGHT_EPS) {
@@ -790,6 +824,8 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
                                       UCT_MM_IFACE_FIFO_MAX_POLL :
                                       /* trim by the maximum unsigned integer value */
                                       ucs_min(mm_config->fifo_max_poll, UINT_MAX));
+    self->config.rx_prefetch       = ucs_min(mm_config->rx_prefetch,
+                                             mm_config->seg_size);
 
     self->config.extra_cap_flags   = (mm_config->error_handling == UCS_YES) ?
                                      UCT_IFACE_FLAG_ERRHANDLE_PEER_FAILURE :
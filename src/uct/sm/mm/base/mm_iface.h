@@ -115,6 +115,8 @@ typedef struct uct_mm_iface_config {
                                                    * shared memory buffers */
     unsigned                 fifo_elem_size;      /* Size of the FIFO element size */
     int                      error_handling; /* Exposing of error handling cap */
+    size_t                   rx_prefetch;    /* Bytes of the next bcopy payload
+                                              * to prefetch during RX poll */
     uct_iface_mpool_config_t mp;
     uct_mm_iface_overhead_t  overhead;
 } uct_mm_iface_config_t;
@@ -234,6 +236,8 @@ typedef struct uct_mm_iface {
         /* size of the receive descriptor (for payload) */
         unsigned                seg_size;
         unsigned                fifo_max_poll;
+        /* bytes of the next received bcopy payload to prefetch */
+        unsigned                rx_prefetch;
         uint64_t                extra_cap_flags;
         uct_mm_iface_overhead_t overhead;
     } config;
@@ -49,13 +49,20 @@
 #define UCT_POSIX_SHM_OPEN_DIR          "/dev/shm"       /* directory path for shm_open() */
 #define UCT_POSIX_FILE_FMT              "/ucx_shm_posix_%"PRIx64
 #define UCT_POSIX_PROCFS_FILE_FMT       "/proc/%d/fd/%d" /* file pattern for procfs mode */
+#define UCT_POSIX_MEMFD_NAME            "ucx_shm_posix"  /* name of memfd objects */
+
+/* memfd_create() flags */
+#ifndef MFD_CLOEXEC
+#  define MFD_CLOEXEC                   0x0001U
+#endif
 
 
 typedef struct uct_posix_md_config {
-    uct_mm_md_config_t super;
-    char               *dir;
-    int                use_proc_link;
-    size_t             shm_min_size;
+    uct_mm_md_config_t       super;
+    char                     *dir;
+    int                      use_proc_link;
+    ucs_ternary_auto_value_t use_memfd;
+    size_t                   shm_min_size;
 } uct_posix_md_config_t;
 
 typedef struct uct_posix_packed_rkey {
@@ -88,6 +95,16 @@ static ucs_config_field_t uct_posix_md_config_table[] = {
      " n   - Use original file path to share posix file.\n",
      ucs_offsetof(uct_posix_md_config_t, use_proc_link), UCS_CONFIG_TYPE_BOOL},
 
+    {"USE_MEMFD", "n",
+     "Back allocated shared memory by an anonymous memfd object instead of a\n"
+     "file in the backing directory. Such memory is not limited by the size of\n"
+     "the backing file system, and peers obtain it by pidfd_getfd(), falling\n"
+     "back to /proc/<pid>/fd/<fd>. Requires USE_PROC_LINK=y.\n"
+     " y   - Always use memfd, fail the allocation if it is not supported.\n"
+     " try - Use memfd if supported, otherwise fall back to a backing file.\n"
+     " n   - Do not use memfd.\n",
+     ucs_offsetof(uct_posix_md_config_t, use_memfd), UCS_CONFIG_TYPE_TERNARY},
+
     {NULL}
 };
 
@@ -135,16 +152,22 @@ uct_posix_md_query(uct_md_h tl_md, uct_md_attr_v2_t *md_attr)
     struct statvfs shm_statvfs;
     size_t shm_size;
 
-    if (statvfs(posix_config->dir, &shm_statvfs) < 0) {
-        ucs_error("could not stat shared memory device %s (%m)",
-                  posix_config->dir);
-        return UCS_ERR_NO_DEVICE;
-    }
+    if (posix_config->use_memfd == UCS_YES) {
+        /* memfd objects are not limited by the backing file system */
+        shm_size = ucs_get_phys_mem_size();
+    } else {
+        if (statvfs(posix_config->dir, &shm_statvfs) < 0) {
+            ucs_error("could not stat shared memory device %s (%m)",
+                      posix_config->dir);
+            return UCS_ERR_NO_DEVICE;
+        }
 
-    shm_size = shm_statvfs.f_bsize * shm_statvfs.f_bavail;
-    if (shm_size < posix_config->shm_min_size) {
-        ucs_debug("md alloc disabled: only %zu bytes left in shm", shm_size);
-        shm_size = 0;
+        shm_size = shm_statvfs.f_bsize * shm_statvfs.f_bavail;
+        if (shm_size < posix_config->shm_min_size) {
+            ucs_debug("md alloc disabled: only %zu bytes left in shm",
+                      shm_size);
+            shm_size = 0;
+        }
     }
 
     uct_mm_md_query(&md->super, md_attr, shm_size);
@@ -294,6 +317,67 @@ out:
     return status;
 }
 
+static ucs_status_t uct_posix_pidfd_getfd(int pid, int peer_fd, int *fd_p)
+{
+#if HAVE_DECL_SYS_PIDFD_OPEN && HAVE_DECL_SYS_PIDFD_GETFD
+    static int pidfd_unsupported = 0;
+    int pidfd, ret;
+
+    if (pidfd_unsupported) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    pidfd = syscall(SYS_pidfd_open, pid, 0);
+    if (pidfd < 0) {
+        goto err;
+    }
+
+    ret = syscall(SYS_pidfd_getfd, pidfd, peer_fd, 0);
+    if (ret < 0) {
+        close(pidfd);
+        goto err;
+    }
+
+    close(pidfd);
+    *fd_p = ret;
+    return UCS_OK;
+
+err:
+    ucs_debug("failed to get fd %d of pid %d using pidfd: %m", peer_fd, pid);
+    if (errno == ENOSYS) {
+        /* Do not retry on kernels without pidfd support */
+        pidfd_unsupported = 1;
+    }
+#endif
+    return UCS_ERR_UNSUPPORTED;
+}
+
+static ucs_status_t
+uct_posix_memfd_create(const uct_posix_md_config_t *posix_config, int *fd_p,
+                       ucs_log_level_t err_level)
+{
+#if HAVE_DECL_SYS_MEMFD_CREATE
+    int ret;
+
+    if (!posix_config->use_proc_link) {
+        ucs_log(err_level, "memfd shared memory requires proc link mode");
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    ret = syscall(SYS_memfd_create, UCT_POSIX_MEMFD_NAME, MFD_CLOEXEC);
+    if (ret < 0) {
+        ucs_log(err_level, "memfd_create(%s) failed: %m", UCT_POSIX_MEMFD_NAME);
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    *fd_p = ret;
+    return UCS_OK;
+#else
+    ucs_log(err_level, "memfd shared memory is not supported");
+    return UCS_ERR_UNSUPPORTED;
+#endif
+}
+
 static ucs_status_t
 uct_posix_unlink(uct_mm_md_t *md, uint64_t seg_id, ucs_log_level_t err_level)
 {
@@ -412,7 +496,10 @@ uct_posix_mem_open(uct_mm_seg_id_t seg_id, const char *dir, int *fd_p)
 
     if (seg_id & UCT_POSIX_SEG_FLAG_PROCFS) {
         uct_posix_mmid_procfs_unpack(mmid, &pid, &peer_fd);
-        status = uct_posix_procfs_open(pid, peer_fd, fd_p);
+        status = uct_posix_pidfd_getfd(pid, peer_fd, fd_p);
+        if (status != UCS_OK) {
+            status = uct_posix_procfs_open(pid, peer_fd, fd_p);
+        }
     } else if (seg_id & UCT_POSIX_SEG_FLAG_SHM_OPEN) {
         status = uct_posix_shm_open(mmid, 0, fd_p);
     } else {
@@ -489,6 +576,20 @@ uct_posix_segment_open(uct_mm_md_t *md, uct_mm_seg_id_t *seg_id_p, int *fd_p)
     ucs_status_t status;
     unsigned rand_seed;
 
+    if (posix_config->use_memfd != UCS_NO) {
+        status = uct_posix_memfd_create(posix_config, fd_p,
+                                        (posix_config->use_memfd == UCS_YES) ?
+                                        UCS_LOG_LEVEL_ERROR :
+                                        UCS_LOG_LEVEL_DEBUG);
+        if (status == UCS_OK) {
+            /* The object has no name, it is shared only by procfs link */
+            *seg_id_p = UCT_POSIX_SEG_FLAG_PROCFS;
+            return UCS_OK;
+        } else if (posix_config->use_memfd == UCS_YES) {
+            return status;
+        }
+    }
+
     /* Generate random 32-bit shared memory id and make sure it's not used
      * already by opening the file with O_CREAT|O_EXCL */
     rand_seed = ucs_generate_uuid((uintptr_t)md);
@@ -542,17 +643,29 @@ uct_posix_mem_alloc(uct_md_h tl_md, size_t *length_p, void **address_p,
         goto err_free_seg;
     }
 
-    /* Check if the location of the backing file has enough memory for the
-     * needed size by trying to write there before calling mmap */
-    status = uct_posix_test_mem(fd, seg->length);
-    if (status != UCS_OK) {
-        goto err_close;
+    if (seg->seg_id & UCT_POSIX_SEG_FLAG_PROCFS) {
+        /* memfd object is not limited by a file system, only set its size */
+        if (ftruncate(fd, seg->length) < 0) {
+            ucs_error("ftruncate(fd=%d, length=%zu) failed: %m", fd,
+                      seg->length);
+            status = UCS_ERR_NO_MEMORY;
+            goto err_close;
+        }
+    } else {
+        /* Check if the location of the backing file has enough memory for
+         * the needed size by trying to write there before calling mmap */
+        status = uct_posix_test_mem(fd, seg->length);
+        if (status != UCS_OK) {
+            goto err_close;
+        }
     }
 
     /* If using procfs link instead of mmid, remove the original file and update
      * seg->seg_id */
     if (posix_config->use_proc_link) {
-        uct_posix_unlink(md, seg->seg_id, UCS_LOG_LEVEL_DIAG);
+        if (!(seg->seg_id & UCT_POSIX_SEG_FLAG_PROCFS)) {
+            uct_posix_unlink(md, seg->seg_id, UCS_LOG_LEVEL_DIAG);
+        }
 
         /* Replace mmid by pid+fd. Keep previous SHM_OPEN flag for mkey_pack() */
         seg->seg_id = uct_posix_mmid_procfs_pack(fd) |
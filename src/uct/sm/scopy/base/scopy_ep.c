@@ -11,6 +11,7 @@
 #include "scopy_ep.h"
 
 #include <uct/base/uct_iov.inl>
+#include <ucs/arch/cpu.h>
 
 
 const char* uct_scopy_tx_op_str[] = {
@@ -40,11 +41,39 @@ static UCS_F_ALWAYS_INLINE void
 uct_scopy_ep_tx_init_common(uct_scopy_tx_t *tx, uct_scopy_tx_op_t tx_op,
                             uct_completion_t *comp)
 {
-    tx->comp = comp;
-    tx->op   = tx_op;
+    tx->comp       = comp;
+    tx->op         = tx_op;
+    tx->num_chunks = 0;
     ucs_arbiter_elem_init(&tx->arb_elem);
 }
 
+/* Split a large operation to chunks which are copied by the helper threads */
+static void uct_scopy_ep_tx_split(uct_scopy_iface_t *iface, uct_ep_h tl_ep,
+                                  uct_scopy_tx_t *tx, size_t length)
+{
+    unsigned max_chunks = iface->copy_pool.num_threads + 1;
+    size_t chunk_size   = ucs_align_up(ucs_div_round_up(length, max_chunks),
+                                       UCS_SYS_CACHE_LINE_SIZE);
+    uct_scopy_tx_chunk_t *chunk;
+    size_t offset;
+
+    tx->chunks     = UCS_PTR_BYTE_OFFSET(tx->iov, iface->config.max_iov *
+                                                  sizeof(uct_iov_t));
+    tx->num_chunks = 0;
+    for (offset = 0; offset < length; offset += chunk_size) {
+        ucs_assert(tx->num_chunks < max_chunks);
+        chunk         = &tx->chunks[tx->num_chunks++];
+        chunk->tx     = tx;
+        chunk->tl_ep  = tl_ep;
+        chunk->offset = offset;
+        chunk->length = ucs_min(chunk_size, length - offset);
+    }
+
+    tx->chunks_pending = tx->num_chunks;
+    tx->chunks_status  = UCS_OK;
+    uct_scopy_iface_copy_push(iface, tx);
+}
+
 static UCS_F_ALWAYS_INLINE ucs_status_t
 uct_scopy_ep_tx_init(uct_ep_h tl_ep, const uct_iov_t *iov,
                      size_t iov_cnt, uint64_t remote_addr,
@@ -55,6 +84,7 @@ uct_scopy_ep_tx_init(uct_ep_h tl_ep, const uct_iov_t *iov,
     uct_scopy_ep_t *ep       = ucs_derived_of(tl_ep, uct_scopy_ep_t);
     uct_scopy_tx_t *tx;
     size_t iov_it;
+    size_t length;
 
     ucs_assert((tx_op == UCT_SCOPY_TX_PUT_ZCOPY) ||
                (tx_op == UCT_SCOPY_TX_GET_ZCOPY));
@@ -81,12 +111,13 @@ uct_scopy_ep_tx_init(uct_ep_h tl_ep, const uct_iov_t *iov,
         tx->iov_cnt++;
     }
 
+    length = uct_iov_total_length(tx->iov, tx->iov_cnt);
     if (tx_op == UCT_SCOPY_TX_PUT_ZCOPY) {
         UCT_TL_EP_STAT_OP(ucs_derived_of(tl_ep, uct_base_ep_t), PUT, ZCOPY,
-                          uct_iov_total_length(tx->iov, tx->iov_cnt));
+                          length);
     } else {
         UCT_TL_EP_STAT_OP(ucs_derived_of(tl_ep, uct_base_ep_t), GET, ZCOPY,
-                          uct_iov_total_length(tx->iov, tx->iov_cnt));
+                          length);
     }
 
     if (tx->iov_cnt == 0) {
@@ -102,6 +133,13 @@ uct_scopy_ep_tx_init(uct_ep_h tl_ep, const uct_iov_t *iov,
                 iface, 0, &iface->super.super.prog.id);
     }
 
+    /* Start copying large operations right away, the arbiter keeps the
+     * operation until all its chunks are completed */
+    if ((iface->copy_pool.num_threads > 0) &&
+        (length >= iface->config.copy_thresh)) {
+        uct_scopy_ep_tx_split(iface, tl_ep, tx, length);
+    }
+
     ucs_arbiter_group_push_elem(&ep->arb_group, &tx->arb_elem);
     ucs_arbiter_group_schedule(&iface->arbiter, &ep->arb_group);
 
@@ -143,7 +181,25 @@ ucs_arbiter_cb_result_t uct_scopy_ep_progress_tx(ucs_arbiter_t *arbiter,
         return UCS_ARBITER_CB_RESULT_STOP;
     }
 
-    if (tx->op != UCT_SCOPY_TX_FLUSH_COMP) {
+    if (tx->num_chunks > 0) {
+        if (uct_scopy_iface_copy_progress(iface)) {
+            (*count)++;
+        }
+
+        if (tx->chunks_pending > 0) {
+            return UCS_ARBITER_CB_RESULT_RESCHED_GROUP;
+        }
+
+        ucs_memory_cpu_load_fence();
+        if (ucs_unlikely(tx->chunks_status != UCS_OK)) {
+            /* Repeat the operation serially, to handle the error by the
+             * transport */
+            tx->num_chunks = 0;
+            return UCS_ARBITER_CB_RESULT_RESCHED_GROUP;
+        }
+
+        uct_scopy_trace_data(tx);
+    } else if (tx->op != UCT_SCOPY_TX_FLUSH_COMP) {
         ucs_assert((tx->op == UCT_SCOPY_TX_GET_ZCOPY) ||
                    (tx->op == UCT_SCOPY_TX_PUT_ZCOPY));
         seg_size = iface->config.seg_size;
@@ -8,6 +8,7 @@
 
 #include <uct/base/uct_iface.h>
 #include <uct/sm/base/sm_ep.h>
+#include <ucs/datastruct/queue_types.h>
 #include <ucs/sys/iovec.h>
 
 
@@ -45,16 +46,37 @@ typedef ucs_status_t
                           uct_scopy_tx_op_t tx_op);
 
 
-typedef struct uct_scopy_tx {
+typedef struct uct_scopy_tx uct_scopy_tx_t;
+
+
+/**
+ * Part of a TX operation which is copied by a helper thread
+ */
+typedef struct uct_scopy_tx_chunk {
+    ucs_queue_elem_t                queue;              /* Element in the copy queue */
+    uct_scopy_tx_t                  *tx;                /* TX operation */
+    uct_ep_h                        tl_ep;              /* Transport EP */
+    size_t                          offset;             /* Offset in the TX data */
+    size_t                          length;             /* Length of the chunk */
+} uct_scopy_tx_chunk_t;
+
+
+struct uct_scopy_tx {
     ucs_arbiter_elem_t              arb_elem;           /* TX arbiter group element */
     uct_scopy_tx_op_t               op;                 /* TX operation identifier */
     uint64_t                        remote_addr;        /* The remote address */
     uct_rkey_t                      rkey;               /* User-passed UCT rkey */
     uct_completion_t                *comp;              /* The pointer to the user's passed completion */
     ucs_iov_iter_t                  iov_iter;           /* UCT IOVs iterator */
+    uct_scopy_tx_chunk_t            *chunks;            /* Chunks copied in parallel */
+    unsigned                        num_chunks;         /* Number of chunks, or 0 if the
+                                                         * operation is copied serially */
+    volatile uint32_t               chunks_pending;     /* Number of chunks which are
+                                                         * not copied yet */
+    ucs_status_t                    chunks_status;      /* Status of the chunks copy */
     size_t                          iov_cnt;            /* The number of the UCT IOVs */
     uct_iov_t                       iov[];              /* UCT IOVs */
-} uct_scopy_tx_t;
+};
 
 
 typedef struct uct_scopy_ep {
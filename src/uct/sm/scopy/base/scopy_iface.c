@@ -10,9 +10,12 @@
 #include "scopy_iface.h"
 #include "scopy_ep.h"
 
+#include <ucs/arch/atomic.h>
 #include <ucs/arch/cpu.h>
 #include <ucs/sys/string.h>
+#include <ucs/sys/sys.h>
 
+#include <uct/base/uct_iov.inl>
 #include <uct/sm/base/sm_iface.h>
 
 
@@ -51,6 +54,24 @@ ucs_config_field_t uct_scopy_iface_config_table[] = {
     UCT_IFACE_MPOOL_CONFIG_FIELDS("TX_", -1, 8, 128m, 1.0, "send",
                                   ucs_offsetof(uct_scopy_iface_config_t, tx_mpool), ""),
 
+    {"COPY_THREADS", "0",
+     "Number of helper threads which copy large GET/PUT Zcopy operations in\n"
+     "parallel with the progress thread. 0 disables the parallel copy. Used\n"
+     "only by transports which support it.",
+     ucs_offsetof(uct_scopy_iface_config_t, copy.threads), UCS_CONFIG_TYPE_UINT},
+
+    {"COPY_THRESH", "4m",
+     "Minimal size of a GET/PUT Zcopy operation which is split between the\n"
+     "helper copy threads",
+     ucs_offsetof(uct_scopy_iface_config_t, copy.thresh),
+     UCS_CONFIG_TYPE_MEMUNITS},
+
+    {"COPY_THREADS_CPUS", "",
+     "Range of CPUs, in the form <first>-<last>, which the helper copy threads\n"
+     "are bound to in a round-robin order. If empty, the threads inherit the\n"
+     "affinity of the process.",
+     ucs_offsetof(uct_scopy_iface_config_t, copy.cpus), UCS_CONFIG_TYPE_STRING},
+
     {NULL}
 };
 
@@ -99,6 +120,7 @@ void uct_scopy_iface_query(uct_scopy_iface_t *iface, uct_iface_attr_t *iface_att
 ucs_status_t
 uct_scopy_iface_estimate_perf(uct_iface_h iface, uct_perf_attr_t *perf_attr)
 {
+    uct_scopy_iface_t *scopy_iface = ucs_derived_of(iface, uct_scopy_iface_t);
     ucs_status_t status;
 
     status = uct_base_iface_estimate_perf(iface, perf_attr);
@@ -107,7 +129,7 @@ uct_scopy_iface_estimate_perf(uct_iface_h iface, uct_perf_attr_t *perf_attr)
     }
 
     if (perf_attr->field_mask & UCT_PERF_ATTR_FIELD_SEND_PRE_OVERHEAD) {
-        perf_attr->send_pre_overhead = UCT_SCOPY_IFACE_OVERHEAD;
+        perf_attr->send_pre_overhead = scopy_iface->config.tx_overhead;
     }
 
     if (perf_attr->field_mask & UCT_PERF_ATTR_FIELD_RECV_OVERHEAD) {
@@ -117,6 +139,216 @@ uct_scopy_iface_estimate_perf(uct_iface_h iface, uct_perf_attr_t *perf_attr)
     return UCS_OK;
 }
 
+static void
+uct_scopy_iface_copy_chunk(uct_scopy_iface_t *iface, uct_scopy_tx_chunk_t *chunk)
+{
+    uct_scopy_tx_t *tx  = chunk->tx;
+    size_t offset       = chunk->offset;
+    size_t end          = chunk->offset + chunk->length;
+    ucs_status_t status = UCS_OK;
+    ucs_iov_iter_t iov_iter;
+    size_t seg_size;
+
+    /* Position the iterator at the beginning of the chunk */
+    ucs_iov_iter_init(&iov_iter);
+    while (offset >= uct_iov_get_length(&tx->iov[iov_iter.iov_index])) {
+        offset -= uct_iov_get_length(&tx->iov[iov_iter.iov_index]);
+        ++iov_iter.iov_index;
+    }
+    iov_iter.buffer_offset = offset;
+
+    for (offset = chunk->offset; offset < end; offset += seg_size) {
+        seg_size = ucs_min(iface->config.seg_size, end - offset);
+        status   = iface->tx_mt(chunk->tl_ep, tx->iov, tx->iov_cnt, &iov_iter,
+                                &seg_size, tx->remote_addr + offset, tx->rkey,
+                                tx->op);
+        if (ucs_unlikely(status != UCS_OK)) {
+            tx->chunks_status = status;
+            break;
+        }
+    }
+
+    /* Make the status visible before the chunk is reported as completed */
+    ucs_memory_cpu_store_fence();
+    ucs_atomic_sub32(&tx->chunks_pending, 1);
+}
+
+static uct_scopy_tx_chunk_t *
+uct_scopy_iface_copy_pull(uct_scopy_copy_pool_t *pool)
+{
+    if (ucs_queue_is_empty(&pool->queue)) {
+        return NULL;
+    }
+
+    return ucs_queue_pull_elem_non_empty(&pool->queue, uct_scopy_tx_chunk_t,
+                                         queue);
+}
+
+static void *uct_scopy_iface_copy_thread_func(void *arg)
+{
+    uct_scopy_iface_t *iface    = arg;
+    uct_scopy_copy_pool_t *pool  = &iface->copy_pool;
+    uct_scopy_tx_chunk_t *chunk;
+
+    pthread_mutex_lock(&pool->lock);
+    while (!pool->stop) {
+        chunk = uct_scopy_iface_copy_pull(pool);
+        if (chunk == NULL) {
+            pthread_cond_wait(&pool->cond, &pool->lock);
+            continue;
+        }
+
+        pthread_mutex_unlock(&pool->lock);
+        uct_scopy_iface_copy_chunk(iface, chunk);
+        pthread_mutex_lock(&pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+void uct_scopy_iface_copy_push(uct_scopy_iface_t *iface, uct_scopy_tx_t *tx)
+{
+    uct_scopy_copy_pool_t *pool = &iface->copy_pool;
+    unsigned i;
+
+    pthread_mutex_lock(&pool->lock);
+    for (i = 0; i < tx->num_chunks; ++i) {
+        ucs_queue_push(&pool->queue, &tx->chunks[i].queue);
+    }
+    pthread_cond_broadcast(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+int uct_scopy_iface_copy_progress(uct_scopy_iface_t *iface)
+{
+    uct_scopy_copy_pool_t *pool = &iface->copy_pool;
+    uct_scopy_tx_chunk_t *chunk;
+
+    pthread_mutex_lock(&pool->lock);
+    chunk = uct_scopy_iface_copy_pull(pool);
+    pthread_mutex_unlock(&pool->lock);
+
+    if (chunk == NULL) {
+        return 0;
+    }
+
+    /* The calling thread takes part in the copy as well */
+    uct_scopy_iface_copy_chunk(iface, chunk);
+    return 1;
+}
+
+static void uct_scopy_iface_copy_threads_stop(uct_scopy_iface_t *iface,
+                                              unsigned num_threads)
+{
+    uct_scopy_copy_pool_t *pool = &iface->copy_pool;
+    unsigned i;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (i = 0; i < num_threads; ++i) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    ucs_assert(ucs_queue_is_empty(&pool->queue));
+}
+
+static void uct_scopy_iface_copy_thread_bind(uct_scopy_iface_t *iface,
+                                             const ucs_range_spec_t *cpus,
+                                             unsigned thread_index)
+{
+    unsigned cpu = cpus->first +
+                   (thread_index % (cpus->last - cpus->first + 1));
+    ucs_sys_cpuset_t cpuset;
+    int ret;
+
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    ret = pthread_setaffinity_np(iface->copy_pool.threads[thread_index],
+                                 sizeof(cpuset), &cpuset);
+    if (ret != 0) {
+        ucs_warn("failed to bind scopy copy thread %u to cpu %u: %s",
+                 thread_index, cpu, strerror(ret));
+    }
+}
+
+static ucs_status_t
+uct_scopy_iface_copy_threads_start(uct_scopy_iface_t *iface,
+                                   const uct_scopy_iface_config_t *config)
+{
+    uct_scopy_copy_pool_t *pool = &iface->copy_pool;
+    ucs_range_spec_t cpus       = {0, 0};
+    int bind                    = 0;
+    ucs_status_t status;
+    unsigned i;
+
+    pool->num_threads = 0;
+    pool->threads     = NULL;
+    pool->stop        = 0;
+    ucs_queue_head_init(&pool->queue);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->cond, NULL);
+
+    if ((config->copy.threads == 0) || (iface->tx_mt == NULL)) {
+        return UCS_OK;
+    }
+
+    if (strlen(config->copy.cpus) > 0) {
+        if (!ucs_config_sscanf_range_spec(config->copy.cpus, &cpus, NULL) ||
+            (cpus.first > cpus.last)) {
+            ucs_error("invalid copy threads CPU range: '%s'",
+                      config->copy.cpus);
+            return UCS_ERR_INVALID_PARAM;
+        }
+
+        bind = 1;
+    }
+
+    pool->threads = ucs_calloc(config->copy.threads, sizeof(*pool->threads),
+                               "scopy_copy_threads");
+    if (pool->threads == NULL) {
+        ucs_error("failed to allocate %u copy threads", config->copy.threads);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    for (i = 0; i < config->copy.threads; ++i) {
+        status = ucs_pthread_create(&pool->threads[i],
+                                    uct_scopy_iface_copy_thread_func, iface,
+                                    "scopy_copy#%u", i);
+        if (status != UCS_OK) {
+            goto err_stop;
+        }
+
+        if (bind) {
+            uct_scopy_iface_copy_thread_bind(iface, &cpus, i);
+        }
+    }
+
+    pool->num_threads = config->copy.threads;
+    return UCS_OK;
+
+err_stop:
+    uct_scopy_iface_copy_threads_stop(iface, i);
+    ucs_free(pool->threads);
+    return status;
+}
+
+static void uct_scopy_iface_copy_threads_cleanup(uct_scopy_iface_t *iface)
+{
+    uct_scopy_copy_pool_t *pool = &iface->copy_pool;
+
+    if (pool->num_threads > 0) {
+        uct_scopy_iface_copy_threads_stop(iface, pool->num_threads);
+        ucs_free(pool->threads);
+    }
+
+    pthread_cond_destroy(&pool->cond);
+    pthread_mutex_destroy(&pool->lock);
+}
+
 UCS_CLASS_INIT_FUNC(uct_scopy_iface_t, uct_iface_ops_t *ops,
                     uct_scopy_iface_ops_t *scopy_ops, uct_md_h md,
                     uct_worker_h worker, const uct_iface_params_t *params,
@@ -131,13 +363,26 @@ UCS_CLASS_INIT_FUNC(uct_scopy_iface_t, uct_iface_ops_t *ops,
     UCS_CLASS_CALL_SUPER_INIT(uct_sm_iface_t, ops, &scopy_ops->super, md,
                               worker, params, tl_config);
 
-    self->tx              = scopy_ops->ep_tx;
-    self->config.max_iov  = ucs_min(config->max_iov, ucs_iov_get_max());
-    self->config.seg_size = config->seg_size;
-    self->config.tx_quota = config->tx_quota;
+    self->tx                 = scopy_ops->ep_tx;
+    self->tx_mt              = scopy_ops->ep_tx_mt;
+    self->config.max_iov     = ucs_min(config->max_iov, ucs_iov_get_max());
+    self->config.seg_size    = config->seg_size;
+    self->config.tx_quota    = config->tx_quota;
+    self->config.copy_thresh = config->copy.thresh;
+    self->config.tx_overhead = UCT_SCOPY_IFACE_OVERHEAD;
 
-    elem_size             = sizeof(uct_scopy_tx_t) +
-                            self->config.max_iov * sizeof(uct_iov_t);
+    status = uct_scopy_iface_copy_threads_start(self, config);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    /* The calling thread copies one of the chunks as well */
+    elem_size = sizeof(uct_scopy_tx_t) +
+                self->config.max_iov * sizeof(uct_iov_t);
+    if (self->copy_pool.num_threads > 0) {
+        elem_size += (self->copy_pool.num_threads + 1) *
+                     sizeof(uct_scopy_tx_chunk_t);
+    }
 
     ucs_arbiter_init(&self->arbiter);
 
@@ -147,7 +392,15 @@ UCS_CLASS_INIT_FUNC(uct_scopy_iface_t, uct_iface_ops_t *ops,
     mp_params.ops             = &uct_scopy_mpool_ops;
     mp_params.name            = "uct_scopy_iface_tx_mp";
     status = ucs_mpool_init(&mp_params, &self->tx_mpool);
+    if (status != UCS_OK) {
+        goto err_threads_cleanup;
+    }
+
+    return UCS_OK;
 
+err_threads_cleanup:
+    ucs_arbiter_cleanup(&self->arbiter);
+    uct_scopy_iface_copy_threads_cleanup(self);
     return status;
 }
 
@@ -155,6 +408,7 @@ static UCS_CLASS_CLEANUP_FUNC(uct_scopy_iface_t)
 {
     uct_worker_progress_unregister_safe(&self->super.super.worker->super,
                                         &self->super.super.prog.id);
+    uct_scopy_iface_copy_threads_cleanup(self);
     ucs_mpool_cleanup(&self->tx_mpool, 1);
     ucs_arbiter_cleanup(&self->arbiter);
 }
@@ -10,6 +10,9 @@
 
 #include <uct/base/uct_iface.h>
 #include <uct/sm/base/sm_iface.h>
+#include <ucs/datastruct/queue.h>
+
+#include <pthread.h>
 
 #define uct_scopy_trace_data(_tx) \
     ucs_trace_data("%s [tx %p iov %zu/%zu length %zu/%zu] to %" PRIx64 "(%+ld)", \
@@ -32,14 +35,34 @@ typedef struct uct_scopy_iface_config {
     unsigned                      tx_quota;   /* How many TX segments can be dispatched
                                                * during iface progress */
     uct_iface_mpool_config_t      tx_mpool;   /* TX memory pool configuration */
+    struct {
+        unsigned                  threads;    /* Number of helper copy threads */
+        size_t                    thresh;     /* Minimal size of a parallel copy */
+        char                      *cpus;      /* CPU range of the helper threads */
+    } copy;
 } uct_scopy_iface_config_t;
 
 
+/**
+ * Helper threads which copy chunks of large TX operations in parallel
+ */
+typedef struct uct_scopy_copy_pool {
+    pthread_mutex_t               lock;        /* Protects the queue */
+    pthread_cond_t                cond;        /* Signaled when chunks are added */
+    ucs_queue_head_t              queue;       /* Chunks waiting to be copied */
+    int                           stop;        /* Whether the threads should exit */
+    unsigned                      num_threads; /* Number of helper threads */
+    pthread_t                     *threads;    /* Helper threads */
+} uct_scopy_copy_pool_t;
+
+
 typedef struct uct_scopy_iface {
     uct_sm_iface_t                super;
     ucs_arbiter_t                 arbiter;     /* TX arbiter */
     ucs_mpool_t                   tx_mpool;    /* TX memory pool */
     uct_scopy_ep_tx_func_t        tx;          /* TX function */
+    uct_scopy_ep_tx_func_t        tx_mt;       /* Thread-safe TX function */
+    uct_scopy_copy_pool_t         copy_pool;   /* Helper copy threads */
     struct {
         size_t                    max_iov;     /* Maximum supported IOVs limited by
                                                 * user configuration and system
@@ -49,6 +72,10 @@ typedef struct uct_scopy_iface {
                                                 * Zcopy transfers */
         unsigned                  tx_quota;    /* How many TX segments can be dispatched
                                                 * during iface progress */
+        size_t                    copy_thresh; /* Minimal size of a TX operation
+                                                * which is copied in parallel */
+        double                    tx_overhead; /* Estimated overhead of a TX
+                                                * operation */
     } config;
 } uct_scopy_iface_t;
 
@@ -56,6 +83,10 @@ typedef struct uct_scopy_iface {
 typedef struct uct_scopy_iface_ops {
     uct_iface_internal_ops_t super;
     uct_scopy_ep_tx_func_t   ep_tx;
+    /* Same as ep_tx, but can be called from the helper copy threads, so it
+     * must not report errors or modify the iface and EP state. NULL if the
+     * transport does not support parallel copy. */
+    uct_scopy_ep_tx_func_t   ep_tx_mt;
 } uct_scopy_iface_ops_t;
 
 
@@ -70,6 +101,10 @@ UCS_CLASS_DECLARE(uct_scopy_iface_t, uct_iface_ops_t*, uct_scopy_iface_ops_t*,
 
 unsigned uct_scopy_iface_progress(uct_iface_h tl_iface);
 
+void uct_scopy_iface_copy_push(uct_scopy_iface_t *iface, uct_scopy_tx_t *tx);
+
+int uct_scopy_iface_copy_progress(uct_scopy_iface_t *iface);
+
 ucs_status_t uct_scopy_iface_event_arm(uct_iface_h tl_iface, unsigned events);
 
 ucs_status_t uct_scopy_iface_flush(uct_iface_h tl_iface, unsigned flags,
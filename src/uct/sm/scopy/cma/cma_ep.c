@@ -100,10 +100,11 @@ int uct_cma_ep_is_connected(const uct_ep_h tl_ep,
     return ep->remote_pid == uct_cma_ep_get_remote_pid(params->iface_addr);
 }
 
-ucs_status_t uct_cma_ep_tx(uct_ep_h tl_ep, const uct_iov_t *iov, size_t iov_cnt,
-                           ucs_iov_iter_t *iov_iter, size_t *length_p,
-                           uint64_t remote_addr, uct_rkey_t rkey,
-                           uct_scopy_tx_op_t tx_op)
+static UCS_F_ALWAYS_INLINE ucs_status_t
+uct_cma_ep_do_tx(uct_ep_h tl_ep, const uct_iov_t *iov, size_t iov_cnt,
+                 ucs_iov_iter_t *iov_iter, size_t *length_p,
+                 uint64_t remote_addr, uct_scopy_tx_op_t tx_op,
+                 int handle_error)
 {
     uct_cma_ep_t *ep     = ucs_derived_of(tl_ep, uct_cma_ep_t);
     size_t local_iov_idx = 0;
@@ -126,9 +127,11 @@ ucs_status_t uct_cma_ep_tx(uct_ep_h tl_ep, const uct_iov_t *iov, size_t iov_cnt,
                                   local_iov_cnt - local_iov_idx, &remote_iov,
                                   1, 0);
     if (ucs_unlikely(ret < 0)) {
-        uct_cma_ep_tx_error(ep, uct_cma_ep_fn[tx_op].name, ret, errno,
-                            &local_iov[local_iov_idx],
-                            local_iov_cnt - local_iov_idx, &remote_iov);
+        if (handle_error) {
+            uct_cma_ep_tx_error(ep, uct_cma_ep_fn[tx_op].name, ret, errno,
+                                &local_iov[local_iov_idx],
+                                local_iov_cnt - local_iov_idx, &remote_iov);
+        }
         return UCS_ERR_IO_ERROR;
     }
 
@@ -138,6 +141,25 @@ ucs_status_t uct_cma_ep_tx(uct_ep_h tl_ep, const uct_iov_t *iov, size_t iov_cnt,
     return UCS_OK;
 }
 
+ucs_status_t uct_cma_ep_tx(uct_ep_h tl_ep, const uct_iov_t *iov, size_t iov_cnt,
+                           ucs_iov_iter_t *iov_iter, size_t *length_p,
+                           uint64_t remote_addr, uct_rkey_t rkey,
+                           uct_scopy_tx_op_t tx_op)
+{
+    return uct_cma_ep_do_tx(tl_ep, iov, iov_cnt, iov_iter, length_p,
+                            remote_addr, tx_op, 1);
+}
+
+ucs_status_t uct_cma_ep_tx_mt(uct_ep_h tl_ep, const uct_iov_t *iov,
+                              size_t iov_cnt, ucs_iov_iter_t *iov_iter,
+                              size_t *length_p, uint64_t remote_addr,
+                              uct_rkey_t rkey, uct_scopy_tx_op_t tx_op)
+{
+    /* The error is handled when the operation is repeated by uct_cma_ep_tx */
+    return uct_cma_ep_do_tx(tl_ep, iov, iov_cnt, iov_iter, length_p,
+                            remote_addr, tx_op, 0);
+}
+
 ucs_status_t uct_cma_ep_check(const uct_ep_h tl_ep, unsigned flags,
                               uct_completion_t *comp)
 {
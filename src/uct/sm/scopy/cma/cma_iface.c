@@ -14,6 +14,12 @@
 
 #include <uct/base/uct_md.h>
 #include <ucs/sys/string.h>
+#include <ucs/time/time.h>
+#include <ucs/type/init_once.h>
+
+
+/* Number of system calls to measure the TX overhead */
+#define UCT_CMA_IFACE_CALIB_ITERS 1000
 
 
 typedef struct {
@@ -163,17 +169,55 @@ static uct_scopy_iface_ops_t uct_cma_iface_ops = {
         .ep_is_connected        = uct_cma_ep_is_connected,
         .ep_get_device_ep       = (uct_ep_get_device_ep_func_t)ucs_empty_function_return_unsupported
     },
-    .ep_tx = uct_cma_ep_tx,
+    .ep_tx    = uct_cma_ep_tx,
+    .ep_tx_mt = uct_cma_ep_tx_mt
 };
 
+static double uct_cma_iface_measure_tx_overhead(void)
+{
+    uint64_t src         = 0;
+    uint64_t dst         = 0;
+    struct iovec src_iov = {.iov_base = &src, .iov_len = sizeof(src)};
+    struct iovec dst_iov = {.iov_base = &dst, .iov_len = sizeof(dst)};
+    pid_t pid            = getpid();
+    ucs_time_t start_time;
+    unsigned i;
+
+    start_time = ucs_get_time();
+    for (i = 0; i < UCT_CMA_IFACE_CALIB_ITERS; ++i) {
+        if (process_vm_readv(pid, &dst_iov, 1, &src_iov, 1, 0) < 0) {
+            return 0;
+        }
+    }
+
+    return ucs_time_to_sec(ucs_get_time() - start_time) /
+           UCT_CMA_IFACE_CALIB_ITERS;
+}
+
 static UCS_CLASS_INIT_FUNC(uct_cma_iface_t, uct_md_h md, uct_worker_h worker,
                            const uct_iface_params_t *params,
                            const uct_iface_config_t *tl_config)
 {
+    static ucs_init_once_t calib_once = UCS_INIT_ONCE_INITIALIZER;
+    static double tx_overhead         = 0;
+    uct_cma_iface_config_t *config    = ucs_derived_of(tl_config,
+                                                       uct_cma_iface_config_t);
+
     UCS_CLASS_CALL_SUPER_INIT(uct_scopy_iface_t, &uct_cma_iface_tl_ops,
                               &uct_cma_iface_ops, md, worker, params,
                               tl_config);
 
+    if (config->super.super.calibrate) {
+        UCS_INIT_ONCE(&calib_once) {
+            tx_overhead = uct_sm_perf_get(&config->super.super, "cma_overhead",
+                                          uct_cma_iface_measure_tx_overhead);
+        }
+
+        if (tx_overhead > 0) {
+            self->super.config.tx_overhead = tx_overhead;
+        }
+    }
+
     return UCS_OK;
 }
 
@@ -85,7 +85,8 @@ static uct_scopy_iface_ops_t uct_knem_iface_ops = {
         .ep_is_connected        = uct_base_ep_is_connected,
         .ep_get_device_ep       = (uct_ep_get_device_ep_func_t)ucs_empty_function_return_unsupported
     },
-    .ep_tx = uct_knem_ep_tx,
+    .ep_tx    = uct_knem_ep_tx,
+    .ep_tx_mt = NULL
 };
 
 static UCS_CLASS_INIT_FUNC(uct_knem_iface_t, uct_md_h md, uct_worker_h worker,
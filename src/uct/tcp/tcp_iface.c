@@ -801,6 +801,7 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
     mp_params.elem_size       = self->config.tx_seg_size;
     mp_params.ops             = &uct_tcp_mpool_ops;
     mp_params.name            = "uct_tcp_iface_tx_buf_mp";
+    mp_params.numa_node       = self->super.numa_node;
     status = ucs_mpool_init(&mp_params, &self->tx_mpool);
     if (status != UCS_OK) {
         goto err;
@@ -813,6 +814,7 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
     mp_params.elem_size       = self->config.rx_seg_size * 2;
     mp_params.ops             = &uct_tcp_mpool_ops;
     mp_params.name            = "uct_tcp_iface_rx_buf_mp";
+    mp_params.numa_node       = self->super.numa_node;
     status = ucs_mpool_init(&mp_params, &self->rx_mpool);
     if (status != UCS_OK) {
         goto err_cleanup_tx_mpool;
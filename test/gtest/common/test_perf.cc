@@ -204,6 +204,7 @@ void test_perf::test_params_init(const test_spec &test,
     params.api                 = test.api;
     params.command             = test.command;
     params.test_type           = test.test_type;
+    params.pattern             = test.pattern;
     params.thread_mode         = UCS_THREAD_MODE_SINGLE;
     params.async_mode          = UCS_ASYNC_THREAD_LOCK_TYPE;
     params.thread_count        = 1;
@@ -12,6 +12,7 @@
 extern "C" {
 #include <ucp/core/ucp_context.h>
 #include <ucs/sys/sys.h>
+#include <ucs/time/time.h>
 }
 
 class test_ucp_lib_query : public ucs::test {
@@ -61,6 +62,49 @@ UCS_TEST_P(test_ucp_context, minimal_field_mask) {
     }
 }
 
+UCS_TEST_SKIP_COND_P(test_ucp_context, startup_time,
+                     RUNNING_ON_VALGRIND || (ucs::test_time_multiplier() > 1))
+{
+    const unsigned num_iters = 20;
+    ucs_time_t start_time, config_time, init_time, worker_time;
+
+    config_time = init_time = worker_time = 0;
+    for (unsigned i = 0; i < num_iters; ++i) {
+        ucs::handle<ucp_config_t*> config;
+        ucs::handle<ucp_context_h> ucph;
+        ucs::handle<ucp_worker_h> worker;
+
+        start_time = ucs_get_time();
+        UCS_TEST_CREATE_HANDLE(ucp_config_t*, config, ucp_config_release,
+                               ucp_config_read, NULL, NULL);
+        config_time += ucs_get_time() - start_time;
+
+        ucp_params_t params;
+        params.field_mask = UCP_PARAM_FIELD_FEATURES;
+        params.features   = get_variant_ctx_params().features;
+
+        start_time = ucs_get_time();
+        UCS_TEST_CREATE_HANDLE(ucp_context_h, ucph, ucp_cleanup, ucp_init,
+                               &params, config.get());
+        init_time += ucs_get_time() - start_time;
+
+        ucp_worker_params_t worker_params;
+        worker_params.field_mask = 0;
+
+        start_time = ucs_get_time();
+        UCS_TEST_CREATE_HANDLE(ucp_worker_h, worker, ucp_worker_destroy,
+                               ucp_worker_create, ucph.get(), &worker_params);
+        worker_time += ucs_get_time() - start_time;
+    }
+
+    UCS_TEST_MESSAGE << "config_read: "
+                     << ucs_time_to_usec(config_time) / num_iters
+                     << " usec, init: "
+                     << ucs_time_to_usec(init_time) / num_iters
+                     << " usec, worker_create: "
+                     << ucs_time_to_usec(worker_time) / num_iters << " usec";
+}
+
 UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_context, all, "all")
 
 class test_ucp_aliases : public test_ucp_context {
@@ -12,6 +12,7 @@ extern "C" {
 #include <ucp/core/ucp_context.h>
 #include <ucp/core/ucp_mm.h>
 #include <ucp/core/ucp_rkey.h>
+#include <ucp/core/ucp_worker.h>
 #include <ucp/core/ucp_ep.inl>
 #include <ucp/dt/dt.h>
 #include <ucs/sys/math.h>
@@ -1318,6 +1319,59 @@ UCS_TEST_P(test_ucp_rkey_compare, rkey_compare)
 
 UCP_INSTANTIATE_TEST_CASE_GPU_AWARE(test_ucp_rkey_compare)
 
+class test_ucp_rkey_cache : public test_ucp_rkey_compare {
+protected:
+    size_t cache_size()
+    {
+        ucp_worker_h worker = receiver().worker();
+
+        EXPECT_EQ(ucs_lru_size(worker->rkey_cache.lru),
+                  kh_size(&worker->rkey_cache.hash));
+        return kh_size(&worker->rkey_cache.hash);
+    }
+};
+
+UCS_TEST_P(test_ucp_rkey_cache, unpack_cached, "RKEY_CACHE_SIZE=2")
+{
+    ucp_rkey_h rkey1, rkey2;
+
+    rkey1 = m_chunks[0]->unpack(receiver().ep());
+    rkey2 = m_chunks[0]->unpack(receiver().ep());
+    EXPECT_EQ(rkey1, rkey2);
+    EXPECT_TRUE(rkey1->flags & UCP_RKEY_DESC_FLAG_CACHED);
+    EXPECT_EQ(1, cache_size());
+
+    rkey2 = m_chunks[1]->unpack(receiver().ep());
+    if (rkey1 == rkey2) {
+        UCS_TEST_SKIP_R("packed remote keys do not depend on memory region");
+    }
+
+    EXPECT_EQ(2, cache_size());
+
+    /* Touch the first key, so the second one becomes least recently used */
+    EXPECT_EQ(rkey1, m_chunks[0]->unpack(receiver().ep()));
+    m_chunks[2]->unpack(receiver().ep());
+    EXPECT_EQ(2, cache_size());
+
+    /* Evicted key is still referenced and valid, but not returned anymore */
+    EXPECT_EQ(rkey1, m_chunks[0]->unpack(receiver().ep()));
+    EXPECT_NE(rkey2, m_chunks[1]->unpack(receiver().ep()));
+    EXPECT_TRUE(rkey2->flags & UCP_RKEY_DESC_FLAG_CACHED);
+}
+
+UCS_TEST_P(test_ucp_rkey_cache, disabled)
+{
+    ucp_rkey_h rkey1, rkey2;
+
+    rkey1 = m_chunks[0]->unpack(receiver().ep());
+    rkey2 = m_chunks[0]->unpack(receiver().ep());
+    EXPECT_NE(rkey1, rkey2);
+    EXPECT_FALSE(rkey1->flags & UCP_RKEY_DESC_FLAG_CACHED);
+    EXPECT_EQ(NULL, receiver().worker()->rkey_cache.lru);
+}
+
+UCP_INSTANTIATE_TEST_CASE_GPU_AWARE(test_ucp_rkey_cache)
+
 
 class test_ucp_mmap_export : public test_ucp_mmap {
 public:
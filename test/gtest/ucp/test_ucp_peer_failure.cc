@@ -14,6 +14,8 @@ extern "C" {
 #include <ucp/core/ucp_request.h> /* for debug */
 #include <ucp/core/ucp_worker.h>  /* for testing memory consumption */
 #include <ucp/rndv/proto_rndv.h>
+#include <ucp/wireup/wireup_ep.h>
+#include <uct/base/uct_iface.h>
 }
 
 #include <unordered_map>
@@ -623,6 +625,80 @@ UCS_TEST_P(test_ucp_peer_failure, force_close, "RC_FC_ENABLE?=n",
             false /* must_fail */);
 }
 
+class test_ucp_peer_failure_many_eps : public test_ucp_peer_failure {
+public:
+    test_ucp_peer_failure_many_eps()
+    {
+        /* Expose peer failure support of the shared memory transport */
+        m_env.push_back(new ucs::scoped_setenv("UCX_POSIX_ERROR_HANDLING",
+                                               "y"));
+    }
+
+    static void get_test_variants(std::vector<ucp_test_variant> &variants)
+    {
+        add_variant_with_value(variants, UCP_FEATURE_AM, TEST_AM, "am");
+    }
+};
+
+UCS_TEST_SKIP_COND_P(test_ucp_peer_failure_many_eps, fail_all,
+                     RUNNING_ON_VALGRIND || (ucs::test_time_multiplier() > 1))
+{
+    const size_t num_eps = 10000;
+    ucp_ep_params_t ep_params = get_ep_params();
+    std::vector<uct_ep_h> uct_eps;
+    std::vector<ucp_ep_h> eps;
+    std::vector<void*> reqs;
+    ucp_address_t *address;
+    size_t address_length;
+    ucs_status_t status;
+
+    status = ucp_worker_get_address(receiver().worker(), &address,
+                                    &address_length);
+    ASSERT_UCS_OK(status);
+
+    ep_params.field_mask |= UCP_EP_PARAM_FIELD_REMOTE_ADDRESS;
+    ep_params.address     = address;
+    for (size_t i = 0; i < num_eps; ++i) {
+        ucp_ep_h ep;
+        status = ucp_ep_create(sender().worker(), &ep_params, &ep);
+        ASSERT_UCS_OK(status);
+        eps.push_back(ep);
+    }
+
+    ucp_worker_release_address(receiver().worker(), address);
+    flush_worker(sender());
+
+    for (auto ep : eps) {
+        uct_eps.push_back(ucp_ep_get_lane(ep, ucp_ep_get_am_lane(ep)));
+        ASSERT_FALSE(ucp_wireup_ep_test(uct_eps.back()));
+    }
+
+    /* Fail all endpoints at once, as if the peer process died */
+    ucs_time_t start_time = ucs_get_time();
+    for (auto uct_ep : uct_eps) {
+        uct_iface_handle_ep_err(uct_ep->iface, uct_ep,
+                                UCS_ERR_ENDPOINT_TIMEOUT);
+    }
+    double handle_time = ucs_time_to_sec(ucs_get_time() - start_time);
+
+    wait_for_value(&m_err_count, num_eps);
+    double total_time = ucs_time_to_sec(ucs_get_time() - start_time);
+    EXPECT_EQ(num_eps, m_err_count);
+
+    UCS_TEST_MESSAGE << num_eps << " endpoints failed: error handlers "
+                     << (handle_time * UCS_MSEC_PER_SEC) << " ms, all "
+                     << "callbacks " << (total_time * UCS_MSEC_PER_SEC)
+                     << " ms";
+
+    for (auto ep : eps) {
+        reqs.push_back(ep_close_nbx(ep, UCP_EP_CLOSE_FLAG_FORCE));
+    }
+    requests_wait(reqs);
+}
+
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_peer_failure_many_eps, posix, "posix")
+
+
 class test_ucp_peer_failure_keepalive : public test_ucp_peer_failure
 {
 public:
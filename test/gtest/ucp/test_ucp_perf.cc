@@ -395,6 +395,68 @@ UCS_TEST_P(test_ucp_loopback, envelope)
 UCP_INSTANTIATE_TEST_CASE(test_ucp_loopback)
 
 
+class test_ucp_perf_pattern : public test_ucp_perf {
+public:
+    static void get_test_variants(std::vector<ucp_test_variant> &variants)
+    {
+        add_variant_with_value(variants, 0, UCX_PERF_CMD_TAG, "tag");
+        add_variant_with_value(variants, 0, UCX_PERF_CMD_AM, "am");
+        add_variant_with_value(variants, 0, UCX_PERF_CMD_PUT, "put");
+    }
+
+protected:
+    void test_pattern(ucx_perf_pattern_t pattern, size_t length)
+    {
+        /* Jain's index of n flows is within [1/n, 1], and the test runs
+         * with 2 processes */
+        test_spec test = { "pattern fairness", "",
+                           UCX_PERF_API_UCP,
+                           (ucx_perf_cmd_t)get_variant_value(),
+                           UCX_PERF_TEST_TYPE_STREAM_UNI,
+                           UCX_PERF_WAIT_MODE_POLL,
+                           UCP_PERF_DATATYPE_CONTIG,
+                           0, 1, { length }, 16, 1000lu,
+                           ucs_offsetof(ucx_perf_result_t, fairness),
+                           1.0, 0.5, 1.0 + 1e-6, 0,
+                           UCS_MEMORY_TYPE_HOST,
+                           UCS_MEMORY_TYPE_HOST,
+                           pattern };
+
+        std::stringstream ss;
+        ss << GetParam().transports;
+        /* coverity[tainted_string_argument] */
+        ucs::scoped_setenv tls("UCX_TLS", ss.str().c_str());
+
+        double fairness = run_test(test, 0, false, "", "");
+        EXPECT_GE(fairness, test.min);
+        EXPECT_LE(fairness, test.max);
+    }
+};
+
+UCS_TEST_P(test_ucp_perf_pattern, many_to_one)
+{
+    test_pattern(UCX_PERF_PATTERN_MANY_TO_ONE, 8);
+}
+
+UCS_TEST_P(test_ucp_perf_pattern, one_to_many)
+{
+    test_pattern(UCX_PERF_PATTERN_ONE_TO_MANY, 8);
+}
+
+UCS_TEST_P(test_ucp_perf_pattern, all_to_all)
+{
+    test_pattern(UCX_PERF_PATTERN_ALL_TO_ALL, 8);
+}
+
+UCS_TEST_P(test_ucp_perf_pattern, all_to_all_rndv)
+{
+    test_pattern(UCX_PERF_PATTERN_ALL_TO_ALL, 256 * UCS_KBYTE);
+}
+
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_perf_pattern, shm, "shm")
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_perf_pattern, tcp, "tcp")
+
+
 class test_ucp_wait_mem : public test_ucp_perf {
 public:
     static void get_test_variants(std::vector<ucp_test_variant> &variants)
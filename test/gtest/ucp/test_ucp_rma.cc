@@ -11,6 +11,7 @@ extern "C" {
 #include <ucp/core/ucp_context.h>
 #include <ucp/core/ucp_mm.h> /* for UCP_MEM_IS_ACCESSIBLE_FROM_CPU */
 #include <ucp/core/ucp_ep.inl>
+#include <ucp/core/ucp_request.h>
 #include <ucs/sys/sys.h>
 }
 
@@ -679,3 +680,204 @@ UCS_TEST_P(test_ucp_ep_based_fence, test_ep_based_fence_before_atomic) {
 }
 
 UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_ep_based_fence, all, "all")
+
+
+class test_ucp_rma_flush_dirty_eps : public test_ucp_memheap {
+public:
+    static void get_test_variants(std::vector<ucp_test_variant> &variants)
+    {
+        add_variant(variants, UCP_FEATURE_RMA);
+    }
+
+protected:
+    entity &peer(entity &e)
+    {
+        return is_self() ? e : receiver();
+    }
+
+    void create_eps(entity &e, size_t num_eps, std::vector<ucp_ep_h> &eps)
+    {
+        std::vector<ucp_ep_params_t> ep_params(num_eps, get_ep_params());
+        ucp_address_t *address;
+        size_t address_length;
+        ucs_status_t status;
+
+        status = ucp_worker_get_address(peer(e).worker(), &address,
+                                        &address_length);
+        ASSERT_UCS_OK(status);
+
+        for (auto &params : ep_params) {
+            params.field_mask |= UCP_EP_PARAM_FIELD_REMOTE_ADDRESS;
+            params.address     = address;
+        }
+
+        eps.resize(num_eps);
+        status = ucp_ep_create_bulk(e.worker(), ep_params.data(), num_eps,
+                                    eps.data());
+        ucp_worker_release_address(peer(e).worker(), address);
+        ASSERT_UCS_OK(status);
+    }
+
+    void close_eps(const std::vector<ucp_ep_h> &eps)
+    {
+        std::vector<void*> reqs;
+
+        for (auto ep : eps) {
+            reqs.push_back(ep_close_nbx(ep, 0));
+        }
+        requests_wait(reqs);
+    }
+
+    void put(ucp_ep_h ep, const mapped_buffer &rbuf, size_t index,
+             ucp_rkey_h rkey)
+    {
+        uint64_t value            = index;
+        ucp_request_param_t param = {0};
+
+        request_wait(ucp_put_nbx(ep, &value, sizeof(value),
+                                 (uint64_t)rbuf.ptr() + (index * sizeof(value)),
+                                 rkey, &param));
+    }
+
+    static ucp_ep_ptr_arr_t &dirty_eps(entity &e)
+    {
+        return e.worker()->flush_dirty_eps;
+    }
+
+    static void check_dirty_eps(entity &e)
+    {
+        unsigned idx = 0;
+        ucp_ep_h *ep_p;
+
+        ucs_array_for_each(ep_p, &dirty_eps(e)) {
+            EXPECT_EQ(idx++, (*ep_p)->ext->flush_dirty_idx);
+        }
+    }
+
+    /* Emulate a transport with outstanding operations, so the worker flush
+     * goes over the endpoints, and return the time it took */
+    double flush_walk_time(entity &e)
+    {
+        ucp_worker_h worker = e.worker();
+        ucs_time_t start_time;
+        ucp_request_t *req;
+        void *request;
+
+        ++worker->flush_ops_count;
+        start_time = ucs_get_time();
+        request    = e.flush_worker_nb();
+        EXPECT_TRUE(UCS_PTR_IS_PTR(request));
+        req = (ucp_request_t*)request - 1;
+        while ((req->flush_worker.dirty_ep_idx <
+                req->flush_worker.num_dirty_eps) ||
+               (&req->flush_worker.next_ep_ext->ep_list != &worker->all_eps)) {
+            e.progress();
+        }
+        --worker->flush_ops_count;
+        request_wait(request);
+        return ucs_time_to_sec(ucs_get_time() - start_time);
+    }
+
+    double measure_flush(entity &e, size_t num_eps, size_t num_dirty_eps)
+    {
+        const unsigned num_iters = 10;
+        mapped_buffer rbuf(num_eps * sizeof(uint64_t), peer(e));
+        ucs::handle<ucp_rkey_h> rkey;
+        std::vector<ucp_ep_h> eps;
+        double time = 0;
+
+        create_eps(e, num_eps, eps);
+        rbuf.memset(0);
+        rbuf.rkey(e, rkey);
+
+        for (unsigned iter = 0; iter < num_iters; ++iter) {
+            for (size_t i = iter; i < num_eps; i += num_eps / num_dirty_eps) {
+                put(eps[i], rbuf, i, rkey);
+            }
+            time += flush_walk_time(e);
+        }
+
+        for (size_t i = 0; i < num_eps; i += num_eps / num_dirty_eps) {
+            EXPECT_EQ(i, static_cast<uint64_t*>(rbuf.ptr())[i]);
+        }
+
+        rkey.reset();
+        close_eps(eps);
+        return time / num_iters;
+    }
+};
+
+UCS_TEST_P(test_ucp_rma_flush_dirty_eps, track)
+{
+    const size_t num_eps = 64;
+    mapped_buffer rbuf(num_eps * sizeof(uint64_t), receiver());
+    ucs::handle<ucp_rkey_h> rkey;
+    std::vector<ucp_ep_h> eps;
+
+    create_eps(sender(), num_eps, eps);
+    rbuf.rkey(sender(), rkey);
+    flush_worker(sender());
+    EXPECT_EQ(0, ucs_array_length(&dirty_eps(sender())));
+
+    for (size_t i = 0; i < num_eps; i += 4) {
+        put(eps[i], rbuf, i, rkey);
+        put(eps[i], rbuf, i, rkey);
+    }
+    EXPECT_EQ(num_eps / 4, ucs_array_length(&dirty_eps(sender())));
+    check_dirty_eps(sender());
+
+    /* Closing a dirty endpoint removes it from the set */
+    std::vector<ucp_ep_h> closed_eps = {eps[0], eps[num_eps / 2]};
+    eps.erase(eps.begin() + (num_eps / 2));
+    eps.erase(eps.begin());
+    close_eps(closed_eps);
+    EXPECT_EQ((num_eps / 4) - 2, ucs_array_length(&dirty_eps(sender())));
+    check_dirty_eps(sender());
+
+    flush_walk_time(sender());
+    EXPECT_EQ(0, ucs_array_length(&dirty_eps(sender())));
+
+    put(eps[1], rbuf, 1, rkey);
+    flush_worker(sender());
+    EXPECT_EQ(0, ucs_array_length(&dirty_eps(sender())));
+    EXPECT_EQ(1, static_cast<uint64_t*>(rbuf.ptr())[1]);
+
+    rkey.reset();
+    close_eps(eps);
+}
+
+UCS_TEST_P(test_ucp_rma_flush_dirty_eps, untracked,
+           "FLUSH_WORKER_DIRTY_EPS=n")
+{
+    mapped_buffer rbuf(sizeof(uint64_t), receiver());
+    ucs::handle<ucp_rkey_h> rkey;
+
+    rbuf.rkey(sender(), rkey);
+    put(sender().ep(), rbuf, 0, rkey);
+    EXPECT_EQ(0, ucs_array_length(&dirty_eps(sender())));
+    flush_walk_time(sender());
+}
+
+UCS_TEST_SKIP_COND_P(test_ucp_rma_flush_dirty_eps, flush_rate,
+                     RUNNING_ON_VALGRIND || (ucs::test_time_multiplier() > 1))
+{
+    const size_t num_eps       = is_self() ? 100000 : 10000;
+    const size_t num_dirty_eps = num_eps / 100;
+
+    entity &e = sender();
+    modify_config("FLUSH_WORKER_DIRTY_EPS", "n");
+    entity *all_e = create_entity(true);
+    all_e->connect(&peer(*all_e), get_ep_params());
+
+    double dirty_time = measure_flush(e, num_eps, num_dirty_eps);
+    double all_time   = measure_flush(*all_e, num_eps, num_dirty_eps);
+
+    UCS_TEST_MESSAGE << num_eps << " endpoints, " << num_dirty_eps
+                     << " dirty: worker flush " << (all_time * UCS_USEC_PER_SEC)
+                     << " usec over all endpoints, "
+                     << (dirty_time * UCS_USEC_PER_SEC)
+                     << " usec over dirty endpoints";
+}
+
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_rma_flush_dirty_eps, self, "self")
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_rma_flush_dirty_eps, shm, "shm")
@@ -7,6 +7,7 @@
 #include "ucp_test.h"
 
 #include <algorithm>
+#include <thread>
 #include <sys/epoll.h>
 #include <sys/poll.h>
 
@@ -178,6 +179,96 @@ UCS_TEST_P(test_ucp_wakeup, signal)
     EXPECT_EQ(UCS_OK, ucp_worker_arm(worker));
 }
 
+UCS_TEST_P(test_ucp_wakeup, wait_adaptive)
+{
+    const ucp_datatype_t DATATYPE = ucp_dt_make_contig(1);
+    const uint64_t TAG            = 0xdeadbeef;
+    uint64_t send_data            = 0x12121212;
+    uint64_t recv_data            = 0;
+    ucp_worker_wait_attr_t attr;
+    void *sreq, *rreq;
+
+    sender().connect(&receiver(), get_ep_params());
+
+    sreq = ucp_tag_send_nb(sender().ep(), &send_data, sizeof(send_data),
+                           DATATYPE, TAG, send_completion);
+    if (UCS_PTR_IS_PTR(sreq)) {
+        wait(sreq);
+    } else {
+        ASSERT_UCS_OK(UCS_PTR_STATUS(sreq));
+    }
+
+    rreq = ucp_tag_recv_nb(receiver().worker(), &recv_data, sizeof(recv_data),
+                           DATATYPE, TAG, (ucp_tag_t)-1, recv_completion);
+
+    attr.field_mask = UCP_WORKER_WAIT_ATTR_FIELD_SPIN_TIME |
+                      UCP_WORKER_WAIT_ATTR_FIELD_BLOCK_TIME |
+                      UCP_WORKER_WAIT_ATTR_FIELD_SPIN_LIMIT;
+    while (!ucp_request_is_completed(rreq)) {
+        ASSERT_UCS_OK(ucp_worker_wait_adaptive(receiver().worker(), &attr));
+        EXPECT_GE(attr.spin_time, 0);
+        EXPECT_GE(attr.block_time, 0);
+        EXPECT_LE(attr.spin_limit, 100e-6 * 1.01);
+    }
+    ucp_request_release(rreq);
+
+    flush_worker(sender());
+    EXPECT_EQ(send_data, recv_data);
+}
+
+UCS_TEST_SKIP_COND_P(test_ucp_wakeup, wait_adaptive_learn,
+                     RUNNING_ON_VALGRIND, "WAIT_SPIN_MAX=1ms")
+{
+    const double spin_max    = 1e-3;
+    const unsigned num_iters = 20;
+    ucp_worker_h worker      = sender().worker();
+    double spin_time         = 0;
+    double block_time        = 0;
+    ucp_worker_wait_attr_t attr;
+
+    attr.field_mask = UCP_WORKER_WAIT_ATTR_FIELD_SPIN_TIME |
+                      UCP_WORKER_WAIT_ATTR_FIELD_BLOCK_TIME |
+                      UCP_WORKER_WAIT_ATTR_FIELD_SPIN_LIMIT;
+
+    /* Events are signaled much later than the polling limit, so the worker
+     * should stop polling and block right away */
+    for (unsigned i = 0; i < num_iters; ++i) {
+        std::thread signal_thread([worker]() {
+            usleep(5000);
+            ucp_worker_signal(worker);
+        });
+
+        ASSERT_UCS_OK(ucp_worker_wait_adaptive(worker, &attr));
+        signal_thread.join();
+        EXPECT_LE(attr.spin_limit, spin_max * 1.01);
+        spin_time  += attr.spin_time;
+        block_time += attr.block_time;
+
+        /* Consume the signal, so the next wait would block */
+        while (ucp_worker_arm(worker) == UCS_ERR_BUSY) {
+            progress();
+        }
+    }
+
+    EXPECT_EQ(0, attr.spin_limit);
+    EXPECT_LT(attr.spin_time, spin_max);
+
+    UCS_TEST_MESSAGE << "idle worker: " << (spin_time * UCS_USEC_PER_SEC)
+                     << " usec polling, " << (block_time * UCS_USEC_PER_SEC)
+                     << " usec blocked";
+
+    /* Events are pending, so the wait should return without blocking and
+     * resume polling */
+    bool polling = false;
+    for (unsigned i = 0; i < num_iters; ++i) {
+        ASSERT_UCS_OK(ucp_worker_signal(worker));
+        ASSERT_UCS_OK(ucp_worker_wait_adaptive(worker, &attr));
+        polling = polling || (attr.spin_limit > 0);
+    }
+
+    EXPECT_TRUE(polling);
+}
+
 UCP_INSTANTIATE_TEST_CASE(test_ucp_wakeup)
 
 class test_ucp_wakeup_external_epollfd : public test_ucp_wakeup {
@@ -12,6 +12,7 @@
 #include "ucp/ucp_test.h"
 
 #include <algorithm>
+#include <fstream>
 #include <set>
 
 extern "C" {
@@ -564,6 +565,173 @@ UCS_TEST_P(test_ucp_wireup_1sided, empty_address) {
     ucs_free(buffer);
 }
 
+UCS_TEST_P(test_ucp_wireup_1sided, compact_address) {
+    ucp_worker_h worker = sender().worker();
+    unsigned flags      = ucp_worker_default_address_pack_flags(worker);
+    ucp_unpacked_address_t unpacked_full, unpacked_compact;
+    ucp_worker_attr_t attr;
+    ucs_status_t status;
+    size_t full_size;
+    void *full;
+
+    attr.field_mask    = UCP_WORKER_ATTR_FIELD_ADDRESS |
+                         UCP_WORKER_ATTR_FIELD_ADDRESS_FLAGS |
+                         UCP_WORKER_ATTR_FIELD_ADDRESS_TEMPLATE;
+    attr.address_flags = UCP_WORKER_ADDRESS_FLAG_COMPACT;
+    status             = ucp_worker_query(worker, &attr);
+    ASSERT_UCS_OK(status);
+
+    status = ucp_address_pack(worker, NULL, &ucp_tl_bitmap_max, flags,
+                              UCP_OBJECT_VERSION_V2, NULL, UINT_MAX,
+                              &full_size, &full);
+    ASSERT_UCS_OK(status);
+    EXPECT_LT(attr.address_length, full_size);
+
+    /* The template is unknown to the receiver */
+    if (!is_loopback()) {
+        status = ucp_address_unpack(receiver().worker(), attr.address,
+                                    flags | UCP_ADDRESS_PACK_FLAG_NO_TRACE,
+                                    &unpacked_compact);
+        EXPECT_EQ(UCS_ERR_INVALID_PARAM, status);
+    }
+
+    status = ucp_address_template_add(receiver().worker(),
+                                      attr.address_template, NULL);
+    ASSERT_UCS_OK(status);
+
+    status = ucp_address_unpack(receiver().worker(), attr.address, flags,
+                                &unpacked_compact);
+    ASSERT_UCS_OK(status);
+    status = ucp_address_unpack(receiver().worker(), full, flags,
+                                &unpacked_full);
+    ASSERT_UCS_OK(status);
+
+    EXPECT_EQ(worker->uuid, unpacked_compact.uuid);
+    EXPECT_EQ(std::string(unpacked_full.name),
+              std::string(unpacked_compact.name));
+    EXPECT_EQ(unpacked_full.dst_version, unpacked_compact.dst_version);
+    ASSERT_EQ(unpacked_full.address_count, unpacked_compact.address_count);
+    for (unsigned i = 0; i < unpacked_full.address_count; ++i) {
+        const ucp_address_entry_t *ae_full    = &unpacked_full.address_list[i];
+        const ucp_address_entry_t *ae_compact =
+                &unpacked_compact.address_list[i];
+
+        EXPECT_EQ(ae_full->tl_name_csum, ae_compact->tl_name_csum);
+        EXPECT_EQ(ae_full->md_index, ae_compact->md_index);
+        EXPECT_EQ(ae_full->dev_index, ae_compact->dev_index);
+        EXPECT_EQ(ae_full->sys_dev, ae_compact->sys_dev);
+        EXPECT_EQ(ae_full->dev_num_paths, ae_compact->dev_num_paths);
+        EXPECT_EQ(ae_full->iface_attr.flags, ae_compact->iface_attr.flags);
+        EXPECT_EQ(ae_full->iface_attr.bandwidth,
+                  ae_compact->iface_attr.bandwidth);
+        EXPECT_EQ(0u, ae_compact->num_ep_addrs);
+        ASSERT_EQ(ae_full->dev_addr_len, ae_compact->dev_addr_len);
+        ASSERT_EQ(ae_full->dev_addr == NULL, ae_compact->dev_addr == NULL);
+        if (ae_full->dev_addr != NULL) {
+            EXPECT_EQ(0, memcmp(ae_full->dev_addr, ae_compact->dev_addr,
+                                ae_full->dev_addr_len));
+        }
+        ASSERT_EQ(ae_full->iface_addr_len, ae_compact->iface_addr_len);
+        ASSERT_EQ(ae_full->iface_addr == NULL, ae_compact->iface_addr == NULL);
+        if (ae_full->iface_addr != NULL) {
+            EXPECT_EQ(0, memcmp(ae_full->iface_addr, ae_compact->iface_addr,
+                                ae_full->iface_addr_len));
+        }
+    }
+
+    ucs_free(unpacked_full.address_list);
+    ucs_free(unpacked_compact.address_list);
+    ucs_free(full);
+    ucp_worker_release_address(worker, attr.address);
+    ucp_worker_release_address(worker, attr.address_template);
+}
+
+UCS_TEST_P(test_ucp_wireup_1sided, compact_address_wireup) {
+    ucp_ep_params_t ep_params = get_ep_params();
+    ucp_worker_attr_t attr;
+    ucs_status_t status;
+    ucp_ep_h ep;
+
+    attr.field_mask    = UCP_WORKER_ATTR_FIELD_ADDRESS |
+                         UCP_WORKER_ATTR_FIELD_ADDRESS_FLAGS |
+                         UCP_WORKER_ATTR_FIELD_ADDRESS_TEMPLATE;
+    attr.address_flags = UCP_WORKER_ADDRESS_FLAG_COMPACT;
+    status             = ucp_worker_query(receiver().worker(), &attr);
+    ASSERT_UCS_OK(status);
+
+    ep_params.field_mask      |= UCP_EP_PARAM_FIELD_REMOTE_ADDRESS |
+                                 UCP_EP_PARAM_FIELD_REMOTE_ADDRESS_TEMPLATE;
+    ep_params.address          = attr.address;
+    ep_params.address_template = attr.address_template;
+    status = ucp_ep_create(sender().worker(), &ep_params, &ep);
+    ASSERT_UCS_OK(status);
+
+    ucp_worker_release_address(receiver().worker(), attr.address);
+    ucp_worker_release_address(receiver().worker(), attr.address_template);
+
+    send_recv(ep, receiver().worker(), NULL, 1, 1);
+    disconnect(ep);
+}
+
+UCS_TEST_SKIP_COND_P(test_ucp_wireup_1sided, compact_address_perf,
+                     RUNNING_ON_VALGRIND ||
+                     (ucs::test_time_multiplier() > 1)) {
+    const size_t num_ranks = 100000;
+    const int num_unpacks  = 100000;
+    ucp_worker_h worker    = receiver().worker();
+    unsigned flags         = ucp_worker_default_address_pack_flags(worker);
+    ucp_unpacked_address_t unpacked;
+    ucp_worker_attr_t attr;
+    ucs_status_t status;
+    size_t full_size;
+    void *full;
+
+    attr.field_mask    = UCP_WORKER_ATTR_FIELD_ADDRESS |
+                         UCP_WORKER_ATTR_FIELD_ADDRESS_FLAGS |
+                         UCP_WORKER_ATTR_FIELD_ADDRESS_TEMPLATE;
+    attr.address_flags = UCP_WORKER_ADDRESS_FLAG_COMPACT;
+    status             = ucp_worker_query(worker, &attr);
+    ASSERT_UCS_OK(status);
+
+    status = ucp_address_pack(worker, NULL, &ucp_tl_bitmap_max, flags,
+                              UCP_OBJECT_VERSION_V2, NULL, UINT_MAX,
+                              &full_size, &full);
+    ASSERT_UCS_OK(status);
+
+    status = ucp_address_template_add(sender().worker(),
+                                      attr.address_template, NULL);
+    ASSERT_UCS_OK(status);
+
+    double time[2];
+    const void *buffers[2] = {full, attr.address};
+    for (int i = 0; i < 2; ++i) {
+        ucs_time_t start_time = ucs_get_time();
+        for (int n = 0; n < num_unpacks; ++n) {
+            status = ucp_address_unpack(sender().worker(), buffers[i], flags,
+                                        &unpacked);
+            ASSERT_UCS_OK(status);
+            ucs_free(unpacked.address_list);
+        }
+        time[i] = ucs_time_to_sec(ucs_get_time() - start_time);
+    }
+
+    UCS_TEST_MESSAGE << "address size: full " << full_size << ", compact "
+                     << attr.address_length << " + template "
+                     << attr.address_template_length;
+    UCS_TEST_MESSAGE << num_ranks << " ranks all-gather: full "
+                     << (full_size * num_ranks) / UCS_KBYTE << " KB, compact "
+                     << (attr.address_length * num_ranks +
+                         attr.address_template_length) / UCS_KBYTE << " KB";
+    UCS_TEST_MESSAGE << "unpack time: full "
+                     << (time[0] * UCS_NSEC_PER_SEC / num_unpacks)
+                     << " ns, compact "
+                     << (time[1] * UCS_NSEC_PER_SEC / num_unpacks) << " ns";
+
+    ucs_free(full);
+    ucp_worker_release_address(worker, attr.address);
+    ucp_worker_release_address(worker, attr.address_template);
+}
+
 UCS_TEST_P(test_ucp_wireup_1sided, one_sided_wireup) {
     sender().connect(&receiver(), get_ep_params());
     send_recv(sender().ep(), receiver().worker(), receiver().ep(), 1, 1);
@@ -768,6 +936,15 @@ public:
 
 protected:
     void test_connect_loopback(bool delay_before_connect, bool enable_loopback);
+
+    ucp_ep_params_t get_lazy_ep_params()
+    {
+        ucp_ep_params_t ep_params = get_ep_params();
+
+        ep_params.field_mask |= UCP_EP_PARAM_FIELD_FLAGS;
+        ep_params.flags      |= UCP_EP_PARAMS_FLAGS_LAZY_CONNECT;
+        return ep_params;
+    }
 };
 
 UCS_TEST_P(test_ucp_wireup_2sided, two_sided_wireup) {
@@ -902,6 +1079,60 @@ UCS_TEST_P(test_ucp_wireup_2sided, close_nbx_callback) {
     requests_wait(reqs);
 }
 
+UCS_TEST_P(test_ucp_wireup_2sided, lazy_connect) {
+    sender().connect(&receiver(), get_lazy_ep_params());
+    EXPECT_TRUE(sender().ep()->flags & UCP_EP_FLAG_LAZY_CONNECT);
+    if (!is_loopback()) {
+        receiver().connect(&sender(), get_lazy_ep_params());
+    }
+
+    send_recv(sender().ep(), receiver().worker(), receiver().ep(), 1, 1);
+    EXPECT_FALSE(sender().ep()->flags & UCP_EP_FLAG_LAZY_CONNECT);
+    flush_worker(sender());
+    send_recv(receiver().ep(), sender().worker(), sender().ep(), 1, 1);
+    flush_worker(receiver());
+}
+
+UCS_TEST_P(test_ucp_wireup_2sided, lazy_connect_remote_first) {
+    if (is_loopback()) {
+        UCS_TEST_SKIP_R("loopback");
+    }
+
+    sender().connect(&receiver(), get_lazy_ep_params());
+    receiver().connect(&sender(), get_ep_params());
+
+    /* With point-to-point transports, the wireup request from the peer
+     * connects the deferred endpoint */
+    send_recv(receiver().ep(), sender().worker(), sender().ep(), 1, 1);
+    flush_worker(receiver());
+    send_recv(sender().ep(), receiver().worker(), receiver().ep(), 1, 1);
+    flush_worker(sender());
+}
+
+UCS_TEST_P(test_ucp_wireup_2sided, lazy_connect_unused) {
+    ucp_ep_attr_t attr;
+    ucp_transport_entry_t transports[UCP_MAX_LANES];
+
+    sender().connect(&receiver(), get_lazy_ep_params());
+    if (!is_loopback()) {
+        /* Released by the worker cleanup */
+        receiver().connect(&sender(), get_lazy_ep_params());
+    }
+
+    attr.field_mask             = UCP_EP_ATTR_FIELD_TRANSPORTS;
+    attr.transports.entries     = transports;
+    attr.transports.num_entries = UCP_MAX_LANES;
+    attr.transports.entry_size  = sizeof(transports[0]);
+    ASSERT_UCS_OK(ucp_ep_query(sender().ep(), &attr));
+    EXPECT_EQ(0, attr.transports.num_entries);
+
+    /* Flushing the worker does not connect the endpoint */
+    flush_worker(sender());
+    EXPECT_TRUE(sender().ep()->flags & UCP_EP_FLAG_LAZY_CONNECT);
+
+    disconnect(sender());
+}
+
 UCS_TEST_P(test_ucp_wireup_2sided, multi_ep_2sided) {
     const unsigned count = 10;
 
@@ -1871,3 +2102,260 @@ UCS_TEST_SKIP_COND_P(test_ucp_address_v2, diff_seg_sizes,
 }
 
 UCP_INSTANTIATE_TEST_CASE(test_ucp_address_v2)
+
+class test_ucp_wireup_lanes_cache : public ucp_test {
+public:
+    static void get_test_variants(std::vector<ucp_test_variant> &variants)
+    {
+        add_variant(variants, UCP_FEATURE_TAG);
+    }
+
+protected:
+    double create_eps(entity &e, size_t num_eps, std::vector<ucp_ep_h> &eps,
+                      unsigned ep_flags = 0)
+    {
+        /* Self transport can reach only the same worker */
+        entity &peer              = is_self() ? e : receiver();
+        ucp_ep_params_t ep_params = get_ep_params();
+        ucp_address_t *address;
+        size_t address_length;
+        ucs_status_t status;
+
+        if (ep_flags != 0) {
+            ep_params.field_mask |= UCP_EP_PARAM_FIELD_FLAGS;
+            ep_params.flags      |= ep_flags;
+        }
+
+        status = ucp_worker_get_address(peer.worker(), &address,
+                                        &address_length);
+        EXPECT_UCS_OK(status);
+        if (status != UCS_OK) {
+            return 0;
+        }
+
+        ep_params.field_mask |= UCP_EP_PARAM_FIELD_REMOTE_ADDRESS;
+        ep_params.address     = address;
+
+        ucs_time_t start_time = ucs_get_time();
+        for (size_t i = 0; i < num_eps; ++i) {
+            ucp_ep_h ep;
+            status = ucp_ep_create(e.worker(), &ep_params, &ep);
+            if (status != UCS_OK) {
+                break;
+            }
+            eps.push_back(ep);
+        }
+        double elapsed = ucs_time_to_sec(ucs_get_time() - start_time);
+
+        ucp_worker_release_address(peer.worker(), address);
+        EXPECT_UCS_OK(status);
+        return elapsed;
+    }
+
+    double create_eps_bulk(entity &e, size_t num_eps,
+                           std::vector<ucp_ep_h> &eps)
+    {
+        entity &peer = is_self() ? e : receiver();
+        std::vector<ucp_ep_params_t> ep_params(num_eps, get_ep_params());
+        ucp_address_t *address;
+        size_t address_length;
+        ucs_status_t status;
+
+        status = ucp_worker_get_address(peer.worker(), &address,
+                                        &address_length);
+        EXPECT_UCS_OK(status);
+        if (status != UCS_OK) {
+            return 0;
+        }
+
+        for (auto &params : ep_params) {
+            params.field_mask |= UCP_EP_PARAM_FIELD_REMOTE_ADDRESS;
+            params.address     = address;
+        }
+
+        eps.resize(num_eps);
+        ucs_time_t start_time = ucs_get_time();
+        status = ucp_ep_create_bulk(e.worker(), ep_params.data(), num_eps,
+                                    eps.data());
+        double elapsed = ucs_time_to_sec(ucs_get_time() - start_time);
+
+        ucp_worker_release_address(peer.worker(), address);
+        EXPECT_UCS_OK(status);
+        return elapsed;
+    }
+
+    static size_t get_rss()
+    {
+        std::ifstream statm("/proc/self/statm");
+        size_t size = 0, resident = 0;
+
+        statm >> size >> resident;
+        return resident * ucs_get_page_size();
+    }
+
+    void close_eps(const std::vector<ucp_ep_h> &eps)
+    {
+        std::vector<void*> reqs;
+
+        for (auto ep : eps) {
+            if (ep != NULL) {
+                reqs.push_back(ep_close_nbx(ep, 0));
+            }
+        }
+        requests_wait(reqs);
+    }
+};
+
+UCS_TEST_P(test_ucp_wireup_lanes_cache, same_config)
+{
+    entity &cached_e = sender();
+    std::vector<ucp_ep_h> cached_eps, eps;
+
+    modify_config("WIREUP_LANES_CACHE_SIZE", "0");
+    entity *e = create_entity(true);
+
+    create_eps(cached_e, 3, cached_eps);
+    create_eps(*e, 1, eps);
+    ASSERT_EQ(3, cached_eps.size());
+    ASSERT_EQ(1, eps.size());
+
+    EXPECT_EQ(1, kh_size(&cached_e.worker()->lanes_cache));
+    EXPECT_EQ(0, kh_size(&e->worker()->lanes_cache));
+
+    /* Endpoints which used the cached lanes must have the same configuration
+     * as the one selected without the cache */
+    for (auto ep : cached_eps) {
+        EXPECT_EQ(ucp_ep_config(cached_eps.front()), ucp_ep_config(ep));
+        EXPECT_TRUE(ucp_ep_config_is_equal(&ucp_ep_config(eps.front())->key,
+                                           &ucp_ep_config(ep)->key));
+    }
+
+    close_eps(cached_eps);
+    close_eps(eps);
+}
+
+UCS_TEST_SKIP_COND_P(test_ucp_wireup_lanes_cache, create_rate,
+                     RUNNING_ON_VALGRIND || (ucs::test_time_multiplier() > 1))
+{
+    /* Every shared memory endpoint maps the remote FIFO, so keep the number
+     * of mappings below the system limit */
+    const size_t num_eps = is_self() ? 100000 : 10000;
+    entity &cached_e     = sender();
+    std::vector<ucp_ep_h> cached_eps, eps;
+
+    modify_config("WIREUP_LANES_CACHE_SIZE", "0");
+    entity *e = create_entity(true);
+
+    double time        = create_eps(*e, num_eps, eps);
+    double cached_time = create_eps(cached_e, num_eps, cached_eps);
+
+    UCS_TEST_MESSAGE << num_eps << " endpoints: "
+                     << (eps.size() / time) << " eps/sec without cache, "
+                     << (cached_eps.size() / cached_time)
+                     << " eps/sec with cache";
+
+    close_eps(cached_eps);
+    close_eps(eps);
+}
+
+UCS_TEST_P(test_ucp_wireup_lanes_cache, bulk_create)
+{
+    std::vector<ucp_ep_h> eps, bulk_eps;
+
+    create_eps(sender(), 1, eps);
+    create_eps_bulk(sender(), 16, bulk_eps);
+    ASSERT_EQ(1, eps.size());
+    ASSERT_EQ(16, bulk_eps.size());
+
+    for (auto ep : bulk_eps) {
+        ASSERT_NE((ucp_ep_h)NULL, ep);
+        EXPECT_EQ(ucp_ep_config(eps.front()), ucp_ep_config(ep));
+    }
+
+    close_eps(bulk_eps);
+    close_eps(eps);
+}
+
+UCS_TEST_P(test_ucp_wireup_lanes_cache, bulk_create_partial)
+{
+    entity &peer = is_self() ? sender() : receiver();
+    std::vector<ucp_ep_params_t> ep_params(3, get_ep_params());
+    std::vector<ucp_ep_h> eps(3);
+    ucp_address_t *address;
+    size_t address_length;
+    ucs_status_t status;
+
+    status = ucp_worker_get_address(peer.worker(), &address, &address_length);
+    ASSERT_UCS_OK(status);
+
+    /* The middle endpoint has no remote address */
+    for (size_t i = 0; i < ep_params.size(); i += 2) {
+        ep_params[i].field_mask |= UCP_EP_PARAM_FIELD_REMOTE_ADDRESS;
+        ep_params[i].address     = address;
+    }
+
+    {
+        scoped_log_handler wrap_err(wrap_errors_logger);
+        status = ucp_ep_create_bulk(sender().worker(), ep_params.data(),
+                                    ep_params.size(), eps.data());
+    }
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM, status);
+    EXPECT_NE((ucp_ep_h)NULL, eps[0]);
+    EXPECT_EQ((ucp_ep_h)NULL, eps[1]);
+    EXPECT_NE((ucp_ep_h)NULL, eps[2]);
+
+    ucp_worker_release_address(peer.worker(), address);
+    close_eps(eps);
+}
+
+UCS_TEST_SKIP_COND_P(test_ucp_wireup_lanes_cache, bulk_create_rate,
+                     RUNNING_ON_VALGRIND || (ucs::test_time_multiplier() > 1))
+{
+    const size_t num_eps = is_self() ? 100000 : 10000;
+    entity &bulk_e       = sender();
+    std::vector<ucp_ep_h> bulk_eps, eps;
+
+    entity *e = create_entity(true);
+
+    double time      = create_eps(*e, num_eps, eps);
+    double bulk_time = create_eps_bulk(bulk_e, num_eps, bulk_eps);
+
+    UCS_TEST_MESSAGE << num_eps << " endpoints: " << (eps.size() / time)
+                     << " eps/sec with ucp_ep_create, "
+                     << (bulk_eps.size() / bulk_time)
+                     << " eps/sec with ucp_ep_create_bulk";
+
+    close_eps(bulk_eps);
+    close_eps(eps);
+}
+
+UCS_TEST_SKIP_COND_P(test_ucp_wireup_lanes_cache, lazy_create_rate,
+                     RUNNING_ON_VALGRIND || (ucs::test_time_multiplier() > 1))
+{
+    const size_t num_eps = is_self() ? 50000 : 10000;
+    entity &lazy_e       = sender();
+    std::vector<ucp_ep_h> lazy_eps, eps;
+
+    entity *e = create_entity(true);
+
+    size_t rss  = get_rss();
+    double time = create_eps(*e, num_eps, eps);
+    size_t mem  = get_rss() - rss;
+
+    rss              = get_rss();
+    double lazy_time = create_eps(lazy_e, num_eps, lazy_eps,
+                                  UCP_EP_PARAMS_FLAGS_LAZY_CONNECT);
+    size_t lazy_mem  = get_rss() - rss;
+
+    UCS_TEST_MESSAGE << num_eps << " unused endpoints: "
+                     << (eps.size() / time) << " eps/sec and "
+                     << (mem / eps.size()) << " bytes/ep connected, "
+                     << (lazy_eps.size() / lazy_time) << " eps/sec and "
+                     << (lazy_mem / lazy_eps.size()) << " bytes/ep lazy";
+
+    close_eps(lazy_eps);
+    close_eps(eps);
+}
+
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_wireup_lanes_cache, self, "self")
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_wireup_lanes_cache, shm, "shm")
@@ -17,6 +17,8 @@ extern "C" {
 #include <uct/base/uct_iface.h>
 }
 
+#include <glob.h>
+
 
 class test_ucp_worker_discard : public ucp_test {
 public:
@@ -1008,3 +1010,329 @@ UCS_TEST_P(test_worker_cpu_mask, all_cpus)
 }
 
 UCP_INSTANTIATE_TEST_CASE_TLS(test_worker_cpu_mask, all, "all")
+
+class test_ucp_worker_progress_thread : public ucp_test {
+public:
+    static void get_test_variants(std::vector<ucp_test_variant> &variants)
+    {
+        add_variant_with_value(variants, UCP_FEATURE_TAG, 0, "");
+#if ENABLE_MT
+        add_variant_with_value(variants, UCP_FEATURE_TAG, 1,
+                               "progress_thread");
+#endif
+    }
+
+    test_ucp_worker_progress_thread()
+    {
+        if (progress_thread()) {
+            modify_config("PROGRESS_THREAD", "y");
+        }
+    }
+
+    void init() override
+    {
+        ucp_test::init();
+        sender().connect(&receiver(), get_ep_params());
+    }
+
+protected:
+    bool progress_thread() const
+    {
+        return get_variant_value(0);
+    }
+
+    void *send(const std::vector<char> &buffer)
+    {
+        ucp_request_param_t param = {};
+        void *sreq = ucp_tag_send_nbx(sender().ep(), buffer.data(),
+                                      buffer.size(), m_tag, &param);
+        EXPECT_FALSE(UCS_PTR_IS_ERR(sreq));
+        return sreq;
+    }
+
+    void *recv(std::vector<char> &buffer)
+    {
+        ucp_request_param_t param = {};
+        void *rreq = ucp_tag_recv_nbx(receiver().worker(), buffer.data(),
+                                      buffer.size(), m_tag, (ucp_tag_t)-1,
+                                      &param);
+        EXPECT_FALSE(UCS_PTR_IS_ERR(rreq));
+        return rreq;
+    }
+
+    static bool is_completed(void *req)
+    {
+        return !UCS_PTR_IS_PTR(req) ||
+               (ucp_request_check_status(req) != UCS_INPROGRESS);
+    }
+
+    static void release(void *req)
+    {
+        if (UCS_PTR_IS_PTR(req)) {
+            EXPECT_UCS_OK(ucp_request_check_status(req));
+            ucp_request_free(req);
+        }
+    }
+
+    /* Send and receive a message, while keeping the CPU busy for
+     * compute_time without calling ucp_worker_progress(). Returns the total
+     * time until the transfer is completed. */
+    ucs_time_t transfer(size_t size, ucs_time_t compute_time)
+    {
+        std::vector<char> sbuf(size, 'x'), rbuf(size);
+        ucs_time_t start_time = ucs_get_time();
+        void *rreq            = recv(rbuf);
+        void *sreq            = send(sbuf);
+
+        while (ucs_get_time() < (start_time + compute_time)) {
+            ucs_cpu_relax();
+        }
+
+        while (!is_completed(sreq) || !is_completed(rreq)) {
+            progress();
+        }
+
+        ucs_time_t elapsed = ucs_get_time() - start_time;
+        release(sreq);
+        release(rreq);
+        EXPECT_EQ(sbuf, rbuf);
+        return elapsed;
+    }
+
+    static const ucp_tag_t m_tag = 0x1337;
+};
+
+UCS_TEST_SKIP_COND_P(test_ucp_worker_progress_thread, progress,
+                     !progress_thread())
+{
+    static const size_t size = UCS_MBYTE;
+    std::vector<char> sbuf(size, 'x'), rbuf(size);
+    void *rreq = recv(rbuf);
+    void *sreq = send(sbuf);
+
+    /* The transfer must complete without calling ucp_worker_progress() */
+    ucs_time_t deadline = ucs::get_deadline();
+    while ((!is_completed(sreq) || !is_completed(rreq)) &&
+           (ucs_get_time() < deadline)) {
+        sched_yield();
+    }
+
+    ASSERT_TRUE(is_completed(sreq));
+    ASSERT_TRUE(is_completed(rreq));
+    release(sreq);
+    release(rreq);
+    EXPECT_EQ(sbuf, rbuf);
+}
+
+UCS_TEST_SKIP_COND_P(test_ucp_worker_progress_thread, overlap,
+                     RUNNING_ON_VALGRIND || (ucs::test_time_multiplier() > 1))
+{
+    static const size_t size       = 4 * UCS_MBYTE;
+    static const unsigned num_iter = 10;
+    ucs_time_t comm_time           = 0;
+    ucs_time_t total_time          = 0;
+    ucs_time_t compute_time;
+
+    /* Warmup, and measure communication time alone */
+    transfer(size, 0);
+    for (unsigned i = 0; i < num_iter; ++i) {
+        comm_time += transfer(size, 0);
+    }
+
+    comm_time   /= num_iter;
+    compute_time = comm_time * 2;
+    for (unsigned i = 0; i < num_iter; ++i) {
+        total_time += transfer(size, compute_time);
+    }
+
+    total_time /= num_iter;
+
+    /* Fraction of the communication time which was hidden by computation */
+    double overlap = (double)(ssize_t)(comm_time + compute_time - total_time) /
+                     comm_time;
+    UCS_TEST_MESSAGE << (progress_thread() ? "with" : "without")
+                     << " progress thread: communication "
+                     << ucs_time_to_usec(comm_time) << " usec, compute "
+                     << ucs_time_to_usec(compute_time) << " usec, total "
+                     << ucs_time_to_usec(total_time) << " usec, overlap "
+                     << ucs_max(0.0, ucs_min(overlap, 1.0)) * 100 << "%";
+}
+
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_worker_progress_thread, shm, "shm")
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_worker_progress_thread, tcp, "tcp")
+
+class test_ucp_worker_op_trace : public ucp_test {
+public:
+    static void get_test_variants(std::vector<ucp_test_variant> &variants)
+    {
+        add_variant(variants,
+                    UCP_FEATURE_TAG | UCP_FEATURE_AM | UCP_FEATURE_RMA);
+    }
+
+    test_ucp_worker_op_trace() :
+        m_trace_file("/tmp/gtest_ucp_op_trace." + ucs::to_string(getpid()) +
+                     "." + ucs::to_string(ucs_generate_uuid(0)))
+    {
+        modify_config("OP_TRACE_FILE", m_trace_file);
+    }
+
+    void init() override
+    {
+        ucp_test::init();
+        sender().connect(&receiver(), get_ep_params());
+    }
+
+    void cleanup() override
+    {
+        ucp_test::cleanup();
+        for (const std::string &path : trace_files()) {
+            unlink(path.c_str());
+        }
+    }
+
+protected:
+    static ucs_status_t
+    am_cb(void *arg, const void *header, size_t header_length, void *data,
+          size_t length, const ucp_am_recv_param_t *param)
+    {
+        return UCS_OK;
+    }
+
+    std::vector<std::string> trace_files() const
+    {
+        std::vector<std::string> files;
+        glob_t g;
+
+        if (glob((m_trace_file + "*").c_str(), 0, NULL, &g) == 0) {
+            files.assign(g.gl_pathv, g.gl_pathv + g.gl_pathc);
+            globfree(&g);
+        }
+
+        return files;
+    }
+
+    /* Read the records of the only worker which issued operations */
+    std::vector<ucp_op_trace_record_t> read_trace(uint32_t *num_peers) const
+    {
+        std::vector<ucp_op_trace_record_t> records;
+
+        for (const std::string &path : trace_files()) {
+            FILE *stream = fopen(path.c_str(), "r");
+            ucp_op_trace_header_t header;
+
+            EXPECT_TRUE(stream != NULL) << path;
+            if (stream == NULL) {
+                continue;
+            }
+
+            EXPECT_EQ(1, fread(&header, sizeof(header), 1, stream));
+            EXPECT_EQ(UCP_OP_TRACE_MAGIC, header.magic);
+            EXPECT_EQ(UCP_OP_TRACE_VERSION, header.version);
+            EXPECT_EQ(sizeof(ucp_op_trace_record_t), header.record_size);
+            if (header.num_records != 0) {
+                EXPECT_TRUE(records.empty());
+                records.resize(header.num_records);
+                EXPECT_EQ(header.num_records,
+                          fread(&records[0], sizeof(records[0]),
+                                records.size(), stream));
+                *num_peers = header.num_peers;
+            }
+
+            fclose(stream);
+        }
+
+        return records;
+    }
+
+    std::string m_trace_file;
+};
+
+UCS_TEST_P(test_ucp_worker_op_trace, record)
+{
+    static const ucp_tag_t tag  = 0x1234;
+    static const unsigned am_id = 3;
+    std::vector<char> buffer(1000, 'x');
+    std::vector<char> target(buffer.size());
+    std::vector<void*> recv_reqs;
+    ucp_request_param_t param   = {};
+    ucp_request_param_t iov_param;
+    ucp_am_handler_param_t am_param;
+    ucp_mem_map_params_t mem_params;
+    ucp_dt_iov_t iov[2];
+    ucp_mem_h memh;
+    ucp_rkey_h rkey;
+    void *rkey_buffer;
+    size_t rkey_size;
+
+    am_param.field_mask = UCP_AM_HANDLER_PARAM_FIELD_ID |
+                          UCP_AM_HANDLER_PARAM_FIELD_CB;
+    am_param.id         = am_id;
+    am_param.cb         = am_cb;
+    ASSERT_UCS_OK(ucp_worker_set_am_recv_handler(receiver().worker(),
+                                                 &am_param));
+
+    mem_params.field_mask = UCP_MEM_MAP_PARAM_FIELD_ADDRESS |
+                            UCP_MEM_MAP_PARAM_FIELD_LENGTH |
+                            UCP_MEM_MAP_PARAM_FIELD_FLAGS;
+    mem_params.address    = target.data();
+    mem_params.length     = target.size();
+    mem_params.flags      = 0;
+    ASSERT_UCS_OK(ucp_mem_map(receiver().ucph(), &mem_params, &memh));
+    ASSERT_UCS_OK(ucp_rkey_pack(receiver().ucph(), memh, &rkey_buffer,
+                                &rkey_size));
+    ASSERT_UCS_OK(ucp_ep_rkey_unpack(sender().ep(), rkey_buffer, &rkey));
+    ucp_rkey_buffer_release(rkey_buffer);
+
+    iov[0].buffer          = &buffer[0];
+    iov[0].length          = 100;
+    iov[1].buffer          = &buffer[100];
+    iov[1].length          = 200;
+    iov_param.op_attr_mask = UCP_OP_ATTR_FIELD_DATATYPE;
+    iov_param.datatype     = ucp_dt_make_iov();
+
+    for (ucp_tag_t recv_tag = tag; recv_tag <= tag + 1; ++recv_tag) {
+        recv_reqs.push_back(ucp_tag_recv_nbx(receiver().worker(),
+                                             target.data(), target.size(),
+                                             recv_tag, UCP_TAG_MASK_FULL,
+                                             &param));
+    }
+
+    request_wait(ucp_tag_send_nbx(sender().ep(), buffer.data(), 8, tag,
+                                  &param));
+    request_wait(ucp_tag_send_nbx(sender().ep(), iov, 2, tag + 1,
+                                  &iov_param));
+    requests_wait(recv_reqs);
+    request_wait(ucp_am_send_nbx(sender().ep(), am_id, NULL, 0, buffer.data(),
+                                 64, &param));
+    request_wait(ucp_put_nbx(sender().ep(), buffer.data(), buffer.size(),
+                             (uintptr_t)target.data(), rkey, &param));
+    flush_worker(sender());
+    ucp_rkey_destroy(rkey);
+
+    /* The trace is written when the worker is destroyed */
+    sender().destroy_worker();
+
+    uint32_t num_peers                         = 0;
+    std::vector<ucp_op_trace_record_t> records = read_trace(&num_peers);
+    ASSERT_EQ(4, records.size());
+    EXPECT_EQ(1, num_peers);
+
+    const uint8_t ops[]      = {UCP_OP_TRACE_TAG_SEND, UCP_OP_TRACE_TAG_SEND,
+                                UCP_OP_TRACE_AM_SEND, UCP_OP_TRACE_PUT};
+    const uint64_t lengths[] = {8, 300, 64, buffer.size()};
+    const uint64_t tags[]    = {tag, tag + 1, am_id, (uintptr_t)target.data()};
+    for (size_t i = 0; i < records.size(); ++i) {
+        EXPECT_EQ(ops[i], records[i].op) << i;
+        EXPECT_EQ(lengths[i], records[i].length) << i;
+        EXPECT_EQ(tags[i], records[i].tag) << i;
+        EXPECT_EQ(0, records[i].peer) << i;
+        if (i > 0) {
+            EXPECT_GE(records[i].timestamp, records[i - 1].timestamp) << i;
+        }
+    }
+
+    ucp_mem_unmap(receiver().ucph(), memh);
+}
+
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_worker_op_trace, shm, "shm")
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_worker_op_trace, tcp, "tcp")
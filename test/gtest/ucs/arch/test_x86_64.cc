@@ -64,11 +64,30 @@ protected:
         return result;
     }
 
+    static void skip_no_nt_buffer_transfer()
+    {
+        if (!UCS_ARCH_X86_NT_BUFFER_TRANSFER) {
+            UCS_TEST_SKIP_R("Built without AVX support");
+        }
+
+        if (!(ucs_arch_get_cpu_flag() & UCS_CPU_FLAG_AVX)) {
+            UCS_TEST_SKIP_R("CPU does not support AVX");
+        }
+    }
+
+    template <ucs_arch_memcpy_hint_t Hint>
+    static void *nt_buffer_transfer(void *dst, const void *src, size_t size)
+    {
+#if UCS_ARCH_X86_NT_BUFFER_TRANSFER
+        ucs_x86_nt_buffer_transfer(dst, src, size, Hint, size);
+#endif
+        return dst;
+    }
+
     void nt_buffer_transfer_test(ucs_arch_memcpy_hint_t hint)
     {
-#ifndef __AVX__
-        UCS_TEST_SKIP_R("Built without AVX support");
-#else
+        skip_no_nt_buffer_transfer();
+#if UCS_ARCH_X86_NT_BUFFER_TRANSFER
         int i, j;
         char *src, *dst;
         size_t len, total_size, test_window_size, hole_size, align;
@@ -185,6 +204,30 @@ UCS_TEST_SKIP_COND_F(test_arch, memcpy, RUNNING_ON_VALGRIND || !ucs::perf_retry_
     }
 }
 
+UCS_TEST_SKIP_COND_F(test_arch, nt_buffer_transfer_bw,
+                     RUNNING_ON_VALGRIND || !ucs::perf_retry_count) {
+    skip_no_nt_buffer_transfer();
+
+    for (size_t size = 64 * UCS_KBYTE; size <= 64 * UCS_MBYTE; size *= 4) {
+        char memunits_str[32];
+
+        ucs_memunits_to_str(size, memunits_str, sizeof(memunits_str));
+        UCS_TEST_MESSAGE
+                << memunits_str << " memcpy: "
+                << measure_memcpy_bandwidth<memcpy>(size) / UCS_GBYTE
+                << " nt_none: "
+                << measure_memcpy_bandwidth<nt_buffer_transfer<
+                           UCS_ARCH_MEMCPY_NT_NONE> >(size) / UCS_GBYTE
+                << " nt_src: "
+                << measure_memcpy_bandwidth<nt_buffer_transfer<
+                           UCS_ARCH_MEMCPY_NT_SOURCE> >(size) / UCS_GBYTE
+                << " nt_dst: "
+                << measure_memcpy_bandwidth<nt_buffer_transfer<
+                           UCS_ARCH_MEMCPY_NT_DEST> >(size) / UCS_GBYTE
+                << " GB/s";
+    }
+}
+
 UCS_TEST_F(test_arch, nt_buffer_transfer_nt_src) {
     nt_buffer_transfer_test(UCS_ARCH_MEMCPY_NT_SOURCE);
 }
@@ -11,6 +11,7 @@
 extern "C" {
 #include <ucs/sys/sys.h>
 #include <ucs/datastruct/arbiter.h>
+#include <ucs/time/time.h>
 }
 #include <set>
 
@@ -1077,3 +1078,321 @@ UCS_TEST_F(test_arbiter_random_resched, one_elem_many_groups) {
 UCS_TEST_F(test_arbiter_random_resched, many_elems_many_groups) {
     do_test_loop(42, 10, 4);
 }
+
+class test_arbiter_drr : public ucs::test {
+protected:
+    struct drr_elem {
+        unsigned           group_idx;
+        ucs_arbiter_elem_t elem;
+    };
+
+    virtual void init()
+    {
+        ucs::test::init();
+        ucs_arbiter_init(&m_arb);
+        m_max_consume = UINT_MAX;
+        m_result      = UCS_ARBITER_CB_RESULT_NEXT_GROUP;
+        m_push_self   = false;
+    }
+
+    virtual void cleanup()
+    {
+        for (size_t i = 0; i < m_groups.size(); ++i) {
+            ucs_arbiter_drr_group_purge(&m_arb, &m_groups[i], purge_cb, NULL);
+            ucs_arbiter_drr_group_cleanup(&m_groups[i]);
+        }
+        ucs_arbiter_cleanup(&m_arb);
+        ucs::test::cleanup();
+    }
+
+    void add_groups(const std::vector<unsigned> &weights,
+                    unsigned elems_per_group)
+    {
+        /* elements are pushed by address, so the vectors must not grow */
+        m_groups.resize(weights.size());
+        m_elems.resize((weights.size() * elems_per_group) + weights.size());
+
+        for (unsigned i = 0; i < weights.size(); ++i) {
+            ucs_arbiter_drr_group_init(&m_groups[i], weights[i]);
+            for (unsigned j = 0; j < elems_per_group; ++j) {
+                push(i, (i * elems_per_group) + j);
+            }
+            ucs_arbiter_group_schedule(&m_arb, &m_groups[i].super);
+        }
+    }
+
+    void push(unsigned group_idx, size_t elem_idx)
+    {
+        drr_elem *e = &m_elems[elem_idx];
+
+        e->group_idx = group_idx;
+        ucs_arbiter_elem_init(&e->elem);
+        ucs_arbiter_drr_group_push_elem(&m_groups[group_idx], &e->elem);
+    }
+
+    unsigned batch(ucs_arbiter_group_t *group, ucs_arbiter_elem_t **elems,
+                   unsigned count, ucs_arbiter_cb_result_t *result_p)
+    {
+        unsigned consumed = ucs_min(count, m_max_consume);
+        unsigned group_idx;
+
+        group_idx = ucs_container_of(elems[0], drr_elem, elem)->group_idx;
+        EXPECT_EQ(&m_groups[group_idx].super, group);
+        EXPECT_TRUE(ucs_arbiter_group_is_empty(group));
+
+        for (unsigned i = 0; i < consumed; ++i) {
+            EXPECT_EQ(group_idx,
+                      ucs_container_of(elems[i], drr_elem, elem)->group_idx);
+            m_sequence.push_back(elems[i]);
+        }
+        m_batches.push_back(count);
+
+        if (m_push_self) {
+            /* the extra element is placed at the end of the elements array */
+            m_push_self = false;
+            push(group_idx, m_elems.size() - m_groups.size() + group_idx);
+            ucs_arbiter_group_schedule(&m_arb, group);
+        }
+
+        *result_p = m_result;
+        return consumed;
+    }
+
+    static unsigned batch_cb(ucs_arbiter_t *arbiter, ucs_arbiter_group_t *group,
+                             ucs_arbiter_elem_t **elems, unsigned count,
+                             ucs_arbiter_cb_result_t *result_p, void *arg)
+    {
+        test_arbiter_drr *self = static_cast<test_arbiter_drr*>(arg);
+        return self->batch(group, elems, count, result_p);
+    }
+
+    static ucs_arbiter_cb_result_t purge_cb(ucs_arbiter_t *arbiter,
+                                            ucs_arbiter_group_t *group,
+                                            ucs_arbiter_elem_t *elem, void *arg)
+    {
+        return UCS_ARBITER_CB_RESULT_REMOVE_ELEM;
+    }
+
+    unsigned seq_group(size_t index) const
+    {
+        return ucs_container_of(m_sequence.at(index), drr_elem,
+                                elem)->group_idx;
+    }
+
+    size_t total_backlog() const
+    {
+        size_t backlog = 0;
+
+        for (size_t i = 0; i < m_groups.size(); ++i) {
+            backlog += ucs_arbiter_drr_group_backlog(&m_groups[i]);
+        }
+        return backlog;
+    }
+
+    ucs_arbiter_t                        m_arb;
+    std::vector<ucs_arbiter_drr_group_t> m_groups;
+    std::vector<drr_elem>                m_elems;
+    std::vector<ucs_arbiter_elem_t*>     m_sequence;
+    std::vector<unsigned>                m_batches;
+    unsigned                             m_max_consume;
+    ucs_arbiter_cb_result_t              m_result;
+    bool                                 m_push_self;
+};
+
+UCS_TEST_F(test_arbiter_drr, weights) {
+    const unsigned elems_per_group = 16;
+    std::vector<unsigned> weights  = {1, 2, 4};
+
+    add_groups(weights, elems_per_group);
+    EXPECT_EQ(weights.size() * elems_per_group, total_backlog());
+
+    ucs_arbiter_dispatch_drr(&m_arb, 1, batch_cb, this);
+    EXPECT_TRUE(ucs_arbiter_is_empty(&m_arb));
+    EXPECT_EQ(0u, total_backlog());
+    ASSERT_EQ(weights.size() * elems_per_group, m_sequence.size());
+
+    /* every round, each group gets a batch of its weight size */
+    std::vector<unsigned> expected = {0, 1, 1, 2, 2, 2, 2, 0, 1, 1};
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i], seq_group(i)) << "index " << i;
+    }
+    EXPECT_EQ(std::vector<unsigned>({1, 2, 4, 1, 2, 4}),
+              std::vector<unsigned>(m_batches.begin(), m_batches.begin() + 6));
+
+    /* elements of each group are dispatched in order */
+    for (size_t i = 1; i < m_sequence.size(); ++i) {
+        if (seq_group(i) == seq_group(i - 1)) {
+            EXPECT_LT(m_sequence[i - 1], m_sequence[i]);
+        }
+    }
+}
+
+UCS_TEST_F(test_arbiter_drr, large_weight) {
+    const unsigned elems_per_group = UCS_ARBITER_DRR_BATCH_MAX * 3;
+    std::vector<unsigned> weights  = {1, 2};
+
+    add_groups(weights, elems_per_group);
+
+    /* a visit larger than the batch size is split to several callbacks */
+    ucs_arbiter_dispatch_drr(&m_arb, UCS_ARBITER_DRR_BATCH_MAX, batch_cb, this);
+    EXPECT_EQ(0u, total_backlog());
+    EXPECT_EQ(0u, seq_group(UCS_ARBITER_DRR_BATCH_MAX - 1));
+    EXPECT_EQ(1u, seq_group(UCS_ARBITER_DRR_BATCH_MAX));
+    EXPECT_EQ(1u, seq_group((UCS_ARBITER_DRR_BATCH_MAX * 3) - 1));
+    EXPECT_EQ(0u, seq_group(UCS_ARBITER_DRR_BATCH_MAX * 3));
+}
+
+UCS_TEST_F(test_arbiter_drr, partial_resched) {
+    const unsigned elems_per_group = 8;
+    std::vector<unsigned> weights  = {4, 4, 4};
+
+    add_groups(weights, elems_per_group);
+
+    /* out of resources after the first element of every batch */
+    m_max_consume = 1;
+    m_result      = UCS_ARBITER_CB_RESULT_RESCHED_GROUP;
+    ucs_arbiter_dispatch_drr(&m_arb, 1, batch_cb, this);
+
+    EXPECT_EQ(weights.size(), m_sequence.size());
+    for (size_t i = 0; i < m_groups.size(); ++i) {
+        EXPECT_EQ(elems_per_group - 1,
+                  ucs_arbiter_drr_group_backlog(&m_groups[i]));
+        EXPECT_TRUE(ucs_arbiter_group_is_scheduled(&m_groups[i].super));
+        /* unused credits are kept, up to one visit */
+        EXPECT_EQ(3u, m_groups[i].deficit);
+    }
+
+    /* resources are back, the leftover credits are added to the next visit */
+    m_max_consume = UINT_MAX;
+    m_batches.clear();
+    ucs_arbiter_dispatch_drr(&m_arb, 1, batch_cb, this);
+    EXPECT_EQ(0u, total_backlog());
+    EXPECT_EQ(7u, m_batches.front());
+}
+
+UCS_TEST_F(test_arbiter_drr, push_from_callback) {
+    std::vector<unsigned> weights = {2};
+
+    add_groups(weights, 4);
+
+    m_push_self   = true;
+    m_max_consume = 1;
+    m_result      = UCS_ARBITER_CB_RESULT_NEXT_GROUP;
+    ucs_arbiter_dispatch_drr(&m_arb, 1, batch_cb, this);
+
+    EXPECT_EQ(0u, total_backlog());
+    ASSERT_EQ(5u, m_sequence.size());
+    /* the element pushed by the callback is dispatched after the old ones */
+    EXPECT_EQ(&m_elems.back().elem, m_sequence.back());
+    EXPECT_TRUE(ucs_arbiter_group_is_empty(&m_groups[0].super));
+}
+
+UCS_TEST_F(test_arbiter_drr, desched) {
+    std::vector<unsigned> weights = {1, 1};
+
+    add_groups(weights, 3);
+
+    m_max_consume = 0;
+    m_result      = UCS_ARBITER_CB_RESULT_DESCHED_GROUP;
+    ucs_arbiter_dispatch_drr(&m_arb, 1, batch_cb, this);
+
+    EXPECT_TRUE(ucs_arbiter_is_empty(&m_arb));
+    EXPECT_EQ(6u, total_backlog());
+    for (size_t i = 0; i < m_groups.size(); ++i) {
+        EXPECT_FALSE(ucs_arbiter_group_is_scheduled(&m_groups[i].super));
+        EXPECT_EQ(3u, ucs_arbiter_group_num_elems(&m_groups[i].super));
+    }
+}
+
+UCS_TEST_F(test_arbiter_drr, stop) {
+    std::vector<unsigned> weights = {1, 1};
+
+    add_groups(weights, 2);
+
+    m_max_consume = 0;
+    m_result      = UCS_ARBITER_CB_RESULT_STOP;
+    ucs_arbiter_dispatch_drr(&m_arb, 1, batch_cb, this);
+    EXPECT_EQ(1u, m_batches.size());
+
+    /* next dispatch continues from the same group */
+    m_max_consume = UINT_MAX;
+    m_result      = UCS_ARBITER_CB_RESULT_NEXT_GROUP;
+    ucs_arbiter_dispatch_drr(&m_arb, 1, batch_cb, this);
+    EXPECT_EQ(0u, total_backlog());
+    EXPECT_EQ(0u, seq_group(0));
+}
+
+class test_arbiter_dispatch_perf : public test_arbiter_drr {
+protected:
+    static ucs_arbiter_cb_result_t remove_cb(ucs_arbiter_t *arbiter,
+                                             ucs_arbiter_group_t *group,
+                                             ucs_arbiter_elem_t *elem,
+                                             void *arg)
+    {
+        ++(*static_cast<size_t*>(arg));
+        return UCS_ARBITER_CB_RESULT_REMOVE_ELEM;
+    }
+
+    static unsigned remove_batch_cb(ucs_arbiter_t *arbiter,
+                                    ucs_arbiter_group_t *group,
+                                    ucs_arbiter_elem_t **elems, unsigned count,
+                                    ucs_arbiter_cb_result_t *result_p,
+                                    void *arg)
+    {
+        *static_cast<size_t*>(arg) += count;
+        return count;
+    }
+
+    /* Elements are dispatched through plain groups, so the backlog of the
+     * DRR groups is restored before the next measurement */
+    double measure(unsigned num_groups, unsigned elems_per_group,
+                   unsigned per_group, bool drr)
+    {
+        size_t total = num_groups * elems_per_group;
+        size_t count = 0;
+        ucs_time_t start_time;
+
+        for (unsigned i = 0; i < num_groups; ++i) {
+            for (unsigned j = 0; j < elems_per_group; ++j) {
+                push(i, (i * elems_per_group) + j);
+            }
+            ucs_arbiter_group_schedule(&m_arb, &m_groups[i].super);
+        }
+
+        start_time = ucs_get_time();
+        if (drr) {
+            ucs_arbiter_dispatch_drr(&m_arb, per_group, remove_batch_cb,
+                                     &count);
+        } else {
+            ucs_arbiter_dispatch(&m_arb, per_group, remove_cb, &count);
+            for (unsigned i = 0; i < num_groups; ++i) {
+                m_groups[i].backlog = 0;
+            }
+        }
+
+        EXPECT_EQ(total, count);
+        return total / ucs_time_to_sec(ucs_get_time() - start_time);
+    }
+};
+
+UCS_TEST_SKIP_COND_F(test_arbiter_dispatch_perf, many_groups,
+                     RUNNING_ON_VALGRIND || !ucs::perf_retry_count) {
+    const unsigned num_groups      = 4096;
+    const unsigned elems_per_group = 64;
+    std::vector<unsigned> weights(num_groups, 1);
+
+    add_groups(weights, 0);
+    m_elems.resize(num_groups * elems_per_group);
+
+    for (unsigned per_group = 1; per_group <= 16; per_group *= 4) {
+        double rr_rate  = measure(num_groups, elems_per_group, per_group,
+                                  false);
+        double drr_rate = measure(num_groups, elems_per_group, per_group,
+                                  true);
+        UCS_TEST_MESSAGE << num_groups << "x" << elems_per_group
+                         << " elements, per group " << per_group
+                         << ": dispatch " << rr_rate / 1e6
+                         << " Melem/s, drr dispatch " << drr_rate / 1e6
+                         << " Melem/s";
+    }
+}
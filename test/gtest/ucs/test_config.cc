@@ -794,6 +794,36 @@ UCS_TEST_F(test_config, performance) {
     }
 }
 
+UCS_TEST_F(test_config, env_snapshot_update) {
+    {
+        /* coverity[tainted_string_argument] */
+        ucs::scoped_setenv env1("UCX_COLOR", "white");
+
+        car_opts opts1(UCS_DEFAULT_ENV_PREFIX, NULL);
+        EXPECT_EQ(COLOR_WHITE, opts1->color);
+
+        /* Same environment, parsed table is reused */
+        car_opts opts2(UCS_DEFAULT_ENV_PREFIX, NULL);
+        EXPECT_EQ(COLOR_WHITE, opts2->color);
+
+        /* Modified value must be observed */
+        /* coverity[tainted_string_argument] */
+        ucs::scoped_setenv env2("UCX_COLOR", "black");
+        car_opts opts3(UCS_DEFAULT_ENV_PREFIX, NULL);
+        EXPECT_EQ(COLOR_BLACK, opts3->color);
+
+        /* New variable must be observed */
+        /* coverity[tainted_string_argument] */
+        ucs::scoped_setenv env3("UCX_CARS_COLOR", "white");
+        car_opts opts4(UCS_DEFAULT_ENV_PREFIX, "CARS_");
+        EXPECT_EQ(COLOR_WHITE, opts4->color);
+    }
+
+    /* Removed variable must be observed */
+    car_opts opts(UCS_DEFAULT_ENV_PREFIX, NULL);
+    EXPECT_EQ(COLOR_RED, opts->color);
+}
+
 UCS_TEST_F(test_config, unused) {
     ucs::ucx_env_cleanup env_cleanup;
 
@@ -107,3 +107,33 @@ UCS_TEST_F(test_lru, pop_oldest) {
     expected.insert(expected.end(), elements2.begin(), elements2.end());
     run(elements2, expected);
 }
+
+UCS_TEST_F(test_lru, remove) {
+    std::vector<uint64_t> elements;
+    init_vector(elements, m_capacity, 0);
+    run(elements, elements);
+
+    EXPECT_EQ(size_t(m_capacity), ucs_lru_size(m_lru));
+    EXPECT_FALSE(ucs_lru_remove(m_lru, (void*)(m_capacity * 2)));
+
+    for (size_t i = 0; i < m_capacity; i += 2) {
+        EXPECT_TRUE(ucs_lru_remove(m_lru, (void*)elements[i]));
+        EXPECT_FALSE(ucs_lru_is_present(m_lru, (void*)elements[i]));
+    }
+
+    EXPECT_EQ(size_t(m_capacity / 2), ucs_lru_size(m_lru));
+
+    std::vector<uint64_t> expected;
+    for (size_t i = 1; i < m_capacity; i += 2) {
+        expected.push_back(elements[i]);
+    }
+
+    int elem_index = expected.size() - 1;
+    void **item;
+    ucs_lru_for_each(item, m_lru) {
+        ASSERT_GE(elem_index, 0);
+        EXPECT_EQ(expected[elem_index], (uint64_t)*item);
+        elem_index--;
+    }
+    EXPECT_EQ(-1, elem_index);
+}
@@ -7,9 +7,13 @@
 #include <common/test.h>
 extern "C" {
 #include <ucs/datastruct/mpool.h>
+#include <ucs/datastruct/mpool_mt.h>
+#include <ucs/type/spinlock.h>
 }
 
 #include <limits.h>
+#include <atomic>
+#include <thread>
 #include <vector>
 #include <queue>
 
@@ -291,6 +295,47 @@ UCS_TEST_F(test_mpool, grow) {
     ucs_mpool_cleanup(&mp, 1);
 }
 
+UCS_TEST_F(test_mpool, huge_pages) {
+    const unsigned NUM_ELEMS = 1000;
+    std::vector<void*> objs;
+    ucs_status_t status;
+    ucs_mpool_t mp;
+
+    ucs_mpool_ops_t ops = {
+       ucs_mpool_huge_malloc,
+       ucs_mpool_hugetlb_free,
+       NULL,
+       NULL,
+       NULL
+    };
+    ucs_mpool_params_t mp_params;
+
+    ucs_mpool_params_reset(&mp_params);
+    mp_params.elem_size       = header_size + data_size;
+    mp_params.align_offset    = header_size;
+    mp_params.alignment       = align;
+    mp_params.elems_per_chunk = 256;
+    mp_params.ops             = &ops;
+    mp_params.name            = "tests";
+    status = ucs_mpool_init(&mp_params, &mp);
+    ASSERT_UCS_OK(status);
+
+    for (unsigned i = 0; i < NUM_ELEMS; ++i) {
+        void *obj = ucs_mpool_get(&mp);
+        ASSERT_TRUE(obj != NULL);
+        EXPECT_EQ(0ul, ((uintptr_t)obj + header_size) % align);
+        memset(obj, 0xee, header_size + data_size);
+        objs.push_back(obj);
+    }
+
+    for (std::vector<void*>::iterator it = objs.begin(); it != objs.end();
+         ++it) {
+        ucs_mpool_put(*it);
+    }
+
+    ucs_mpool_cleanup(&mp, 1);
+}
+
 UCS_TEST_F(test_mpool, infinite) {
     const unsigned NUM_ELEMS = 1000000 / ucs::test_time_multiplier();
     ucs_status_t status;
@@ -495,3 +540,194 @@ UCS_TEST_SKIP_COND_F(test_mpool_fifo, alloc_release, !ENABLE_DEBUG_DATA)
 
     ucs_mpool_cleanup(&mp, 0); // skip individual put as obj could be corrupted
 }
+
+class test_mpool_mt : public test_mpool {
+protected:
+    typedef std::vector<void*> batch_t;
+
+    /* Single-producer single-consumer channel of object batches */
+    class channel {
+    public:
+        channel() : m_head(0), m_tail(0), m_done(false)
+        {
+        }
+
+        void push(batch_t &&batch)
+        {
+            while ((m_head - m_tail) == num_slots) {
+                sched_yield();
+            }
+            m_slots[m_head % num_slots] = std::move(batch);
+            ++m_head;
+        }
+
+        bool pull(batch_t &batch)
+        {
+            while (m_tail == m_head) {
+                if (m_done) {
+                    return m_tail != m_head;
+                }
+                sched_yield();
+            }
+            batch = std::move(m_slots[m_tail % num_slots]);
+            ++m_tail;
+            return true;
+        }
+
+        void done()
+        {
+            m_done = true;
+        }
+
+    private:
+        static const size_t num_slots = 64;
+        batch_t             m_slots[num_slots];
+        std::atomic<size_t> m_head;
+        std::atomic<size_t> m_tail;
+        std::atomic<bool>   m_done;
+    };
+
+    void setup_mpool_mt(ucs_mpool_mt_t *mp)
+    {
+        static ucs_mpool_ops_t mpool_ops = {ucs_mpool_chunk_malloc,
+                                            ucs_mpool_chunk_free, NULL, NULL,
+                                            obj_str};
+        ucs_mpool_params_t mp_params;
+
+        ucs_mpool_params_reset(&mp_params);
+        mp_params.elem_size       = data_size;
+        mp_params.elems_per_chunk = 256;
+        mp_params.ops             = &mpool_ops;
+        mp_params.name            = "test";
+        ASSERT_UCS_OK(ucs_mpool_mt_init(&mp_params, magazine_elems,
+                                        num_magazines, mp));
+    }
+
+    /* Allocate objects on the calling thread and release them on another
+     * thread, return the number of nanoseconds per object */
+    template <typename Get, typename Put>
+    double cross_thread(Get get, Put put, size_t count)
+    {
+        channel ch;
+
+        std::thread consumer([&ch, &put]() {
+            batch_t batch;
+            while (ch.pull(batch)) {
+                for (void *obj : batch) {
+                    put(obj);
+                }
+            }
+        });
+
+        ucs_time_t start_time = ucs_get_time();
+        for (size_t i = 0; i < count; i += batch_size) {
+            batch_t batch;
+            for (size_t j = 0; j < batch_size; ++j) {
+                void *obj = get();
+                EXPECT_NE(nullptr, obj);
+                batch.push_back(obj);
+            }
+            ch.push(std::move(batch));
+        }
+        ch.done();
+        consumer.join();
+        ucs_time_t end_time = ucs_get_time();
+
+        return ucs_time_to_nsec(end_time - start_time) / count;
+    }
+
+    static const unsigned magazine_elems = 32;
+    static const unsigned num_magazines  = 64;
+    static const size_t   batch_size     = 16;
+};
+
+UCS_TEST_F(test_mpool_mt, get_put) {
+    ucs_mpool_mt_t mp;
+    std::vector<void*> objs;
+
+    setup_mpool_mt(&mp);
+
+    for (unsigned i = 0; i < magazine_elems * 10; ++i) {
+        void *obj = ucs_mpool_mt_get(&mp);
+        ASSERT_NE(nullptr, obj);
+        memset(obj, 0xcc, data_size);
+        objs.push_back(obj);
+    }
+
+    std::sort(objs.begin(), objs.end());
+    EXPECT_EQ(objs.end(), std::adjacent_find(objs.begin(), objs.end()));
+
+    for (void *obj : objs) {
+        ucs_mpool_mt_put(obj);
+    }
+
+    ucs_mpool_mt_cleanup(&mp, 1);
+}
+
+UCS_TEST_F(test_mpool_mt, leak_check) {
+    ucs_mpool_mt_t mp;
+
+    setup_mpool_mt(&mp);
+    void *obj = ucs_mpool_mt_get(&mp);
+    ASSERT_NE(nullptr, obj);
+
+    leak_count = 0;
+    {
+        scoped_log_handler log_handler(mpool_log_leak_handler);
+        ucs_mpool_mt_cleanup(&mp, 1);
+    }
+    EXPECT_EQ(1, leak_count);
+}
+
+UCS_TEST_F(test_mpool_mt, cross_thread) {
+    const size_t count = 100000 / ucs::test_time_multiplier();
+    ucs_mpool_mt_t mp;
+
+    setup_mpool_mt(&mp);
+    cross_thread([&mp]() { return ucs_mpool_mt_get(&mp); },
+                 ucs_mpool_mt_put, count);
+
+    /* Thread which released the objects has exited, so all of them must be
+     * back in the depot or in the backing pool */
+    ucs_mpool_mt_cleanup(&mp, 1);
+}
+
+UCS_TEST_SKIP_COND_F(test_mpool_mt, cross_thread_perf,
+                     (ucs::test_time_multiplier() > 1)) {
+    const size_t count = 10000000ul;
+    ucs_spinlock_t lock;
+    ucs_mpool_mt_t mp_mt;
+    ucs_mpool_t mp;
+
+    ASSERT_UCS_OK(setup_mpool(&mp, data_size, 256, UINT_MAX));
+    ASSERT_UCS_OK(ucs_spinlock_init(&lock, 0));
+    double locked_ns = cross_thread(
+            [&mp, &lock]() {
+                ucs_spin_lock(&lock);
+                void *obj = ucs_mpool_get(&mp);
+                ucs_spin_unlock(&lock);
+                return obj;
+            },
+            [&lock](void *obj) {
+                ucs_spin_lock(&lock);
+                ucs_mpool_put(obj);
+                ucs_spin_unlock(&lock);
+            },
+            count);
+    ucs_spinlock_destroy(&lock);
+    ucs_mpool_cleanup(&mp, 1);
+
+    setup_mpool_mt(&mp_mt);
+    double mt_ns = cross_thread([&mp_mt]() { return ucs_mpool_mt_get(&mp_mt); },
+                                ucs_mpool_mt_put, count);
+    ucs_mpool_mt_cleanup(&mp_mt, 1);
+
+    UCS_TEST_MESSAGE << "cross-thread get+put: locked mpool " << locked_ns
+                     << " nsec, thread-safe mpool " << mt_ns << " nsec";
+
+    if (ucs::perf_retry_count) {
+        EXPECT_LT(mt_ns, locked_ns);
+    } else {
+        UCS_TEST_MESSAGE << "not validating performance";
+    }
+}
@@ -9,8 +9,11 @@ extern "C" {
 #include <ucs/memory/numa.h>
 #include <ucs/sys/sys.h>
 #include <ucs/sys/topo/base/topo.h>
+#include <ucs/time/time.h>
 }
 
+#include <sys/mman.h>
+
 static std::string get_sysfs_device_path(const std::string &bdf)
 {
     std::string symlink = "/sys/bus/pci/devices/" + bdf;
@@ -245,6 +248,102 @@ UCS_TEST_F(test_topo, numa_distance) {
     }
 }
 
+UCS_TEST_F(test_topo, numa_node_of_cpuset) {
+    ucs_numa_node_t node0 = ucs_numa_node_of_cpu(0);
+    ucs_cpu_set_t cpu_mask;
+
+    UCS_CPU_ZERO(&cpu_mask);
+    EXPECT_EQ(UCS_NUMA_NODE_UNDEFINED, ucs_numa_node_of_cpuset(&cpu_mask));
+
+    UCS_CPU_SET(0, &cpu_mask);
+    EXPECT_EQ(node0, ucs_numa_node_of_cpuset(&cpu_mask));
+
+    for (unsigned cpu = 1; cpu < ucs_numa_num_configured_cpus(); ++cpu) {
+        if (ucs_numa_node_of_cpu(cpu) != node0) {
+            UCS_CPU_SET(cpu, &cpu_mask);
+            EXPECT_EQ(UCS_NUMA_NODE_UNDEFINED,
+                      ucs_numa_node_of_cpuset(&cpu_mask));
+            break;
+        }
+    }
+}
+
+UCS_TEST_F(test_topo, numa_mbind) {
+    const size_t size = 4 * ucs_get_page_size();
+    ucs_status_t status;
+
+    for (ucs_numa_node_t node = 0; node < ucs_numa_num_configured_nodes();
+         ++node) {
+        void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        ASSERT_NE(MAP_FAILED, ptr);
+
+        status = ucs_numa_mbind(ptr, size, node);
+        if (status == UCS_ERR_UNSUPPORTED) {
+            munmap(ptr, size);
+            UCS_TEST_SKIP_R("mbind is not supported");
+        }
+
+        EXPECT_UCS_OK(status);
+        memset(ptr, 0, size);
+        munmap(ptr, size);
+    }
+
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM,
+              ucs_numa_mbind(NULL, 0, ucs_numa_num_configured_nodes()));
+}
+
+UCS_TEST_SKIP_COND_F(test_topo, numa_bandwidth,
+                     RUNNING_ON_VALGRIND || (ucs::test_time_multiplier() > 1))
+{
+    const size_t size     = 32 * UCS_MBYTE;
+    const unsigned iters  = 10;
+    ucs_sys_cpuset_t orig_cpuset, cpuset;
+    ucs_numa_node_t local_node;
+
+    if (ucs_numa_num_configured_nodes() < 2) {
+        UCS_TEST_SKIP_R("less than two NUMA nodes");
+    }
+
+    /* Run on the first CPU, and copy from shared memory bound to every node */
+    ASSERT_UCS_OK(ucs_sys_pthread_getaffinity(&orig_cpuset));
+    CPU_ZERO(&cpuset);
+    CPU_SET(0, &cpuset);
+    ASSERT_EQ(0, pthread_setaffinity_np(pthread_self(), sizeof(cpuset),
+                                        &cpuset));
+    local_node = ucs_numa_node_of_cpu(0);
+
+    std::vector<char> dst(size);
+    for (ucs_numa_node_t node = 0; node < ucs_numa_num_configured_nodes();
+         ++node) {
+        void *src = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        ASSERT_NE(MAP_FAILED, src);
+
+        if (ucs_numa_mbind(src, size, node) != UCS_OK) {
+            munmap(src, size);
+            continue;
+        }
+
+        memset(src, 1, size);
+        memcpy(dst.data(), src, size);
+
+        ucs_time_t start_time = ucs_get_time();
+        for (unsigned i = 0; i < iters; ++i) {
+            memcpy(dst.data(), src, size);
+        }
+        double elapsed = ucs_time_to_sec(ucs_get_time() - start_time);
+
+        UCS_TEST_MESSAGE << "node " << local_node << " <- node " << node
+                         << " (distance " << ucs_numa_distance(local_node, node)
+                         << "): " << (size * iters) / elapsed / UCS_MBYTE
+                         << " MB/s";
+        munmap(src, size);
+    }
+
+    pthread_setaffinity_np(pthread_self(), sizeof(orig_cpuset), &orig_cpuset);
+}
+
 // Scan and classify PCI devices
 void test_topo::read_pcie_devices()
 {
@@ -19,18 +19,22 @@ public:
 
     struct mm_resource : public resource {
         std::string  shm_dir;
+        bool         memfd;
 
-        mm_resource(const resource& res, const std::string& shm_dir = "") :
+        mm_resource(const resource& res, const std::string& shm_dir = "",
+                    bool memfd = false) :
             resource(res.component, res.component_name, res.md_name,
                      res.local_cpus, res.tl_name, res.dev_name, res.dev_type,
                      res.sys_device),
-            shm_dir(shm_dir)
+            shm_dir(shm_dir), memfd(memfd)
         {
         }
 
         virtual std::string name() const {
             std::string name = resource::name();
-            if (!shm_dir.empty()) {
+            if (memfd) {
+                name += ",memfd";
+            } else if (!shm_dir.empty()) {
                 name += ",dir=" + shm_dir;
             }
             return name;
@@ -75,10 +79,14 @@ public:
                                     std::vector<mm_resource> &variants) {
         variants.push_back(mm_resource(res, "."       ));
         variants.push_back(mm_resource(res, "/dev/shm"));
+        variants.push_back(mm_resource(res, "/dev/shm", true));
     }
 
     void set_posix_config() {
         set_config("POSIX_DIR=" + GetParam()->shm_dir);
+        if (GetParam()->memfd) {
+            set_config("POSIX_USE_MEMFD=y");
+        }
     }
 
     virtual void init() {
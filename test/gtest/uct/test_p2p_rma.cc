@@ -170,3 +170,85 @@ UCS_TEST_SKIP_COND_P(test_p2p_rma_madvise, madvise,
 }
 
 UCT_INSTANTIATE_TEST_CASE(test_p2p_rma_madvise)
+
+
+class test_p2p_rma_parallel_copy : public uct_p2p_rma_test {
+protected:
+    /* Lengths around the copy threshold, unaligned to the chunk size */
+    void test_lengths(send_func_t send, unsigned flags)
+    {
+        static const size_t lengths[] = {
+            UCS_KBYTE, 64 * UCS_KBYTE - 1, 64 * UCS_KBYTE, 64 * UCS_KBYTE + 17,
+            UCS_MBYTE + 3, 8 * UCS_MBYTE, 32 * UCS_MBYTE + 5
+        };
+
+        for (size_t i = 0; i < ucs_static_array_size(lengths); ++i) {
+            test_xfer(send, lengths[i], flags, UCS_MEMORY_TYPE_HOST);
+        }
+    }
+
+    double test_bandwidth(send_func_t send, size_t length, unsigned iters)
+    {
+        mapped_buffer sendbuf(length, SEED1, sender());
+        mapped_buffer recvbuf(length, SEED2, receiver());
+
+        /* Warmup */
+        blocking_send(send, sender_ep(), sendbuf, recvbuf, true);
+
+        ucs_time_t start_time = ucs_get_time();
+        for (unsigned i = 0; i < iters; ++i) {
+            blocking_send(send, sender_ep(), sendbuf, recvbuf, true);
+        }
+
+        return (length * iters) /
+               ucs_time_to_sec(ucs_get_time() - start_time) / UCS_GBYTE;
+    }
+};
+
+UCS_TEST_SKIP_COND_P(test_p2p_rma_parallel_copy, put_zcopy,
+                     !check_caps(UCT_IFACE_FLAG_PUT_ZCOPY),
+                     "SCOPY_COPY_THREADS=3", "SCOPY_COPY_THRESH=64k")
+{
+    test_lengths(static_cast<send_func_t>(&uct_p2p_rma_test::put_zcopy),
+                 TEST_UCT_FLAG_SEND_ZCOPY);
+}
+
+UCS_TEST_SKIP_COND_P(test_p2p_rma_parallel_copy, get_zcopy,
+                     !check_caps(UCT_IFACE_FLAG_GET_ZCOPY),
+                     "SCOPY_COPY_THREADS=3", "SCOPY_COPY_THRESH=64k")
+{
+    test_lengths(static_cast<send_func_t>(&uct_p2p_rma_test::get_zcopy),
+                 TEST_UCT_FLAG_RECV_ZCOPY);
+}
+
+UCS_TEST_SKIP_COND_P(test_p2p_rma_parallel_copy, bandwidth,
+                     !check_caps(UCT_IFACE_FLAG_GET_ZCOPY) ||
+                     RUNNING_ON_VALGRIND || (ucs::test_time_multiplier() > 1),
+                     "SCOPY_COPY_THREADS=3")
+{
+    const size_t length = 256 * UCS_MBYTE;
+
+    UCS_TEST_MESSAGE << "get_zcopy " << (length / UCS_MBYTE)
+                     << "MB with 3 copy threads: "
+                     << test_bandwidth(static_cast<send_func_t>(
+                                               &uct_p2p_rma_test::get_zcopy),
+                                       length, 8)
+                     << " GB/s";
+}
+
+UCS_TEST_SKIP_COND_P(test_p2p_rma_parallel_copy, bandwidth_serial,
+                     !check_caps(UCT_IFACE_FLAG_GET_ZCOPY) ||
+                     RUNNING_ON_VALGRIND || (ucs::test_time_multiplier() > 1),
+                     "SCOPY_COPY_THREADS=0")
+{
+    const size_t length = 256 * UCS_MBYTE;
+
+    UCS_TEST_MESSAGE << "get_zcopy " << (length / UCS_MBYTE)
+                     << "MB without copy threads: "
+                     << test_bandwidth(static_cast<send_func_t>(
+                                               &uct_p2p_rma_test::get_zcopy),
+                                       length, 8)
+                     << " GB/s";
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_p2p_rma_parallel_copy, cma)
@@ -672,5 +672,13 @@ UCS_TEST_SKIP_COND_P(test_uct_peer_failure_rma_zcopy, get,
     test_rma_zcopy_peer_failure(false);
 }
 
+UCS_TEST_SKIP_COND_P(test_uct_peer_failure_rma_zcopy, get_parallel_copy,
+                     !check_caps(UCT_IFACE_FLAG_ERRHANDLE_PEER_FAILURE |
+                                 UCT_IFACE_FLAG_GET_ZCOPY),
+                     "SCOPY_COPY_THREADS=2", "SCOPY_COPY_THRESH=64")
+{
+    test_rma_zcopy_peer_failure(false);
+}
+
 _UCT_INSTANTIATE_TEST_CASE(test_uct_peer_failure_rma_zcopy, cma)
 
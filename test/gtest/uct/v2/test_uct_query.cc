@@ -12,8 +12,11 @@ extern "C" {
 #include <uct/api/uct.h>
 #include <uct/api/v2/uct_v2.h>
 #include <uct/base/uct_iface.h>
+#include <uct/sm/base/sm_iface.h>
 }
 
+#include <fstream>
+
 
 #define IB_SEND_OVERHEAD_BCOPY     1
 #define IB_SEND_OVERHEAD_CQE       2
@@ -178,3 +181,64 @@ UCS_TEST_P(test_uct_query_mm, send_recv_overhead,
 }
 
 UCT_INSTANTIATE_MM_TEST_CASE(test_uct_query_mm)
+
+class test_uct_query_sm : public test_uct_query {
+public:
+    test_uct_query_sm()
+    {
+        set_config("SM_CALIBRATE=y");
+    }
+
+protected:
+    static double measure_unexpected()
+    {
+        ADD_FAILURE() << "cached value should not be measured";
+        return 0;
+    }
+
+    static double measure_value()
+    {
+        return 1.5e-7;
+    }
+};
+
+UCS_TEST_P(test_uct_query_sm, calibrate)
+{
+    auto perf_attr        = init_perf_attr();
+    perf_attr.field_mask |= UCT_PERF_ATTR_FIELD_SEND_PRE_OVERHEAD |
+                            UCT_PERF_ATTR_FIELD_BANDWIDTH |
+                            UCT_PERF_ATTR_FIELD_LATENCY;
+
+    ASSERT_UCS_OK(iface_estimate_perf(&perf_attr));
+    EXPECT_GT(perf_attr.bandwidth.dedicated, 0);
+    EXPECT_GT(perf_attr.send_pre_overhead, 0);
+    EXPECT_GT(perf_attr.latency.c, 0);
+
+    UCS_TEST_MESSAGE << "bandwidth: "
+                     << (perf_attr.bandwidth.dedicated / UCS_MBYTE)
+                     << " MB/s, overhead: "
+                     << (perf_attr.send_pre_overhead * UCS_NSEC_PER_SEC)
+                     << " ns, latency: "
+                     << (perf_attr.latency.c * UCS_NSEC_PER_SEC) << " ns";
+}
+
+UCS_TEST_P(test_uct_query_sm, calibrate_cache)
+{
+    std::string path = "/tmp/uct_sm_perf_" + std::to_string(getpid());
+    uct_sm_iface_config_t config;
+
+    config.calib_cache = const_cast<char*>(path.c_str());
+    std::ofstream(path) << "cached_value 4.2e-07" << std::endl;
+
+    EXPECT_DOUBLE_EQ(4.2e-7, uct_sm_perf_get(&config, "cached_value",
+                                             measure_unexpected));
+    EXPECT_DOUBLE_EQ(1.5e-7, uct_sm_perf_get(&config, "new_value",
+                                             measure_value));
+    EXPECT_DOUBLE_EQ(1.5e-7, uct_sm_perf_get(&config, "new_value",
+                                             measure_unexpected));
+
+    unlink(path.c_str());
+}
+
+UCT_INSTANTIATE_MM_TEST_CASE(test_uct_query_sm)
+_UCT_INSTANTIATE_TEST_CASE(test_uct_query_sm, cma)